@@ -12,6 +12,30 @@
 #include <SDL2_ttf/SDL_ttf.h>
 #include <tgmath.h>
 
+//The bulk kernels have SSE2 and AVX2 versions on x86, picked at runtime
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AE_X86_SIMD 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define AE_TARGET_SSE2 __attribute__((target("sse2")))
+#define AE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AE_TARGET_SSE2
+#define AE_TARGET_AVX2
+#endif
+#endif
+
+//Kernels whose scalar and SIMD versions must give bit-identical results can't let the compiler fuse multiplies and adds
+#if defined(__GNUC__) && !defined(__clang__)
+#define AE_NO_FP_CONTRACT __attribute__((optimize("fp-contract=off")))
+#elif defined(__clang__)
+//Clang has no per-function switch, so contraction is turned off for the rest of the file instead
+#pragma clang fp contract(off)
+#define AE_NO_FP_CONTRACT
+#else
+#define AE_NO_FP_CONTRACT
+#endif
+
 //
 //
 //Start: SDL Initialization and Closing Functions
@@ -146,6 +170,356 @@ void AE_CloseSDL()
 //
 //
 
+//
+//
+//Start: Memory Functions
+//
+//
+
+//Pooled objects and arena allocations are kept 16-byte aligned so SIMD code can use them
+#define AE_MEMORY_ALIGNMENT 16
+#define AE_MEMORY_ALIGN(size) (((size) + (AE_MEMORY_ALIGNMENT - 1)) & ~(size_t)(AE_MEMORY_ALIGNMENT - 1))
+#define AE_OBJECT_POOL_BLOCK_OBJECTS 64
+
+//Each block starts with a link to the next block. SDL_malloc only promises alignment for basic types, so there is room to push the objects after it up to an aligned address
+#define AE_OBJECT_POOL_BLOCK_HEADER (sizeof(void*) + AE_MEMORY_ALIGNMENT - 1)
+
+//The pools the default allocator uses, one per object type, ready without any setup
+static AE_ObjectPool AE_enginePools[AE_OBJECT_TYPE_COUNT] = {
+    {AE_MEMORY_ALIGN(sizeof(AE_Sprite)), AE_OBJECT_POOL_BLOCK_OBJECTS, NULL, NULL, 0, 0, 0},
+    {AE_MEMORY_ALIGN(sizeof(AE_SpriteDef)), AE_OBJECT_POOL_BLOCK_OBJECTS, NULL, NULL, 0, 0, 0},
+    {AE_MEMORY_ALIGN(sizeof(AE_LinkedTexture)), AE_OBJECT_POOL_BLOCK_OBJECTS, NULL, NULL, 0, 0, 0},
+    {AE_MEMORY_ALIGN(sizeof(AE_PreciseTimer)), AE_OBJECT_POOL_BLOCK_OBJECTS, NULL, NULL, 0, 0, 0}
+};
+
+/**
+ Allocates an object from the engine's pool for its type. This is the allocate callback of the default allocator
+ 
+ @param context Unused, the default allocator has no context
+ @param type The kind of object being allocated
+ @param size Unused, each pool already knows the size of its objects
+ @return The uninitialized object, or NULL if it couldn't be allocated
+ */
+static void* AE_DefaultAllocate(void* context, AE_ObjectType type, size_t size)
+{
+    (void)context;
+    (void)size;
+    return AE_ObjectPool_Allocate(&AE_enginePools[type]);
+}
+
+/**
+ Returns an object to the engine's pool for its type. This is the release callback of the default allocator
+ 
+ @param context Unused, the default allocator has no context
+ @param type The kind of object being released
+ @param object The object to release
+ */
+static void AE_DefaultRelease(void* context, AE_ObjectType type, void* object)
+{
+    (void)context;
+    AE_ObjectPool_Free(&AE_enginePools[type], object);
+}
+
+static AE_Allocator AE_allocator = {AE_DefaultAllocate, AE_DefaultRelease, NULL};
+
+/**
+ Allocates one of the engine's small objects from the current allocator
+ 
+ @param type The kind of object being allocated
+ @param size The size of the object
+ @return The uninitialized object, or NULL if it couldn't be allocated
+ */
+static void* AE_AllocateObject(AE_ObjectType type, size_t size)
+{
+    return AE_allocator.allocate(AE_allocator.context, type, size);
+}
+
+/**
+ Returns one of the engine's small objects to the current allocator
+ 
+ @param type The kind of object being released
+ @param object The object to release (NULL is ignored)
+ */
+static void AE_ReleaseObject(AE_ObjectType type, void* object)
+{
+    if (object != NULL)
+    {
+        AE_allocator.release(AE_allocator.context, type, object);
+    }
+}
+
+/**
+ Frees every block of a pool, leaving it empty but usable
+ 
+ @param pool The AE_ObjectPool whose blocks will be freed
+ */
+static void AE_ObjectPool_FreeBlocks(AE_ObjectPool* pool)
+{
+    void* block = pool->blocks;
+    while (block != NULL)
+    {
+        void* next = *(void**)block;
+        SDL_free(block);
+        block = next;
+    }
+    pool->blocks = NULL;
+    pool->freeList = NULL;
+    pool->liveCount = 0;
+    pool->capacity = 0;
+}
+
+/**
+ Replaces the allocator the engine makes its sprites, sprite definitions, linkedTextures and precise timers from. Like SDL_SetMemoryFunctions, it must be set before any of those objects are created or after all of them are destroyed
+ 
+ @param allocator The allocator to use, or NULL to go back to the engine's own object pools
+ */
+void AE_SetAllocator(const AE_Allocator* allocator)
+{
+    if (allocator == NULL || allocator->allocate == NULL || allocator->release == NULL)
+    {
+        AE_allocator.allocate = AE_DefaultAllocate;
+        AE_allocator.release = AE_DefaultRelease;
+        AE_allocator.context = NULL;
+    }
+    else
+    {
+        AE_allocator = *allocator;
+    }
+}
+
+/**
+ Gets the allocator the engine makes its small objects from
+ 
+ @return The current allocator
+ */
+AE_Allocator AE_GetAllocator(void)
+{
+    return AE_allocator;
+}
+
+/**
+ Gets one of the object pools the engine's default allocator uses
+ 
+ @param type The kind of object whose pool will be retrieved
+ @return The pool objects of that kind are allocated from by default
+ */
+AE_ObjectPool* AE_GetObjectPool(AE_ObjectType type)
+{
+    if (type < 0 || type >= AE_OBJECT_TYPE_COUNT)
+    {
+        return NULL;
+    }
+    return &AE_enginePools[type];
+}
+
+/**
+ Creates a pool of fixed-size objects
+ 
+ @param objectSize The size of each object
+ @param objectsPerBlock The number of objects allocated at once when the pool runs out (0 or less for 64)
+ @return The new AE_ObjectPool, or NULL if it could not be created
+ */
+AE_ObjectPool* AE_CreateObjectPool(size_t objectSize, int objectsPerBlock)
+{
+    AE_ObjectPool* pool = SDL_malloc(sizeof(AE_ObjectPool));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+    
+    //Free objects hold the free list link, so they can't be smaller than a pointer
+    if (objectSize < sizeof(void*))
+    {
+        objectSize = sizeof(void*);
+    }
+    pool->objectSize = AE_MEMORY_ALIGN(objectSize);
+    pool->objectsPerBlock = objectsPerBlock > 0 ? objectsPerBlock : AE_OBJECT_POOL_BLOCK_OBJECTS;
+    pool->blocks = NULL;
+    pool->freeList = NULL;
+    pool->liveCount = 0;
+    pool->capacity = 0;
+    pool->lock = 0;
+    return pool;
+}
+
+/**
+ Takes an object from a pool, allocating a new block if the pool is empty. Safe to call from any thread
+ 
+ @param pool The AE_ObjectPool to allocate from
+ @return The uninitialized object, or NULL if a new block couldn't be allocated
+ */
+void* AE_ObjectPool_Allocate(AE_ObjectPool* pool)
+{
+    void* object;
+    
+    SDL_AtomicLock(&pool->lock);
+    if (pool->freeList == NULL)
+    {
+        Uint8* block = SDL_malloc(AE_OBJECT_POOL_BLOCK_HEADER + pool->objectSize * pool->objectsPerBlock);
+        if (block == NULL)
+        {
+            SDL_AtomicUnlock(&pool->lock);
+            return NULL;
+        }
+        *(void**)block = pool->blocks;
+        pool->blocks = block;
+        Uint8* objects = (Uint8*)AE_MEMORY_ALIGN((uintptr_t)block + sizeof(void*));
+        
+        //Thread the new objects onto the free list back to front, so they're handed out in address order
+        for (int i = pool->objectsPerBlock - 1; i >= 0; i--)
+        {
+            void* free = objects + pool->objectSize * i;
+            *(void**)free = pool->freeList;
+            pool->freeList = free;
+        }
+        pool->capacity += pool->objectsPerBlock;
+    }
+    object = pool->freeList;
+    pool->freeList = *(void**)object;
+    pool->liveCount++;
+    SDL_AtomicUnlock(&pool->lock);
+    return object;
+}
+
+/**
+ Returns an object to the pool it was taken from. Safe to call from any thread
+ 
+ @param pool The AE_ObjectPool the object was taken from
+ @param object The object to return (NULL is ignored)
+ */
+void AE_ObjectPool_Free(AE_ObjectPool* pool, void* object)
+{
+    if (object != NULL)
+    {
+        SDL_AtomicLock(&pool->lock);
+        *(void**)object = pool->freeList;
+        pool->freeList = object;
+        pool->liveCount--;
+        SDL_AtomicUnlock(&pool->lock);
+    }
+}
+
+/**
+ Gets the number of objects taken from a pool and not yet returned
+ 
+ @param pool The AE_ObjectPool whose objects will be counted
+ @return The number of live objects
+ */
+int AE_ObjectPool_GetLiveCount(AE_ObjectPool* pool)
+{
+    int liveCount;
+    SDL_AtomicLock(&pool->lock);
+    liveCount = pool->liveCount;
+    SDL_AtomicUnlock(&pool->lock);
+    return liveCount;
+}
+
+/**
+ Frees every block of a pool and the pool itself. Any objects still taken from it become invalid
+ 
+ @param pool The AE_ObjectPool to be destroyed
+ */
+void AE_DestroyObjectPool(AE_ObjectPool* pool)
+{
+    if (pool != NULL)
+    {
+        AE_ObjectPool_FreeBlocks(pool);
+        SDL_free(pool);
+    }
+}
+
+/**
+ Creates a frame arena
+ 
+ @param capacity The number of bytes the arena can hand out between resets
+ @return The new AE_FrameArena, or NULL if it could not be created
+ */
+AE_FrameArena* AE_CreateFrameArena(size_t capacity)
+{
+    AE_FrameArena* arena = SDL_malloc(sizeof(AE_FrameArena));
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    
+    //SDL_malloc only promises alignment for basic types, so the start is aligned by hand when needed
+    arena->memory = SDL_malloc(capacity + AE_MEMORY_ALIGNMENT);
+    if (arena->memory == NULL)
+    {
+        SDL_free(arena);
+        return NULL;
+    }
+    arena->capacity = capacity;
+    arena->used = 0;
+    arena->peak = 0;
+    return arena;
+}
+
+/**
+ Takes memory from a frame arena, aligned for any type. The memory stays valid until the arena is reset
+ 
+ @param arena The AE_FrameArena to allocate from
+ @param size The number of bytes needed
+ @return The memory, or NULL if the arena doesn't have enough room left
+ */
+void* AE_FrameArena_Allocate(AE_FrameArena* arena, size_t size)
+{
+    Uint8* base = (Uint8*)AE_MEMORY_ALIGN((uintptr_t)arena->memory);
+    size_t offset = AE_MEMORY_ALIGN(arena->used);
+    
+    if (size > arena->capacity || offset > arena->capacity - size)
+    {
+        return NULL;
+    }
+    arena->used = offset + size;
+    if (arena->used > arena->peak)
+    {
+        arena->peak = arena->used;
+    }
+    return base + offset;
+}
+
+/**
+ Hands all of a frame arena's memory back at once, invalidating everything allocated from it
+ 
+ @param arena The AE_FrameArena to reset
+ */
+void AE_FrameArena_Reset(AE_FrameArena* arena)
+{
+    arena->used = 0;
+}
+
+/**
+ Gets the most memory a frame arena has had in use at once, for sizing it
+ 
+ @param arena The AE_FrameArena whose peak will be retrieved
+ @return The peak number of bytes in use
+ */
+size_t AE_FrameArena_GetPeak(AE_FrameArena* arena)
+{
+    return arena->peak;
+}
+
+/**
+ Frees and destroys an AE_FrameArena
+ 
+ @param arena The AE_FrameArena to be destroyed
+ */
+void AE_DestroyFrameArena(AE_FrameArena* arena)
+{
+    if (arena != NULL)
+    {
+        SDL_free(arena->memory);
+        SDL_free(arena);
+    }
+}
+
+//
+//
+//End: Memory Functions
+//
+//
+
 
 //
 //
@@ -181,6 +555,7 @@ Uint32 AE_GetSurfacePixel(SDL_Surface* surface, int x, int y)
  */
 SDL_Texture* AE_LoadTextureFromFile(SDL_Renderer* renderer, const char* path)
 {   
+    AE_PROFILE_BEGIN("AE_LoadTextureFromFile");
     //Load a surface from the given path
     SDL_Surface* loaded = IMG_Load(path);
     SDL_Texture* output = NULL;
@@ -214,6 +589,7 @@ SDL_Texture* AE_LoadTextureFromFile(SDL_Renderer* renderer, const char* path)
         //Destroy original surface
         SDL_FreeSurface(loaded);
     }
+    AE_PROFILE_END();
     return output;
 }
 
@@ -230,6 +606,7 @@ SDL_Texture* AE_LoadTextureFromFile(SDL_Renderer* renderer, const char* path)
  */
 SDL_Texture* AE_LoadTextureFromText(SDL_Renderer* renderer, TTF_Font* font, const char* text, SDL_Color textColor)
 {
+    AE_PROFILE_BEGIN("AE_LoadTextureFromText");
     //Render the text onto a surface
     SDL_Surface* loaded = TTF_RenderText_Solid(font, text, textColor);
     
@@ -252,6 +629,7 @@ SDL_Texture* AE_LoadTextureFromText(SDL_Renderer* renderer, TTF_Font* font, cons
     }
     //Free the original surface
     SDL_FreeSurface(loaded);
+    AE_PROFILE_END();
     return output;
 }
 
@@ -317,1182 +695,10226 @@ Uint32 AE_TextureGetFormat(SDL_Texture* texture)
 
 //
 //
-//Start: Linked Textures and Associated Functions
+//Start: Renderer State Cache Functions
 //
 //
 
-/**
- Creates a new linkedTexture from an SDL_Texture with an empty list of referencing objects
-
- @param texture The SDL_Texture to create the linkedTexture from
- @return The linkedTexture with the SDL_Texture as its texture and an empty list of referencing objects
- */
-AE_LinkedTexture* AE_CreateLinkedTexture(SDL_Texture* texture)
-{
-    AE_LinkedTexture* output = SDL_malloc(sizeof(AE_LinkedTexture));
-    output->texture = texture;
-    output->linkedList = NULL;
-    output->references = 0;
-    return output;
-}
+//The state caches of every renderer that has one
+static AE_RenderState** AE_renderStates = NULL;
+static int AE_renderStateCount = 0;
 
 /**
- Creates a new linkedTexture from an SDL_Texture from a given pathname with an empty list of referencing objects
- 
- @param renderer The renderer which will generate the new Texture
- @param path The pathname of the file to be loaded
- @return The linkedTexture with the SDL_Texture as its texture and an empty list of referencing objects
+ Hashes a texture pointer into a slot of a state cache
+
+ @param texture The texture to be hashed
+ @param capacity The capacity of the state cache (a power of 2)
+ @return The first slot the texture may be stored in
  */
-AE_LinkedTexture* AE_LinkedTexture_CreateFromFile(SDL_Renderer* renderer, const char* path)
+static int AE_RenderState_Slot(SDL_Texture* texture, int capacity)
 {
-    AE_LinkedTexture* output = SDL_malloc(sizeof(AE_LinkedTexture));
-    output->texture = AE_LoadTextureFromFile(renderer, path);
-    output->linkedList = NULL;
-    output->references = 0;
-    return output;
+    Uint64 hash = (Uint64)(uintptr_t)texture;
+    hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (int)(hash & (Uint64)(capacity - 1));
 }
 
 /**
- Adds an object to the list of objects referencing a linkedTexture
+ Finds the tracked state of a texture, adding an unknown state for it if it's not tracked yet
 
- @param linkedTexture The linkedTexture that the object would like to reference
- @param stakeholder_object The object that will reference the linkedTexture
- @return Whether the object joined the list of objects referencing the linkedTexture or not
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture whose state will be found
+ @return The tracked state of the texture
  */
-SDL_bool AE_LinkedTexture_Join(AE_LinkedTexture* linkedTexture, void* stakeholder_object)
+static AE_TextureState* AE_RenderState_Find(AE_RenderState* state, SDL_Texture* texture)
 {
-    //Whether creating a new link to the linkedTexture was successful or not
-    SDL_bool success = SDL_FALSE;
-    
-    //If there are no objects referencing a linkedTexture yet
-    if (linkedTexture->linkedList == NULL)
+    //Grow the table once it is half full to keep the probes short
+    if ((state->count + 1) * 2 > state->capacity)
     {
-        //Make the root reference into the current stakeholder object
-        if ((linkedTexture->linkedList = SDL_malloc(sizeof(AE_SheetLink))))
-        {
-            success = SDL_TRUE;
-        }
-        linkedTexture->linkedList->reference = stakeholder_object;
-        linkedTexture->linkedList->next = NULL;
+        AE_TextureState* oldEntries = state->entries;
+        int oldCapacity = state->capacity;
         
-        //Increment the number of references
-        linkedTexture->references++;
-    }
-    else
-    {
-        AE_SheetLink* tempSheetLink = linkedTexture->linkedList;
+        state->capacity = oldCapacity * 2;
+        state->entries = SDL_calloc(state->capacity, sizeof(AE_TextureState));
         
-        //Skip through the list of objects until you reach the end
-        while (tempSheetLink->next != NULL)
+        //Reinsert every tracked texture into the new table
+        for (int i = 0; i<oldCapacity; i++)
         {
-            tempSheetLink = tempSheetLink->next;
+            if (oldEntries[i].texture != NULL)
+            {
+                int slot = AE_RenderState_Slot(oldEntries[i].texture, state->capacity);
+                while (state->entries[slot].texture != NULL)
+                {
+                    slot = (slot + 1) & (state->capacity - 1);
+                }
+                state->entries[slot] = oldEntries[i];
+            }
         }
-        //Create the new reference at the end of the list
-        if ((tempSheetLink->next = SDL_malloc(sizeof(AE_SheetLink))))
+        SDL_free(oldEntries);
+    }
+    
+    int slot = AE_RenderState_Slot(texture, state->capacity);
+    while (state->entries[slot].texture != NULL)
+    {
+        if (state->entries[slot].texture == texture)
         {
-            success = SDL_TRUE;
+            return &state->entries[slot];
         }
-        tempSheetLink->next->reference = stakeholder_object;
-        tempSheetLink->next->next = NULL;
-        
-        //Increment the number of references
-        linkedTexture->references++;
+        slot = (slot + 1) & (state->capacity - 1);
     }
     
-    return success;
+    //The texture isn't tracked yet, so nothing is known about its state
+    SDL_zero(state->entries[slot]);
+    state->entries[slot].texture = texture;
+    state->count++;
+    return &state->entries[slot];
 }
 
 /**
- Removes an object from the list of objects that reference a linkedTexture
+ Creates a state cache for a renderer. While it exists, the engine's own sprite drawing on that renderer goes through the cache
 
- @param linkedTexture The linked texture that the object is removing itself from
- @param stakeholder_object The object that will no longer reference the linkedTexture
- @return Whether the object was removed from the referencing list or not
+ @param renderer The renderer whose texture state will be tracked
+ @return The new AE_RenderState (or the existing one if the renderer already has a cache)
  */
-SDL_bool AE_LinkedTexture_Leave(AE_LinkedTexture* linkedTexture, void* stakeholder_object)
+AE_RenderState* AE_CreateRenderState(SDL_Renderer* renderer)
 {
-    if (linkedTexture->linkedList != NULL)
+    AE_RenderState* output = AE_RenderState_Get(renderer);
+    
+    if (output == NULL)
     {
+        output = SDL_malloc(sizeof(AE_RenderState));
+        output->renderer = renderer;
+        output->capacity = 64;
+        output->count = 0;
+        output->entries = SDL_calloc(output->capacity, sizeof(AE_TextureState));
+        SDL_zero(output->stats);
         
-        AE_SheetLink* tempSheetLink = linkedTexture->linkedList;
-        AE_SheetLink* prevSheetLink = NULL;
-        
-        while (tempSheetLink != NULL)
-        {
-            if (tempSheetLink->reference == stakeholder_object)
-            {
-                if (prevSheetLink == NULL)
-                {
-                    linkedTexture->linkedList = tempSheetLink->next;
-                }
-                else
-                {
-                    prevSheetLink->next = tempSheetLink->next;
-                }
-                SDL_free(tempSheetLink);
-                linkedTexture->references--;
-                return SDL_TRUE;
-            }
-            else
-            {
-                prevSheetLink = tempSheetLink;
-                tempSheetLink = tempSheetLink->next;
-            }
-        }
+        //Register the cache so the engine's drawing functions can find it from the renderer
+        AE_renderStates = SDL_realloc(AE_renderStates, sizeof(AE_RenderState*) * (AE_renderStateCount + 1));
+        AE_renderStates[AE_renderStateCount++] = output;
     }
     
-    return SDL_FALSE;
+    return output;
 }
 
 /**
- Gets the number of objects referencing a linkedTexture
+ Gets the state cache of a renderer
 
- @param linkedTexture The linkedTexture whose reference count will be retrieved
- @return The number of ojects referencing the linked texture
+ @param renderer The renderer whose state cache will be retrieved
+ @return The renderer's AE_RenderState, or NULL if it has none
  */
-Uint16 AE_LinkedTexture_GetReferenceCount(AE_LinkedTexture* linkedTexture)
+AE_RenderState* AE_RenderState_Get(SDL_Renderer* renderer)
 {
-    return linkedTexture->references;
+    for (int i = 0; i<AE_renderStateCount; i++)
+    {
+        if (AE_renderStates[i]->renderer == renderer)
+        {
+            return AE_renderStates[i];
+        }
+    }
+    return NULL;
 }
 
 /**
- Gets the width of the texture in a linkedTexture
+ Sets the color modulation of a texture, skipping the call if the texture already has that modulation
 
- @param linkedTexture The texture whose width will be retrieved
- @return The width of the texture
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture whose color modulation will be set
+ @param r The red modulation
+ @param g The green modulation
+ @param b The blue modulation
+ @return Whether the texture has the given color modulation or not
  */
-int AE_LinkedTexture_GetWidth(AE_LinkedTexture* linkedTexture)
+SDL_bool AE_RenderState_SetTextureColorMod(AE_RenderState* state, SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b)
 {
-    //Create the output variable
-    int output;
+    AE_TextureState* textureState = AE_RenderState_Find(state, texture);
     
-    //Fill the output variable with the necessary data
-    SDL_QueryTexture(linkedTexture->texture, NULL, NULL, &output, NULL);
+    if (textureState->colorKnown && textureState->r == r && textureState->g == g && textureState->b == b)
+    {
+        state->stats.colorModElided++;
+        return SDL_TRUE;
+    }
     
-    //Return the output variable
-    return output;
+    state->stats.colorModCalls++;
+    if (SDL_SetTextureColorMod(texture, r, g, b) != 0)
+    {
+        textureState->colorKnown = SDL_FALSE;
+        return SDL_FALSE;
+    }
+    textureState->r = r;
+    textureState->g = g;
+    textureState->b = b;
+    textureState->colorKnown = SDL_TRUE;
+    return SDL_TRUE;
 }
 
 /**
- Gets the height of the texture in a linkedTexture
- 
- @param linkedTexture The texture whose height will be retrieved
- @return The height of the texture
+ Sets the alpha modulation of a texture, skipping the call if the texture already has that modulation
+
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture whose alpha modulation will be set
+ @param alpha The alpha modulation
+ @return Whether the texture has the given alpha modulation or not
  */
-int AE_LinkedTexture_GetHeight(AE_LinkedTexture* linkedTexture)
+SDL_bool AE_RenderState_SetTextureAlphaMod(AE_RenderState* state, SDL_Texture* texture, Uint8 alpha)
 {
-    //Create the output variable
-    int output;
+    AE_TextureState* textureState = AE_RenderState_Find(state, texture);
     
-    //Fill the output variable with the necessary data
-    SDL_QueryTexture(linkedTexture->texture, NULL, NULL, NULL, &output);
+    if (textureState->alphaKnown && textureState->alpha == alpha)
+    {
+        state->stats.alphaModElided++;
+        return SDL_TRUE;
+    }
     
-    //Return the output variable
-    return output;
+    state->stats.alphaModCalls++;
+    if (SDL_SetTextureAlphaMod(texture, alpha) != 0)
+    {
+        textureState->alphaKnown = SDL_FALSE;
+        return SDL_FALSE;
+    }
+    textureState->alpha = alpha;
+    textureState->alphaKnown = SDL_TRUE;
+    return SDL_TRUE;
 }
 
 /**
- Gets the format of the texture in a linkedTexture
- 
- @param linkedTexture The texture whose format will be retrieved
- @return The format of the texture
+ Sets the blend mode of a texture, skipping the call if the texture already has that blend mode
+
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture whose blend mode will be set
+ @param blendMode The blend mode
+ @return Whether the texture has the given blend mode or not
  */
-Uint32 AE_LinkedTexture_GetFormat(AE_LinkedTexture* linkedTexture)
+SDL_bool AE_RenderState_SetTextureBlendMode(AE_RenderState* state, SDL_Texture* texture, SDL_BlendMode blendMode)
 {
-    //Create the output variable
-    Uint32 output;
+    AE_TextureState* textureState = AE_RenderState_Find(state, texture);
     
-    //Fill the output variable with the necessary data
-    SDL_QueryTexture(linkedTexture->texture, &output, NULL, NULL, NULL);
+    if (textureState->blendKnown && textureState->blendMode == blendMode)
+    {
+        state->stats.blendModeElided++;
+        return SDL_TRUE;
+    }
     
-    //Return the output variable
-    return output;
+    state->stats.blendModeCalls++;
+    if (SDL_SetTextureBlendMode(texture, blendMode) != 0)
+    {
+        textureState->blendKnown = SDL_FALSE;
+        return SDL_FALSE;
+    }
+    textureState->blendMode = blendMode;
+    textureState->blendKnown = SDL_TRUE;
+    return SDL_TRUE;
 }
 
-
 /**
- Destroys a linkedTexture only if nothing references it
+ Forgets the tracked state of a texture. Must be called if the texture is changed or destroyed outside of the engine
 
- @param linkedTexture The linkedTexture to destroy
- @return Whether the linkedTexture was destroyed or not
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture to forget
  */
-SDL_bool AE_DestroyLinkedTexture(AE_LinkedTexture* linkedTexture)
+void AE_RenderState_ForgetTexture(AE_RenderState* state, SDL_Texture* texture)
 {
-    SDL_bool success = SDL_FALSE;
+    int slot = AE_RenderState_Slot(texture, state->capacity);
     
-    //If nothing is referencing the linkedTexture
-    if (linkedTexture->linkedList == NULL && linkedTexture->references == 0)
+    while (state->entries[slot].texture != NULL)
     {
-        //Destroy the texture completely
-        SDL_DestroyTexture(linkedTexture->texture);
-        SDL_free(linkedTexture);
-        success = SDL_TRUE;
+        if (state->entries[slot].texture == texture)
+        {
+            //Empty the slot, then shift back any later entries that would no longer be reachable
+            int hole = slot;
+            state->entries[hole].texture = NULL;
+            state->count--;
+            
+            slot = (slot + 1) & (state->capacity - 1);
+            while (state->entries[slot].texture != NULL)
+            {
+                int home = AE_RenderState_Slot(state->entries[slot].texture, state->capacity);
+                //Move the entry into the hole if its home slot is not between the hole and where it sits now
+                if (((slot - home) & (state->capacity - 1)) >= ((slot - hole) & (state->capacity - 1)))
+                {
+                    state->entries[hole] = state->entries[slot];
+                    state->entries[slot].texture = NULL;
+                    hole = slot;
+                }
+                slot = (slot + 1) & (state->capacity - 1);
+            }
+            return;
+        }
+        slot = (slot + 1) & (state->capacity - 1);
     }
-    return success;
 }
 
 /**
- Destroys a linkedTexture and the list of objects referencing it, regardless of whether objects are referencing it or not
+ Forgets the tracked state of a texture in every renderer's state cache
 
- @param linkedTexture The linkedTexture to destroy
+ @param texture The texture to forget
  */
-void AE_DestroyLinkedTexture_Unsafe(AE_LinkedTexture* linkedTexture)
+static void AE_RenderState_ForgetTextureEverywhere(SDL_Texture* texture)
 {
-    AE_SheetLink* tempSheetLink;
-    AE_SheetLink* freeSheetLink = NULL;
-    if (linkedTexture->references > 0)
+    for (int i = 0; i<AE_renderStateCount; i++)
     {
-        tempSheetLink = linkedTexture->linkedList;
-        while (tempSheetLink != NULL)
-        {
-            freeSheetLink = tempSheetLink;
-            tempSheetLink = tempSheetLink->next;
-            SDL_free(freeSheetLink);
-        }
+        AE_RenderState_ForgetTexture(AE_renderStates[i], texture);
     }
-    SDL_DestroyTexture(linkedTexture->texture);
-    SDL_free(linkedTexture);
 }
 
+/**
+ Forgets the tracked state of every texture
 
-//
-//
-//End: Linked Textures and Associated Functions
-//
-//
-
-//
-//
-//Start: Sprites and Sprite Functions
-//
-//
+ @param state The AE_RenderState to clear
+ */
+void AE_RenderState_Invalidate(AE_RenderState* state)
+{
+    SDL_memset(state->entries, 0, sizeof(AE_TextureState) * state->capacity);
+    state->count = 0;
+}
 
 /**
- Creates a new AE_Sprite from a preexisting LinkedTexture
- 
- @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
- @param reference_x The x of the sprite on the spritesheet
- @param reference_y The y of the sprite on the spritesheet
- @param frameCount The number of frames in the sprite
- @param width The width of a single sprite frame
- @param height The height of a single sprite frame
- @param pivot_x The x of the sprite pivot point
- @param pivot_y The y of the sprite pivot point
- @return The initialized AE_Sprite, with all other parameters set to default
+ Gets the call counters of a state cache
+
+ @param state The AE_RenderState whose counters will be retrieved
+ @return The counters of issued and elided calls
  */
-AE_Sprite* AE_CreateSprite(AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y)
+AE_RenderStateStats AE_RenderState_GetStats(AE_RenderState* state)
 {
-    AE_Sprite* output = SDL_malloc(sizeof(AE_Sprite));
-    
-    //Offloads work to another function for modularity
-    AE_FillSprite(output, spriteSheet, reference_x, reference_y, frameCount, width, height, pivot_x, pivot_y);
-    
-    return output;
+    return state->stats;
 }
 
 /**
- Guts out and fills a sprite with the given data
- 
- @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
- @param reference_x The x of the sprite on the spritesheet
- @param reference_y The y of the sprite on the spritesheet
- @param frameCount The number of frames in the sprite
- @param width The width of a single sprite frame
- @param height The height of a single sprite frame
- @param pivot_x The x of the sprite pivot point
- @param pivot_y The y of the sprite pivot point
+ Resets the call counters of a state cache to 0
+
+ @param state The AE_RenderState whose counters will be reset
  */
-void AE_FillSprite(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y)
+void AE_RenderState_ResetStats(AE_RenderState* state)
 {
-    sprite->spriteSheet = NULL;
-    sprite->frames = NULL;
-    sprite->width = width;
-    sprite->height = height;
-    
-    AE_SpriteSetSpriteSheet(sprite, spriteSheet, frameCount, reference_x, reference_y, width, height, AE_SPRITE_KEEP_NONE);
-    
-    AE_SpriteSetPivot(sprite, pivot_x, pivot_y, AE_SPRITE_KEEP_NONE);
-    
-    AE_SpriteSetAngle(sprite, 0.0);
-    AE_SpriteSetFlip(sprite, SDL_FLIP_NONE);
-    
-    sprite->drawRect.x = 0;
-    sprite->drawRect.y = 0;
-    AE_SpriteSetScale(sprite, 1, 1, AE_SPRITE_DEFAULT);
-    
-    //Default frame speed is 30
-    AE_SpriteSetFrameSpeed(sprite, 30);
-    
-    AE_SpriteSetColor(sprite, NULL, AE_SPRITE_DEFAULT);
-    AE_SpriteSetAlpha(sprite, 255);
+    SDL_zero(state->stats);
 }
 
 /**
- Resets the frame sprite sheet
+ Frees and destroys an AE_RenderState, returning its renderer to uncached drawing
 
- @param sprite The AE_Sprite whose spritesheet will be reset
- @param spriteSheet The spritesheet that the AE_Sprite will now reference
- @param frameCount The number of frames in the sprite
- @param reference_x The x of the desired sprite on the spritesheet
- @param reference_y The y of the desired sprite on the spritesheet
- @param frame_width The width of the new frames
- @param frame_height The height of the new frames
- @param dataToKeep Whether to keep the previous width or height, or neither
+ @param state The AE_RenderState to be destroyed
  */
-void AE_SpriteSetSpriteSheet(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep)
+void AE_DestroyRenderState(AE_RenderState* state)
 {
-    if (sprite->spriteSheet != NULL)
+    if (state != NULL)
     {
-        AE_LinkedTexture_Leave(sprite->spriteSheet, sprite);
+        //Unregister the cache
+        for (int i = 0; i<AE_renderStateCount; i++)
+        {
+            if (AE_renderStates[i] == state)
+            {
+                AE_renderStates[i] = AE_renderStates[--AE_renderStateCount];
+                break;
+            }
+        }
+        if (AE_renderStateCount == 0)
+        {
+            SDL_free(AE_renderStates);
+            AE_renderStates = NULL;
+        }
+        
+        SDL_free(state->entries);
+        SDL_free(state);
     }
-    sprite->spriteSheet = spriteSheet;
-    AE_LinkedTexture_Join(spriteSheet, sprite);
-    
-    //Offload the work to the SetFrames function for modularity
-    AE_SpriteSetFrames(sprite, frameCount, reference_x, reference_y, frame_width, frame_height, dataToKeep);
 }
 
-
 /**
- Sets the number of frames in a sprite, and creates an array of frames for the sprite
+ Sets the color and alpha modulation of a texture about to be drawn, going through the renderer's state cache if it has one
 
- @param sprite The sprite whose frame count will be expanded
- @param frameCount The number of sprite frames
- @param reference_x The x of the sprite on its spritesheet
- @param reference_y The y of the sprite on its spritesheet
- @param frame_width The width of the new frames
- @param frame_height The height of the new frames
- @param dataToKeep Whether you want to keep the width, height, or neither
+ @param renderer The renderer the texture will be drawn on
+ @param texture The texture whose modulation will be set
+ @param color The color modulation
+ @param alpha The alpha modulation
  */
-void AE_SpriteSetFrames(AE_Sprite* sprite, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep)
+static void AE_SetTextureModulation(SDL_Renderer* renderer, SDL_Texture* texture, AE_ColorBundle color, Uint8 alpha)
 {
-    //Set the sprite framecount
-    sprite->frameCount = frameCount;
-    
-    //Initialize temp_width and temp_height variables
-    int temp_width = 0;
-    int temp_height = 0;
-    
-    //If you're not saving the width, set it to the new frame_width
-    if (dataToKeep != AE_SPRITE_KEEP_WIDTH)
-    {
-        temp_width = sprite->width = frame_width;
-    }
-    else
-    {
-        temp_width = sprite->width;
-    }
+    AE_RenderState* state = AE_RenderState_Get(renderer);
     
-    //If you're not saving the height, set it to the new frame_height
-    if (dataToKeep != AE_SPRITE_KEEP_HEIGHT)
+    if (state != NULL)
     {
-        temp_height = sprite->height = frame_height;
+        AE_RenderState_SetTextureColorMod(state, texture, color.r, color.g, color.b);
+        AE_RenderState_SetTextureAlphaMod(state, texture, alpha);
     }
     else
     {
-        temp_height = sprite->height;
-    }
-    
-    //If there is one frame and it's the same size as the spritesheet and there is a spritesheet
-    if (frameCount == 1 && reference_x == 0 && reference_y == 0 && sprite->spriteSheet != NULL && temp_width == AE_LinkedTexture_GetWidth(sprite->spriteSheet) && temp_height == AE_LinkedTexture_GetHeight(sprite->spriteSheet))
-    {
-        //Free any leftover frame data and make the sprite point at NULL frames
-        if (sprite->frames != NULL)
-        {
-            SDL_free(sprite->frames);
-        }
-        sprite->frames = NULL;
+        SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+        SDL_SetTextureAlphaMod(texture, alpha);
     }
-    else
-    //If there's any frames and it's not the same size as the spritesheet
+}
+
+/**
+ Sets the blend mode of a texture about to be drawn, going through the renderer's state cache if it has one
+
+ @param renderer The renderer the texture will be drawn on
+ @param texture The texture whose blend mode will be set
+ @param blendMode The blend mode (SDL_BLENDMODE_INVALID to leave the texture's blend mode as it is)
+ */
+static void AE_SetTextureBlend(SDL_Renderer* renderer, SDL_Texture* texture, SDL_BlendMode blendMode)
+{
+    if (blendMode != SDL_BLENDMODE_INVALID)
     {
-        //If there's a prexisting framesheet and it's not the same framecount as the new framecount, destroy the old framesheet
-        if (sprite->frames != NULL && sprite->frameCount != frameCount)
-        {
-            //Free any leftover frame data and make the sprite point at NULL frames
-            SDL_Rect* temp_frames = sprite->frames;
-            sprite->frames = NULL;
-            SDL_free(&temp_frames);
-        }
-        if (sprite->frames == NULL)
+        AE_RenderState* state = AE_RenderState_Get(renderer);
+        
+        if (state != NULL)
         {
-            sprite->frames = SDL_malloc(sizeof(SDL_Rect)*frameCount);
+            AE_RenderState_SetTextureBlendMode(state, texture, blendMode);
         }
-        //For each frame in the array, set the frame attributes up
-        for (int i = 0; i<frameCount; i++)
+        else
         {
-            //If the currently set frame is not frame 0, make the frame the endpoint + 1
-            sprite->frames[i].x = (i == 0) ? reference_x : reference_x + (temp_width * i);
-            
-            //The frames run along the width of the sprite sheet, so the y remains static
-            sprite->frames[i].y = reference_y;
-            
-            //Set the frame width and height to be the sprite width and height
-            sprite->frames[i].w = temp_width;
-            sprite->frames[i].h = temp_height;
+            SDL_SetTextureBlendMode(texture, blendMode);
         }
     }
 }
 
+//
+//
+//End: Renderer State Cache Functions
+//
+//
+
+//
+//
+//Start: Linked Textures and Associated Functions
+//
+//
+
+//The id given to the last linkedTexture, used to tell sprite sheets apart when sorting draws
+static SDL_atomic_t AE_lastLinkedTextureId;
+
+//The linkedTextures waiting for the render thread to destroy them, linked through nextDestroyed
+static void* AE_linkedTextureDestroyQueue = NULL;
+
 /**
- Sets the current pivot
+ Queries a linkedTexture's texture once and keeps its size and format, so the getters never have to ask SDL
 
- @param sprite The sprite whose pivot will be set
- @param pivot_x The x of the new pivot
- @param pivot_y The y of the new pivot
- @param dataToKeep Which pivot point attributes will be overwritten: x, y, both, or sets the pivot to the default position (centerpoint)
+ @param linkedTexture The linkedTexture whose metadata will be cached
  */
-void AE_SpriteSetPivot(AE_Sprite* sprite, int pivot_x, int pivot_y, int dataToKeep)
+static void AE_LinkedTexture_CacheMetadata(AE_LinkedTexture* linkedTexture)
 {
-    //If you're keeping the original pivot x, set the pivot y to the given y
-    if (dataToKeep != AE_SPRITE_KEEP_X && dataToKeep != AE_SPRITE_DEFAULT)
-    {
-        sprite->pivot.x = pivot_x;
-    }
-    //If you're keeping the original pivot y, set the pivot x to the given x
-    if (dataToKeep == AE_SPRITE_KEEP_Y && dataToKeep != AE_SPRITE_DEFAULT)
+    linkedTexture->width = 0;
+    linkedTexture->height = 0;
+    linkedTexture->format = 0;
+    if (linkedTexture->texture != NULL)
     {
-        sprite->pivot.y = pivot_y;
+        SDL_QueryTexture(linkedTexture->texture, &linkedTexture->format, NULL, &linkedTexture->width, &linkedTexture->height);
     }
-    //If you're setting the pivot point to the centerpoint, do that
-    if (dataToKeep == AE_SPRITE_DEFAULT)
+}
+
+/**
+ Creates a new linkedTexture from an SDL_Texture with an empty list of referencing objects
+
+ @param texture The SDL_Texture to create the linkedTexture from
+ @return The linkedTexture with the SDL_Texture as its texture and an empty list of referencing objects
+ */
+AE_LinkedTexture* AE_CreateLinkedTexture(SDL_Texture* texture)
+{
+    AE_LinkedTexture* output = AE_AllocateObject(AE_OBJECT_LINKEDTEXTURE, sizeof(AE_LinkedTexture));
+    if (output == NULL)
     {
-        sprite->pivot.x = sprite->width/2;
-        sprite->pivot.y = sprite->height/2;
+        return NULL;
     }
+    output->texture = texture;
+    output->stakeholders = NULL;
+    output->stakeholderTable = NULL;
+    output->stakeholderCapacity = 0;
+    output->stakeholderLock = 0;
+    SDL_AtomicSet(&output->references, 0);
+    output->destroyWhenUnused = SDL_FALSE;
+    output->nextDestroyed = NULL;
+    output->id = (Uint32)SDL_AtomicAdd(&AE_lastLinkedTextureId, 1) + 1;
+    output->loadState = (texture != NULL) ? AE_TEXTURE_READY : AE_TEXTURE_FAILED;
+    output->version = 0;
+    AE_LinkedTexture_CacheMetadata(output);
+    return output;
 }
 
 /**
- Sets the sprite angle
-
- @param sprite The sprite whose angle will be set
- @param angle The angle of the sprite
+ Creates a new linkedTexture from an SDL_Texture from a given pathname with an empty list of referencing objects
+ 
+ @param renderer The renderer which will generate the new Texture
+ @param path The pathname of the file to be loaded
+ @return The linkedTexture with the SDL_Texture as its texture and an empty list of referencing objects
  */
-void AE_SpriteSetAngle(AE_Sprite* sprite, double angle)
+AE_LinkedTexture* AE_LinkedTexture_CreateFromFile(SDL_Renderer* renderer, const char* path)
 {
-    sprite->angle = angle;
+    //Offload the work to the create function for modularity
+    return AE_CreateLinkedTexture(AE_LoadTextureFromFile(renderer, path));
 }
 
 /**
- Sets the rendererflip of the sprite
+ Hashes a stakeholder pointer into a slot of a linkedTexture's stakeholder table
 
- @param sprite The sprite whose rendererflip will be set
- @param flip The desired rendererflip type
+ @param stakeholder_object The stakeholder to be hashed
+ @param capacity The capacity of the table (a power of 2)
+ @return The first slot the stakeholder may be stored in
  */
-void AE_SpriteSetFlip(AE_Sprite* sprite, SDL_RendererFlip flip)
+static int AE_LinkedTexture_Slot(void* stakeholder_object, Uint32 capacity)
 {
-    sprite->flip = flip;
+    Uint64 hash = (Uint64)(uintptr_t)stakeholder_object;
+    hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (int)(hash & (Uint64)(capacity - 1));
 }
 
 /**
- Sets the sprite scale
+ Points a free slot of a linkedTexture's stakeholder table at a stakeholder
 
- @param sprite The sprite whose scale will be set
- @param x_scale The new scale on the x axis
- @param y_scale The new scale on the y axis
- @param dataToKeep Which scale attributes will be overwritten: x scale, y scale, both, or sets the both scales to the default size (1)
+ @param linkedTexture The linkedTexture whose table will be added to
+ @param index The index of the stakeholder in the stakeholder array
  */
-void AE_SpriteSetScale(AE_Sprite* sprite, float x_scale, float y_scale, int dataToKeep)
+static void AE_LinkedTexture_Index(AE_LinkedTexture* linkedTexture, int index)
 {
-    //Set a drawRect pointer to the sprite's drawRect for less dereferencing
-    SDL_Rect* drawRect = &sprite->drawRect;
-    //If you're setting the scales to default, set both scales to 1
-    if (dataToKeep == AE_SPRITE_DEFAULT)
-    {
-        sprite->x_scale = sprite->y_scale = 1;
-        
-        //Set the drawRect width and height to 1
-        drawRect->w = sprite->width;
-        drawRect->h = sprite->height;
-    }
-    else
+    Uint32 tableCapacity = linkedTexture->stakeholderCapacity * 2;
+    int slot = AE_LinkedTexture_Slot(linkedTexture->stakeholders[index], tableCapacity);
+    
+    while (linkedTexture->stakeholderTable[slot] >= 0)
     {
-        //If you're not keeping it, set the x_scale
-        if (dataToKeep != AE_SPRITE_KEEP_X)
-        {
-            sprite->x_scale = x_scale;
-            
-            //If the sprite has a preexisting drawRect to render to, adjust it
-            if (drawRect != NULL)
-            {
-                drawRect->w =(int)(((float)sprite->width) * sprite->x_scale);
-            }
-        }
-        //If you're not keeping it, set the y_scale
-        if (dataToKeep != AE_SPRITE_KEEP_Y)
-        {
-            sprite->y_scale = y_scale;
-            
-            //If the sprite has a preexisting drawRect to render to, adjust it
-            if (drawRect != NULL)
-            {
-                drawRect->h =(int)(((float)sprite->height) * sprite->y_scale);
-            }
-        }
+        slot = (slot + 1) & (tableCapacity - 1);
     }
+    linkedTexture->stakeholderTable[slot] = index;
 }
 
 /**
- Gets the current loop frame of the sprite
+ Doubles the number of stakeholders a linkedTexture has room for
 
- @param sprite The sprite whose frame will be retrieved
- @return The current loop frame
+ @param linkedTexture The linkedTexture to be grown
+ @return Whether the linkedTexture was grown or not
  */
-int AE_SpriteGetSavedFrame(AE_Sprite* sprite)
+static SDL_bool AE_LinkedTexture_Grow(AE_LinkedTexture* linkedTexture)
 {
-    return sprite->currentFrame;
+    Uint32 capacity = (linkedTexture->stakeholderCapacity > 0) ? linkedTexture->stakeholderCapacity * 2 : 4;
+    void** stakeholders = SDL_realloc(linkedTexture->stakeholders, sizeof(void*) * capacity);
+    if (stakeholders == NULL)
+    {
+        return SDL_FALSE;
+    }
+    linkedTexture->stakeholders = stakeholders;
+    
+    //The table is kept at twice the capacity, so it is never more than half full
+    int* table = SDL_malloc(sizeof(int) * capacity * 2);
+    if (table == NULL)
+    {
+        return SDL_FALSE;
+    }
+    SDL_memset(table, 0xFF, sizeof(int) * capacity * 2);
+    SDL_free(linkedTexture->stakeholderTable);
+    linkedTexture->stakeholderTable = table;
+    linkedTexture->stakeholderCapacity = capacity;
+    
+    int references = SDL_AtomicGet(&linkedTexture->references);
+    for (int i = 0; i<references; i++)
+    {
+        AE_LinkedTexture_Index(linkedTexture, i);
+    }
+    return SDL_TRUE;
 }
 
-//
-//Sets the current loop frame of the sprite
-//return: void
-//
-
 /**
- Sets the current loop frame of the sprite
+ Pushes a linkedTexture onto the queue of linkedTextures for the render thread to destroy. Any number of threads can push at once without locking
 
- @param sprite The sprite whose current loop frame will be set
- @param desiredFrame The frame the loop will be set to
+ @param linkedTexture The linkedTexture to be destroyed (its stakeholder lock must be held, so the render thread can't free it before the caller lets go)
  */
-void AE_SpriteSetSavedFrame(AE_Sprite* sprite, int desiredFrame)
+static void AE_LinkedTexture_QueueDestroy(AE_LinkedTexture* linkedTexture)
 {
-    //If the desired frame is bigger than the amount of frames in the sprite, set the current frame to the final frame
-    if (desiredFrame >= sprite->frameCount)
-    {
-        sprite->currentFrame = sprite->frameCount - 1;
-    }
-    //If the desired frame is less than 0, set the sprite frame to 0
-    else if (desiredFrame < 0)
-    {
-        sprite->currentFrame = 0;
-    }
-    else
-    //If the frame is within the frame count, set the frame to the desired frame
+    void* head;
+    
+    do
     {
-        sprite->currentFrame = desiredFrame;
+        head = SDL_AtomicGetPtr(&AE_linkedTextureDestroyQueue);
+        linkedTexture->nextDestroyed = head;
     }
+    while (!SDL_AtomicCASPtr(&AE_linkedTextureDestroyQueue, head, linkedTexture));
 }
 
-//
-//Sets the frame speed of the sprite
-//return: void
-//
-
 /**
- Sets the frame speed of the sprite
+ Frees a linkedTexture and its texture without checking whether anything references it
 
- @param sprite The sprite whose frame speed will be set
- @param frameSpeed The speed the sprite will be set to
+ @param linkedTexture The linkedTexture to be freed
  */
-void AE_SpriteSetFrameSpeed(AE_Sprite* sprite, float frameSpeed)
+static void AE_LinkedTexture_Free(AE_LinkedTexture* linkedTexture)
 {
-    sprite->frameSpeed = frameSpeed;
+    AE_RenderState_ForgetTextureEverywhere(linkedTexture->texture);
+    SDL_DestroyTexture(linkedTexture->texture);
+    SDL_free(linkedTexture->stakeholders);
+    SDL_free(linkedTexture->stakeholderTable);
+    AE_ReleaseObject(AE_OBJECT_LINKEDTEXTURE, linkedTexture);
 }
 
 /**
- Sets the color of the sprite
+ Adds an object to the list of objects referencing a linkedTexture. An object may join more than once, and must leave once for each join. Fails once AE_DestroyLinkedTexture_Deferred has been called on the linkedTexture. Safe to call from any thread
 
- @param sprite The AE_Sprite whose color will be set
- @param color The color the AE_Sprite will be set to
- @param dataToKeep Which preexisting color values to keep (red, green, blue) or set the color values to default color white
+ @param linkedTexture The linkedTexture that the object would like to reference
+ @param stakeholder_object The object that will reference the linkedTexture
+ @return Whether the object joined the list of objects referencing the linkedTexture or not
  */
-void AE_SpriteSetColor(AE_Sprite* sprite, AE_ColorBundle* color, int dataToKeep)
+SDL_bool AE_LinkedTexture_Join(AE_LinkedTexture* linkedTexture, void* stakeholder_object)
 {
-	if (dataToKeep == AE_SPRITE_DEFAULT)
-    {
-        sprite->color.r = 255;
-        sprite->color.g = 255;
-        sprite->color.b = 255;
-    }
-    if (dataToKeep != AE_SPRITE_KEEP_R && dataToKeep != AE_SPRITE_DEFAULT && color != NULL)
+    SDL_bool success = SDL_FALSE;
+    
+    SDL_AtomicLock(&linkedTexture->stakeholderLock);
+    int references = SDL_AtomicGet(&linkedTexture->references);
+    //A linkedTexture waiting to be destroyed (or already queued) can't be brought back into use
+    if (linkedTexture->destroyWhenUnused)
     {
-        sprite->color.r = color->r;
+        success = SDL_FALSE;
     }
-    if (dataToKeep != AE_SPRITE_KEEP_G && dataToKeep != AE_SPRITE_DEFAULT && color != NULL)
+    else if ((Uint32)references < linkedTexture->stakeholderCapacity || AE_LinkedTexture_Grow(linkedTexture))
     {
-        sprite->color.g = color->g;
+        linkedTexture->stakeholders[references] = stakeholder_object;
+        AE_LinkedTexture_Index(linkedTexture, references);
+        SDL_AtomicIncRef(&linkedTexture->references);
+        success = SDL_TRUE;
     }
-    if (dataToKeep != AE_SPRITE_KEEP_B && dataToKeep != AE_SPRITE_DEFAULT && color != NULL)
+    SDL_AtomicUnlock(&linkedTexture->stakeholderLock);
+    
+    return success;
+}
+
+/**
+ Removes an object from the list of objects that reference a linkedTexture, queueing the linkedTexture for destruction if it was the last reference and AE_DestroyLinkedTexture_Deferred was called on it. Safe to call from any thread
+
+ @param linkedTexture The linked texture that the object is removing itself from
+ @param stakeholder_object The object that will no longer reference the linkedTexture
+ @return Whether the object was removed from the referencing list or not
+ */
+SDL_bool AE_LinkedTexture_Leave(AE_LinkedTexture* linkedTexture, void* stakeholder_object)
+{
+    SDL_bool success = SDL_FALSE;
+    
+    SDL_AtomicLock(&linkedTexture->stakeholderLock);
+    
+    Uint32 tableCapacity = linkedTexture->stakeholderCapacity * 2;
+    int* table = linkedTexture->stakeholderTable;
+    int slot = (SDL_AtomicGet(&linkedTexture->references) > 0) ? AE_LinkedTexture_Slot(stakeholder_object, tableCapacity) : -1;
+    
+    while (slot >= 0 && table[slot] >= 0)
     {
-        sprite->color.b = color->b;
+        if (linkedTexture->stakeholders[table[slot]] == stakeholder_object)
+        {
+            int index = table[slot];
+            int last = SDL_AtomicAdd(&linkedTexture->references, -1) - 1;
+            
+            //Empty the slot, then shift back any later entries that would no longer be reachable
+            int hole = slot;
+            table[hole] = -1;
+            slot = (slot + 1) & (tableCapacity - 1);
+            while (table[slot] >= 0)
+            {
+                int home = AE_LinkedTexture_Slot(linkedTexture->stakeholders[table[slot]], tableCapacity);
+                //Move the entry into the hole if its home slot is not between the hole and where it sits now
+                if ((Uint32)((slot - home) & (tableCapacity - 1)) >= (Uint32)((slot - hole) & (tableCapacity - 1)))
+                {
+                    table[hole] = table[slot];
+                    table[slot] = -1;
+                    hole = slot;
+                }
+                slot = (slot + 1) & (tableCapacity - 1);
+            }
+            
+            //Fill the gap in the stakeholder array with the last stakeholder, and point its slot at its new index
+            if (index != last)
+            {
+                linkedTexture->stakeholders[index] = linkedTexture->stakeholders[last];
+                slot = AE_LinkedTexture_Slot(linkedTexture->stakeholders[index], tableCapacity);
+                while (table[slot] != last)
+                {
+                    slot = (slot + 1) & (tableCapacity - 1);
+                }
+                table[slot] = index;
+            }
+            
+            //The last stakeholder of a linkedTexture waiting to be destroyed hands it to the render thread
+            //Nothing can join it again, so this only happens once
+            if (last == 0 && linkedTexture->destroyWhenUnused)
+            {
+                AE_LinkedTexture_QueueDestroy(linkedTexture);
+            }
+            success = SDL_TRUE;
+            break;
+        }
+        slot = (slot + 1) & (tableCapacity - 1);
     }
+    
+    SDL_AtomicUnlock(&linkedTexture->stakeholderLock);
+    
+    return success;
 }
 
 /**
- Gets the color modulation of a sprite
+ Gets the number of objects referencing a linkedTexture
 
- @param sprite The AE_Sprite whose color will be retrieved
- @return A pointer to an AE_ColorBundle containing the colors of the AE_Sprite
+ @param linkedTexture The linkedTexture whose reference count will be retrieved
+ @return The number of ojects referencing the linked texture
  */
-AE_ColorBundle* AE_SpriteGetColor(AE_Sprite* sprite)
+Uint32 AE_LinkedTexture_GetReferenceCount(AE_LinkedTexture* linkedTexture)
 {
-    //Create a new AE_ColorBundle and fill with the given sprite's colors
-    AE_ColorBundle* output = SDL_malloc(sizeof(AE_ColorBundle));
-    output->r = sprite->color.r;
-    output->g = sprite->color.g;
-    output->b = sprite->color.b;
-    return output;
+    return (Uint32)SDL_AtomicGet(&linkedTexture->references);
 }
 
 /**
- Sets the color of the sprite
- 
- @param sprite The AE_Sprite whose alpha will be set
- @param alpha The alpha the AE_Sprite will be set to
+ Gets the width of the texture in a linkedTexture, cached when the texture was created or finished loading
+
+ @param linkedTexture The texture whose width will be retrieved
+ @return The width of the texture
  */
-void AE_SpriteSetAlpha(AE_Sprite* sprite, Uint8 alpha)
+int AE_LinkedTexture_GetWidth(AE_LinkedTexture* linkedTexture)
 {
-    sprite->alpha = alpha;
+    return linkedTexture->width;
 }
 
 /**
- Gets the alpha modulation of a sprite
+ Gets the height of the texture in a linkedTexture, cached when the texture was created or finished loading
  
- @param sprite The AE_Sprite whose alpha will be retrieved
- @return The alpha modulation of the sprite
+ @param linkedTexture The texture whose height will be retrieved
+ @return The height of the texture
  */
-Uint8 AE_SpriteGetAlpha(AE_Sprite* sprite)
+int AE_LinkedTexture_GetHeight(AE_LinkedTexture* linkedTexture)
 {
-    return sprite->alpha;
+    return linkedTexture->height;
 }
 
 /**
- Renders the sprite on the given renderer
-
- @param sprite The sprite to be rendered
- @param renderer The renderer the sprite will be rendered on
- @param x The x coordinate the sprite will be drawn at
- @param y The y coordinate the sprite will be drawn at
- @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
- @param step The timestep the sprite will be drawn at
- @return Whether the sprite was successfully rendered or not
+ Gets the format of the texture in a linkedTexture, cached when the texture was created or finished loading
+ 
+ @param linkedTexture The texture whose format will be retrieved
+ @return The format of the texture
  */
-SDL_bool AE_SpriteRender(AE_Sprite* sprite, SDL_Renderer* renderer, int x, int y, int currentFrame, float step)
+Uint32 AE_LinkedTexture_GetFormat(AE_LinkedTexture* linkedTexture)
 {
-    int drawFrame = currentFrame;
-    SDL_bool success = SDL_FALSE;
-    if (sprite->spriteSheet != NULL)
-    {
-        //If currentFrame is less than 0, loop through the spritesheet (sets the sprite's currentFrame along with it)
-        if (currentFrame < 0)
-        {
-            if (sprite->currentFrame >= (float)(sprite->frameCount))
-            {
-                sprite->currentFrame = fmodf(sprite->currentFrame,(float)(sprite->frameCount - 1));
-            }
-            drawFrame = fmodf(sprite->currentFrame,(float)(sprite->frameCount - 1));
-        }
-        //If the currentFrame is larger than the number of frames the sprite has, go to the last frame of the animation, and reset the sprite's currentFrame for the next time it loops
-        else if (currentFrame >= sprite->frameCount)
-        {
-            currentFrame = sprite->frameCount-1;
-            sprite->currentFrame = 0;
-        }
-        //Reset the sprite's currentFrame for the next time it loops
-        else
-        {
-            sprite->currentFrame = 0;
-        }
-        sprite->drawRect.x = x;
-        sprite->drawRect.y = y;
-        
-        SDL_SetTextureColorMod(sprite->spriteSheet->texture, sprite->color.r, sprite->color.g, sprite->color.b);
-        SDL_SetTextureAlphaMod(sprite->spriteSheet->texture, sprite->alpha);
-        
-        if ( SDL_RenderCopyEx(renderer, sprite->spriteSheet->texture, &sprite->frames[currentFrame], &sprite->drawRect, sprite->angle, &sprite->pivot, sprite->flip) )
-        {
-            success = SDL_TRUE;
-        }
-        sprite->currentFrame += ((sprite->frameSpeed/2)*step);
-    }
-    return success;
+    return linkedTexture->format;
 }
 
+
 /**
- Frees and destroys an AE_Sprite
+ Gets whether the texture of a linkedTexture is ready to draw, still loading in the background, or failed to load
 
- @param sprite The sprite to be destroyed
+ @param linkedTexture The linkedTexture whose load state will be retrieved
+ @return The load state of the linkedTexture
  */
-void AE_DestroySprite(AE_Sprite* sprite)
+AE_TextureLoadState AE_LinkedTexture_GetLoadState(AE_LinkedTexture* linkedTexture)
 {
-    AE_LinkedTexture_Leave(sprite->spriteSheet, sprite);
-    SDL_free(sprite->frames);
-    SDL_free(sprite);
-    sprite = NULL;
+    return linkedTexture->loadState;
 }
 
-//
-//
-//End: Sprites and Sprite Functions
-//
-//
-
-
-//
-//
-//Start: Timer functions
-//
-//
-
 /**
- Creates a new AE_Timer
+ Marks the pixels of a linkedTexture as changed, so anything cached from it (an AE_CachedLayer, the chunks of an AE_Tilemap, or the draws an AE_DirtyRegion compares between frames) is drawn again. Call after updating the texture yourself, such as with SDL_UpdateTexture
 
- @return A pointer to the new AE_Timer
+ @param linkedTexture The linkedTexture whose pixels changed
  */
-AE_Timer* AE_Create_Timer()
+void AE_LinkedTexture_MarkChanged(AE_LinkedTexture* linkedTexture)
 {
-    AE_Timer* output = SDL_malloc(sizeof(AE_Timer));
-    output->isStarted = SDL_FALSE;
-    output->isPaused = SDL_FALSE;
-    output->startTime = 0;
-    output->pauseTime = 0;
-    return output;
+    linkedTexture->version++;
 }
 
 /**
- Starts (and unpauses) an AE_Timer
+ Gets the version of a linkedTexture, which goes up every time its texture or pixels change
 
- @param timer The timer to start
+ @param linkedTexture The linkedTexture whose version will be retrieved
+ @return The version of the linkedTexture
  */
-void AE_Timer_Start(AE_Timer* timer)
+Uint32 AE_LinkedTexture_GetVersion(AE_LinkedTexture* linkedTexture)
 {
-    timer->isStarted = SDL_TRUE;
-    timer->isPaused = SDL_FALSE;
-    timer->startTime = SDL_GetTicks();
-    timer->pauseTime = 0;
+    return linkedTexture->version;
 }
 
 /**
- Pauses an AE_Timer
+ Destroys a linkedTexture only if nothing references it and it isn't still loading. Must be called on the render thread
 
- @param timer The AE_Timer to pause
+ @param linkedTexture The linkedTexture to destroy
+ @return Whether the linkedTexture was destroyed or not
  */
-void AE_Timer_Pause(AE_Timer* timer)
+SDL_bool AE_DestroyLinkedTexture(AE_LinkedTexture* linkedTexture)
 {
-    if (timer->isStarted && !timer->isPaused)
+    SDL_bool success = SDL_FALSE;
+    
+    //If nothing is referencing the linkedTexture, and no loader is going to fill it in later
+    if (SDL_AtomicGet(&linkedTexture->references) == 0 && linkedTexture->loadState != AE_TEXTURE_LOADING)
     {
-        timer->isPaused = SDL_TRUE;
-        timer->pauseTime = SDL_GetTicks() - timer->startTime;
+        //Destroy the texture completely
+        AE_LinkedTexture_Free(linkedTexture);
+        success = SDL_TRUE;
     }
+    return success;
 }
 
 /**
- Resumes a paused AE_Timer
+ Destroys a linkedTexture and the list of objects referencing it, regardless of whether objects are referencing it or not
 
- @param timer The AE_Timer to resume
+ @param linkedTexture The linkedTexture to destroy
  */
-void AE_Timer_Resume(AE_Timer* timer)
+void AE_DestroyLinkedTexture_Unsafe(AE_LinkedTexture* linkedTexture)
 {
-    //If a timer is started and paused
-    if (timer->isStarted && timer->isPaused)
-    {
-        //Unpause the timer
-        timer->isPaused = SDL_FALSE;
-        //Set the start time to the saved time
-        timer->startTime = SDL_GetTicks() - timer->pauseTime;
-        timer->pauseTime = 0;
-    }
+    AE_LinkedTexture_Free(linkedTexture);
 }
 
 /**
- Stops a paused AE_Timer
- 
- @param timer The AE_Timer to stop
+ Marks a linkedTexture to be destroyed once nothing references it. Safe to call from any thread; the texture itself is only destroyed by AE_LinkedTexture_DestroyQueued on the render thread. Nothing may join the linkedTexture afterwards
+
+ @param linkedTexture The linkedTexture to destroy
  */
-void AE_Timer_Stop(AE_Timer* timer)
+void AE_DestroyLinkedTexture_Deferred(AE_LinkedTexture* linkedTexture)
 {
-    timer->isStarted = SDL_FALSE;
-    timer->isPaused = SDL_FALSE;
-    timer->startTime = 0;
-    timer->pauseTime = 0;
+    SDL_AtomicLock(&linkedTexture->stakeholderLock);
+    //Asking twice must not queue it twice
+    if (!linkedTexture->destroyWhenUnused)
+    {
+        linkedTexture->destroyWhenUnused = SDL_TRUE;
+        
+        //Otherwise the last stakeholder to leave will queue it
+        if (SDL_AtomicGet(&linkedTexture->references) == 0)
+        {
+            AE_LinkedTexture_QueueDestroy(linkedTexture);
+        }
+    }
+    SDL_AtomicUnlock(&linkedTexture->stakeholderLock);
 }
 
 /**
- Gets the amount of time in an AE_Timer
+ Destroys every linkedTexture whose last reference was dropped after AE_DestroyLinkedTexture_Deferred. Must be called on the render thread, for example once per frame
 
- @param timer The AE_Timer to get the time from
- @return The current time on the AE_Timer
+ @return The number of linkedTextures destroyed
  */
-Uint32 AE_Timer_GetTime(AE_Timer* timer)
+int AE_LinkedTexture_DestroyQueued(void)
 {
-    Uint32 output = 0;
+    //Take the whole queue at once, so pushes from other threads carry on into a fresh queue
+    AE_LinkedTexture* linkedTexture = SDL_AtomicSetPtr(&AE_linkedTextureDestroyQueue, NULL);
+    int destroyed = 0;
     
-    //If the timer's started
-    if (timer->isStarted)
+    while (linkedTexture != NULL)
     {
-        //If the timer is paused, return the saved time
-        if (timer->isPaused)
+        AE_LinkedTexture* next = linkedTexture->nextDestroyed;
+        
+        //Wait for the thread that queued it to let go of its lock
+        SDL_AtomicLock(&linkedTexture->stakeholderLock);
+        SDL_AtomicUnlock(&linkedTexture->stakeholderLock);
+        
+        //A texture still loading is kept until the loader is done with it
+        if (linkedTexture->loadState == AE_TEXTURE_LOADING)
         {
-            output = timer->pauseTime;
+            AE_LinkedTexture_QueueDestroy(linkedTexture);
         }
         else
-        //return the regular time
         {
-            output = SDL_GetTicks() - timer->startTime;
+            AE_LinkedTexture_Free(linkedTexture);
+            destroyed++;
         }
+        linkedTexture = next;
     }
-    
-    return output;
+    return destroyed;
 }
 
-/**
- Returns whether an AE_Timer is paused or not
 
- @param timer The AE_Timer to be determined whether it is paused or not
- @return Whether the AE_Timer is paused or not
- */
+//
+//
+//End: Linked Textures and Associated Functions
+//
+//
+
+//
+//
+//Start: Texture Registry Functions
+//
+//
+
+//The starting value and multiplier of the 64-bit FNV-1a hash used for paths and file contents
+#define AE_FNV_OFFSET 0xcbf29ce484222325ULL
+#define AE_FNV_PRIME 0x100000001b3ULL
+
+/**
+ Hashes a block of bytes with 64-bit FNV-1a
+
+ @param data The bytes to be hashed
+ @param size The number of bytes
+ @return The hash of the bytes
+ */
+static Uint64 AE_TextureRegistry_Hash(const void* data, size_t size)
+{
+    const Uint8* bytes = data;
+    Uint64 hash = AE_FNV_OFFSET;
+    
+    for (size_t i = 0; i<size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= AE_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ Turns a pathname into the one spelling the registry keys files by: forward slashes only, no empty or "." segments, and ".." segments folded into the directory before them
+
+ @param path The pathname to be normalized
+ @return The normalized pathname (freed by the caller), or NULL if it couldn't be allocated
+ */
+static char* AE_TextureRegistry_NormalizePath(const char* path)
+{
+    size_t length = SDL_strlen(path);
+    char* output = SDL_malloc(length + 2);
+    size_t* segmentStarts = SDL_malloc(sizeof(size_t) * (length + 1));
+    int segmentCount = 0;
+    size_t written = 0;
+    size_t rootLength = 0;
+    size_t i = 0;
+    
+    if (output == NULL || segmentStarts == NULL)
+    {
+        SDL_free(output);
+        SDL_free(segmentStarts);
+        return NULL;
+    }
+    
+    //Absolute paths keep their leading slash
+    if (path[0] == '/' || path[0] == '\\')
+    {
+        output[written++] = '/';
+        rootLength = 1;
+    }
+    
+    while (i < length)
+    {
+        size_t start = i;
+        while (i < length && path[i] != '/' && path[i] != '\\')
+        {
+            i++;
+        }
+        size_t segmentLength = i - start;
+        i++;
+        
+        //Doubled slashes and "." don't change where a path leads
+        if (segmentLength == 0 || (segmentLength == 1 && path[start] == '.'))
+        {
+            continue;
+        }
+        
+        if (segmentLength == 2 && path[start] == '.' && path[start + 1] == '.')
+        {
+            size_t previous = (segmentCount > 0) ? segmentStarts[segmentCount - 1] : 0;
+            SDL_bool previousIsParent = (segmentCount > 0 && written - previous == 2 && output[previous] == '.' && output[previous + 1] == '.');
+            
+            //Step back out of the previous directory
+            if (segmentCount > 0 && !previousIsParent)
+            {
+                written = previous;
+                if (written > rootLength)
+                {
+                    written--;
+                }
+                segmentCount--;
+                continue;
+            }
+            //There's nothing above the root to step out to
+            if (rootLength > 0)
+            {
+                continue;
+            }
+        }
+        
+        if (written > rootLength)
+        {
+            output[written++] = '/';
+        }
+        segmentStarts[segmentCount++] = written;
+        SDL_memcpy(&output[written], &path[start], segmentLength);
+        written += segmentLength;
+    }
+    
+    if (written == 0)
+    {
+        output[written++] = '.';
+    }
+    output[written] = '\0';
+    
+    SDL_free(segmentStarts);
+    return output;
+}
+
+/**
+ Hashes a 64-bit hash down to a slot of one of a registry's tables
+
+ @param hash The hash to be placed
+ @param capacity The capacity of the table (a power of 2)
+ @return The first slot the hash may be stored in
+ */
+static int AE_TextureRegistry_Slot(Uint64 hash, int capacity)
+{
+    return (int)((hash ^ (hash >> 32)) & (Uint64)(capacity - 1));
+}
+
+/**
+ Finds the entry of a normalized pathname
+
+ @param registry The AE_TextureRegistry to search
+ @param path The normalized pathname
+ @param pathHash The hash of the normalized pathname
+ @return The index of the entry, or -1 if the registry doesn't have the path
+ */
+static int AE_TextureRegistry_FindPath(AE_TextureRegistry* registry, const char* path, Uint64 pathHash)
+{
+    int slot = AE_TextureRegistry_Slot(pathHash, registry->tableCapacity);
+    
+    while (registry->pathTable[slot] >= 0)
+    {
+        AE_TextureRegistryEntry* entry = &registry->entries[registry->pathTable[slot]];
+        if (entry->pathHash == pathHash && SDL_strcmp(entry->path, path) == 0)
+        {
+            return registry->pathTable[slot];
+        }
+        slot = (slot + 1) & (registry->tableCapacity - 1);
+    }
+    return -1;
+}
+
+/**
+ Finds the first entry loaded from a file with the given contents
+
+ @param registry The AE_TextureRegistry to search
+ @param contentHash The hash of the file's contents
+ @param contentSize The size of the file
+ @return The index of the entry, or -1 if no file with those contents was loaded
+ */
+static int AE_TextureRegistry_FindContent(AE_TextureRegistry* registry, Uint64 contentHash, Sint64 contentSize)
+{
+    int slot = AE_TextureRegistry_Slot(contentHash, registry->tableCapacity);
+    
+    while (registry->contentTable[slot] >= 0)
+    {
+        AE_TextureRegistryEntry* entry = &registry->entries[registry->contentTable[slot]];
+        if (entry->contentHash == contentHash && entry->contentSize == contentSize)
+        {
+            return registry->contentTable[slot];
+        }
+        slot = (slot + 1) & (registry->tableCapacity - 1);
+    }
+    return -1;
+}
+
+/**
+ Adds an entry to a registry's tables, only adding it to the content table if no other entry has the same contents
+
+ @param registry The AE_TextureRegistry whose tables will be added to
+ @param index The index of the entry
+ */
+static void AE_TextureRegistry_Index(AE_TextureRegistry* registry, int index)
+{
+    AE_TextureRegistryEntry* entry = &registry->entries[index];
+    int slot = AE_TextureRegistry_Slot(entry->pathHash, registry->tableCapacity);
+    
+    while (registry->pathTable[slot] >= 0)
+    {
+        slot = (slot + 1) & (registry->tableCapacity - 1);
+    }
+    registry->pathTable[slot] = index;
+    
+    if (registry->hashContents && AE_TextureRegistry_FindContent(registry, entry->contentHash, entry->contentSize) < 0)
+    {
+        slot = AE_TextureRegistry_Slot(entry->contentHash, registry->tableCapacity);
+        while (registry->contentTable[slot] >= 0)
+        {
+            slot = (slot + 1) & (registry->tableCapacity - 1);
+        }
+        registry->contentTable[slot] = index;
+    }
+}
+
+/**
+ Empties a registry's tables and adds every entry back, for after entries have moved
+
+ @param registry The AE_TextureRegistry whose tables will be rebuilt
+ */
+static void AE_TextureRegistry_Reindex(AE_TextureRegistry* registry)
+{
+    SDL_memset(registry->pathTable, 0xFF, sizeof(int) * registry->tableCapacity);
+    if (registry->contentTable != NULL)
+    {
+        SDL_memset(registry->contentTable, 0xFF, sizeof(int) * registry->tableCapacity);
+    }
+    
+    for (int i = 0; i<registry->count; i++)
+    {
+        AE_TextureRegistry_Index(registry, i);
+    }
+}
+
+/**
+ Replaces a registry's tables with tables of a new capacity
+
+ @param registry The AE_TextureRegistry whose tables will be replaced
+ @param tableCapacity The capacity of the new tables (a power of 2)
+ @return Whether the tables were replaced or not
+ */
+static SDL_bool AE_TextureRegistry_Resize(AE_TextureRegistry* registry, int tableCapacity)
+{
+    int* pathTable = SDL_malloc(sizeof(int) * tableCapacity);
+    int* contentTable = (registry->hashContents) ? SDL_malloc(sizeof(int) * tableCapacity) : NULL;
+    
+    if (pathTable == NULL || (registry->hashContents && contentTable == NULL))
+    {
+        SDL_free(pathTable);
+        SDL_free(contentTable);
+        return SDL_FALSE;
+    }
+    
+    SDL_free(registry->pathTable);
+    SDL_free(registry->contentTable);
+    registry->pathTable = pathTable;
+    registry->contentTable = contentTable;
+    registry->tableCapacity = tableCapacity;
+    
+    AE_TextureRegistry_Reindex(registry);
+    return SDL_TRUE;
+}
+
+/**
+ Makes sure a registry has room for one more entry
+
+ @param registry The AE_TextureRegistry that will be added to
+ @return Whether there is room or not
+ */
+static SDL_bool AE_TextureRegistry_Reserve(AE_TextureRegistry* registry)
+{
+    if (registry->count == registry->capacity)
+    {
+        int capacity = registry->capacity * 2;
+        AE_TextureRegistryEntry* entries = SDL_realloc(registry->entries, sizeof(AE_TextureRegistryEntry) * capacity);
+        if (entries == NULL)
+        {
+            return SDL_FALSE;
+        }
+        registry->entries = entries;
+        registry->capacity = capacity;
+    }
+    
+    //Grow the tables once they are half full to keep the probes short
+    if ((registry->count + 1) * 2 > registry->tableCapacity)
+    {
+        return AE_TextureRegistry_Resize(registry, registry->tableCapacity * 2);
+    }
+    return SDL_TRUE;
+}
+
+/**
+ Decodes an image file already read into memory and uploads it, color keyed the same way as AE_LoadTextureFromFile
+
+ @param registry The AE_TextureRegistry whose renderer the texture will be uploaded to
+ @param data The contents of the file
+ @param size The size of the file
+ @return The new linkedTexture, or NULL if the image couldn't be decoded or uploaded
+ */
+static AE_LinkedTexture* AE_TextureRegistry_Decode(AE_TextureRegistry* registry, const void* data, size_t size)
+{
+    SDL_Surface* loaded = IMG_Load_RW(SDL_RWFromConstMem(data, (int)size), 1);
+    SDL_Texture* texture = NULL;
+    
+    if (loaded != NULL)
+    {
+        //Color key the image based on the bottom-left pixel, to match AE_LoadTextureFromFile
+        SDL_SetColorKey(loaded, SDL_TRUE, AE_GetSurfacePixel(loaded, 0, loaded->h-1));
+        texture = SDL_CreateTextureFromSurface(registry->renderer, loaded);
+        SDL_FreeSurface(loaded);
+    }
+    
+    return (texture != NULL) ? AE_CreateLinkedTexture(texture) : NULL;
+}
+
+/**
+ Removes an entry from a registry, destroying its linkedTexture if nothing else references it. The last entry takes its place, so the tables must be reindexed afterwards
+
+ @param registry The AE_TextureRegistry to remove the entry from
+ @param index The index of the entry
+ */
+static void AE_TextureRegistry_RemoveEntry(AE_TextureRegistry* registry, int index)
+{
+    AE_TextureRegistryEntry* entry = &registry->entries[index];
+    
+    AE_LinkedTexture_Leave(entry->linkedTexture, registry);
+    
+    //Only goes through if this was the last reference to the linkedTexture
+    AE_DestroyLinkedTexture(entry->linkedTexture);
+    
+    SDL_free(entry->path);
+    registry->entries[index] = registry->entries[--registry->count];
+}
+
+/**
+ Creates an empty texture registry
+
+ @param renderer The renderer the textures will be uploaded to
+ @param hashContents Whether files should also be matched by their contents, so copies of an image under different paths share one texture
+ @return The new AE_TextureRegistry, or NULL if it could not be created
+ */
+AE_TextureRegistry* AE_CreateTextureRegistry(SDL_Renderer* renderer, SDL_bool hashContents)
+{
+    AE_TextureRegistry* output = SDL_calloc(1, sizeof(AE_TextureRegistry));
+    if (output == NULL)
+    {
+        return NULL;
+    }
+    output->renderer = renderer;
+    output->hashContents = hashContents;
+    output->capacity = 16;
+    output->entries = SDL_malloc(sizeof(AE_TextureRegistryEntry) * output->capacity);
+    
+    if (output->entries == NULL || !AE_TextureRegistry_Resize(output, 32))
+    {
+        SDL_free(output->entries);
+        SDL_free(output);
+        return NULL;
+    }
+    return output;
+}
+
+/**
+ Gets the linkedTexture of a file, loading it only if the registry doesn't have it yet. The registry references the linkedTexture until it is evicted
+
+ @param registry The AE_TextureRegistry to load through
+ @param path The pathname of the file (equivalent pathnames such as "a/./b.png" and "a\\b.png" are treated as the same file)
+ @return The linkedTexture of the file, or NULL if it could not be loaded
+ */
+AE_LinkedTexture* AE_TextureRegistry_Load(AE_TextureRegistry* registry, const char* path)
+{
+    char* normalized = AE_TextureRegistry_NormalizePath(path);
+    AE_LinkedTexture* linkedTexture = NULL;
+    SDL_bool decoded = SDL_FALSE;
+    Uint64 contentHash = 0;
+    Sint64 contentSize = 0;
+    
+    if (normalized == NULL)
+    {
+        return NULL;
+    }
+    
+    Uint64 pathHash = AE_TextureRegistry_Hash(normalized, SDL_strlen(normalized));
+    int index = AE_TextureRegistry_FindPath(registry, normalized, pathHash);
+    if (index >= 0)
+    {
+        registry->stats.hits++;
+        SDL_free(normalized);
+        return registry->entries[index].linkedTexture;
+    }
+    
+    //Make room before loading anything, so a loaded texture always has somewhere to go
+    if (!AE_TextureRegistry_Reserve(registry))
+    {
+        SDL_free(normalized);
+        return NULL;
+    }
+    
+    AE_PROFILE_BEGIN("AE_TextureRegistry_Load");
+    if (registry->hashContents)
+    {
+        size_t size = 0;
+        void* data = SDL_LoadFile(path, &size);
+        
+        if (data != NULL)
+        {
+            contentHash = AE_TextureRegistry_Hash(data, size);
+            contentSize = (Sint64)size;
+            
+            //The same image under another path shares the texture that's already loaded
+            index = AE_TextureRegistry_FindContent(registry, contentHash, contentSize);
+            if (index >= 0)
+            {
+                linkedTexture = registry->entries[index].linkedTexture;
+                registry->stats.contentHits++;
+            }
+            else
+            {
+                linkedTexture = AE_TextureRegistry_Decode(registry, data, size);
+                decoded = SDL_TRUE;
+                registry->stats.misses++;
+            }
+            SDL_free(data);
+        }
+    }
+    else
+    {
+        SDL_Texture* texture = AE_LoadTextureFromFile(registry->renderer, path);
+        if (texture != NULL)
+        {
+            linkedTexture = AE_CreateLinkedTexture(texture);
+        }
+        decoded = SDL_TRUE;
+        registry->stats.misses++;
+    }
+    AE_PROFILE_END();
+    
+    //Failed loads aren't remembered, so the file can be tried again later
+    if (linkedTexture == NULL)
+    {
+        registry->stats.failures++;
+        SDL_free(normalized);
+        return NULL;
+    }
+    
+    //The registry hands out only textures it references, so a failed join leaves no entry behind
+    if (!AE_LinkedTexture_Join(linkedTexture, registry))
+    {
+        if (decoded)
+        {
+            AE_DestroyLinkedTexture(linkedTexture);
+        }
+        registry->stats.failures++;
+        SDL_free(normalized);
+        return NULL;
+    }
+    
+    AE_TextureRegistryEntry* entry = &registry->entries[registry->count];
+    entry->path = normalized;
+    entry->pathHash = pathHash;
+    entry->contentHash = contentHash;
+    entry->contentSize = contentSize;
+    entry->linkedTexture = linkedTexture;
+    AE_TextureRegistry_Index(registry, registry->count++);
+    
+    return linkedTexture;
+}
+
+/**
+ Gets the linkedTexture of a file only if the registry already has it, without loading anything or counting a hit or miss
+
+ @param registry The AE_TextureRegistry to search
+ @param path The pathname of the file
+ @return The linkedTexture of the file, or NULL if the registry doesn't have it
+ */
+AE_LinkedTexture* AE_TextureRegistry_Find(AE_TextureRegistry* registry, const char* path)
+{
+    char* normalized = AE_TextureRegistry_NormalizePath(path);
+    AE_LinkedTexture* output = NULL;
+    
+    if (normalized != NULL)
+    {
+        int index = AE_TextureRegistry_FindPath(registry, normalized, AE_TextureRegistry_Hash(normalized, SDL_strlen(normalized)));
+        if (index >= 0)
+        {
+            output = registry->entries[index].linkedTexture;
+        }
+        SDL_free(normalized);
+    }
+    return output;
+}
+
+/**
+ Removes a file from a registry, destroying its linkedTexture if nothing else references it
+
+ @param registry The AE_TextureRegistry to remove the file from
+ @param path The pathname of the file
+ @return Whether the file was in the registry or not
+ */
+SDL_bool AE_TextureRegistry_Evict(AE_TextureRegistry* registry, const char* path)
+{
+    char* normalized = AE_TextureRegistry_NormalizePath(path);
+    int index = -1;
+    
+    if (normalized != NULL)
+    {
+        index = AE_TextureRegistry_FindPath(registry, normalized, AE_TextureRegistry_Hash(normalized, SDL_strlen(normalized)));
+        SDL_free(normalized);
+    }
+    if (index < 0)
+    {
+        return SDL_FALSE;
+    }
+    
+    AE_TextureRegistry_RemoveEntry(registry, index);
+    AE_TextureRegistry_Reindex(registry);
+    return SDL_TRUE;
+}
+
+/**
+ Removes and destroys every linkedTexture that nothing but the registry references
+
+ @param registry The AE_TextureRegistry to clean out
+ @return The number of files removed from the registry
+ */
+int AE_TextureRegistry_EvictUnused(AE_TextureRegistry* registry)
+{
+    int removed = 0;
+    
+    //Going backwards means the entry moved into a removed entry's place has already been checked
+    for (int i = registry->count - 1; i>=0; i--)
+    {
+        AE_LinkedTexture* linkedTexture = registry->entries[i].linkedTexture;
+        SDL_bool unused = SDL_TRUE;
+        
+        //A linkedTexture is unused if every reference to it belongs to the registry
+        SDL_AtomicLock(&linkedTexture->stakeholderLock);
+        for (int j = 0; j<SDL_AtomicGet(&linkedTexture->references) && unused; j++)
+        {
+            unused = (linkedTexture->stakeholders[j] == registry) ? SDL_TRUE : SDL_FALSE;
+        }
+        SDL_AtomicUnlock(&linkedTexture->stakeholderLock);
+        if (unused)
+        {
+            AE_TextureRegistry_RemoveEntry(registry, i);
+            removed++;
+        }
+    }
+    
+    if (removed > 0)
+    {
+        AE_TextureRegistry_Reindex(registry);
+    }
+    return removed;
+}
+
+/**
+ Gets the number of files in a registry
+
+ @param registry The AE_TextureRegistry whose files will be counted
+ @return The number of files, counting each path sharing a texture separately
+ */
+int AE_TextureRegistry_GetCount(AE_TextureRegistry* registry)
+{
+    return registry->count;
+}
+
+/**
+ Gets the hit and miss counters of a registry
+
+ @param registry The AE_TextureRegistry whose counters will be retrieved
+ @return The counters of cached and uncached loads
+ */
+AE_TextureRegistryStats AE_TextureRegistry_GetStats(AE_TextureRegistry* registry)
+{
+    return registry->stats;
+}
+
+/**
+ Resets the hit and miss counters of a registry to 0
+
+ @param registry The AE_TextureRegistry whose counters will be reset
+ */
+void AE_TextureRegistry_ResetStats(AE_TextureRegistry* registry)
+{
+    SDL_zero(registry->stats);
+}
+
+/**
+ Frees and destroys an AE_TextureRegistry, destroying every linkedTexture nothing else references. Textures still referenced are left to their other stakeholders
+
+ @param registry The AE_TextureRegistry to be destroyed
+ */
+void AE_DestroyTextureRegistry(AE_TextureRegistry* registry)
+{
+    if (registry != NULL)
+    {
+        while (registry->count > 0)
+        {
+            AE_TextureRegistry_RemoveEntry(registry, registry->count - 1);
+        }
+        SDL_free(registry->pathTable);
+        SDL_free(registry->contentTable);
+        SDL_free(registry->entries);
+        SDL_free(registry);
+    }
+}
+
+//
+//
+//End: Texture Registry Functions
+//
+//
+
+//
+//
+//Start: Texture Atlas Functions
+//
+//
+
+//The size of an atlas page when the renderer doesn't report a maximum texture size
+#define AE_ATLAS_DEFAULT_PAGE_SIZE 2048
+//The largest atlas page that will be made, even if the renderer allows bigger textures
+#define AE_ATLAS_MAX_PAGE_SIZE 4096
+
+/**
+ A horizontal segment of the top edge of everything packed into a page so far
+ */
+typedef struct {
+    int x;
+    int y;
+    int width;
+}AE_SkylineNode;
+
+/**
+ The outline of an atlas page being packed
+ */
+typedef struct {
+    int width;
+    int height;
+    int nodeCount;
+    AE_SkylineNode* nodes;
+}AE_Skyline;
+
+/**
+ An image waiting to be packed, kept apart from the regions so images can be packed tallest first
+ */
+typedef struct {
+    int index;
+    int width;
+    int height;
+}AE_AtlasPackItem;
+
+/**
+ Empties a skyline so it covers a blank page
+
+ @param skyline The AE_Skyline to be emptied
+ */
+static void AE_Skyline_Reset(AE_Skyline* skyline)
+{
+    skyline->nodeCount = 1;
+    skyline->nodes[0].x = 0;
+    skyline->nodes[0].y = 0;
+    skyline->nodes[0].width = skyline->width;
+}
+
+/**
+ Finds how low a rectangle can sit if its left edge is placed at a skyline node
+
+ @param skyline The AE_Skyline the rectangle will be placed on
+ @param index The node the rectangle's left edge will be placed at
+ @param width The width of the rectangle
+ @param height The height of the rectangle
+ @return The y the rectangle would be placed at, or -1 if it doesn't fit there
+ */
+static int AE_Skyline_Fit(AE_Skyline* skyline, int index, int width, int height)
+{
+    int y = 0;
+    int remaining = width;
+    
+    if (skyline->nodes[index].x + width > skyline->width)
+    {
+        return -1;
+    }
+    
+    //The rectangle rests on the highest node underneath it
+    for (int i = index; remaining > 0; i++)
+    {
+        y = SDL_max(y, skyline->nodes[i].y);
+        if (y + height > skyline->height)
+        {
+            return -1;
+        }
+        remaining -= skyline->nodes[i].width;
+    }
+    
+    return y;
+}
+
+/**
+ Places a rectangle on a skyline where its bottom edge ends up lowest
+
+ @param skyline The AE_Skyline the rectangle will be placed on
+ @param width The width of the rectangle
+ @param height The height of the rectangle
+ @param position Gets the top-left corner the rectangle was placed at
+ @return Whether the rectangle fit on the skyline or not
+ */
+static SDL_bool AE_Skyline_Insert(AE_Skyline* skyline, int width, int height, SDL_Point* position)
+{
+    int bestIndex = -1;
+    int bestBottom = 0;
+    int bestWidth = 0;
+    
+    //Bottom-left rule: lowest bottom edge first, then the narrowest node to waste the least space
+    for (int i = 0; i<skyline->nodeCount; i++)
+    {
+        int y = AE_Skyline_Fit(skyline, i, width, height);
+        if (y >= 0 && (bestIndex < 0 || y + height < bestBottom || (y + height == bestBottom && skyline->nodes[i].width < bestWidth)))
+        {
+            bestIndex = i;
+            bestBottom = y + height;
+            bestWidth = skyline->nodes[i].width;
+        }
+    }
+    
+    if (bestIndex < 0)
+    {
+        return SDL_FALSE;
+    }
+    
+    position->x = skyline->nodes[bestIndex].x;
+    position->y = bestBottom - height;
+    
+    //Add a node for the top of the new rectangle
+    SDL_memmove(&skyline->nodes[bestIndex + 1], &skyline->nodes[bestIndex], sizeof(AE_SkylineNode) * (skyline->nodeCount - bestIndex));
+    skyline->nodes[bestIndex].x = position->x;
+    skyline->nodes[bestIndex].y = bestBottom;
+    skyline->nodes[bestIndex].width = width;
+    skyline->nodeCount++;
+    
+    //Trim or remove the nodes the new rectangle now covers
+    for (int i = bestIndex + 1; i<skyline->nodeCount; i++)
+    {
+        AE_SkylineNode* previous = &skyline->nodes[i - 1];
+        int overlap = previous->x + previous->width - skyline->nodes[i].x;
+        if (overlap <= 0)
+        {
+            break;
+        }
+        
+        skyline->nodes[i].x += overlap;
+        skyline->nodes[i].width -= overlap;
+        if (skyline->nodes[i].width > 0)
+        {
+            break;
+        }
+        
+        SDL_memmove(&skyline->nodes[i], &skyline->nodes[i + 1], sizeof(AE_SkylineNode) * (skyline->nodeCount - i - 1));
+        skyline->nodeCount--;
+        i--;
+    }
+    
+    //Merge neighbouring nodes at the same height
+    for (int i = 0; i<skyline->nodeCount - 1; i++)
+    {
+        if (skyline->nodes[i].y == skyline->nodes[i + 1].y)
+        {
+            skyline->nodes[i].width += skyline->nodes[i + 1].width;
+            SDL_memmove(&skyline->nodes[i + 1], &skyline->nodes[i + 2], sizeof(AE_SkylineNode) * (skyline->nodeCount - i - 2));
+            skyline->nodeCount--;
+            i--;
+        }
+    }
+    
+    return SDL_TRUE;
+}
+
+/**
+ Orders pack items tallest first, then widest first
+
+ @param a The first AE_AtlasPackItem
+ @param b The second AE_AtlasPackItem
+ @return Negative if a goes first, positive if b goes first, 0 if they tie
+ */
+static int AE_AtlasPackItem_Compare(const void* a, const void* b)
+{
+    const AE_AtlasPackItem* itemA = a;
+    const AE_AtlasPackItem* itemB = b;
+    
+    if (itemA->height != itemB->height)
+    {
+        return itemB->height - itemA->height;
+    }
+    if (itemA->width != itemB->width)
+    {
+        return itemB->width - itemA->width;
+    }
+    return itemA->index - itemB->index;
+}
+
+/**
+ Gets the largest atlas page a renderer can hold
+
+ @param renderer The renderer the pages will be made for
+ @param width Gets the largest page width
+ @param height Gets the largest page height
+ */
+static void AE_TextureAtlas_GetPageLimit(SDL_Renderer* renderer, int* width, int* height)
+{
+    SDL_RendererInfo info;
+    
+    *width = AE_ATLAS_DEFAULT_PAGE_SIZE;
+    *height = AE_ATLAS_DEFAULT_PAGE_SIZE;
+    
+    //A maximum of 0 means the renderer has no limit it will report
+    if (SDL_GetRendererInfo(renderer, &info) == 0)
+    {
+        if (info.max_texture_width > 0)
+        {
+            *width = SDL_min(info.max_texture_width, AE_ATLAS_MAX_PAGE_SIZE);
+        }
+        if (info.max_texture_height > 0)
+        {
+            *height = SDL_min(info.max_texture_height, AE_ATLAS_MAX_PAGE_SIZE);
+        }
+    }
+}
+
+/**
+ Places every packable surface on a page, tallest first, starting a new page whenever the current one is full
+
+ @param atlas The AE_TextureAtlas whose region rects will be set
+ @param surfaces The surfaces to be placed, any of which may be NULL
+ @param items Room for one AE_AtlasPackItem per surface
+ @param skyline An AE_Skyline as large as a page plus the padding
+ @param padding The number of empty pixels left between packed images
+ @param regionPages Gets the page each surface was placed on, or -1 if it wasn't placed
+ @param pageSizes Gets the size of what was placed on each page
+ @return The number of pages used
+ */
+static int AE_TextureAtlas_Place(AE_TextureAtlas* atlas, SDL_Surface** surfaces, AE_AtlasPackItem* items, AE_Skyline* skyline, int padding, int* regionPages, SDL_Point* pageSizes)
+{
+    int itemCount = 0;
+    int pageCount = 0;
+    
+    for (int i = 0; i<atlas->regionCount; i++)
+    {
+        regionPages[i] = -1;
+        if (surfaces[i] == NULL)
+        {
+            continue;
+        }
+        if (surfaces[i]->w + padding > skyline->width || surfaces[i]->h + padding > skyline->height)
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Atlas packing error", "An image is larger than the largest texture the renderer can make", NULL);
+            continue;
+        }
+        items[itemCount].index = i;
+        items[itemCount].width = surfaces[i]->w;
+        items[itemCount].height = surfaces[i]->h;
+        itemCount++;
+    }
+    
+    //Packing tallest first keeps the skyline flat
+    SDL_qsort(items, itemCount, sizeof(AE_AtlasPackItem), AE_AtlasPackItem_Compare);
+    
+    AE_Skyline_Reset(skyline);
+    for (int i = 0; i<itemCount; i++)
+    {
+        SDL_Point position;
+        
+        //Start a new page when the current one is full
+        if (!AE_Skyline_Insert(skyline, items[i].width + padding, items[i].height + padding, &position))
+        {
+            pageCount++;
+            AE_Skyline_Reset(skyline);
+            AE_Skyline_Insert(skyline, items[i].width + padding, items[i].height + padding, &position);
+        }
+        
+        regionPages[items[i].index] = pageCount;
+        atlas->regions[items[i].index].rect.x = position.x;
+        atlas->regions[items[i].index].rect.y = position.y;
+        atlas->regions[items[i].index].rect.w = items[i].width;
+        atlas->regions[items[i].index].rect.h = items[i].height;
+        
+        //Pages are trimmed to what was packed onto them
+        pageSizes[pageCount].x = SDL_max(pageSizes[pageCount].x, position.x + items[i].width);
+        pageSizes[pageCount].y = SDL_max(pageSizes[pageCount].y, position.y + items[i].height);
+    }
+    
+    return (itemCount > 0) ? pageCount + 1 : 0;
+}
+
+/**
+ Draws the placed surfaces onto their pages and uploads each page as a linkedTexture
+
+ @param atlas The AE_TextureAtlas whose pages will be made
+ @param renderer The renderer which will generate the atlas pages
+ @param surfaces The placed surfaces
+ @param regionPages The page each surface was placed on, or -1 if it wasn't placed
+ @param pageSizes The size of each page
+ @param pageCount The number of pages to make
+ */
+static void AE_TextureAtlas_BuildPages(AE_TextureAtlas* atlas, SDL_Renderer* renderer, SDL_Surface** surfaces, int* regionPages, SDL_Point* pageSizes, int pageCount)
+{
+    for (int page = 0; page<pageCount; page++)
+    {
+        SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, pageSizes[page].x, pageSizes[page].y, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Texture* pageTexture = NULL;
+        
+        if (pageSurface == NULL)
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Atlas packing error", "Failed to create an atlas page surface", NULL);
+            continue;
+        }
+        
+        //Copy each image straight onto the transparent page, keeping color keys but not blending
+        for (int i = 0; i<atlas->regionCount; i++)
+        {
+            if (regionPages[i] == page)
+            {
+                SDL_BlendMode blendMode;
+                SDL_Rect destination = atlas->regions[i].rect;
+                SDL_GetSurfaceBlendMode(surfaces[i], &blendMode);
+                SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(surfaces[i], NULL, pageSurface, &destination);
+                SDL_SetSurfaceBlendMode(surfaces[i], blendMode);
+            }
+        }
+        
+        pageTexture = SDL_CreateTextureFromSurface(renderer, pageSurface);
+        SDL_FreeSurface(pageSurface);
+        if (pageTexture == NULL)
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Surface conversion error", "An atlas page could not be converted to a texture", NULL);
+            continue;
+        }
+        
+        atlas->pages[atlas->pageCount] = AE_CreateLinkedTexture(pageTexture);
+        for (int i = 0; i<atlas->regionCount; i++)
+        {
+            if (regionPages[i] == page)
+            {
+                atlas->regions[i].page = atlas->pages[atlas->pageCount];
+            }
+        }
+        atlas->pageCount++;
+    }
+}
+
+/**
+ Packs surfaces into the fewest pages that fit and uploads each page as a linkedTexture
+
+ @param renderer The renderer which will generate the atlas pages
+ @param surfaces The surfaces to be packed, any of which may be NULL
+ @param surfaceCount The number of surfaces
+ @param padding The number of empty pixels left between packed images
+ @return The AE_TextureAtlas, or NULL if it could not be created
+ */
+static AE_TextureAtlas* AE_TextureAtlas_Pack(SDL_Renderer* renderer, SDL_Surface** surfaces, int surfaceCount, int padding)
+{
+    AE_TextureAtlas* output = NULL;
+    AE_Skyline skyline;
+    int pageLimit_w;
+    int pageLimit_h;
+    
+    if (surfaceCount <= 0)
+    {
+        return NULL;
+    }
+    padding = SDL_max(padding, 0);
+    AE_TextureAtlas_GetPageLimit(renderer, &pageLimit_w, &pageLimit_h);
+    
+    //Each rectangle carries its padding on the right and bottom, so the skyline is widened by the padding to let images touch the page edge
+    skyline.width = pageLimit_w + padding;
+    skyline.height = pageLimit_h + padding;
+    skyline.nodes = SDL_malloc(sizeof(AE_SkylineNode) * (skyline.width + 1));
+    
+    AE_AtlasPackItem* items = SDL_malloc(sizeof(AE_AtlasPackItem) * surfaceCount);
+    int* regionPages = SDL_malloc(sizeof(int) * surfaceCount);
+    SDL_Point* pageSizes = SDL_calloc(surfaceCount, sizeof(SDL_Point));
+    
+    if (skyline.nodes != NULL && items != NULL && regionPages != NULL && pageSizes != NULL && (output = SDL_calloc(1, sizeof(AE_TextureAtlas))) != NULL)
+    {
+        output->regions = SDL_calloc(surfaceCount, sizeof(AE_AtlasRegion));
+        //There's never more than one page per surface
+        output->pages = SDL_calloc(surfaceCount, sizeof(AE_LinkedTexture*));
+        
+        if (output->regions == NULL || output->pages == NULL)
+        {
+            SDL_free(output->regions);
+            SDL_free(output->pages);
+            SDL_free(output);
+            output = NULL;
+        }
+        else
+        {
+            output->regionCount = surfaceCount;
+            int pageCount = AE_TextureAtlas_Place(output, surfaces, items, &skyline, padding, regionPages, pageSizes);
+            AE_TextureAtlas_BuildPages(output, renderer, surfaces, regionPages, pageSizes, pageCount);
+        }
+    }
+    
+    SDL_free(skyline.nodes);
+    SDL_free(items);
+    SDL_free(regionPages);
+    SDL_free(pageSizes);
+    
+    return output;
+}
+
+/**
+ Loads images from files and packs them into one or more atlas pages, color keying each image the same way as AE_LoadTextureFromFile
+
+ @param renderer The renderer which will generate the atlas pages
+ @param paths The pathnames of the files to be packed
+ @param pathCount The number of pathnames
+ @param padding The number of empty pixels left between packed images
+ @return The AE_TextureAtlas, with one region per pathname in the same order, or NULL if it could not be created
+ */
+AE_TextureAtlas* AE_CreateTextureAtlas_FromFiles(SDL_Renderer* renderer, const char** paths, int pathCount, int padding)
+{
+    AE_TextureAtlas* output = NULL;
+    SDL_Surface** surfaces = NULL;
+    
+    if (pathCount <= 0 || (surfaces = SDL_calloc(pathCount, sizeof(SDL_Surface*))) == NULL)
+    {
+        return NULL;
+    }
+    
+    for (int i = 0; i<pathCount; i++)
+    {
+        surfaces[i] = IMG_Load(paths[i]);
+        if (surfaces[i] == NULL)
+        {
+            char errormsg[1024];
+            SDL_snprintf(errormsg, sizeof(errormsg), "Cannot load image at: %s", paths[i]);
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Image loading error", errormsg, NULL);
+        }
+        //Color key the image based on the bottom-left pixel, to match textures loaded on their own
+        else if (SDL_SetColorKey(surfaces[i], SDL_TRUE, AE_GetSurfacePixel(surfaces[i], 0, surfaces[i]->h-1)) < 0)
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Color key error", "Failed to color key", NULL);
+        }
+    }
+    
+    output = AE_TextureAtlas_Pack(renderer, surfaces, pathCount, padding);
+    
+    for (int i = 0; i<pathCount; i++)
+    {
+        SDL_FreeSurface(surfaces[i]);
+    }
+    SDL_free(surfaces);
+    
+    return output;
+}
+
+/**
+ Packs surfaces into one or more atlas pages, leaving the surfaces untouched
+
+ @param renderer The renderer which will generate the atlas pages
+ @param surfaces The surfaces to be packed
+ @param surfaceCount The number of surfaces
+ @param padding The number of empty pixels left between packed images
+ @return The AE_TextureAtlas, with one region per surface in the same order, or NULL if it could not be created
+ */
+AE_TextureAtlas* AE_CreateTextureAtlas_FromSurfaces(SDL_Renderer* renderer, SDL_Surface** surfaces, int surfaceCount, int padding)
+{
+    return AE_TextureAtlas_Pack(renderer, surfaces, surfaceCount, padding);
+}
+
+/**
+ Gets a packed image's region in an atlas
+
+ @param atlas The AE_TextureAtlas the image was packed into
+ @param index The position of the image in the list the atlas was created from
+ @return The region of the image, or NULL if the index is out of range. A region whose page is NULL could not be packed
+ */
+AE_AtlasRegion* AE_TextureAtlas_GetRegion(AE_TextureAtlas* atlas, int index)
+{
+    if (index < 0 || index >= atlas->regionCount)
+    {
+        return NULL;
+    }
+    return &atlas->regions[index];
+}
+
+/**
+ Gets the number of pages in an atlas
+
+ @param atlas The AE_TextureAtlas whose pages will be counted
+ @return The number of pages in the atlas
+ */
+int AE_TextureAtlas_GetPageCount(AE_TextureAtlas* atlas)
+{
+    return atlas->pageCount;
+}
+
+/**
+ Gets a page of an atlas
+
+ @param atlas The AE_TextureAtlas whose page will be retrieved
+ @param index The index of the page
+ @return The linkedTexture of the page, or NULL if the index is out of range
+ */
+AE_LinkedTexture* AE_TextureAtlas_GetPage(AE_TextureAtlas* atlas, int index)
+{
+    if (index < 0 || index >= atlas->pageCount)
+    {
+        return NULL;
+    }
+    return atlas->pages[index];
+}
+
+/**
+ Destroys an atlas and its pages only if nothing references any of its pages
+
+ @param atlas The AE_TextureAtlas to destroy
+ @return Whether the atlas was destroyed or not
+ */
+SDL_bool AE_DestroyTextureAtlas(AE_TextureAtlas* atlas)
+{
+    //Don't pull a page out from under any sprite still using it
+    for (int i = 0; i<atlas->pageCount; i++)
+    {
+        if (AE_LinkedTexture_GetReferenceCount(atlas->pages[i]) > 0)
+        {
+            return SDL_FALSE;
+        }
+    }
+    
+    for (int i = 0; i<atlas->pageCount; i++)
+    {
+        AE_DestroyLinkedTexture(atlas->pages[i]);
+    }
+    SDL_free(atlas->pages);
+    SDL_free(atlas->regions);
+    SDL_free(atlas);
+    
+    return SDL_TRUE;
+}
+
+//
+//
+//End: Texture Atlas Functions
+//
+//
+
+//
+//
+//Start: Asynchronous Texture Loading Functions
+//
+//
+
+/**
+ Reads, decodes and color keys an image file, then converts it to the format it will be uploaded in
+
+ @param path The pathname of the file to be loaded
+ @param format The pixel format the surface will be converted to
+ @return The converted surface, or NULL if it could not be loaded
+ */
+static SDL_Surface* AE_TextureLoader_Decode(const char* path, Uint32 format)
+{
+    AE_PROFILE_BEGIN("AE_TextureLoader_Decode");
+    SDL_Surface* loaded = IMG_Load(path);
+    SDL_Surface* output = NULL;
+    
+    if (loaded != NULL)
+    {
+        //Color key the image based on the bottom-left pixel, to match AE_LoadTextureFromFile
+        SDL_SetColorKey(loaded, SDL_TRUE, AE_GetSurfacePixel(loaded, 0, loaded->h-1));
+        
+        //Converting here leaves the render thread nothing to do but copy the pixels (the color key becomes alpha)
+        output = SDL_ConvertSurfaceFormat(loaded, format, 0);
+        SDL_FreeSurface(loaded);
+    }
+    
+    AE_PROFILE_END();
+    return output;
+}
+
+/**
+ Adds a job to the back of a loader's completed queue. Any number of threads can add jobs at once without locking
+
+ @param loader The AE_TextureLoader whose completed queue the job will be added to
+ @param job The AE_TextureLoadJob to be added
+ */
+static void AE_TextureLoader_PushCompleted(AE_TextureLoader* loader, AE_TextureLoadJob* job)
+{
+    AE_TextureLoadJob* previous;
+    
+    SDL_AtomicSetPtr(&job->next, NULL);
+    //Everything written to the job has to be seen before the job can be reached
+    SDL_MemoryBarrierRelease();
+    
+    //Claim the back of the queue, then link the old back to the job
+    previous = SDL_AtomicSetPtr(&loader->completedTail, job);
+    SDL_AtomicSetPtr(&previous->next, job);
+}
+
+/**
+ Takes the job at the front of a loader's completed queue. Only the render thread takes jobs
+
+ @param loader The AE_TextureLoader whose completed queue the job will be taken from
+ @return The AE_TextureLoadJob, or NULL if none are ready
+ */
+static AE_TextureLoadJob* AE_TextureLoader_PopCompleted(AE_TextureLoader* loader)
+{
+    AE_TextureLoadJob* head = loader->completedHead;
+    AE_TextureLoadJob* next = SDL_AtomicGetPtr(&head->next);
+    
+    //The stub keeps the queue from ever being truly empty, so step over it
+    if (head == &loader->completedStub)
+    {
+        if (next == NULL)
+        {
+            return NULL;
+        }
+        loader->completedHead = head = next;
+        next = SDL_AtomicGetPtr(&head->next);
+    }
+    
+    //The front job can be taken as soon as another job is linked behind it
+    if (next == NULL)
+    {
+        //A worker has claimed the back of the queue but hasn't linked its job yet
+        if (head != SDL_AtomicGetPtr(&loader->completedTail))
+        {
+            return NULL;
+        }
+        
+        //The front job is the only one, so put the stub behind it
+        AE_TextureLoader_PushCompleted(loader, &loader->completedStub);
+        next = SDL_AtomicGetPtr(&head->next);
+        if (next == NULL)
+        {
+            return NULL;
+        }
+    }
+    
+    loader->completedHead = next;
+    SDL_MemoryBarrierAcquire();
+    return head;
+}
+
+/**
+ Takes requests off a loader's request queue and decodes them until the loader quits
+
+ @param data The AE_TextureLoader the worker belongs to
+ @return 0 once the loader quits
+ */
+static int AE_TextureLoader_Work(void* data)
+{
+    AE_TextureLoader* loader = data;
+    
+    for (;;)
+    {
+        AE_TextureLoadJob* job = NULL;
+        
+        //Sleep until there's a request or the loader quits
+        SDL_LockMutex(loader->requestLock);
+        while (loader->requestHead == NULL && !SDL_AtomicGet(&loader->quit))
+        {
+            SDL_CondWait(loader->requestSignal, loader->requestLock);
+        }
+        if (!SDL_AtomicGet(&loader->quit))
+        {
+            job = loader->requestHead;
+            loader->requestHead = job->next;
+            if (loader->requestHead == NULL)
+            {
+                loader->requestTail = NULL;
+            }
+        }
+        SDL_UnlockMutex(loader->requestLock);
+        
+        //Requests left behind when the loader quits are failed by AE_DestroyTextureLoader
+        if (job == NULL)
+        {
+            break;
+        }
+        
+        job->surface = AE_TextureLoader_Decode(job->path, loader->surfaceFormat);
+        AE_TextureLoader_PushCompleted(loader, job);
+    }
+    
+    return 0;
+}
+
+/**
+ Uploads a decoded job's surface, marks its linkedTexture as ready or failed and calls its callback
+
+ @param loader The AE_TextureLoader the job belongs to
+ @param job The AE_TextureLoadJob to be finished (freed afterwards)
+ */
+static void AE_TextureLoader_Complete(AE_TextureLoader* loader, AE_TextureLoadJob* job)
+{
+    SDL_bool success = SDL_FALSE;
+    
+    if (job->surface != NULL)
+    {
+        job->linkedTexture->texture = SDL_CreateTextureFromSurface(loader->renderer, job->surface);
+        AE_LinkedTexture_MarkChanged(job->linkedTexture);
+        AE_LinkedTexture_CacheMetadata(job->linkedTexture);
+        SDL_FreeSurface(job->surface);
+        success = (job->linkedTexture->texture != NULL) ? SDL_TRUE : SDL_FALSE;
+    }
+    job->linkedTexture->loadState = success ? AE_TEXTURE_READY : AE_TEXTURE_FAILED;
+    loader->pendingCount--;
+    
+    if (job->callback != NULL)
+    {
+        job->callback(job->linkedTexture, success, job->userdata);
+    }
+    
+    SDL_free(job->path);
+    SDL_free(job);
+}
+
+/**
+ Creates a texture loader and starts its worker threads
+
+ @param renderer The renderer the textures will be uploaded to
+ @param workerCount The number of worker threads (0 or less for one fewer than the number of CPUs, at least 1)
+ @return The new AE_TextureLoader, or NULL if it could not be created
+ */
+AE_TextureLoader* AE_CreateTextureLoader(SDL_Renderer* renderer, int workerCount)
+{
+    AE_TextureLoader* output = SDL_calloc(1, sizeof(AE_TextureLoader));
+    SDL_RendererInfo info;
+    
+    if (output == NULL)
+    {
+        return NULL;
+    }
+    
+    //Leave a CPU for the render thread
+    if (workerCount <= 0)
+    {
+        workerCount = SDL_max(SDL_GetCPUCount() - 1, 1);
+    }
+    
+    //Decode straight into the first format the renderer takes that can hold the color key as alpha
+    output->renderer = renderer;
+    output->surfaceFormat = SDL_PIXELFORMAT_ARGB8888;
+    if (SDL_GetRendererInfo(renderer, &info) == 0)
+    {
+        for (Uint32 i = 0; i<info.num_texture_formats; i++)
+        {
+            if (!SDL_ISPIXELFORMAT_FOURCC(info.texture_formats[i]) && SDL_ISPIXELFORMAT_ALPHA(info.texture_formats[i]))
+            {
+                output->surfaceFormat = info.texture_formats[i];
+                break;
+            }
+        }
+    }
+    
+    output->completedHead = &output->completedStub;
+    output->completedTail = &output->completedStub;
+    
+    output->requestLock = SDL_CreateMutex();
+    output->requestSignal = SDL_CreateCond();
+    output->workers = SDL_calloc(workerCount, sizeof(SDL_Thread*));
+    if (output->requestLock == NULL || output->requestSignal == NULL || output->workers == NULL)
+    {
+        AE_DestroyTextureLoader(output);
+        return NULL;
+    }
+    
+    for (int i = 0; i<workerCount; i++)
+    {
+        output->workers[output->workerCount] = SDL_CreateThread(AE_TextureLoader_Work, "AE_TextureLoader", output);
+        if (output->workers[output->workerCount] != NULL)
+        {
+            output->workerCount++;
+        }
+    }
+    
+    if (output->workerCount == 0)
+    {
+        AE_DestroyTextureLoader(output);
+        return NULL;
+    }
+    
+    return output;
+}
+
+/**
+ Starts loading a texture from a file in the background, color keyed the same way as AE_LoadTextureFromFile
+
+ @param loader The AE_TextureLoader that will load the texture
+ @param path The pathname of the file to be loaded
+ @param callback Called on the render thread once the texture is ready or has failed (NULL for none)
+ @param userdata Passed to the callback
+ @return A linkedTexture with no texture yet, that can be joined and given to sprites straight away and is drawn once it finishes loading, or NULL if the load could not be started
+ */
+AE_LinkedTexture* AE_TextureLoader_Load(AE_TextureLoader* loader, const char* path, AE_TextureLoadCallback callback, void* userdata)
+{
+    AE_TextureLoadJob* job = SDL_calloc(1, sizeof(AE_TextureLoadJob));
+    
+    if (job == NULL || (job->path = SDL_strdup(path)) == NULL)
+    {
+        SDL_free(job);
+        return NULL;
+    }
+    
+    job->linkedTexture = AE_CreateLinkedTexture(NULL);
+    job->linkedTexture->loadState = AE_TEXTURE_LOADING;
+    job->callback = callback;
+    job->userdata = userdata;
+    
+    //Hand the request to a worker
+    SDL_LockMutex(loader->requestLock);
+    if (loader->requestTail != NULL)
+    {
+        loader->requestTail->next = job;
+    }
+    else
+    {
+        loader->requestHead = job;
+    }
+    loader->requestTail = job;
+    SDL_CondSignal(loader->requestSignal);
+    SDL_UnlockMutex(loader->requestLock);
+    
+    loader->pendingCount++;
+    
+    return job->linkedTexture;
+}
+
+/**
+ Uploads textures that have finished decoding, stopping once the time budget is spent. Call it once a frame on the render thread
+
+ @param loader The AE_TextureLoader whose textures will be uploaded
+ @param budgetMilliseconds The time that can be spent uploading (at least one texture is always uploaded if one is waiting)
+ @return The number of textures finished, whether they loaded or failed
+ */
+int AE_TextureLoader_Update(AE_TextureLoader* loader, double budgetMilliseconds)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const Uint64 budget = (Uint64)(SDL_max(budgetMilliseconds, 0.0) * (double)SDL_GetPerformanceFrequency() / 1000.0);
+    AE_TextureLoadJob* job;
+    int finished = 0;
+    
+    AE_PROFILE_BEGIN("AE_TextureLoader_Update");
+    while ((finished == 0 || SDL_GetPerformanceCounter() - start < budget) && (job = AE_TextureLoader_PopCompleted(loader)) != NULL)
+    {
+        AE_TextureLoader_Complete(loader, job);
+        finished++;
+    }
+    AE_PROFILE_END();
+    
+    return finished;
+}
+
+/**
+ Blocks until every requested texture has been loaded or has failed
+
+ @param loader The AE_TextureLoader to wait on
+ */
+void AE_TextureLoader_Finish(AE_TextureLoader* loader)
+{
+    while (loader->pendingCount > 0)
+    {
+        //Upload everything that's ready, then give the workers time to decode more
+        if (AE_TextureLoader_Update(loader, 1000000.0) == 0)
+        {
+            SDL_Delay(1);
+        }
+    }
+}
+
+/**
+ Gets the number of textures that have been requested but not yet finished
+
+ @param loader The AE_TextureLoader whose textures will be counted
+ @return The number of textures still loading
+ */
+int AE_TextureLoader_GetPendingCount(AE_TextureLoader* loader)
+{
+    return loader->pendingCount;
+}
+
+/**
+ Stops a texture loader's workers and destroys it. Textures that hadn't finished are marked as failed and their callbacks are called
+
+ @param loader The AE_TextureLoader to destroy
+ */
+void AE_DestroyTextureLoader(AE_TextureLoader* loader)
+{
+    AE_TextureLoadJob* job;
+    
+    if (loader == NULL)
+    {
+        return;
+    }
+    
+    //Wake every worker so it sees the loader is quitting
+    SDL_AtomicSet(&loader->quit, 1);
+    if (loader->requestLock != NULL && loader->requestSignal != NULL)
+    {
+        SDL_LockMutex(loader->requestLock);
+        SDL_CondBroadcast(loader->requestSignal);
+        SDL_UnlockMutex(loader->requestLock);
+    }
+    for (int i = 0; i<loader->workerCount; i++)
+    {
+        SDL_WaitThread(loader->workers[i], NULL);
+    }
+    
+    //Fail everything that was decoded but never uploaded, then everything never decoded
+    while ((job = AE_TextureLoader_PopCompleted(loader)) != NULL)
+    {
+        SDL_FreeSurface(job->surface);
+        job->surface = NULL;
+        AE_TextureLoader_Complete(loader, job);
+    }
+    while ((job = loader->requestHead) != NULL)
+    {
+        loader->requestHead = job->next;
+        AE_TextureLoader_Complete(loader, job);
+    }
+    
+    SDL_DestroyCond(loader->requestSignal);
+    SDL_DestroyMutex(loader->requestLock);
+    SDL_free(loader->workers);
+    SDL_free(loader);
+}
+
+//
+//
+//End: Asynchronous Texture Loading Functions
+//
+//
+
+//
+//
+//Start: Sprites and Sprite Functions
+//
+//
+
+/**
+ Allocates an AE_SpriteDef with no frames that joins a sprite sheet, with one reference held by the caller
+
+ @param spriteSheet The LinkedTexture that will be used as the sprite sheet
+ @return The new AE_SpriteDef, or NULL if it couldn't be allocated or couldn't join the sprite sheet
+ */
+static AE_SpriteDef* AE_SpriteDef_Allocate(AE_LinkedTexture* spriteSheet)
+{
+    AE_SpriteDef* output = AE_AllocateObject(AE_OBJECT_SPRITEDEF, sizeof(AE_SpriteDef));
+    if (output == NULL)
+    {
+        return NULL;
+    }
+    
+    //The sprite sheet is joined once by the definition rather than once by every sprite sharing it
+    if (spriteSheet != NULL && !AE_LinkedTexture_Join(spriteSheet, output))
+    {
+        AE_ReleaseObject(AE_OBJECT_SPRITEDEF, output);
+        return NULL;
+    }
+    output->spriteSheet = spriteSheet;
+    output->width = 0;
+    output->height = 0;
+    output->frameCount = 0;
+    output->frames = NULL;
+    output->pivot.x = 0;
+    output->pivot.y = 0;
+    
+    //Default frame speed is 30
+    output->frameSpeed = 30;
+    SDL_AtomicSet(&output->references, 1);
+    return output;
+}
+
+/**
+ Sets the number of frames in a definition, and creates an array of frames for it
+
+ @param definition The AE_SpriteDef whose frames will be set
+ @param frameCount The number of frames
+ @param reference_x The x of the first frame on the spritesheet
+ @param reference_y The y of the first frame on the spritesheet
+ @param frame_width The width of the new frames
+ @param frame_height The height of the new frames
+ @param dataToKeep Whether you want to keep the width, height, or neither
+ */
+static void AE_SpriteDef_SetFrames(AE_SpriteDef* definition, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep)
+{
+    //Remember how many frames the current framesheet was made for
+    int previousFrameCount = definition->frameCount;
+    
+    //Set the definition framecount
+    definition->frameCount = frameCount;
+    
+    //Initialize temp_width and temp_height variables
+    int temp_width = 0;
+    int temp_height = 0;
+    
+    //If you're not saving the width, set it to the new frame_width
+    if (dataToKeep != AE_SPRITE_KEEP_WIDTH)
+    {
+        temp_width = definition->width = frame_width;
+    }
+    else
+    {
+        temp_width = definition->width;
+    }
+    
+    //If you're not saving the height, set it to the new frame_height
+    if (dataToKeep != AE_SPRITE_KEEP_HEIGHT)
+    {
+        temp_height = definition->height = frame_height;
+    }
+    else
+    {
+        temp_height = definition->height;
+    }
+    
+    //If there is one frame and it's the same size as the spritesheet and there is a spritesheet
+    if (frameCount == 1 && reference_x == 0 && reference_y == 0 && definition->spriteSheet != NULL && temp_width == AE_LinkedTexture_GetWidth(definition->spriteSheet) && temp_height == AE_LinkedTexture_GetHeight(definition->spriteSheet))
+    {
+        //Free any leftover frame data and make the definition point at NULL frames
+        if (definition->frames != NULL)
+        {
+            SDL_free(definition->frames);
+        }
+        definition->frames = NULL;
+    }
+    else
+    //If there's any frames and it's not the same size as the spritesheet
+    {
+        //If there's a prexisting framesheet and it's not the same framecount as the new framecount, destroy the old framesheet
+        if (definition->frames != NULL && previousFrameCount != frameCount)
+        {
+            //Free any leftover frame data and make the definition point at NULL frames
+            SDL_Rect* temp_frames = definition->frames;
+            definition->frames = NULL;
+            SDL_free(temp_frames);
+        }
+        if (definition->frames == NULL)
+        {
+            definition->frames = SDL_malloc(sizeof(SDL_Rect)*frameCount);
+            
+            //Without a frame array the whole sprite sheet is drawn
+            if (definition->frames == NULL)
+            {
+                definition->frameCount = 0;
+                return;
+            }
+        }
+        //For each frame in the array, set the frame attributes up
+        for (int i = 0; i<frameCount; i++)
+        {
+            //If the currently set frame is not frame 0, make the frame the endpoint + 1
+            definition->frames[i].x = (i == 0) ? reference_x : reference_x + (temp_width * i);
+            
+            //The frames run along the width of the sprite sheet, so the y remains static
+            definition->frames[i].y = reference_y;
+            
+            //Set the frame width and height to be the definition width and height
+            definition->frames[i].w = temp_width;
+            definition->frames[i].h = temp_height;
+        }
+    }
+}
+
+/**
+ Makes sure a sprite's definition is its own before its sheet or frames are changed, so sprites sharing the definition are left untouched
+
+ @param sprite The sprite whose definition is about to change
+ @return The sprite's own AE_SpriteDef (a copy of everything but the frames if the definition was shared), or NULL if a copy couldn't be made
+ */
+static AE_SpriteDef* AE_SpriteOwnDef(AE_Sprite* sprite)
+{
+    AE_SpriteDef* shared = sprite->definition;
+    
+    //A definition nothing else references can be changed in place
+    if (shared != NULL && SDL_AtomicGet(&shared->references) <= 1)
+    {
+        return shared;
+    }
+    
+    AE_SpriteDef* copy = AE_SpriteDef_Allocate((shared != NULL) ? shared->spriteSheet : NULL);
+    if (copy != NULL)
+    {
+        if (shared != NULL)
+        {
+            copy->width = shared->width;
+            copy->height = shared->height;
+            copy->pivot = shared->pivot;
+            copy->frameSpeed = shared->frameSpeed;
+            AE_SpriteDef_Release(shared);
+        }
+        sprite->definition = copy;
+    }
+    return copy;
+}
+
+/**
+ Creates a new AE_Sprite from a preexisting LinkedTexture
+ 
+ @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
+ @param reference_x The x of the sprite on the spritesheet
+ @param reference_y The y of the sprite on the spritesheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame
+ @param height The height of a single sprite frame
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return The initialized AE_Sprite, with all other parameters set to default
+ */
+AE_Sprite* AE_CreateSprite(AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y)
+{
+    AE_Sprite* output = AE_AllocateObject(AE_OBJECT_SPRITE, sizeof(AE_Sprite));
+    if (output == NULL)
+    {
+        return NULL;
+    }
+    
+    //Offloads work to another function for modularity
+    if (!AE_FillSprite(output, spriteSheet, reference_x, reference_y, frameCount, width, height, pivot_x, pivot_y))
+    {
+        AE_ReleaseObject(AE_OBJECT_SPRITE, output);
+        output = NULL;
+    }
+    return output;
+}
+
+/**
+ Guts out and fills a sprite with the given data, giving it a definition of its own
+ 
+ @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
+ @param reference_x The x of the sprite on the spritesheet
+ @param reference_y The y of the sprite on the spritesheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame
+ @param height The height of a single sprite frame
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return Whether the sprite's definition could be created or not. On failure the sprite is zeroed and must not be rendered
+ */
+SDL_bool AE_FillSprite(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y)
+{
+    AE_SpriteDef* definition = AE_CreateSpriteDef(spriteSheet, reference_x, reference_y, frameCount, width, height, pivot_x, pivot_y, 30);
+    
+    if (!AE_FillSpriteFromDef(sprite, definition))
+    {
+        return SDL_FALSE;
+    }
+    
+    //The sprite now holds the only reference to its definition
+    AE_SpriteDef_Release(definition);
+    return SDL_TRUE;
+}
+
+/**
+ Resets the frame sprite sheet (giving the sprite its own definition first if it shares one)
+
+ @param sprite The AE_Sprite whose spritesheet will be reset
+ @param spriteSheet The spritesheet that the AE_Sprite will now reference
+ @param frameCount The number of frames in the sprite
+ @param reference_x The x of the desired sprite on the spritesheet
+ @param reference_y The y of the desired sprite on the spritesheet
+ @param frame_width The width of the new frames
+ @param frame_height The height of the new frames
+ @param dataToKeep Whether to keep the previous width or height, or neither
+ @return Whether the sprite now references the spritesheet or not (if it couldn't be joined, the sprite is left without a spritesheet)
+ */
+SDL_bool AE_SpriteSetSpriteSheet(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep)
+{
+    AE_SpriteDef* definition = AE_SpriteOwnDef(sprite);
+    if (definition == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    if (definition->spriteSheet != spriteSheet)
+    {
+        if (definition->spriteSheet != NULL)
+        {
+            AE_LinkedTexture_Leave(definition->spriteSheet, definition);
+        }
+        
+        //A sheet the definition couldn't join isn't kept, since it could be destroyed while the definition still draws from it
+        definition->spriteSheet = (spriteSheet != NULL && AE_LinkedTexture_Join(spriteSheet, definition)) ? spriteSheet : NULL;
+    }
+    
+    //Offload the work to the SetFrames function for modularity
+    AE_SpriteDef_SetFrames(definition, frameCount, reference_x, reference_y, frame_width, frame_height, dataToKeep);
+    return (definition->spriteSheet == spriteSheet) ? SDL_TRUE : SDL_FALSE;
+}
+
+
+/**
+ Sets the number of frames in a sprite, and creates an array of frames for the sprite (giving the sprite its own definition first if it shares one)
+
+ @param sprite The sprite whose frame count will be expanded
+ @param frameCount The number of sprite frames
+ @param reference_x The x of the sprite on its spritesheet
+ @param reference_y The y of the sprite on its spritesheet
+ @param frame_width The width of the new frames
+ @param frame_height The height of the new frames
+ @param dataToKeep Whether you want to keep the width, height, or neither
+ */
+void AE_SpriteSetFrames(AE_Sprite* sprite, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep)
+{
+    AE_SpriteDef* definition = AE_SpriteOwnDef(sprite);
+    if (definition != NULL)
+    {
+        AE_SpriteDef_SetFrames(definition, frameCount, reference_x, reference_y, frame_width, frame_height, dataToKeep);
+    }
+}
+
+/**
+ Creates a new AE_Sprite whose frames start at the origin of an atlas region
+
+ @param region The AE_AtlasRegion the sprite will be drawn from, whose page will be used as the sprite sheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame, or 0 to split the region's width evenly between the frames
+ @param height The height of a single sprite frame, or 0 to use the region's height
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return The initialized AE_Sprite, with all other parameters set to default, or NULL if the region was never packed
+ */
+AE_Sprite* AE_CreateSpriteFromRegion(AE_AtlasRegion* region, int frameCount, int width, int height, int pivot_x, int pivot_y)
+{
+    if (region == NULL || region->page == NULL || frameCount <= 0)
+    {
+        return NULL;
+    }
+    
+    //Default to frames laid out along the region
+    if (width <= 0)
+    {
+        width = region->rect.w / frameCount;
+    }
+    if (height <= 0)
+    {
+        height = region->rect.h;
+    }
+    
+    return AE_CreateSprite(region->page, region->rect.x, region->rect.y, frameCount, width, height, pivot_x, pivot_y);
+}
+
+/**
+ Sets the frames of a sprite to start at the origin of an atlas region, switching to the region's page if needed
+
+ @param sprite The sprite whose frames will be set
+ @param region The AE_AtlasRegion the frames will be taken from
+ @param frameCount The number of sprite frames
+ @param frame_width The width of the new frames, or 0 to split the region's width evenly between the frames
+ @param frame_height The height of the new frames, or 0 to use the region's height
+ @param dataToKeep Whether you want to keep the width, height, or neither
+ @return Whether the frames were set or not
+ */
+SDL_bool AE_SpriteSetFramesFromRegion(AE_Sprite* sprite, AE_AtlasRegion* region, int frameCount, int frame_width, int frame_height, int dataToKeep)
+{
+    if (region == NULL || region->page == NULL || frameCount <= 0)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Default to frames laid out along the region
+    if (frame_width <= 0)
+    {
+        frame_width = region->rect.w / frameCount;
+    }
+    if (frame_height <= 0)
+    {
+        frame_height = region->rect.h;
+    }
+    
+    //Only rejoin a sprite sheet when the region is on a different page
+    if (sprite->definition == NULL || sprite->definition->spriteSheet != region->page)
+    {
+        return AE_SpriteSetSpriteSheet(sprite, region->page, frameCount, region->rect.x, region->rect.y, frame_width, frame_height, dataToKeep);
+    }
+    
+    AE_SpriteSetFrames(sprite, frameCount, region->rect.x, region->rect.y, frame_width, frame_height, dataToKeep);
+    return SDL_TRUE;
+}
+
+/**
+ Creates a new AE_SpriteDef that sprites can share instead of each holding their own copy of the frames
+
+ @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
+ @param reference_x The x of the first frame on the spritesheet
+ @param reference_y The y of the first frame on the spritesheet
+ @param frameCount The number of frames in the definition
+ @param width The width of a single frame
+ @param height The height of a single frame
+ @param pivot_x The x of the default pivot point
+ @param pivot_y The y of the default pivot point
+ @param frameSpeed The default frame speed
+ @return The new AE_SpriteDef with one reference held by the caller, or NULL if it couldn't be created
+ */
+AE_SpriteDef* AE_CreateSpriteDef(AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y, float frameSpeed)
+{
+    AE_SpriteDef* output = AE_SpriteDef_Allocate(spriteSheet);
+    if (output != NULL)
+    {
+        AE_SpriteDef_SetFrames(output, frameCount, reference_x, reference_y, width, height, AE_SPRITE_KEEP_NONE);
+        output->pivot.x = pivot_x;
+        output->pivot.y = pivot_y;
+        output->frameSpeed = frameSpeed;
+    }
+    return output;
+}
+
+/**
+ Creates a new AE_SpriteDef whose frames start at the origin of an atlas region
+
+ @param region The AE_AtlasRegion the frames will be taken from, whose page will be used as the sprite sheet
+ @param frameCount The number of frames in the definition
+ @param width The width of a single frame, or 0 to split the region's width evenly between the frames
+ @param height The height of a single frame, or 0 to use the region's height
+ @param pivot_x The x of the default pivot point
+ @param pivot_y The y of the default pivot point
+ @param frameSpeed The default frame speed
+ @return The new AE_SpriteDef with one reference held by the caller, or NULL if the region was never packed
+ */
+AE_SpriteDef* AE_CreateSpriteDefFromRegion(AE_AtlasRegion* region, int frameCount, int width, int height, int pivot_x, int pivot_y, float frameSpeed)
+{
+    if (region == NULL || region->page == NULL || frameCount <= 0)
+    {
+        return NULL;
+    }
+    
+    //Default to frames laid out along the region
+    if (width <= 0)
+    {
+        width = region->rect.w / frameCount;
+    }
+    if (height <= 0)
+    {
+        height = region->rect.h;
+    }
+    
+    return AE_CreateSpriteDef(region->page, region->rect.x, region->rect.y, frameCount, width, height, pivot_x, pivot_y, frameSpeed);
+}
+
+/**
+ Adds a reference to an AE_SpriteDef. Safe to call from any thread
+
+ @param definition The AE_SpriteDef that will be referenced
+ */
+void AE_SpriteDef_Retain(AE_SpriteDef* definition)
+{
+    SDL_AtomicIncRef(&definition->references);
+}
+
+/**
+ Removes a reference from an AE_SpriteDef, destroying it once nothing references it. Safe to call from any thread
+
+ @param definition The AE_SpriteDef that will no longer be referenced
+ @return Whether the AE_SpriteDef was destroyed or not
+ */
+SDL_bool AE_SpriteDef_Release(AE_SpriteDef* definition)
+{
+    if (!SDL_AtomicDecRef(&definition->references))
+    {
+        return SDL_FALSE;
+    }
+    
+    if (definition->spriteSheet != NULL)
+    {
+        AE_LinkedTexture_Leave(definition->spriteSheet, definition);
+    }
+    SDL_free(definition->frames);
+    AE_ReleaseObject(AE_OBJECT_SPRITEDEF, definition);
+    return SDL_TRUE;
+}
+
+/**
+ Gets the number of sprites and owners referencing an AE_SpriteDef
+
+ @param definition The AE_SpriteDef whose reference count will be retrieved
+ @return The number of references to the AE_SpriteDef
+ */
+int AE_SpriteDef_GetReferenceCount(AE_SpriteDef* definition)
+{
+    return SDL_AtomicGet(&definition->references);
+}
+
+/**
+ Creates a new AE_Sprite that shares an AE_SpriteDef
+
+ @param definition The AE_SpriteDef the sprite will be drawn from
+ @return The initialized AE_Sprite, with its pivot and frame speed taken from the definition and all other parameters set to default
+ */
+AE_Sprite* AE_CreateSpriteFromDef(AE_SpriteDef* definition)
+{
+    if (definition == NULL)
+    {
+        return NULL;
+    }
+    
+    AE_Sprite* output = AE_AllocateObject(AE_OBJECT_SPRITE, sizeof(AE_Sprite));
+    if (output != NULL)
+    {
+        AE_FillSpriteFromDef(output, definition);
+    }
+    return output;
+}
+
+/**
+ Guts out and fills a sprite so it shares an AE_SpriteDef, for sprites stored by value
+
+ @param sprite The sprite that will be filled
+ @param definition The AE_SpriteDef the sprite will be drawn from
+ @return Whether the sprite was filled or not (SDL_FALSE if definition is NULL, in which case the sprite is zeroed)
+ */
+SDL_bool AE_FillSpriteFromDef(AE_Sprite* sprite, AE_SpriteDef* definition)
+{
+    if (definition == NULL)
+    {
+        //Zeroed, the sprite has no definition for the render paths to draw from
+        SDL_zerop(sprite);
+        return SDL_FALSE;
+    }
+    sprite->definition = definition;
+    AE_SpriteDef_Retain(definition);
+    
+    sprite->currentFrame = 0;
+    AE_SpriteSetFrameSpeed(sprite, definition->frameSpeed);
+    sprite->pivot = definition->pivot;
+    
+    AE_SpriteSetAngle(sprite, 0.0);
+    AE_SpriteSetFlip(sprite, SDL_FLIP_NONE);
+    
+    sprite->drawRect.x = 0;
+    sprite->drawRect.y = 0;
+    AE_SpriteSetScale(sprite, 1, 1, AE_SPRITE_DEFAULT);
+    
+    AE_SpriteSetColor(sprite, NULL, AE_SPRITE_DEFAULT);
+    AE_SpriteSetAlpha(sprite, 255);
+    return SDL_TRUE;
+}
+
+/**
+ Switches the AE_SpriteDef a sprite is drawn from, restarting its animation with the new definition's pivot and frame speed
+
+ @param sprite The sprite whose definition will be switched
+ @param definition The AE_SpriteDef the sprite will be drawn from
+ */
+void AE_SpriteSetDef(AE_Sprite* sprite, AE_SpriteDef* definition)
+{
+    //Retain before releasing, so switching to the same definition can't destroy it
+    AE_SpriteDef_Retain(definition);
+    if (sprite->definition != NULL)
+    {
+        AE_SpriteDef_Release(sprite->definition);
+    }
+    sprite->definition = definition;
+    
+    sprite->currentFrame = 0;
+    sprite->frameSpeed = definition->frameSpeed;
+    sprite->pivot = definition->pivot;
+    
+    //Keep the sprite's scale on the new frame size
+    AE_SpriteSetScale(sprite, sprite->x_scale, sprite->y_scale, AE_SPRITE_KEEP_NONE);
+}
+
+/**
+ Gets the AE_SpriteDef a sprite is drawn from
+
+ @param sprite The sprite whose definition will be retrieved
+ @return The AE_SpriteDef of the sprite
+ */
+AE_SpriteDef* AE_SpriteGetDef(AE_Sprite* sprite)
+{
+    return sprite->definition;
+}
+
+/**
+ Sets the current pivot
+
+ @param sprite The sprite whose pivot will be set
+ @param pivot_x The x of the new pivot
+ @param pivot_y The y of the new pivot
+ @param dataToKeep Which pivot point attributes will be overwritten: x, y, both, or sets the pivot to the default position (centerpoint)
+ */
+void AE_SpriteSetPivot(AE_Sprite* sprite, int pivot_x, int pivot_y, int dataToKeep)
+{
+    //If you're not keeping the original pivot x, set the pivot x to the given x
+    if (dataToKeep != AE_SPRITE_KEEP_X && dataToKeep != AE_SPRITE_DEFAULT)
+    {
+        sprite->pivot.x = pivot_x;
+    }
+    //If you're not keeping the original pivot y, set the pivot y to the given y
+    if (dataToKeep != AE_SPRITE_KEEP_Y && dataToKeep != AE_SPRITE_DEFAULT)
+    {
+        sprite->pivot.y = pivot_y;
+    }
+    //If you're setting the pivot point to the centerpoint, do that
+    if (dataToKeep == AE_SPRITE_DEFAULT)
+    {
+        sprite->pivot.x = sprite->definition->width/2;
+        sprite->pivot.y = sprite->definition->height/2;
+    }
+}
+
+/**
+ Sets the sprite angle
+
+ @param sprite The sprite whose angle will be set
+ @param angle The angle of the sprite
+ */
+void AE_SpriteSetAngle(AE_Sprite* sprite, double angle)
+{
+    sprite->angle = angle;
+}
+
+/**
+ Sets the rendererflip of the sprite
+
+ @param sprite The sprite whose rendererflip will be set
+ @param flip The desired rendererflip type
+ */
+void AE_SpriteSetFlip(AE_Sprite* sprite, SDL_RendererFlip flip)
+{
+    sprite->flip = flip;
+}
+
+/**
+ Sets the sprite scale
+
+ @param sprite The sprite whose scale will be set
+ @param x_scale The new scale on the x axis
+ @param y_scale The new scale on the y axis
+ @param dataToKeep Which scale attributes will be overwritten: x scale, y scale, both, or sets the both scales to the default size (1)
+ */
+void AE_SpriteSetScale(AE_Sprite* sprite, float x_scale, float y_scale, int dataToKeep)
+{
+    //Set a drawRect pointer to the sprite's drawRect for less dereferencing
+    SDL_Rect* drawRect = &sprite->drawRect;
+    //If you're setting the scales to default, set both scales to 1
+    if (dataToKeep == AE_SPRITE_DEFAULT)
+    {
+        sprite->x_scale = sprite->y_scale = 1;
+        
+        //Set the drawRect width and height to 1
+        drawRect->w = sprite->definition->width;
+        drawRect->h = sprite->definition->height;
+    }
+    else
+    {
+        //If you're not keeping it, set the x_scale
+        if (dataToKeep != AE_SPRITE_KEEP_X)
+        {
+            sprite->x_scale = x_scale;
+            
+            //If the sprite has a preexisting drawRect to render to, adjust it
+            if (drawRect != NULL)
+            {
+                drawRect->w =(int)(((float)sprite->definition->width) * sprite->x_scale);
+            }
+        }
+        //If you're not keeping it, set the y_scale
+        if (dataToKeep != AE_SPRITE_KEEP_Y)
+        {
+            sprite->y_scale = y_scale;
+            
+            //If the sprite has a preexisting drawRect to render to, adjust it
+            if (drawRect != NULL)
+            {
+                drawRect->h =(int)(((float)sprite->definition->height) * sprite->y_scale);
+            }
+        }
+    }
+}
+
+/**
+ Gets the current loop frame of the sprite
+
+ @param sprite The sprite whose frame will be retrieved
+ @return The current loop frame
+ */
+int AE_SpriteGetSavedFrame(AE_Sprite* sprite)
+{
+    return sprite->currentFrame;
+}
+
+//
+//Sets the current loop frame of the sprite
+//return: void
+//
+
+/**
+ Sets the current loop frame of the sprite
+
+ @param sprite The sprite whose current loop frame will be set
+ @param desiredFrame The frame the loop will be set to
+ */
+void AE_SpriteSetSavedFrame(AE_Sprite* sprite, int desiredFrame)
+{
+    //If the desired frame is bigger than the amount of frames in the sprite, set the current frame to the final frame
+    if (desiredFrame >= sprite->definition->frameCount)
+    {
+        sprite->currentFrame = sprite->definition->frameCount - 1;
+    }
+    //If the desired frame is less than 0, set the sprite frame to 0
+    else if (desiredFrame < 0)
+    {
+        sprite->currentFrame = 0;
+    }
+    else
+    //If the frame is within the frame count, set the frame to the desired frame
+    {
+        sprite->currentFrame = desiredFrame;
+    }
+}
+
+//
+//Sets the frame speed of the sprite
+//return: void
+//
+
+/**
+ Sets the frame speed of the sprite
+
+ @param sprite The sprite whose frame speed will be set
+ @param frameSpeed The speed the sprite will be set to
+ */
+void AE_SpriteSetFrameSpeed(AE_Sprite* sprite, float frameSpeed)
+{
+    sprite->frameSpeed = frameSpeed;
+}
+
+/**
+ Sets the color of the sprite
+
+ @param sprite The AE_Sprite whose color will be set
+ @param color The color the AE_Sprite will be set to
+ @param dataToKeep Which preexisting color values to keep (red, green, blue) or set the color values to default color white
+ */
+void AE_SpriteSetColor(AE_Sprite* sprite, AE_ColorBundle* color, int dataToKeep)
+{
+	if (dataToKeep == AE_SPRITE_DEFAULT)
+    {
+        sprite->color.r = 255;
+        sprite->color.g = 255;
+        sprite->color.b = 255;
+    }
+    if (dataToKeep != AE_SPRITE_KEEP_R && dataToKeep != AE_SPRITE_DEFAULT && color != NULL)
+    {
+        sprite->color.r = color->r;
+    }
+    if (dataToKeep != AE_SPRITE_KEEP_G && dataToKeep != AE_SPRITE_DEFAULT && color != NULL)
+    {
+        sprite->color.g = color->g;
+    }
+    if (dataToKeep != AE_SPRITE_KEEP_B && dataToKeep != AE_SPRITE_DEFAULT && color != NULL)
+    {
+        sprite->color.b = color->b;
+    }
+}
+
+/**
+ Gets the color modulation of a sprite in a newly allocated AE_ColorBundle, which the caller frees with SDL_free. AE_SpriteGetColorValue gets the same colors without allocating
+
+ @param sprite The AE_Sprite whose color will be retrieved
+ @return A pointer to an AE_ColorBundle containing the colors of the AE_Sprite
+ */
+AE_ColorBundle* AE_SpriteGetColor(AE_Sprite* sprite)
+{
+    //Create a new AE_ColorBundle and fill with the given sprite's colors
+    AE_ColorBundle* output = SDL_malloc(sizeof(AE_ColorBundle));
+    output->r = sprite->color.r;
+    output->g = sprite->color.g;
+    output->b = sprite->color.b;
+    return output;
+}
+
+/**
+ Gets the color modulation of a sprite by value
+
+ @param sprite The AE_Sprite whose color will be retrieved
+ @return An AE_ColorBundle containing the colors of the AE_Sprite
+ */
+AE_ColorBundle AE_SpriteGetColorValue(AE_Sprite* sprite)
+{
+    AE_ColorBundle output;
+    output.r = sprite->color.r;
+    output.g = sprite->color.g;
+    output.b = sprite->color.b;
+    return output;
+}
+
+/**
+ Sets the color of the sprite
+ 
+ @param sprite The AE_Sprite whose alpha will be set
+ @param alpha The alpha the AE_Sprite will be set to
+ */
+void AE_SpriteSetAlpha(AE_Sprite* sprite, Uint8 alpha)
+{
+    sprite->alpha = alpha;
+}
+
+/**
+ Gets the alpha modulation of a sprite
+ 
+ @param sprite The AE_Sprite whose alpha will be retrieved
+ @return The alpha modulation of the sprite
+ */
+Uint8 AE_SpriteGetAlpha(AE_Sprite* sprite)
+{
+    return sprite->alpha;
+}
+
+/**
+ Resolves the frame of a sprite that will be drawn (wrapping the sprite's animation loop the same way for every render path) and moves the sprite's drawRect to the given coordinates
+
+ @param sprite The sprite whose frame will be resolved
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @return The frame on the sprite sheet to be drawn, or NULL for the whole sprite sheet
+ */
+static SDL_Rect* AE_SpritePrepareFrame(AE_Sprite* sprite, int x, int y, int currentFrame)
+{
+    AE_SpriteDef* definition = sprite->definition;
+    int drawFrame = currentFrame;
+    
+    //If currentFrame is less than 0, loop through the spritesheet (sets the sprite's currentFrame along with it)
+    if (currentFrame < 0)
+    {
+        //A single frame sprite has nothing to loop through
+        if (definition->frameCount <= 1)
+        {
+            drawFrame = 0;
+        }
+        else
+        {
+            if (sprite->currentFrame >= (float)(definition->frameCount))
+            {
+                sprite->currentFrame = fmodf(sprite->currentFrame,(float)(definition->frameCount - 1));
+            }
+            drawFrame = fmodf(sprite->currentFrame,(float)(definition->frameCount - 1));
+        }
+    }
+    //If the currentFrame is larger than the number of frames the sprite has, go to the last frame of the animation, and reset the sprite's currentFrame for the next time it loops
+    else if (currentFrame >= definition->frameCount)
+    {
+        drawFrame = definition->frameCount-1;
+        sprite->currentFrame = 0;
+    }
+    //Reset the sprite's currentFrame for the next time it loops
+    else
+    {
+        sprite->currentFrame = 0;
+    }
+    sprite->drawRect.x = x;
+    sprite->drawRect.y = y;
+    
+    //A sprite without frames is drawn from the whole sprite sheet
+    return (definition->frames != NULL) ? &definition->frames[drawFrame] : NULL;
+}
+
+/**
+ Renders the sprite on the given renderer, skipping the copy if the sprite is entirely outside the renderer's viewport
+
+ @param sprite The sprite to be rendered
+ @param renderer The renderer the sprite will be rendered on
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was successfully rendered or not
+ */
+SDL_bool AE_SpriteRender(AE_Sprite* sprite, SDL_Renderer* renderer, int x, int y, int currentFrame, float step)
+{
+    SDL_bool success = SDL_FALSE;
+    //A sprite whose fill failed has no definition, and so nothing to draw
+    AE_LinkedTexture* spriteSheet = (sprite->definition != NULL) ? sprite->definition->spriteSheet : NULL;
+    AE_PROFILE_BEGIN("AE_SpriteRender");
+    if (spriteSheet != NULL)
+    {
+        SDL_Rect* frame = AE_SpritePrepareFrame(sprite, x, y, currentFrame);
+        SDL_Rect viewport;
+        SDL_Rect bounds;
+        
+        //Drawing coordinates are relative to the viewport, so only its size matters
+        SDL_RenderGetViewport(renderer, &viewport);
+        viewport.x = 0;
+        viewport.y = 0;
+        AE_GetRotatedBounds(&sprite->drawRect, sprite->angle, &sprite->pivot, &bounds);
+        
+        //A sprite sheet that is still loading has nothing to draw yet
+        if (spriteSheet->texture == NULL)
+        {
+            success = SDL_FALSE;
+        }
+        //A sprite that can't be seen counts as rendered, it just skips the copy
+        else if (!SDL_HasIntersection(&bounds, &viewport))
+        {
+            success = SDL_TRUE;
+        }
+        else
+        {
+            AE_SetTextureModulation(renderer, spriteSheet->texture, sprite->color, sprite->alpha);
+            
+            if (SDL_RenderCopyEx(renderer, spriteSheet->texture, frame, &sprite->drawRect, sprite->angle, &sprite->pivot, sprite->flip) == 0)
+            {
+                success = SDL_TRUE;
+            }
+        }
+        sprite->currentFrame += ((sprite->frameSpeed/2)*step);
+    }
+    AE_PROFILE_END();
+    return success;
+}
+
+/**
+ Frees and destroys an AE_Sprite, releasing its reference to its AE_SpriteDef
+
+ @param sprite The sprite to be destroyed
+ */
+void AE_DestroySprite(AE_Sprite* sprite)
+{
+    if (sprite->definition != NULL)
+    {
+        AE_SpriteDef_Release(sprite->definition);
+    }
+    AE_ReleaseObject(AE_OBJECT_SPRITE, sprite);
+    sprite = NULL;
+}
+
+//
+//
+//End: Sprites and Sprite Functions
+//
+//
+
+
+//
+//
+//Start: Sprite Batch Functions
+//
+//
+
+/**
+ Creates a new AE_SpriteBatch for a renderer
+
+ @param renderer The renderer the batch will draw to
+ @param spriteCapacity The number of sprites the batch will have room for before it needs to grow (0 or less for the default)
+ @return The new AE_SpriteBatch
+ */
+AE_SpriteBatch* AE_CreateSpriteBatch(SDL_Renderer* renderer, int spriteCapacity)
+{
+    AE_SpriteBatch* output = SDL_malloc(sizeof(AE_SpriteBatch));
+    SDL_RendererInfo info;
+    
+    //Default to room for 1024 sprites
+    if (spriteCapacity <= 0)
+    {
+        spriteCapacity = 1024;
+    }
+    
+    output->renderer = renderer;
+    
+    //The software renderer rasterizes rotated copies differently than rotated geometry, so it needs to be known for pixel-identical output
+    output->softwareRenderer = SDL_FALSE;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE))
+    {
+        output->softwareRenderer = SDL_TRUE;
+    }
+    
+    output->spriteSheet = NULL;
+    output->sheetWidth = 0;
+    output->sheetHeight = 0;
+    
+    //Every sprite is a quad of 4 vertices and 2 triangles
+    output->vertexCapacity = spriteCapacity * 4;
+    output->vertices = SDL_malloc(sizeof(SDL_Vertex) * output->vertexCapacity);
+    output->vertexCount = 0;
+    output->indexCapacity = spriteCapacity * 6;
+    output->indices = SDL_malloc(sizeof(int) * output->indexCapacity);
+    output->indexCount = 0;
+    
+    output->spriteCount = 0;
+    output->drawCalls = 0;
+    
+    return output;
+}
+
+/**
+ Begins a new frame of batched sprites, discarding anything unflushed and resetting the batch statistics
+
+ @param batch The AE_SpriteBatch to begin
+ */
+void AE_SpriteBatch_Begin(AE_SpriteBatch* batch)
+{
+    batch->spriteSheet = NULL;
+    batch->vertexCount = 0;
+    batch->indexCount = 0;
+    batch->spriteCount = 0;
+    batch->drawCalls = 0;
+}
+
+/**
+ Makes sure a batch has room for one more quad
+
+ @param batch The AE_SpriteBatch that will be grown
+ @return Whether the batch has room for another quad or not
+ */
+static SDL_bool AE_SpriteBatch_Reserve(AE_SpriteBatch* batch)
+{
+    //Double the vertex array when it runs out of room
+    if (batch->vertexCount + 4 > batch->vertexCapacity)
+    {
+        int newCapacity = batch->vertexCapacity * 2;
+        SDL_Vertex* newVertices = SDL_realloc(batch->vertices, sizeof(SDL_Vertex) * newCapacity);
+        if (newVertices == NULL)
+        {
+            return SDL_FALSE;
+        }
+        batch->vertices = newVertices;
+        batch->vertexCapacity = newCapacity;
+    }
+    //Double the index array when it runs out of room
+    if (batch->indexCount + 6 > batch->indexCapacity)
+    {
+        int newCapacity = batch->indexCapacity * 2;
+        int* newIndices = SDL_realloc(batch->indices, sizeof(int) * newCapacity);
+        if (newIndices == NULL)
+        {
+            return SDL_FALSE;
+        }
+        batch->indices = newIndices;
+        batch->indexCapacity = newCapacity;
+    }
+    return SDL_TRUE;
+}
+
+/**
+ Adds a sprite quad to a batch, using the same inputs as AE_SpriteRender. If the quad uses a different sprite sheet than the current run, the current run is flushed first
+
+ @param batch The AE_SpriteBatch the quad will be added to
+ @param spriteSheet The LinkedTexture the quad will be drawn from
+ @param frame The rect on the sprite sheet to be drawn (NULL for the whole sheet)
+ @param drawRect The rect on the renderer the quad will be drawn to
+ @param angle The angle of the quad in degrees
+ @param pivot The point the quad will be rotated around, relative to the drawRect (NULL for the center of the drawRect)
+ @param flip The rendererflip of the quad
+ @param color The color modulation of the quad
+ @param alpha The alpha modulation of the quad
+ @return Whether the quad was added to the batch or not
+ */
+SDL_bool AE_SpriteBatch_Submit(AE_SpriteBatch* batch, AE_LinkedTexture* spriteSheet, const SDL_Rect* frame, const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_RendererFlip flip, AE_ColorBundle color, Uint8 alpha)
+{
+    SDL_bool success = SDL_TRUE;
+    
+    if (spriteSheet == NULL || spriteSheet->texture == NULL || drawRect == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    batch->spriteCount++;
+    
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    //The software renderer rotates and flips copies with its own rasterizer, so those sprites are drawn on their own to stay pixel-identical
+    if (batch->softwareRenderer && (angle != 0.0 || flip != SDL_FLIP_NONE))
+#endif
+    {
+        //Keep the draw order by flushing whatever was queued before this sprite
+        success = AE_SpriteBatch_Flush(batch);
+        
+        AE_SetTextureModulation(batch->renderer, spriteSheet->texture, color, alpha);
+        if (SDL_RenderCopyEx(batch->renderer, spriteSheet->texture, frame, drawRect, angle, pivot, flip) != 0)
+        {
+            success = SDL_FALSE;
+        }
+        batch->drawCalls++;
+        return success;
+    }
+    
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    //If the sprite uses a different sprite sheet, the current run is finished
+    if (spriteSheet != batch->spriteSheet)
+    {
+        success = AE_SpriteBatch_Flush(batch);
+        batch->spriteSheet = spriteSheet;
+        batch->sheetWidth = (float)AE_LinkedTexture_GetWidth(spriteSheet);
+        batch->sheetHeight = (float)AE_LinkedTexture_GetHeight(spriteSheet);
+    }
+    
+    if (!AE_SpriteBatch_Reserve(batch))
+    {
+        return SDL_FALSE;
+    }
+    
+    //Find the texture coordinates of the frame
+    float minu = 0.0f;
+    float minv = 0.0f;
+    float maxu = 1.0f;
+    float maxv = 1.0f;
+    if (frame != NULL)
+    {
+        minu = (float)frame->x / batch->sheetWidth;
+        minv = (float)frame->y / batch->sheetHeight;
+        maxu = (float)(frame->x + frame->w) / batch->sheetWidth;
+        maxv = (float)(frame->y + frame->h) / batch->sheetHeight;
+    }
+    
+    //Find the point the quad rotates around, defaulting to the center of the drawRect
+    float centerx;
+    float centery;
+    if (pivot != NULL)
+    {
+        centerx = (float)pivot->x + (float)drawRect->x;
+        centery = (float)pivot->y + (float)drawRect->y;
+    }
+    else
+    {
+        centerx = (float)drawRect->w / 2.0f + (float)drawRect->x;
+        centery = (float)drawRect->h / 2.0f + (float)drawRect->y;
+    }
+    
+    //Flipping swaps the edges of the quad, the same way SDL_RenderCopyEx does
+    float minx = (float)drawRect->x;
+    float maxx = (float)(drawRect->x + drawRect->w);
+    float miny = (float)drawRect->y;
+    float maxy = (float)(drawRect->y + drawRect->h);
+    if (flip & SDL_FLIP_HORIZONTAL)
+    {
+        minx = (float)(drawRect->x + drawRect->w);
+        maxx = (float)drawRect->x;
+    }
+    if (flip & SDL_FLIP_VERTICAL)
+    {
+        miny = (float)(drawRect->y + drawRect->h);
+        maxy = (float)drawRect->y;
+    }
+    
+    //Rotate the corners around the center with the same math SDL_RenderCopyEx uses
+    const float radian_angle = (float)((M_PI * angle) / 180.0);
+    const float s = SDL_sinf(radian_angle);
+    const float c = SDL_cosf(radian_angle);
+    const float s_minx = s * (minx - centerx);
+    const float s_miny = s * (miny - centery);
+    const float s_maxx = s * (maxx - centerx);
+    const float s_maxy = s * (maxy - centery);
+    const float c_minx = c * (minx - centerx);
+    const float c_miny = c * (miny - centery);
+    const float c_maxx = c * (maxx - centerx);
+    const float c_maxy = c * (maxy - centery);
+    
+    SDL_Vertex* vertex = &batch->vertices[batch->vertexCount];
+    SDL_Color vertexColor = {color.r, color.g, color.b, alpha};
+    
+    //(minx, miny)
+    vertex[0].position.x = (c_minx - s_miny) + centerx;
+    vertex[0].position.y = (s_minx + c_miny) + centery;
+    vertex[0].tex_coord.x = minu;
+    vertex[0].tex_coord.y = minv;
+    //(maxx, miny)
+    vertex[1].position.x = (c_maxx - s_miny) + centerx;
+    vertex[1].position.y = (s_maxx + c_miny) + centery;
+    vertex[1].tex_coord.x = maxu;
+    vertex[1].tex_coord.y = minv;
+    //(maxx, maxy)
+    vertex[2].position.x = (c_maxx - s_maxy) + centerx;
+    vertex[2].position.y = (s_maxx + c_maxy) + centery;
+    vertex[2].tex_coord.x = maxu;
+    vertex[2].tex_coord.y = maxv;
+    //(minx, maxy)
+    vertex[3].position.x = (c_minx - s_maxy) + centerx;
+    vertex[3].position.y = (s_minx + c_maxy) + centery;
+    vertex[3].tex_coord.x = minu;
+    vertex[3].tex_coord.y = maxv;
+    
+    for (int i = 0; i<4; i++)
+    {
+        vertex[i].color = vertexColor;
+    }
+    
+    //Two triangles per quad
+    int* index = &batch->indices[batch->indexCount];
+    index[0] = batch->vertexCount;
+    index[1] = batch->vertexCount + 1;
+    index[2] = batch->vertexCount + 2;
+    index[3] = batch->vertexCount;
+    index[4] = batch->vertexCount + 2;
+    index[5] = batch->vertexCount + 3;
+    
+    batch->vertexCount += 4;
+    batch->indexCount += 6;
+    
+    return success;
+#endif
+}
+
+/**
+ Adds an AE_Sprite to a batch, animating it exactly as AE_SpriteRender would
+
+ @param batch The AE_SpriteBatch the sprite will be added to
+ @param sprite The sprite to be added
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was added to the batch or not
+ */
+SDL_bool AE_SpriteBatch_SubmitSprite(AE_SpriteBatch* batch, AE_Sprite* sprite, int x, int y, int currentFrame, float step)
+{
+    SDL_bool success = SDL_FALSE;
+    if (sprite->definition != NULL && sprite->definition->spriteSheet != NULL)
+    {
+        SDL_Rect* frame = AE_SpritePrepareFrame(sprite, x, y, currentFrame);
+        
+        success = AE_SpriteBatch_Submit(batch, sprite->definition->spriteSheet, frame, &sprite->drawRect, sprite->angle, &sprite->pivot, sprite->flip, sprite->color, sprite->alpha);
+        
+        sprite->currentFrame += ((sprite->frameSpeed/2)*step);
+    }
+    return success;
+}
+
+/**
+ Draws the current run of quads in a batch with a single geometry draw
+
+ @param batch The AE_SpriteBatch to be flushed
+ @return Whether the run was drawn successfully or not
+ */
+SDL_bool AE_SpriteBatch_Flush(AE_SpriteBatch* batch)
+{
+    SDL_bool success = SDL_TRUE;
+    
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (batch->indexCount > 0 && batch->spriteSheet != NULL)
+    {
+        //Vertex colors carry the modulation, so the texture's own modulation has to be neutral
+        AE_ColorBundle neutral = {255, 255, 255};
+        AE_SetTextureModulation(batch->renderer, batch->spriteSheet->texture, neutral, 255);
+        
+        if (SDL_RenderGeometry(batch->renderer, batch->spriteSheet->texture, batch->vertices, batch->vertexCount, batch->indices, batch->indexCount) != 0)
+        {
+            success = SDL_FALSE;
+        }
+        batch->drawCalls++;
+    }
+#endif
+    
+    batch->vertexCount = 0;
+    batch->indexCount = 0;
+    
+    return success;
+}
+
+/**
+ Ends a frame of batched sprites, flushing anything left in the batch
+
+ @param batch The AE_SpriteBatch to end
+ @return Whether the remaining quads were drawn successfully or not
+ */
+SDL_bool AE_SpriteBatch_End(AE_SpriteBatch* batch)
+{
+    SDL_bool success = AE_SpriteBatch_Flush(batch);
+    batch->spriteSheet = NULL;
+    return success;
+}
+
+/**
+ Gets the number of draw calls a batch has issued since it last began
+
+ @param batch The AE_SpriteBatch whose draw calls will be retrieved
+ @return The number of draw calls issued
+ */
+int AE_SpriteBatch_GetDrawCalls(AE_SpriteBatch* batch)
+{
+    return batch->drawCalls;
+}
+
+/**
+ Gets the number of sprites submitted to a batch since it last began
+
+ @param batch The AE_SpriteBatch whose sprite count will be retrieved
+ @return The number of sprites submitted
+ */
+int AE_SpriteBatch_GetSpriteCount(AE_SpriteBatch* batch)
+{
+    return batch->spriteCount;
+}
+
+/**
+ Frees and destroys an AE_SpriteBatch (without flushing it)
+
+ @param batch The AE_SpriteBatch to be destroyed
+ */
+void AE_DestroySpriteBatch(AE_SpriteBatch* batch)
+{
+    if (batch != NULL)
+    {
+        SDL_free(batch->vertices);
+        SDL_free(batch->indices);
+        SDL_free(batch);
+    }
+}
+
+//
+//
+//End: Sprite Batch Functions
+//
+//
+
+
+//
+//
+//Start: Render Queue Functions
+//
+//
+
+/**
+ Packs the sort key of a draw. From most to least significant: 8 bits of layer, 16 bits of depth, 4 bits of blend mode, 24 bits of sprite sheet id and 12 bits of modulation
+
+ @param layer The layer of the draw (lower layers are drawn first)
+ @param depth The depth of the draw within its layer (lower depths are drawn first)
+ @param spriteSheet The LinkedTexture the draw uses
+ @param blendMode The blend mode of the draw (SDL_BLENDMODE_INVALID to leave the texture's blend mode as it is)
+ @param color The color modulation of the draw
+ @param alpha The alpha modulation of the draw
+ @return The sort key
+ */
+Uint64 AE_RenderQueue_MakeKey(Uint8 layer, Uint16 depth, AE_LinkedTexture* spriteSheet, SDL_BlendMode blendMode, AE_ColorBundle color, Uint8 alpha)
+{
+    Uint64 blendBits;
+    
+    //Give each blend mode a small number so it fits in 4 bits
+    switch (blendMode)
+    {
+        case SDL_BLENDMODE_NONE:
+            blendBits = 0;
+            break;
+        case SDL_BLENDMODE_BLEND:
+            blendBits = 1;
+            break;
+        case SDL_BLENDMODE_ADD:
+            blendBits = 2;
+            break;
+        case SDL_BLENDMODE_MOD:
+            blendBits = 3;
+            break;
+        case SDL_BLENDMODE_INVALID:
+            blendBits = 15;
+            break;
+        default:
+            blendBits = 14;
+            break;
+    }
+    
+    //The top 3 bits of each color and alpha channel group draws with the same modulation together
+    Uint64 modBits = ((Uint64)(color.r >> 5) << 9) | ((Uint64)(color.g >> 5) << 6) | ((Uint64)(color.b >> 5) << 3) | (Uint64)(alpha >> 5);
+    Uint64 sheetBits = (spriteSheet != NULL) ? (spriteSheet->id & 0xFFFFFF) : 0;
+    
+    return ((Uint64)layer << 56) | ((Uint64)depth << 40) | (blendBits << 36) | (sheetBits << 12) | modBits;
+}
+
+/**
+ Creates a new, empty AE_RenderQueue
+
+ @param commandCapacity The number of draws the queue will have room for before it needs to grow (0 or less for the default)
+ @param stableSort Whether draws with equal keys keep the order they were submitted in
+ @return The new AE_RenderQueue
+ */
+AE_RenderQueue* AE_CreateRenderQueue(int commandCapacity, SDL_bool stableSort)
+{
+    AE_RenderQueue* output = SDL_malloc(sizeof(AE_RenderQueue));
+    
+    //Default to room for 1024 draws
+    if (commandCapacity <= 0)
+    {
+        commandCapacity = 1024;
+    }
+    
+    output->capacity = commandCapacity;
+    output->commands = SDL_malloc(sizeof(AE_RenderCommand) * commandCapacity);
+    output->count = 0;
+    
+    //The sort buffers are only allocated once the queue is first sorted
+    output->keys = NULL;
+    output->order = NULL;
+    output->scratchKeys = NULL;
+    output->scratchOrder = NULL;
+    output->sortCapacity = 0;
+    
+    output->stableSort = stableSort;
+    output->textureSwitches = 0;
+    
+    return output;
+}
+
+/**
+ Sets whether a queue keeps draws with equal keys in the order they were submitted in. The unstable sort needs no scratch memory
+
+ @param queue The AE_RenderQueue whose sort mode will be set
+ @param stableSort Whether draws with equal keys keep their submission order
+ */
+void AE_RenderQueue_SetStableSort(AE_RenderQueue* queue, SDL_bool stableSort)
+{
+    queue->stableSort = stableSort;
+}
+
+/**
+ Adds a draw to a queue
+
+ @param queue The AE_RenderQueue the draw will be added to
+ @param layer The layer of the draw (lower layers are drawn first)
+ @param depth The depth of the draw within its layer (lower depths are drawn first)
+ @param spriteSheet The LinkedTexture the draw uses
+ @param frame The rect on the sprite sheet to be drawn (NULL for the whole sheet)
+ @param drawRect The rect on the renderer the sprite sheet will be drawn to
+ @param angle The angle of the draw in degrees
+ @param pivot The point the draw will be rotated around, relative to the drawRect (NULL for the center of the drawRect)
+ @param flip The rendererflip of the draw
+ @param color The color modulation of the draw
+ @param alpha The alpha modulation of the draw
+ @param blendMode The blend mode of the draw (SDL_BLENDMODE_INVALID to leave the texture's blend mode as it is)
+ @return Whether the draw was added to the queue or not
+ */
+SDL_bool AE_RenderQueue_Submit(AE_RenderQueue* queue, Uint8 layer, Uint16 depth, AE_LinkedTexture* spriteSheet, const SDL_Rect* frame, const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_RendererFlip flip, AE_ColorBundle color, Uint8 alpha, SDL_BlendMode blendMode)
+{
+    if (spriteSheet == NULL || drawRect == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Double the command array when it runs out of room
+    if (queue->count == queue->capacity)
+    {
+        AE_RenderCommand* newCommands = SDL_realloc(queue->commands, sizeof(AE_RenderCommand) * queue->capacity * 2);
+        if (newCommands == NULL)
+        {
+            return SDL_FALSE;
+        }
+        queue->commands = newCommands;
+        queue->capacity *= 2;
+    }
+    
+    AE_RenderCommand* command = &queue->commands[queue->count++];
+    
+    command->key = AE_RenderQueue_MakeKey(layer, depth, spriteSheet, blendMode, color, alpha);
+    command->spriteSheet = spriteSheet;
+    command->wholeSheet = (frame == NULL);
+    if (frame != NULL)
+    {
+        command->frame = *frame;
+    }
+    command->drawRect = *drawRect;
+    command->angle = angle;
+    command->centerPivot = (pivot == NULL);
+    if (pivot != NULL)
+    {
+        command->pivot = *pivot;
+    }
+    command->flip = flip;
+    command->color = color;
+    command->alpha = alpha;
+    command->blendMode = blendMode;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Adds an AE_Sprite to a queue, animating it exactly as AE_SpriteRender would
+
+ @param queue The AE_RenderQueue the sprite will be added to
+ @param sprite The sprite to be added
+ @param layer The layer of the sprite (lower layers are drawn first)
+ @param depth The depth of the sprite within its layer (lower depths are drawn first)
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was added to the queue or not
+ */
+SDL_bool AE_RenderQueue_SubmitSprite(AE_RenderQueue* queue, AE_Sprite* sprite, Uint8 layer, Uint16 depth, int x, int y, int currentFrame, float step)
+{
+    SDL_bool success = SDL_FALSE;
+    if (sprite->definition != NULL && sprite->definition->spriteSheet != NULL)
+    {
+        SDL_Rect* frame = AE_SpritePrepareFrame(sprite, x, y, currentFrame);
+        
+        success = AE_RenderQueue_Submit(queue, layer, depth, sprite->definition->spriteSheet, frame, &sprite->drawRect, sprite->angle, &sprite->pivot, sprite->flip, sprite->color, sprite->alpha, SDL_BLENDMODE_INVALID);
+        
+        sprite->currentFrame += ((sprite->frameSpeed/2)*step);
+    }
+    return success;
+}
+
+/**
+ Stable LSD radix sort of keys and their values, one byte per pass. Passes where every key has the same byte are skipped
+
+ @param keys The keys to be sorted
+ @param values The values that move along with the keys
+ @param scratchKeys Scratch memory with room for count keys
+ @param scratchValues Scratch memory with room for count values
+ @param count The number of keys
+ */
+static void AE_RadixSortStable(Uint64* keys, Uint32* values, Uint64* scratchKeys, Uint32* scratchValues, int count)
+{
+    int histograms[8][256];
+    Uint64* sourceKeys = keys;
+    Uint32* sourceValues = values;
+    
+    //Build the histogram of every byte in a single pass over the keys
+    SDL_memset(histograms, 0, sizeof(histograms));
+    for (int i = 0; i<count; i++)
+    {
+        Uint64 key = keys[i];
+        for (int pass = 0; pass<8; pass++)
+        {
+            histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+    
+    for (int pass = 0; pass<8; pass++)
+    {
+        int* histogram = histograms[pass];
+        int shift = pass * 8;
+        
+        //If every key has the same byte, this pass would not move anything
+        if (histogram[(sourceKeys[0] >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+        
+        //Turn the counts into starting offsets
+        int offset = 0;
+        for (int digit = 0; digit<256; digit++)
+        {
+            int digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+        
+        //Scatter into the other buffer, keeping equal bytes in order
+        for (int i = 0; i<count; i++)
+        {
+            int destination = histogram[(sourceKeys[i] >> shift) & 0xFF]++;
+            scratchKeys[destination] = sourceKeys[i];
+            scratchValues[destination] = sourceValues[i];
+        }
+        
+        //Swap the buffers for the next pass
+        Uint64* tempKeys = sourceKeys;
+        Uint32* tempValues = sourceValues;
+        sourceKeys = scratchKeys;
+        sourceValues = scratchValues;
+        scratchKeys = tempKeys;
+        scratchValues = tempValues;
+    }
+    
+    //If the sorted data ended up in the scratch buffers, copy it back
+    if (sourceKeys != keys)
+    {
+        SDL_memcpy(keys, sourceKeys, sizeof(Uint64) * count);
+        SDL_memcpy(values, sourceValues, sizeof(Uint32) * count);
+    }
+}
+
+/**
+ Unstable in-place MSD radix sort (American flag sort) of keys and their values, one byte per level
+
+ @param keys The keys to be sorted
+ @param values The values that move along with the keys
+ @param count The number of keys
+ @param shift The shift of the byte being sorted on
+ */
+static void AE_RadixSortInPlace(Uint64* keys, Uint32* values, int count, int shift)
+{
+    //Small buckets are quicker to insertion sort
+    if (count < 32)
+    {
+        for (int i = 1; i<count; i++)
+        {
+            Uint64 key = keys[i];
+            Uint32 value = values[i];
+            int j = i - 1;
+            while (j >= 0 && keys[j] > key)
+            {
+                keys[j + 1] = keys[j];
+                values[j + 1] = values[j];
+                j--;
+            }
+            keys[j + 1] = key;
+            values[j + 1] = value;
+        }
+        return;
+    }
+    
+    int counts[256] = {0};
+    int heads[256];
+    int tails[256];
+    
+    for (int i = 0; i<count; i++)
+    {
+        counts[(keys[i] >> shift) & 0xFF]++;
+    }
+    
+    int offset = 0;
+    for (int digit = 0; digit<256; digit++)
+    {
+        heads[digit] = offset;
+        offset += counts[digit];
+        tails[digit] = offset;
+    }
+    
+    //Swap every key into its bucket, one cycle at a time
+    for (int digit = 0; digit<256; digit++)
+    {
+        while (heads[digit] < tails[digit])
+        {
+            Uint64 key = keys[heads[digit]];
+            Uint32 value = values[heads[digit]];
+            int keyDigit = (key >> shift) & 0xFF;
+            
+            while (keyDigit != digit)
+            {
+                int destination = heads[keyDigit]++;
+                Uint64 tempKey = keys[destination];
+                Uint32 tempValue = values[destination];
+                keys[destination] = key;
+                values[destination] = value;
+                key = tempKey;
+                value = tempValue;
+                keyDigit = (key >> shift) & 0xFF;
+            }
+            keys[heads[digit]] = key;
+            values[heads[digit]] = value;
+            heads[digit]++;
+        }
+    }
+    
+    //Sort each bucket on the next byte down
+    if (shift > 0)
+    {
+        offset = 0;
+        for (int digit = 0; digit<256; digit++)
+        {
+            if (counts[digit] > 1)
+            {
+                AE_RadixSortInPlace(&keys[offset], &values[offset], counts[digit], shift - 8);
+            }
+            offset += counts[digit];
+        }
+    }
+}
+
+/**
+ Radix sorts the draws in a queue by their keys
+
+ @param queue The AE_RenderQueue to be sorted
+ */
+void AE_RenderQueue_Sort(AE_RenderQueue* queue)
+{
+    //Grow the sort buffers to fit every draw
+    if (queue->sortCapacity < queue->count)
+    {
+        queue->sortCapacity = queue->capacity;
+        queue->keys = SDL_realloc(queue->keys, sizeof(Uint64) * queue->sortCapacity);
+        queue->order = SDL_realloc(queue->order, sizeof(Uint32) * queue->sortCapacity);
+        
+        //The scratch buffers are too small now, so they are reallocated if the stable sort needs them
+        SDL_free(queue->scratchKeys);
+        SDL_free(queue->scratchOrder);
+        queue->scratchKeys = NULL;
+        queue->scratchOrder = NULL;
+    }
+    if (queue->stableSort && queue->scratchKeys == NULL)
+    {
+        queue->scratchKeys = SDL_malloc(sizeof(Uint64) * queue->sortCapacity);
+        queue->scratchOrder = SDL_malloc(sizeof(Uint32) * queue->sortCapacity);
+    }
+    
+    //Sort the keys along with the index of their draw, so the draws themselves never move
+    for (int i = 0; i<queue->count; i++)
+    {
+        queue->keys[i] = queue->commands[i].key;
+        queue->order[i] = i;
+    }
+    
+    if (queue->count > 1)
+    {
+        if (queue->stableSort)
+        {
+            AE_RadixSortStable(queue->keys, queue->order, queue->scratchKeys, queue->scratchOrder, queue->count);
+        }
+        else
+        {
+            AE_RadixSortInPlace(queue->keys, queue->order, queue->count, 56);
+        }
+    }
+}
+
+/**
+ Sorts and draws every draw in a queue, then empties the queue
+
+ @param queue The AE_RenderQueue to be drawn
+ @param renderer The renderer the draws will be drawn on
+ @param batch The AE_SpriteBatch the draws will be merged through (NULL to draw each one on its own)
+ @return Whether every draw was drawn successfully or not
+ */
+SDL_bool AE_RenderQueue_Flush(AE_RenderQueue* queue, SDL_Renderer* renderer, AE_SpriteBatch* batch)
+{
+    SDL_bool success = SDL_TRUE;
+    AE_LinkedTexture* lastSheet = NULL;
+    SDL_BlendMode lastBlendMode = SDL_BLENDMODE_INVALID;
+    
+    AE_RenderQueue_Sort(queue);
+    queue->textureSwitches = 0;
+    
+    for (int i = 0; i<queue->count; i++)
+    {
+        AE_RenderCommand* command = &queue->commands[queue->order[i]];
+        const SDL_Rect* frame = command->wholeSheet ? NULL : &command->frame;
+        const SDL_Point* pivot = command->centerPivot ? NULL : &command->pivot;
+        
+        //A sprite sheet that is still loading has nothing to draw yet
+        if (command->spriteSheet->texture == NULL)
+        {
+            success = SDL_FALSE;
+            continue;
+        }
+        
+        if (command->spriteSheet != lastSheet)
+        {
+            queue->textureSwitches++;
+        }
+        
+        //The blend mode belongs to the texture, so anything batched with the old blend mode has to be drawn before it changes
+        if (command->spriteSheet != lastSheet || command->blendMode != lastBlendMode)
+        {
+            if (batch != NULL && command->spriteSheet == lastSheet && !AE_SpriteBatch_Flush(batch))
+            {
+                success = SDL_FALSE;
+            }
+            AE_SetTextureBlend(renderer, command->spriteSheet->texture, command->blendMode);
+            lastSheet = command->spriteSheet;
+            lastBlendMode = command->blendMode;
+        }
+        
+        if (batch != NULL)
+        {
+            if (!AE_SpriteBatch_Submit(batch, command->spriteSheet, frame, &command->drawRect, command->angle, pivot, command->flip, command->color, command->alpha))
+            {
+                success = SDL_FALSE;
+            }
+        }
+        else
+        {
+            AE_SetTextureModulation(renderer, command->spriteSheet->texture, command->color, command->alpha);
+            if (SDL_RenderCopyEx(renderer, command->spriteSheet->texture, frame, &command->drawRect, command->angle, pivot, command->flip) != 0)
+            {
+                success = SDL_FALSE;
+            }
+        }
+    }
+    
+    //Draw whatever is left in the batch
+    if (batch != NULL && !AE_SpriteBatch_Flush(batch))
+    {
+        success = SDL_FALSE;
+    }
+    
+    AE_RenderQueue_Clear(queue);
+    
+    return success;
+}
+
+/**
+ Empties a queue without drawing it
+
+ @param queue The AE_RenderQueue to be emptied
+ */
+void AE_RenderQueue_Clear(AE_RenderQueue* queue)
+{
+    queue->count = 0;
+}
+
+/**
+ Gets the number of times the sprite sheet changed between draws during the last flush of a queue
+
+ @param queue The AE_RenderQueue whose texture switches will be retrieved
+ @return The number of texture switches
+ */
+int AE_RenderQueue_GetTextureSwitches(AE_RenderQueue* queue)
+{
+    return queue->textureSwitches;
+}
+
+/**
+ Frees and destroys an AE_RenderQueue
+
+ @param queue The AE_RenderQueue to be destroyed
+ */
+void AE_DestroyRenderQueue(AE_RenderQueue* queue)
+{
+    if (queue != NULL)
+    {
+        SDL_free(queue->commands);
+        SDL_free(queue->keys);
+        SDL_free(queue->order);
+        SDL_free(queue->scratchKeys);
+        SDL_free(queue->scratchOrder);
+        SDL_free(queue);
+    }
+}
+
+//
+//
+//End: Render Queue Functions
+//
+//
+
+//
+//
+//Start: Cached Layer Functions
+//
+//
+
+/**
+ Fills in how a layer's sprite looks right now, resolving its frame the same way AE_SpriteRender does but without touching the sprite
+
+ @param draw The AE_CachedLayerDraw whose sprite will be looked at
+ */
+static void AE_CachedLayerDraw_Capture(AE_CachedLayerDraw* draw)
+{
+    AE_Sprite* sprite = draw->sprite;
+    AE_SpriteDef* definition = sprite->definition;
+    AE_LinkedTexture* spriteSheet = (definition != NULL) ? definition->spriteSheet : NULL;
+    int frame = draw->currentFrame;
+    
+    if (frame < 0)
+    {
+        frame = (definition == NULL || definition->frameCount <= 1) ? 0 : (int)fmodf(sprite->currentFrame, (float)(definition->frameCount - 1));
+    }
+    else if (definition != NULL && frame >= definition->frameCount)
+    {
+        frame = definition->frameCount - 1;
+    }
+    
+    draw->texture = (spriteSheet != NULL) ? spriteSheet->texture : NULL;
+    draw->textureVersion = (spriteSheet != NULL) ? spriteSheet->version : 0;
+    draw->wholeSheet = (definition == NULL || definition->frames == NULL || frame < 0);
+    if (!draw->wholeSheet)
+    {
+        draw->frame = definition->frames[frame];
+    }
+    draw->drawRect.x = draw->x;
+    draw->drawRect.y = draw->y;
+    draw->drawRect.w = sprite->drawRect.w;
+    draw->drawRect.h = sprite->drawRect.h;
+    draw->angle = sprite->angle;
+    draw->pivot = sprite->pivot;
+    draw->flip = sprite->flip;
+    draw->color = sprite->color;
+    draw->alpha = sprite->alpha;
+}
+
+/**
+ Checks whether a sprite still looks the way it did when it was drawn into its layer
+
+ @param draw The AE_CachedLayerDraw as it was drawn
+ @return Whether the sprite looks the same or not
+ */
+static SDL_bool AE_CachedLayerDraw_IsCurrent(const AE_CachedLayerDraw* draw)
+{
+    AE_CachedLayerDraw current = *draw;
+    AE_CachedLayerDraw_Capture(&current);
+    
+    if (current.texture != draw->texture || current.textureVersion != draw->textureVersion || current.wholeSheet != draw->wholeSheet)
+    {
+        return SDL_FALSE;
+    }
+    if (!current.wholeSheet && !SDL_RectEquals(&current.frame, &draw->frame))
+    {
+        return SDL_FALSE;
+    }
+    return (SDL_RectEquals(&current.drawRect, &draw->drawRect) && current.angle == draw->angle && current.pivot.x == draw->pivot.x && current.pivot.y == draw->pivot.y && current.flip == draw->flip && current.color.r == draw->color.r && current.color.g == draw->color.g && current.color.b == draw->color.b && current.alpha == draw->alpha) ? SDL_TRUE : SDL_FALSE;
+}
+
+/**
+ Clears a layer's texture and draws every one of its sprites into it
+
+ @param layer The AE_CachedLayer to be drawn
+ @return Whether every sprite was drawn or not
+ */
+static SDL_bool AE_CachedLayer_Redraw(AE_CachedLayer* layer)
+{
+    SDL_Renderer* renderer = layer->renderer;
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_bool success = SDL_TRUE;
+    Uint8 r, g, b, a;
+    
+    if (SDL_SetRenderTarget(renderer, layer->target) != 0)
+    {
+        return SDL_FALSE;
+    }
+    AE_PROFILE_BEGIN("AE_CachedLayer_Redraw");
+    
+    //Start from fully transparent, keeping whatever draw color the game had set
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    
+    for (int i = 0; i<layer->count; i++)
+    {
+        AE_CachedLayerDraw* draw = &layer->draws[i];
+        AE_CachedLayerDraw_Capture(draw);
+        
+        //A sprite sheet that is still loading has nothing to draw yet, and is noticed once it finishes
+        if (draw->texture == NULL)
+        {
+            continue;
+        }
+        AE_SetTextureModulation(renderer, draw->texture, draw->color, draw->alpha);
+        if (SDL_RenderCopyEx(renderer, draw->texture, draw->wholeSheet ? NULL : &draw->frame, &draw->drawRect, draw->angle, &draw->pivot, draw->flip) != 0)
+        {
+            success = SDL_FALSE;
+        }
+    }
+    
+    SDL_SetRenderTarget(renderer, previousTarget);
+    AE_PROFILE_END();
+    
+    //A failed draw is tried again next time
+    layer->isDirty = !success;
+    layer->redrawCount++;
+    return success;
+}
+
+/**
+ Creates an empty AE_CachedLayer backed by a target texture
+
+ @param renderer The renderer the layer will be drawn with
+ @param width The width of the layer
+ @param height The height of the layer
+ @return The new AE_CachedLayer, or NULL if the renderer can't draw to textures or the texture couldn't be created
+ */
+AE_CachedLayer* AE_CreateCachedLayer(SDL_Renderer* renderer, int width, int height)
+{
+    AE_CachedLayer* layer;
+    
+    if (!SDL_RenderTargetSupported(renderer))
+    {
+        return NULL;
+    }
+    layer = SDL_malloc(sizeof(AE_CachedLayer));
+    if (layer == NULL)
+    {
+        return NULL;
+    }
+    
+    layer->renderer = renderer;
+    layer->target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    layer->width = width;
+    layer->height = height;
+    layer->capacity = 16;
+    layer->count = 0;
+    layer->draws = SDL_malloc(sizeof(AE_CachedLayerDraw) * layer->capacity);
+    layer->isDirty = SDL_TRUE;
+    layer->watchChanges = SDL_TRUE;
+    layer->redrawCount = 0;
+    
+    if (layer->target == NULL || layer->draws == NULL)
+    {
+        AE_DestroyCachedLayer(layer);
+        return NULL;
+    }
+    
+    //Sprites blended onto a transparent texture leave it premultiplied, so it's copied out without multiplying by alpha again
+    SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    //Renderers without custom blend modes (like the software renderer) fall back to ordinary blending, which slightly darkens half transparent edges
+    if (SDL_SetTextureBlendMode(layer->target, premultiplied) != 0)
+    {
+        SDL_SetTextureBlendMode(layer->target, SDL_BLENDMODE_BLEND);
+    }
+    
+    return layer;
+}
+
+/**
+ Adds a sprite to a layer. The layer keeps a pointer to the sprite, so remove it before destroying the sprite
+
+ @param layer The AE_CachedLayer the sprite will be drawn into
+ @param sprite The sprite to be added
+ @param x The x coordinate of the sprite within the layer
+ @param y The y coordinate of the sprite within the layer
+ @param currentFrame The frame the sprite will be drawn on (-1 or less for the frame the sprite is on, which the layer never advances)
+ @return Whether the sprite was added or not
+ */
+SDL_bool AE_CachedLayer_AddSprite(AE_CachedLayer* layer, AE_Sprite* sprite, int x, int y, int currentFrame)
+{
+    if (sprite == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Double the draw array when it runs out of room
+    if (layer->count == layer->capacity)
+    {
+        AE_CachedLayerDraw* newDraws = SDL_realloc(layer->draws, sizeof(AE_CachedLayerDraw) * layer->capacity * 2);
+        if (newDraws == NULL)
+        {
+            return SDL_FALSE;
+        }
+        layer->draws = newDraws;
+        layer->capacity *= 2;
+    }
+    
+    AE_CachedLayerDraw* draw = &layer->draws[layer->count++];
+    draw->sprite = sprite;
+    draw->x = x;
+    draw->y = y;
+    draw->currentFrame = currentFrame;
+    AE_CachedLayerDraw_Capture(draw);
+    layer->isDirty = SDL_TRUE;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Removes every draw of a sprite from a layer
+
+ @param layer The AE_CachedLayer the sprite will be removed from
+ @param sprite The sprite to be removed
+ @return The number of draws removed
+ */
+int AE_CachedLayer_RemoveSprite(AE_CachedLayer* layer, AE_Sprite* sprite)
+{
+    int kept = 0;
+    
+    //Keep the remaining draws in order, since later draws cover earlier ones
+    for (int i = 0; i<layer->count; i++)
+    {
+        if (layer->draws[i].sprite != sprite)
+        {
+            layer->draws[kept++] = layer->draws[i];
+        }
+    }
+    
+    int removed = layer->count - kept;
+    if (removed > 0)
+    {
+        layer->count = kept;
+        layer->isDirty = SDL_TRUE;
+    }
+    return removed;
+}
+
+/**
+ Removes every sprite from a layer
+
+ @param layer The AE_CachedLayer to be cleared
+ */
+void AE_CachedLayer_Clear(AE_CachedLayer* layer)
+{
+    layer->count = 0;
+    layer->isDirty = SDL_TRUE;
+}
+
+/**
+ Makes a layer draw its sprites again the next time it's rendered. Sprite and sprite sheet changes are noticed on their own, but a renderer losing its target textures (SDL_RENDER_TARGETS_RESET or SDL_RENDER_DEVICE_RESET) isn't
+
+ @param layer The AE_CachedLayer to be invalidated
+ */
+void AE_CachedLayer_Invalidate(AE_CachedLayer* layer)
+{
+    layer->isDirty = SDL_TRUE;
+}
+
+/**
+ Sets whether a layer checks its sprites and sprite sheets for changes every time it's updated. Checking costs a little per sprite each frame, so very large layers the game invalidates itself can turn it off
+
+ @param layer The AE_CachedLayer whose checking will be set
+ @param watchChanges Whether changes are checked for (the default) or only AE_CachedLayer_Invalidate redraws the layer
+ */
+void AE_CachedLayer_SetWatchChanges(AE_CachedLayer* layer, SDL_bool watchChanges)
+{
+    layer->watchChanges = watchChanges;
+}
+
+/**
+ Gets whether a layer has to be drawn again, because it was invalidated or one of its sprites or sprite sheets changed
+
+ @param layer The AE_CachedLayer to be checked
+ @return Whether the layer has to be drawn again or not
+ */
+SDL_bool AE_CachedLayer_IsDirty(AE_CachedLayer* layer)
+{
+    for (int i = 0; i<layer->count && layer->watchChanges && !layer->isDirty; i++)
+    {
+        if (!AE_CachedLayerDraw_IsCurrent(&layer->draws[i]))
+        {
+            layer->isDirty = SDL_TRUE;
+        }
+    }
+    return layer->isDirty;
+}
+
+/**
+ Draws a layer's sprites into its texture again if anything changed
+
+ @param layer The AE_CachedLayer to be updated
+ @return Whether the layer's texture is up to date or not
+ */
+SDL_bool AE_CachedLayer_Update(AE_CachedLayer* layer)
+{
+    return AE_CachedLayer_IsDirty(layer) ? AE_CachedLayer_Redraw(layer) : SDL_TRUE;
+}
+
+/**
+ Updates a layer if anything changed, then copies it to the renderer's current target
+
+ @param layer The AE_CachedLayer to be rendered
+ @param x The x coordinate the layer will be drawn at
+ @param y The y coordinate the layer will be drawn at
+ @return Whether the layer was rendered or not
+ */
+SDL_bool AE_CachedLayer_Render(AE_CachedLayer* layer, int x, int y)
+{
+    SDL_Rect drawRect = {x, y, layer->width, layer->height};
+    
+    if (!AE_CachedLayer_Update(layer))
+    {
+        return SDL_FALSE;
+    }
+    return (SDL_RenderCopy(layer->renderer, layer->target, NULL, &drawRect) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/**
+ Gets the texture a layer's sprites are drawn into, for drawing it some other way (scaled, or through an AE_SpriteBatch)
+
+ @param layer The AE_CachedLayer whose texture will be retrieved
+ @return The target texture of the layer
+ */
+SDL_Texture* AE_CachedLayer_GetTexture(AE_CachedLayer* layer)
+{
+    return layer->target;
+}
+
+/**
+ Gets the number of times a layer's sprites have been drawn into its texture
+
+ @param layer The AE_CachedLayer whose redraws will be counted
+ @return The number of redraws
+ */
+Uint32 AE_CachedLayer_GetRedrawCount(AE_CachedLayer* layer)
+{
+    return layer->redrawCount;
+}
+
+/**
+ Frees and destroys an AE_CachedLayer and its texture (its sprites are left alone)
+
+ @param layer The AE_CachedLayer to be destroyed
+ */
+void AE_DestroyCachedLayer(AE_CachedLayer* layer)
+{
+    if (layer->target != NULL)
+    {
+        SDL_DestroyTexture(layer->target);
+    }
+    SDL_free(layer->draws);
+    SDL_free(layer);
+}
+
+//
+//
+//End: Cached Layer Functions
+//
+//
+
+
+//
+//
+//Start: Dirty Region Functions
+//
+//
+
+//The most dirty rects a frame is presented with (each is a bit of a draw's rect mask), past which the pair that grows the least is joined
+#define AE_DIRTYREGION_MAX_RECTS 16
+//The percentage of the window past which drawing all of it in one pass is cheaper than drawing its parts
+#define AE_DIRTYREGION_FULL_PERCENT 60
+
+/**
+ Gets the area of a rect
+
+ @param rect The rect whose area will be found
+ @return The area of the rect
+ */
+static Sint64 AE_DirtyRegion_Area(const SDL_Rect* rect)
+{
+    return (Sint64)rect->w * (Sint64)rect->h;
+}
+
+/**
+ Adds an area of the window that has to be drawn again, joining it with the dirty rects it overlaps. Once there are too many rects, the two whose join adds the least area are joined
+
+ @param region The AE_DirtyRegion the area will be added to
+ @param rect The area to be drawn again
+ */
+static void AE_DirtyRegion_AddRect(AE_DirtyRegion* region, const SDL_Rect* rect)
+{
+    SDL_Rect window = {0, 0, region->width, region->height};
+    SDL_Rect merged;
+    SDL_Rect joined;
+    
+    //Areas off the window never have to be drawn
+    if (!SDL_IntersectRect(rect, &window, &merged))
+    {
+        return;
+    }
+    
+    //Rects that overlap enough to cost nothing to join are always joined, and the joined rect may then overlap rects it didn't before
+    for (int i = 0; i<region->rectCount; i++)
+    {
+        SDL_UnionRect(&merged, &region->rects[i], &joined);
+        if (AE_DirtyRegion_Area(&joined) <= AE_DirtyRegion_Area(&merged) + AE_DirtyRegion_Area(&region->rects[i]))
+        {
+            merged = joined;
+            region->rects[i] = region->rects[--region->rectCount];
+            i = -1;
+        }
+    }
+    region->rects[region->rectCount++] = merged;
+    
+    if (region->rectCount > AE_DIRTYREGION_MAX_RECTS)
+    {
+        int first = 0;
+        int second = 1;
+        Sint64 leastGrowth = -1;
+        
+        for (int i = 0; i<region->rectCount; i++)
+        {
+            for (int j = i + 1; j<region->rectCount; j++)
+            {
+                SDL_UnionRect(&region->rects[i], &region->rects[j], &joined);
+                Sint64 growth = AE_DirtyRegion_Area(&joined) - AE_DirtyRegion_Area(&region->rects[i]) - AE_DirtyRegion_Area(&region->rects[j]);
+                if (leastGrowth < 0 || growth < leastGrowth)
+                {
+                    first = i;
+                    second = j;
+                    leastGrowth = growth;
+                }
+            }
+        }
+        
+        //The pair is taken out and their join added back like any other area
+        SDL_UnionRect(&region->rects[first], &region->rects[second], &joined);
+        region->rects[second] = region->rects[--region->rectCount];
+        region->rects[first] = region->rects[--region->rectCount];
+        AE_DirtyRegion_AddRect(region, &joined);
+    }
+}
+
+/**
+ Checks whether two draws put exactly the same pixels on the window
+
+ @param first The first AE_DirtyRegionDraw
+ @param second The second AE_DirtyRegionDraw
+ @return Whether the draws are the same or not
+ */
+static SDL_bool AE_DirtyRegionDraw_Equals(const AE_DirtyRegionDraw* first, const AE_DirtyRegionDraw* second)
+{
+    if (first->spriteSheet != second->spriteSheet || first->textureVersion != second->textureVersion || first->wholeSheet != second->wholeSheet || first->centered != second->centered)
+    {
+        return SDL_FALSE;
+    }
+    return (SDL_RectEquals(&first->frame, &second->frame) && SDL_RectEquals(&first->drawRect, &second->drawRect) && first->angle == second->angle && first->pivot.x == second->pivot.x && first->pivot.y == second->pivot.y && first->flip == second->flip && first->color.r == second->color.r && first->color.g == second->color.g && first->color.b == second->color.b && first->alpha == second->alpha) ? SDL_TRUE : SDL_FALSE;
+}
+
+/**
+ Creates an AE_DirtyRegion for a window drawn by the software renderer (create the renderer with SDL_HINT_RENDER_DRIVER set to "software"). Dirty rects are in window pixels, so the renderer's viewport and scale must be left alone
+
+ @param window The window the region presents to
+ @param renderer The software renderer of the window
+ @return The new AE_DirtyRegion, or NULL if the renderer isn't a software renderer
+ */
+AE_DirtyRegion* AE_CreateDirtyRegion(SDL_Window* window, SDL_Renderer* renderer)
+{
+    AE_DirtyRegion* region;
+    SDL_RendererInfo info;
+    
+    //Only the software renderer draws straight into the window surface that SDL_UpdateWindowSurfaceRects presents
+    if (SDL_GetRenderer(window) != renderer || SDL_GetRendererInfo(renderer, &info) != 0 || !(info.flags & SDL_RENDERER_SOFTWARE))
+    {
+        return NULL;
+    }
+    region = SDL_malloc(sizeof(AE_DirtyRegion));
+    if (region == NULL)
+    {
+        return NULL;
+    }
+    
+    region->window = window;
+    region->renderer = renderer;
+    SDL_GetRendererOutputSize(renderer, &region->width, &region->height);
+    region->background.r = 0;
+    region->background.g = 0;
+    region->background.b = 0;
+    region->background.a = 255;
+    
+    region->capacity = 64;
+    region->count = 0;
+    region->previousCount = 0;
+    region->draws = SDL_malloc(sizeof(AE_DirtyRegionDraw) * region->capacity);
+    region->previousDraws = SDL_malloc(sizeof(AE_DirtyRegionDraw) * region->capacity);
+    //One more rect than the most a frame keeps, for the rect being added
+    region->rects = SDL_malloc(sizeof(SDL_Rect) * (AE_DIRTYREGION_MAX_RECTS + 1));
+    region->rectCount = 0;
+    
+    //Nothing has been presented yet, so the first frame draws everything
+    region->redrawAll = SDL_TRUE;
+    SDL_zero(region->stats);
+    
+    if (region->draws == NULL || region->previousDraws == NULL || region->rects == NULL)
+    {
+        AE_DestroyDirtyRegion(region);
+        return NULL;
+    }
+    
+    return region;
+}
+
+/**
+ Sets the color dirty areas are cleared to before their draws are drawn again
+
+ @param region The AE_DirtyRegion whose background will be set
+ @param background The background color
+ */
+void AE_DirtyRegion_SetBackground(AE_DirtyRegion* region, SDL_Color background)
+{
+    region->background = background;
+    region->redrawAll = SDL_TRUE;
+}
+
+/**
+ Begins a new frame of draws. Draws have to be submitted in the same order every frame, since each one is compared with the draw submitted in its place last frame
+
+ @param region The AE_DirtyRegion to begin
+ */
+void AE_DirtyRegion_Begin(AE_DirtyRegion* region)
+{
+    //The frame that was just drawn becomes the one to compare against, and its array is reused for the new frame
+    AE_DirtyRegionDraw* previousDraws = region->previousDraws;
+    region->previousDraws = region->draws;
+    region->previousCount = region->count;
+    region->draws = previousDraws;
+    region->count = 0;
+}
+
+/**
+ Adds a draw to the current frame
+
+ @param region The AE_DirtyRegion the draw will be added to
+ @param spriteSheet The LinkedTexture to draw from
+ @param frame The area of the sprite sheet to draw (NULL for the whole sprite sheet)
+ @param drawRect The area of the screen to draw to
+ @param angle The angle of the draw
+ @param pivot The point the draw is rotated around (NULL for the center)
+ @param flip The rendererflip of the draw
+ @param color The color modulation of the draw
+ @param alpha The alpha modulation of the draw
+ @return Whether the draw was added or not
+ */
+SDL_bool AE_DirtyRegion_Submit(AE_DirtyRegion* region, AE_LinkedTexture* spriteSheet, const SDL_Rect* frame, const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_RendererFlip flip, AE_ColorBundle color, Uint8 alpha)
+{
+    if (spriteSheet == NULL || drawRect == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Double both draw arrays when they run out of room, since they trade places every frame
+    if (region->count == region->capacity)
+    {
+        AE_DirtyRegionDraw* newDraws = SDL_realloc(region->draws, sizeof(AE_DirtyRegionDraw) * region->capacity * 2);
+        if (newDraws == NULL)
+        {
+            return SDL_FALSE;
+        }
+        region->draws = newDraws;
+        
+        newDraws = SDL_realloc(region->previousDraws, sizeof(AE_DirtyRegionDraw) * region->capacity * 2);
+        if (newDraws == NULL)
+        {
+            return SDL_FALSE;
+        }
+        region->previousDraws = newDraws;
+        region->capacity *= 2;
+    }
+    
+    //Unused frames and pivots are zeroed so draws can be compared field by field
+    AE_DirtyRegionDraw* draw = &region->draws[region->count++];
+    draw->spriteSheet = spriteSheet;
+    draw->textureVersion = spriteSheet->version;
+    draw->wholeSheet = (frame == NULL);
+    if (frame != NULL)
+    {
+        draw->frame = *frame;
+    }
+    else
+    {
+        SDL_zero(draw->frame);
+    }
+    draw->drawRect = *drawRect;
+    draw->angle = angle;
+    draw->centered = (pivot == NULL);
+    if (pivot != NULL)
+    {
+        draw->pivot = *pivot;
+    }
+    else
+    {
+        SDL_zero(draw->pivot);
+    }
+    draw->flip = flip;
+    draw->color = color;
+    draw->alpha = alpha;
+    AE_GetRotatedBounds(drawRect, angle, pivot, &draw->bounds);
+    
+    return SDL_TRUE;
+}
+
+/**
+ Adds an AE_Sprite to the current frame, animating it exactly as AE_SpriteRender would
+
+ @param region The AE_DirtyRegion the sprite will be added to
+ @param sprite The sprite to be added
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was added or not
+ */
+SDL_bool AE_DirtyRegion_SubmitSprite(AE_DirtyRegion* region, AE_Sprite* sprite, int x, int y, int currentFrame, float step)
+{
+    SDL_bool success = SDL_FALSE;
+    if (sprite->definition != NULL && sprite->definition->spriteSheet != NULL)
+    {
+        SDL_Rect* frame = AE_SpritePrepareFrame(sprite, x, y, currentFrame);
+        
+        success = AE_DirtyRegion_Submit(region, sprite->definition->spriteSheet, frame, &sprite->drawRect, sprite->angle, &sprite->pivot, sprite->flip, sprite->color, sprite->alpha);
+        
+        sprite->currentFrame += ((sprite->frameSpeed/2)*step);
+    }
+    return success;
+}
+
+/**
+ Makes the next frame redraw and present the whole window, such as after SDL_WINDOWEVENT_EXPOSED or after drawing to the window some other way
+
+ @param region The AE_DirtyRegion to be invalidated
+ */
+void AE_DirtyRegion_Invalidate(AE_DirtyRegion* region)
+{
+    region->redrawAll = SDL_TRUE;
+}
+
+/**
+ Ends the current frame, drawing the areas that changed since the last frame and presenting only those areas to the window. This replaces SDL_RenderPresent
+
+ @param region The AE_DirtyRegion to end
+ @return Whether the changed areas were drawn and presented successfully or not
+ */
+SDL_bool AE_DirtyRegion_End(AE_DirtyRegion* region)
+{
+    SDL_Renderer* renderer = region->renderer;
+    SDL_bool success = SDL_TRUE;
+    Sint64 dirtyArea = 0;
+    int width = 0;
+    int height = 0;
+    SDL_Rect clip;
+    SDL_bool clipEnabled = SDL_RenderIsClipEnabled(renderer);
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    
+    AE_PROFILE_BEGIN("AE_DirtyRegion_End");
+    
+    //A resized window gets a new surface, which starts out blank
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    if (width != region->width || height != region->height)
+    {
+        region->width = width;
+        region->height = height;
+        region->redrawAll = SDL_TRUE;
+    }
+    
+    region->rectCount = 0;
+    if (!region->redrawAll)
+    {
+        int common = SDL_min(region->count, region->previousCount);
+        
+        //Wherever a draw differs from the one in its place last frame, both where it was and where it is now are drawn again
+        for (int i = 0; i<common; i++)
+        {
+            if (!AE_DirtyRegionDraw_Equals(&region->draws[i], &region->previousDraws[i]))
+            {
+                AE_DirtyRegion_AddRect(region, &region->previousDraws[i].bounds);
+                AE_DirtyRegion_AddRect(region, &region->draws[i].bounds);
+            }
+        }
+        for (int i = common; i<region->previousCount; i++)
+        {
+            AE_DirtyRegion_AddRect(region, &region->previousDraws[i].bounds);
+        }
+        for (int i = common; i<region->count; i++)
+        {
+            AE_DirtyRegion_AddRect(region, &region->draws[i].bounds);
+        }
+        
+        for (int i = 0; i<region->rectCount; i++)
+        {
+            dirtyArea += AE_DirtyRegion_Area(&region->rects[i]);
+        }
+        if (dirtyArea * 100 >= (Sint64)width * (Sint64)height * AE_DIRTYREGION_FULL_PERCENT)
+        {
+            region->redrawAll = SDL_TRUE;
+        }
+    }
+    if (region->redrawAll && width > 0 && height > 0)
+    {
+        region->rects[0].x = 0;
+        region->rects[0].y = 0;
+        region->rects[0].w = width;
+        region->rects[0].h = height;
+        region->rectCount = 1;
+        dirtyArea = (Sint64)width * (Sint64)height;
+    }
+    
+    //Keep whatever clip and draw state the game had set
+    SDL_RenderGetClipRect(renderer, &clip);
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+    SDL_SetRenderDrawColor(renderer, region->background.r, region->background.g, region->background.b, region->background.a);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    
+    //Find every dirty rect each draw touches in a single pass, so a rect only has to check a bit per draw
+    for (int j = 0; j<region->count; j++)
+    {
+        AE_DirtyRegionDraw* draw = &region->draws[j];
+        const SDL_Rect* bounds = &draw->bounds;
+        
+        draw->rectMask = 0;
+        //A sprite sheet that is still loading has nothing to draw yet, and its version changes once it finishes
+        if (draw->spriteSheet->texture == NULL || bounds->w <= 0 || bounds->h <= 0)
+        {
+            continue;
+        }
+        for (int i = 0; i<region->rectCount; i++)
+        {
+            const SDL_Rect* rect = &region->rects[i];
+            if (bounds->x < rect->x + rect->w && rect->x < bounds->x + bounds->w && bounds->y < rect->y + rect->h && rect->y < bounds->y + bounds->h)
+            {
+                draw->rectMask |= (1u << i);
+            }
+        }
+    }
+    
+    region->stats.redrawnDraws = 0;
+    for (int i = 0; i<region->rectCount; i++)
+    {
+        const SDL_Rect* rect = &region->rects[i];
+        
+        //Each dirty rect is cleared and every draw touching it is drawn again in order, clipped to the rect
+        SDL_RenderSetClipRect(renderer, rect);
+        SDL_RenderFillRect(renderer, rect);
+        for (int j = 0; j<region->count; j++)
+        {
+            AE_DirtyRegionDraw* draw = &region->draws[j];
+            
+            if (!(draw->rectMask & (1u << i)))
+            {
+                continue;
+            }
+            AE_SetTextureModulation(renderer, draw->spriteSheet->texture, draw->color, draw->alpha);
+            if (SDL_RenderCopyEx(renderer, draw->spriteSheet->texture, draw->wholeSheet ? NULL : &draw->frame, &draw->drawRect, draw->angle, draw->centered ? NULL : &draw->pivot, draw->flip) != 0)
+            {
+                success = SDL_FALSE;
+            }
+            region->stats.redrawnDraws++;
+        }
+    }
+    
+    SDL_RenderSetClipRect(renderer, clipEnabled ? &clip : NULL);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+    
+    //Only the drawn areas are copied to the window
+    if (region->rectCount > 0)
+    {
+        SDL_RenderFlush(renderer);
+        if (SDL_UpdateWindowSurfaceRects(region->window, region->rects, region->rectCount) != 0)
+        {
+            success = SDL_FALSE;
+        }
+    }
+    
+    region->stats.drawCount = region->count;
+    region->stats.rectCount = region->rectCount;
+    region->stats.redrawnPixels = dirtyArea;
+    region->stats.redrawnPercent = (width > 0 && height > 0) ? (float)(100.0 * (double)dirtyArea / ((double)width * (double)height)) : 0.0f;
+    
+    //A frame that wasn't drawn completely is drawn again in full
+    region->redrawAll = !success;
+    AE_PROFILE_END();
+    return success;
+}
+
+/**
+ Gets the dirty rects the last frame redrew
+
+ @param region The AE_DirtyRegion whose rects will be retrieved
+ @param count Gets the number of rects
+ @return The rects, which stay valid until the next AE_DirtyRegion_End
+ */
+const SDL_Rect* AE_DirtyRegion_GetRects(AE_DirtyRegion* region, int* count)
+{
+    *count = region->rectCount;
+    return region->rects;
+}
+
+/**
+ Gets what the last frame of a region redrew
+
+ @param region The AE_DirtyRegion whose statistics will be retrieved
+ @return The statistics of the last frame
+ */
+AE_DirtyRegionStats AE_DirtyRegion_GetStats(AE_DirtyRegion* region)
+{
+    return region->stats;
+}
+
+/**
+ Frees and destroys an AE_DirtyRegion (its sprite sheets and renderer are left alone)
+
+ @param region The AE_DirtyRegion to be destroyed
+ */
+void AE_DestroyDirtyRegion(AE_DirtyRegion* region)
+{
+    SDL_free(region->draws);
+    SDL_free(region->previousDraws);
+    SDL_free(region->rects);
+    SDL_free(region);
+}
+
+//
+//
+//End: Dirty Region Functions
+//
+//
+
+
+//
+//
+//Start: Tilemap Functions
+//
+//
+
+//How many renders a chunk keeps its geometry for after it was last drawn
+#define AE_TILEMAP_KEEP_RENDERS 120
+
+/**
+ Divides two numbers, rounding toward negative infinity instead of toward zero
+
+ @param value The number to be divided
+ @param divisor The positive number to divide by
+ @return The rounded down quotient
+ */
+static int AE_Tilemap_FloorDivide(int value, int divisor)
+{
+    return (value >= 0) ? value / divisor : -((divisor - 1 - value) / divisor);
+}
+
+/**
+ Finds the chunk a tile is in, along with the tile's cell in that chunk
+
+ @param map The AE_Tilemap the tile is on
+ @param x The x of the tile
+ @param y The y of the tile
+ @param cell Gets the cell of the tile in its chunk
+ @return The chunk, or NULL if the tile is off the map
+ */
+static AE_TilemapChunk* AE_Tilemap_FindChunk(AE_Tilemap* map, int x, int y, int* cell)
+{
+    if (x < 0 || y < 0 || x >= map->width || y >= map->height)
+    {
+        return NULL;
+    }
+    *cell = (y % AE_TILEMAP_CHUNK_SIZE) * AE_TILEMAP_CHUNK_SIZE + (x % AE_TILEMAP_CHUNK_SIZE);
+    return &map->chunks[(y / AE_TILEMAP_CHUNK_SIZE) * map->chunksWide + (x / AE_TILEMAP_CHUNK_SIZE)];
+}
+
+/**
+ Returns whether a tile id has a tile type to be drawn with
+
+ @param map The AE_Tilemap the tile id belongs to
+ @param id The tile id
+ @return Whether the tile is drawn or not
+ */
+static SDL_bool AE_Tilemap_IsDrawn(AE_Tilemap* map, Uint16 id)
+{
+    return (id != AE_TILE_EMPTY && id < map->typeCount && map->types[id].variantCount > 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/**
+ Picks the variant of a tile from its position with AE_SeedHash_Int. The seed mode is ignored, so chunks built before and after AE_SetSeedMode can't disagree
+
+ @param map The AE_Tilemap the tile is on
+ @param id The tile id
+ @param x The x of the tile
+ @param y The y of the tile
+ @return The variant of the tile
+ */
+static Uint8 AE_Tilemap_PickVariant(AE_Tilemap* map, Uint16 id, int x, int y)
+{
+    if (!AE_Tilemap_IsDrawn(map, id) || map->types[id].variantCount == 1)
+    {
+        return 0;
+    }
+    return (Uint8)AE_SeedHash_Int(map->seed, (Uint64)(Sint64)x, (Uint64)(Sint64)y, map->set, 0, map->types[id].variantCount);
+}
+
+/**
+ Writes the texture coordinates of one cell of a built chunk, from its tile and variant
+
+ @param map The AE_Tilemap the chunk is in
+ @param chunk The AE_TilemapChunk the cell is in
+ @param cell The cell to be written
+ */
+static void AE_Tilemap_WriteTexCoords(AE_Tilemap* map, AE_TilemapChunk* chunk, int cell)
+{
+    SDL_Vertex* vertex = &chunk->vertices[cell * 4];
+    Uint16 id = chunk->tiles[cell];
+    float minu = 0.0f;
+    float minv = 0.0f;
+    float maxu = 0.0f;
+    float maxv = 0.0f;
+    
+    //Cells that aren't drawn are left out of the indices, so their coordinates don't matter
+    if (AE_Tilemap_IsDrawn(map, id))
+    {
+        const SDL_Rect* frame = &map->types[id].frame;
+        const float sheetWidth = (float)AE_LinkedTexture_GetWidth(map->tileset);
+        const float sheetHeight = (float)AE_LinkedTexture_GetHeight(map->tileset);
+        const int x = frame->x + frame->w * chunk->variants[cell];
+        
+        minu = (float)x / sheetWidth;
+        minv = (float)frame->y / sheetHeight;
+        maxu = (float)(x + frame->w) / sheetWidth;
+        maxv = (float)(frame->y + frame->h) / sheetHeight;
+    }
+    
+    vertex[0].tex_coord.x = minu;
+    vertex[0].tex_coord.y = minv;
+    vertex[1].tex_coord.x = maxu;
+    vertex[1].tex_coord.y = minv;
+    vertex[2].tex_coord.x = maxu;
+    vertex[2].tex_coord.y = maxv;
+    vertex[3].tex_coord.x = minu;
+    vertex[3].tex_coord.y = maxv;
+}
+
+/**
+ Picks every variant of a chunk and builds its geometry, with every cell getting a fixed quad so a changed tile only has its own quad rewritten
+
+ @param map The AE_Tilemap the chunk is in
+ @param chunkIndex The index of the chunk
+ @param offsetX The x on the renderer the chunk's top left corner is drawn at
+ @param offsetY The y on the renderer the chunk's top left corner is drawn at
+ @return Whether the chunk was built or not
+ */
+static SDL_bool AE_Tilemap_BuildChunk(AE_Tilemap* map, int chunkIndex, int offsetX, int offsetY)
+{
+    AE_TilemapChunk* chunk = &map->chunks[chunkIndex];
+    const int originX = (chunkIndex % map->chunksWide) * AE_TILEMAP_CHUNK_SIZE;
+    const int originY = (chunkIndex / map->chunksWide) * AE_TILEMAP_CHUNK_SIZE;
+    
+    //Chunks that were built before keep their geometry arrays
+    if (chunk->vertices == NULL)
+    {
+        chunk->vertices = SDL_malloc(sizeof(SDL_Vertex) * AE_TILEMAP_CHUNK_TILES * 4);
+        chunk->indices = SDL_malloc(sizeof(int) * AE_TILEMAP_CHUNK_TILES * 6);
+        if (chunk->vertices == NULL || chunk->indices == NULL)
+        {
+            SDL_free(chunk->vertices);
+            SDL_free(chunk->indices);
+            chunk->vertices = NULL;
+            chunk->indices = NULL;
+            return SDL_FALSE;
+        }
+        map->builtChunks[map->builtCount++] = chunkIndex;
+    }
+    
+    SDL_Color vertexColor = {map->color.r, map->color.g, map->color.b, map->alpha};
+    for (int cell = 0; cell<AE_TILEMAP_CHUNK_TILES; cell++)
+    {
+        SDL_Vertex* vertex = &chunk->vertices[cell * 4];
+        const float minx = (float)(offsetX + (cell % AE_TILEMAP_CHUNK_SIZE) * map->tileWidth);
+        const float miny = (float)(offsetY + (cell / AE_TILEMAP_CHUNK_SIZE) * map->tileHeight);
+        const float maxx = minx + (float)map->tileWidth;
+        const float maxy = miny + (float)map->tileHeight;
+        
+        //Every variant of the chunk is picked here once, instead of every time it's drawn
+        chunk->variants[cell] = AE_Tilemap_PickVariant(map, chunk->tiles[cell], originX + cell % AE_TILEMAP_CHUNK_SIZE, originY + cell / AE_TILEMAP_CHUNK_SIZE);
+        
+        vertex[0].position.x = minx;
+        vertex[0].position.y = miny;
+        vertex[1].position.x = maxx;
+        vertex[1].position.y = miny;
+        vertex[2].position.x = maxx;
+        vertex[2].position.y = maxy;
+        vertex[3].position.x = minx;
+        vertex[3].position.y = maxy;
+        for (int i = 0; i<4; i++)
+        {
+            vertex[i].color = vertexColor;
+        }
+        AE_Tilemap_WriteTexCoords(map, chunk, cell);
+    }
+    
+    chunk->offsetX = offsetX;
+    chunk->offsetY = offsetY;
+    chunk->isBuilt = SDL_TRUE;
+    chunk->indicesDirty = SDL_TRUE;
+    map->stats.builtChunks++;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Lists two triangles for every drawn cell of a built chunk
+
+ @param map The AE_Tilemap the chunk is in
+ @param chunk The AE_TilemapChunk whose indices will be built
+ */
+static void AE_Tilemap_BuildIndices(AE_Tilemap* map, AE_TilemapChunk* chunk)
+{
+    int* index = chunk->indices;
+    
+    for (int cell = 0; cell<AE_TILEMAP_CHUNK_TILES; cell++)
+    {
+        if (AE_Tilemap_IsDrawn(map, chunk->tiles[cell]))
+        {
+            const int first = cell * 4;
+            index[0] = first;
+            index[1] = first + 1;
+            index[2] = first + 2;
+            index[3] = first;
+            index[4] = first + 2;
+            index[5] = first + 3;
+            index += 6;
+        }
+    }
+    chunk->indexCount = (int)(index - chunk->indices);
+    chunk->indicesDirty = SDL_FALSE;
+}
+
+/**
+ Makes every built chunk of a tilemap build itself again the next time it's drawn, keeping its geometry arrays
+
+ @param map The AE_Tilemap whose chunks will be rebuilt
+ */
+static void AE_Tilemap_InvalidateChunks(AE_Tilemap* map)
+{
+    for (int i = 0; i<map->builtCount; i++)
+    {
+        map->chunks[map->builtChunks[i]].isBuilt = SDL_FALSE;
+    }
+}
+
+/**
+ Creates a new tilemap with every tile empty
+
+ @param tileset The LinkedTexture every tile will be drawn from
+ @param width The width of the map in tiles
+ @param height The height of the map in tiles
+ @param tileWidth The width of a tile
+ @param tileHeight The height of a tile
+ @param seed The seed tile variants are picked from with AE_SeedHash_Int, whatever the seed mode
+ @param set The set tile variants are picked from
+ @return The new AE_Tilemap, or NULL if it couldn't be created
+ */
+AE_Tilemap* AE_CreateTilemap(AE_LinkedTexture* tileset, int width, int height, int tileWidth, int tileHeight, Uint64 seed, Uint64 set)
+{
+    AE_Tilemap* map;
+    
+    if (tileset == NULL || width <= 0 || height <= 0 || tileWidth <= 0 || tileHeight <= 0)
+    {
+        return NULL;
+    }
+    map = SDL_calloc(1, sizeof(AE_Tilemap));
+    if (map == NULL)
+    {
+        return NULL;
+    }
+    
+    map->tileWidth = tileWidth;
+    map->tileHeight = tileHeight;
+    map->width = width;
+    map->height = height;
+    map->chunksWide = (width + AE_TILEMAP_CHUNK_SIZE - 1) / AE_TILEMAP_CHUNK_SIZE;
+    map->chunksHigh = (height + AE_TILEMAP_CHUNK_SIZE - 1) / AE_TILEMAP_CHUNK_SIZE;
+    map->chunks = SDL_calloc((size_t)map->chunksWide * (size_t)map->chunksHigh, sizeof(AE_TilemapChunk));
+    map->builtChunks = SDL_malloc(sizeof(int) * (size_t)map->chunksWide * (size_t)map->chunksHigh);
+    map->builtCount = 0;
+    
+    map->types = NULL;
+    map->typeCount = 0;
+    map->seed = seed;
+    map->set = set;
+    map->color.r = 255;
+    map->color.g = 255;
+    map->color.b = 255;
+    map->alpha = 255;
+    
+    //The whole map is a single stakeholder of the tileset
+    if (map->chunks == NULL || map->builtChunks == NULL || !AE_LinkedTexture_Join(tileset, map))
+    {
+        SDL_free(map->chunks);
+        SDL_free(map->builtChunks);
+        SDL_free(map);
+        return NULL;
+    }
+    map->tileset = tileset;
+    map->tilesetVersion = tileset->version;
+    
+    return map;
+}
+
+/**
+ Sets where a tile id is on a tilemap's tileset, and how many variants it has
+
+ @param map The AE_Tilemap the tile type belongs to
+ @param id The tile id (anything but AE_TILE_EMPTY)
+ @param reference_x The x of the tile's first variant on the tileset
+ @param reference_y The y of the tile's first variant on the tileset
+ @param variantCount The number of variants of the tile, from 1 to 256
+ @return Whether the tile type was set or not
+ */
+SDL_bool AE_Tilemap_SetTileType(AE_Tilemap* map, Uint16 id, int reference_x, int reference_y, int variantCount)
+{
+    if (id == AE_TILE_EMPTY || variantCount < 1 || variantCount > 256)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Grow the type array to fit the id, with the new types left unset
+    if (id >= map->typeCount)
+    {
+        AE_TileType* newTypes = SDL_realloc(map->types, sizeof(AE_TileType) * (id + 1));
+        if (newTypes == NULL)
+        {
+            return SDL_FALSE;
+        }
+        SDL_memset(&newTypes[map->typeCount], 0, sizeof(AE_TileType) * (id + 1 - map->typeCount));
+        map->types = newTypes;
+        map->typeCount = id + 1;
+    }
+    
+    map->types[id].frame.x = reference_x;
+    map->types[id].frame.y = reference_y;
+    map->types[id].frame.w = map->tileWidth;
+    map->types[id].frame.h = map->tileHeight;
+    map->types[id].variantCount = variantCount;
+    
+    //Tiles of the type may already be built with other variants
+    AE_Tilemap_InvalidateChunks(map);
+    
+    return SDL_TRUE;
+}
+
+/**
+ Sets a tile of a tilemap. A chunk that has been built only has the changed tile updated
+
+ @param map The AE_Tilemap the tile is on
+ @param x The x of the tile
+ @param y The y of the tile
+ @param id The tile id, or AE_TILE_EMPTY to clear the tile
+ @return Whether the tile was on the map or not
+ */
+SDL_bool AE_Tilemap_SetTile(AE_Tilemap* map, int x, int y, Uint16 id)
+{
+    int cell;
+    AE_TilemapChunk* chunk = AE_Tilemap_FindChunk(map, x, y, &cell);
+    
+    if (chunk == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    Uint16 previous = chunk->tiles[cell];
+    if (previous == id)
+    {
+        return SDL_TRUE;
+    }
+    chunk->tiles[cell] = id;
+    chunk->tileCount += (id != AE_TILE_EMPTY) - (previous != AE_TILE_EMPTY);
+    
+    //A built chunk only rewrites the tile's own quad, and its indices if the tile started or stopped being drawn
+    if (chunk->isBuilt)
+    {
+        chunk->variants[cell] = AE_Tilemap_PickVariant(map, id, x, y);
+        AE_Tilemap_WriteTexCoords(map, chunk, cell);
+        if (AE_Tilemap_IsDrawn(map, previous) != AE_Tilemap_IsDrawn(map, id))
+        {
+            chunk->indicesDirty = SDL_TRUE;
+        }
+        map->stats.patchedTiles++;
+    }
+    
+    return SDL_TRUE;
+}
+
+/**
+ Gets a tile of a tilemap
+
+ @param map The AE_Tilemap the tile is on
+ @param x The x of the tile
+ @param y The y of the tile
+ @return The tile id, or AE_TILE_EMPTY if the tile is off the map
+ */
+Uint16 AE_Tilemap_GetTile(AE_Tilemap* map, int x, int y)
+{
+    int cell;
+    AE_TilemapChunk* chunk = AE_Tilemap_FindChunk(map, x, y, &cell);
+    
+    return (chunk != NULL) ? chunk->tiles[cell] : AE_TILE_EMPTY;
+}
+
+/**
+ Sets the color and alpha modulation every tile of a tilemap is drawn with
+
+ @param map The AE_Tilemap whose modulation will be set
+ @param color The color modulation
+ @param alpha The alpha modulation
+ */
+void AE_Tilemap_SetColor(AE_Tilemap* map, AE_ColorBundle color, Uint8 alpha)
+{
+    if (color.r == map->color.r && color.g == map->color.g && color.b == map->color.b && alpha == map->alpha)
+    {
+        return;
+    }
+    map->color = color;
+    map->alpha = alpha;
+    
+    //The modulation is carried by the vertex colors
+    AE_Tilemap_InvalidateChunks(map);
+}
+
+/**
+ Draws the chunks of a tilemap that are inside the renderer's viewport, with one draw call per chunk
+
+ @param map The AE_Tilemap to be drawn
+ @param renderer The renderer the tilemap will be drawn on
+ @param camera_x The x on the map drawn at the left edge of the viewport
+ @param camera_y The y on the map drawn at the top edge of the viewport
+ @return Whether every visible chunk was drawn successfully or not
+ */
+SDL_bool AE_Tilemap_Render(AE_Tilemap* map, SDL_Renderer* renderer, int camera_x, int camera_y)
+{
+    SDL_bool success = SDL_TRUE;
+    const int chunkWidth = AE_TILEMAP_CHUNK_SIZE * map->tileWidth;
+    const int chunkHeight = AE_TILEMAP_CHUNK_SIZE * map->tileHeight;
+    SDL_Rect viewport;
+    
+    //A tileset that is still loading has nothing to draw yet
+    if (map->tileset->texture == NULL)
+    {
+        return SDL_FALSE;
+    }
+    AE_PROFILE_BEGIN("AE_Tilemap_Render");
+    map->renderCount++;
+    
+    //A tileset that finished loading or was changed may have a new size, which moves every texture coordinate
+    if (map->tileset->version != map->tilesetVersion)
+    {
+        map->tilesetVersion = map->tileset->version;
+        AE_Tilemap_InvalidateChunks(map);
+    }
+    
+    //Only the chunks overlapping the viewport are drawn
+    SDL_RenderGetViewport(renderer, &viewport);
+    const int firstX = SDL_max(AE_Tilemap_FloorDivide(camera_x, chunkWidth), 0);
+    const int firstY = SDL_max(AE_Tilemap_FloorDivide(camera_y, chunkHeight), 0);
+    const int lastX = SDL_min(AE_Tilemap_FloorDivide(camera_x + viewport.w - 1, chunkWidth), map->chunksWide - 1);
+    const int lastY = SDL_min(AE_Tilemap_FloorDivide(camera_y + viewport.h - 1, chunkHeight), map->chunksHigh - 1);
+    
+    //Vertex colors carry the modulation, so the texture's own modulation has to be neutral
+    AE_ColorBundle neutral = {255, 255, 255};
+    AE_SetTextureModulation(renderer, map->tileset->texture, neutral, 255);
+    
+    for (int chunkY = firstY; chunkY<=lastY; chunkY++)
+    {
+        for (int chunkX = firstX; chunkX<=lastX; chunkX++)
+        {
+            const int chunkIndex = chunkY * map->chunksWide + chunkX;
+            AE_TilemapChunk* chunk = &map->chunks[chunkIndex];
+            const int offsetX = chunkX * chunkWidth - camera_x;
+            const int offsetY = chunkY * chunkHeight - camera_y;
+            
+            if (chunk->tileCount == 0)
+            {
+                continue;
+            }
+            
+            if (!chunk->isBuilt)
+            {
+                if (!AE_Tilemap_BuildChunk(map, chunkIndex, offsetX, offsetY))
+                {
+                    success = SDL_FALSE;
+                    continue;
+                }
+            }
+            //The camera moved, so the cached vertices are moved with it (positions are whole numbers, so this is exact however often it happens)
+            else if (offsetX != chunk->offsetX || offsetY != chunk->offsetY)
+            {
+                const float moveX = (float)(offsetX - chunk->offsetX);
+                const float moveY = (float)(offsetY - chunk->offsetY);
+                for (int i = 0; i<AE_TILEMAP_CHUNK_TILES * 4; i++)
+                {
+                    chunk->vertices[i].position.x += moveX;
+                    chunk->vertices[i].position.y += moveY;
+                }
+                chunk->offsetX = offsetX;
+                chunk->offsetY = offsetY;
+            }
+            if (chunk->indicesDirty)
+            {
+                AE_Tilemap_BuildIndices(map, chunk);
+            }
+            chunk->lastRender = map->renderCount;
+            
+            if (chunk->indexCount > 0)
+            {
+                if (SDL_RenderGeometry(renderer, map->tileset->texture, chunk->vertices, AE_TILEMAP_CHUNK_TILES * 4, chunk->indices, chunk->indexCount) != 0)
+                {
+                    success = SDL_FALSE;
+                }
+                map->stats.drawnChunks++;
+                map->stats.drawnTiles += (Uint64)(chunk->indexCount / 6);
+            }
+        }
+    }
+    
+    //Chunks that haven't been drawn for a while give their geometry back, and are built again if they come back into view
+    for (int i = 0; i<map->builtCount; i++)
+    {
+        AE_TilemapChunk* chunk = &map->chunks[map->builtChunks[i]];
+        if (map->renderCount - chunk->lastRender > AE_TILEMAP_KEEP_RENDERS)
+        {
+            SDL_free(chunk->vertices);
+            SDL_free(chunk->indices);
+            chunk->vertices = NULL;
+            chunk->indices = NULL;
+            chunk->isBuilt = SDL_FALSE;
+            map->builtChunks[i--] = map->builtChunks[--map->builtCount];
+        }
+    }
+    
+    AE_PROFILE_END();
+    return success;
+}
+
+/**
+ Gets how much drawing and rebuilding a tilemap has done since its statistics were last reset
+
+ @param map The AE_Tilemap whose statistics will be retrieved
+ @return The statistics of the tilemap
+ */
+AE_TilemapStats AE_Tilemap_GetStats(AE_Tilemap* map)
+{
+    return map->stats;
+}
+
+/**
+ Resets the statistics of a tilemap
+
+ @param map The AE_Tilemap whose statistics will be reset
+ */
+void AE_Tilemap_ResetStats(AE_Tilemap* map)
+{
+    SDL_zero(map->stats);
+}
+
+/**
+ Frees and destroys an AE_Tilemap and every chunk in it
+
+ @param map The AE_Tilemap to be destroyed
+ */
+void AE_DestroyTilemap(AE_Tilemap* map)
+{
+    for (int i = 0; i<map->builtCount; i++)
+    {
+        SDL_free(map->chunks[map->builtChunks[i]].vertices);
+        SDL_free(map->chunks[map->builtChunks[i]].indices);
+    }
+    SDL_free(map->chunks);
+    SDL_free(map->builtChunks);
+    SDL_free(map->types);
+    
+    if (map->tileset != NULL)
+    {
+        AE_LinkedTexture_Leave(map->tileset, map);
+    }
+    SDL_free(map);
+}
+
+//
+//
+//End: Tilemap Functions
+//
+//
+
+
+//
+//
+//Start: Sprite Pool Functions
+//
+//
+
+//A sprite handle holds the slot of the sprite in its low bits and the generation of the slot in its high bits
+#define AE_SPRITEPOOL_SLOT_BITS 20
+#define AE_SPRITEPOOL_SLOT_MASK ((1u << AE_SPRITEPOOL_SLOT_BITS) - 1)
+#define AE_SPRITEPOOL_GENERATION_MASK (0xFFFFFFFFu >> AE_SPRITEPOOL_SLOT_BITS)
+
+/**
+ Resizes every array in a pool
+
+ @param pool The AE_SpritePool to be resized
+ @param capacity The new number of sprites the pool will have room for
+ @return Whether every array was resized or not
+ */
+static SDL_bool AE_SpritePool_Resize(AE_SpritePool* pool, int capacity)
+{
+    //Every per-sprite array, along with the size of one element
+    void** arrays[] = {
+        (void**)&pool->x, (void**)&pool->y,
+        (void**)&pool->frameRect, (void**)&pool->frameCount, (void**)&pool->fixedFrame, (void**)&pool->currentFrame, (void**)&pool->frameSpeed,
+        (void**)&pool->x_scale, (void**)&pool->y_scale, (void**)&pool->angle, (void**)&pool->pivot, (void**)&pool->flip,
+        (void**)&pool->color, (void**)&pool->alpha, (void**)&pool->visible,
+        (void**)&pool->denseToSlot, (void**)&pool->slotToDense, (void**)&pool->slotGeneration, (void**)&pool->freeSlots
+    };
+    size_t sizes[] = {
+        sizeof(float), sizeof(float),
+        sizeof(SDL_Rect), sizeof(int), sizeof(int), sizeof(float), sizeof(float),
+        sizeof(float), sizeof(float), sizeof(double), sizeof(SDL_Point), sizeof(SDL_RendererFlip),
+        sizeof(AE_ColorBundle), sizeof(Uint8), sizeof(Uint8),
+        sizeof(Uint32), sizeof(Uint32), sizeof(Uint32), sizeof(Uint32)
+    };
+    
+    for (int i = 0; i<(int)SDL_arraysize(arrays); i++)
+    {
+        void* resized = SDL_realloc(*arrays[i], sizes[i] * capacity);
+        if (resized == NULL)
+        {
+            return SDL_FALSE;
+        }
+        *arrays[i] = resized;
+    }
+    pool->capacity = capacity;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Finds where the sprite of a handle is stored in a pool's arrays
+
+ @param pool The AE_SpritePool the sprite would be in
+ @param handle The handle of the sprite
+ @return The index of the sprite in the pool's arrays, or -1 if the handle is not valid
+ */
+static int AE_SpritePool_Resolve(AE_SpritePool* pool, AE_SpriteHandle handle)
+{
+    Uint32 slot = handle & AE_SPRITEPOOL_SLOT_MASK;
+    Uint32 generation = handle >> AE_SPRITEPOOL_SLOT_BITS;
+    
+    if (handle == AE_SPRITEHANDLE_INVALID || slot >= (Uint32)pool->slotCount || pool->slotGeneration[slot] != generation)
+    {
+        return -1;
+    }
+    return (int)pool->slotToDense[slot];
+}
+
+/**
+ Creates a new, empty AE_SpritePool
+
+ @param spriteSheet The LinkedTexture every sprite in the pool will be drawn from
+ @param capacity The number of sprites the pool will have room for before it needs to grow (0 or less for the default)
+ @return The new AE_SpritePool, or NULL if it could not be allocated or could not join the sprite sheet
+ */
+AE_SpritePool* AE_CreateSpritePool(AE_LinkedTexture* spriteSheet, int capacity)
+{
+    AE_SpritePool* output = SDL_calloc(1, sizeof(AE_SpritePool));
+    
+    //Default to room for 1024 sprites
+    if (capacity <= 0)
+    {
+        capacity = 1024;
+    }
+    
+    if (!AE_SpritePool_Resize(output, capacity))
+    {
+        AE_DestroySpritePool(output);
+        return NULL;
+    }
+    
+    //The whole pool is a single stakeholder of the sprite sheet
+    if (!AE_LinkedTexture_Join(spriteSheet, output))
+    {
+        AE_DestroySpritePool(output);
+        return NULL;
+    }
+    output->spriteSheet = spriteSheet;
+    
+    return output;
+}
+
+/**
+ Adds a sprite to a pool, with all other attributes set to the same defaults as AE_CreateSprite
+
+ @param pool The AE_SpritePool the sprite will be added to
+ @param reference_x The x of the sprite on the spritesheet
+ @param reference_y The y of the sprite on the spritesheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame
+ @param height The height of a single sprite frame
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return The handle of the new sprite, or AE_SPRITEHANDLE_INVALID if it could not be added
+ */
+AE_SpriteHandle AE_SpritePool_Add(AE_SpritePool* pool, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y)
+{
+    Uint32 slot;
+    
+    //Double the pool when it runs out of room
+    if (pool->count == pool->capacity && !AE_SpritePool_Resize(pool, pool->capacity * 2))
+    {
+        return AE_SPRITEHANDLE_INVALID;
+    }
+    
+    //Reuse a removed sprite's slot if there is one, otherwise take a new slot
+    if (pool->freeSlotCount > 0)
+    {
+        slot = pool->freeSlots[--pool->freeSlotCount];
+    }
+    else
+    {
+        if ((Uint32)pool->slotCount > AE_SPRITEPOOL_SLOT_MASK)
+        {
+            return AE_SPRITEHANDLE_INVALID;
+        }
+        slot = pool->slotCount++;
+        pool->slotGeneration[slot] = 1;
+    }
+    
+    int i = pool->count++;
+    pool->slotToDense[slot] = i;
+    pool->denseToSlot[i] = slot;
+    
+    pool->x[i] = 0;
+    pool->y[i] = 0;
+    
+    //Frames run along the width of the sprite sheet, so only the first frame needs to be stored
+    pool->frameRect[i].x = reference_x;
+    pool->frameRect[i].y = reference_y;
+    pool->frameRect[i].w = width;
+    pool->frameRect[i].h = height;
+    pool->frameCount[i] = frameCount;
+    pool->fixedFrame[i] = -1;
+    pool->currentFrame[i] = 0;
+    //Default frame speed is 30
+    pool->frameSpeed[i] = 30;
+    
+    pool->x_scale[i] = 1;
+    pool->y_scale[i] = 1;
+    pool->angle[i] = 0.0;
+    pool->pivot[i].x = pivot_x;
+    pool->pivot[i].y = pivot_y;
+    pool->flip[i] = SDL_FLIP_NONE;
+    
+    pool->color[i].r = 255;
+    pool->color[i].g = 255;
+    pool->color[i].b = 255;
+    pool->alpha[i] = 255;
+    //New sprites are drawn until the pool is next culled
+    pool->visible[i] = 1;
+    
+    return (pool->slotGeneration[slot] << AE_SPRITEPOOL_SLOT_BITS) | slot;
+}
+
+/**
+ Removes a sprite from a pool
+
+ @param pool The AE_SpritePool the sprite will be removed from
+ @param handle The handle of the sprite to be removed
+ @return Whether the sprite was removed or not
+ */
+SDL_bool AE_SpritePool_Remove(AE_SpritePool* pool, AE_SpriteHandle handle)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    
+    if (i < 0)
+    {
+        return SDL_FALSE;
+    }
+    
+    Uint32 slot = handle & AE_SPRITEPOOL_SLOT_MASK;
+    int last = --pool->count;
+    
+    //Move the last sprite into the hole so the arrays stay contiguous
+    if (i != last)
+    {
+        pool->x[i] = pool->x[last];
+        pool->y[i] = pool->y[last];
+        pool->frameRect[i] = pool->frameRect[last];
+        pool->frameCount[i] = pool->frameCount[last];
+        pool->fixedFrame[i] = pool->fixedFrame[last];
+        pool->currentFrame[i] = pool->currentFrame[last];
+        pool->frameSpeed[i] = pool->frameSpeed[last];
+        pool->x_scale[i] = pool->x_scale[last];
+        pool->y_scale[i] = pool->y_scale[last];
+        pool->angle[i] = pool->angle[last];
+        pool->pivot[i] = pool->pivot[last];
+        pool->flip[i] = pool->flip[last];
+        pool->color[i] = pool->color[last];
+        pool->alpha[i] = pool->alpha[last];
+        pool->visible[i] = pool->visible[last];
+        
+        pool->denseToSlot[i] = pool->denseToSlot[last];
+        pool->slotToDense[pool->denseToSlot[i]] = i;
+    }
+    
+    //Bump the generation so old handles to the slot stop being valid (0 is never used so a handle is never 0)
+    pool->slotGeneration[slot] = (pool->slotGeneration[slot] + 1) & AE_SPRITEPOOL_GENERATION_MASK;
+    if (pool->slotGeneration[slot] == 0)
+    {
+        pool->slotGeneration[slot] = 1;
+    }
+    pool->freeSlots[pool->freeSlotCount++] = slot;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Returns whether a handle refers to a sprite in a pool
+
+ @param pool The AE_SpritePool the sprite would be in
+ @param handle The handle to be checked
+ @return Whether the handle refers to a sprite in the pool or not
+ */
+SDL_bool AE_SpritePool_IsValid(AE_SpritePool* pool, AE_SpriteHandle handle)
+{
+    return AE_SpritePool_Resolve(pool, handle) >= 0;
+}
+
+/**
+ Gets the number of sprites in a pool
+
+ @param pool The AE_SpritePool whose sprites will be counted
+ @return The number of sprites in the pool
+ */
+int AE_SpritePool_GetCount(AE_SpritePool* pool)
+{
+    return pool->count;
+}
+
+/**
+ Sets the position a pooled sprite will be drawn at
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ */
+void AE_SpritePool_SetPosition(AE_SpritePool* pool, AE_SpriteHandle handle, float x, float y)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        pool->x[i] = x;
+        pool->y[i] = y;
+    }
+}
+
+/**
+ Gets the position a pooled sprite will be drawn at
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param x Filled with the x coordinate of the sprite
+ @param y Filled with the y coordinate of the sprite
+ */
+void AE_SpritePool_GetPosition(AE_SpritePool* pool, AE_SpriteHandle handle, float* x, float* y)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        *x = pool->x[i];
+        *y = pool->y[i];
+    }
+}
+
+/**
+ Sets which frame a pooled sprite is drawn on
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param currentFrame The frame the sprite will be drawn on (-1 or less for an animation loop)
+ */
+void AE_SpritePool_SetFrame(AE_SpritePool* pool, AE_SpriteHandle handle, int currentFrame)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        //Changing between a fixed frame and the loop restarts the loop, just like AE_SpriteRender
+        if ((currentFrame < 0) != (pool->fixedFrame[i] < 0))
+        {
+            pool->currentFrame[i] = 0;
+        }
+        pool->fixedFrame[i] = (currentFrame < 0) ? -1 : currentFrame;
+    }
+}
+
+/**
+ Sets the frame speed of a pooled sprite
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param frameSpeed The speed the sprite will be set to
+ */
+void AE_SpritePool_SetFrameSpeed(AE_SpritePool* pool, AE_SpriteHandle handle, float frameSpeed)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        pool->frameSpeed[i] = frameSpeed;
+    }
+}
+
+/**
+ Sets the scale of a pooled sprite
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param x_scale The new scale on the x axis
+ @param y_scale The new scale on the y axis
+ */
+void AE_SpritePool_SetScale(AE_SpritePool* pool, AE_SpriteHandle handle, float x_scale, float y_scale)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        pool->x_scale[i] = x_scale;
+        pool->y_scale[i] = y_scale;
+    }
+}
+
+/**
+ Sets the angle of a pooled sprite
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param angle The angle of the sprite
+ */
+void AE_SpritePool_SetAngle(AE_SpritePool* pool, AE_SpriteHandle handle, double angle)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        pool->angle[i] = angle;
+    }
+}
+
+/**
+ Sets the rendererflip of a pooled sprite
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param flip The desired rendererflip type
+ */
+void AE_SpritePool_SetFlip(AE_SpritePool* pool, AE_SpriteHandle handle, SDL_RendererFlip flip)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        pool->flip[i] = flip;
+    }
+}
+
+/**
+ Sets the color of a pooled sprite
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param color The color the sprite will be set to
+ */
+void AE_SpritePool_SetColor(AE_SpritePool* pool, AE_SpriteHandle handle, AE_ColorBundle color)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        pool->color[i] = color;
+    }
+}
+
+/**
+ Sets the alpha of a pooled sprite
+
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param alpha The alpha the sprite will be set to
+ */
+void AE_SpritePool_SetAlpha(AE_SpritePool* pool, AE_SpriteHandle handle, Uint8 alpha)
+{
+    int i = AE_SpritePool_Resolve(pool, handle);
+    if (i >= 0)
+    {
+        pool->alpha[i] = alpha;
+    }
+}
+
+/**
+ Advances the animation loop of every looping sprite in a pool
+
+ @param pool The AE_SpritePool whose sprites will be animated
+ @param step The timestep the sprites will be animated at
+ */
+void AE_SpritePool_Update(AE_SpritePool* pool, float step)
+{
+    //Sprites on a fixed frame are advanced too, but their loop restarts once they go back to looping
+    AE_Sprites_Advance(pool->currentFrame, pool->frameSpeed, pool->frameCount, pool->count, step);
+}
+
+/**
+ Draws every sprite in a pool, except those culled by the last AE_SpritePool_Cull
+
+ @param pool The AE_SpritePool whose sprites will be drawn
+ @param renderer The renderer the sprites will be drawn on
+ @param batch The AE_SpriteBatch the sprites will be merged through (NULL to draw each one on its own)
+ @return Whether every sprite was drawn successfully or not
+ */
+SDL_bool AE_SpritePool_Render(AE_SpritePool* pool, SDL_Renderer* renderer, AE_SpriteBatch* batch)
+{
+    SDL_bool success = SDL_TRUE;
+    
+    //A sprite sheet that is still loading has nothing to draw yet
+    if (pool->spriteSheet == NULL || pool->spriteSheet->texture == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    for (int i = 0; i<pool->count; i++)
+    {
+        int drawFrame = pool->fixedFrame[i];
+        
+        if (!pool->visible[i])
+        {
+            continue;
+        }
+        
+        //Looping sprites draw the frame their loop is on
+        if (drawFrame < 0)
+        {
+            drawFrame = (pool->frameCount[i] > 1) ? (int)fmodf(pool->currentFrame[i], (float)(pool->frameCount[i] - 1)) : 0;
+        }
+        else if (drawFrame >= pool->frameCount[i])
+        {
+            drawFrame = pool->frameCount[i] - 1;
+        }
+        
+        SDL_Rect frame = pool->frameRect[i];
+        frame.x += frame.w * drawFrame;
+        
+        SDL_Rect drawRect;
+        drawRect.x = (int)pool->x[i];
+        drawRect.y = (int)pool->y[i];
+        drawRect.w = (int)(((float)pool->frameRect[i].w) * pool->x_scale[i]);
+        drawRect.h = (int)(((float)pool->frameRect[i].h) * pool->y_scale[i]);
+        
+        if (batch != NULL)
+        {
+            if (!AE_SpriteBatch_Submit(batch, pool->spriteSheet, &frame, &drawRect, pool->angle[i], &pool->pivot[i], pool->flip[i], pool->color[i], pool->alpha[i]))
+            {
+                success = SDL_FALSE;
+            }
+        }
+        else
+        {
+            AE_SetTextureModulation(renderer, pool->spriteSheet->texture, pool->color[i], pool->alpha[i]);
+            if (SDL_RenderCopyEx(renderer, pool->spriteSheet->texture, &frame, &drawRect, pool->angle[i], &pool->pivot[i], pool->flip[i]) != 0)
+            {
+                success = SDL_FALSE;
+            }
+        }
+    }
+    
+    return success;
+}
+
+/**
+ Frees and destroys an AE_SpritePool and every sprite in it
+
+ @param pool The AE_SpritePool to be destroyed
+ */
+void AE_DestroySpritePool(AE_SpritePool* pool)
+{
+    if (pool != NULL)
+    {
+        if (pool->spriteSheet != NULL)
+        {
+            AE_LinkedTexture_Leave(pool->spriteSheet, pool);
+        }
+        SDL_free(pool->x);
+        SDL_free(pool->y);
+        SDL_free(pool->frameRect);
+        SDL_free(pool->frameCount);
+        SDL_free(pool->fixedFrame);
+        SDL_free(pool->currentFrame);
+        SDL_free(pool->frameSpeed);
+        SDL_free(pool->x_scale);
+        SDL_free(pool->y_scale);
+        SDL_free(pool->angle);
+        SDL_free(pool->pivot);
+        SDL_free(pool->flip);
+        SDL_free(pool->color);
+        SDL_free(pool->alpha);
+        SDL_free(pool->visible);
+        SDL_free(pool->denseToSlot);
+        SDL_free(pool->slotToDense);
+        SDL_free(pool->slotGeneration);
+        SDL_free(pool->freeSlots);
+        SDL_free(pool);
+    }
+}
+
+//
+//
+//End: Sprite Pool Functions
+//
+//
+
+
+//
+//
+//Start: Bulk Sprite Animation Functions
+//
+//
+
+//The instruction set asked for, and the one actually in use (AE_SIMD_AUTO until it is first needed)
+static AE_SimdLevel AE_simdLevelRequested = AE_SIMD_AUTO;
+static AE_SimdLevel AE_simdLevel = AE_SIMD_AUTO;
+
+/**
+ Sets the instruction set the engine's bulk kernels run on. Levels the CPU does not support fall back to the best one it does
+
+ @param level The instruction set to use (AE_SIMD_AUTO for the best one available)
+ */
+void AE_SetSimdLevel(AE_SimdLevel level)
+{
+    AE_simdLevelRequested = level;
+    AE_simdLevel = AE_SIMD_AUTO;
+}
+
+/**
+ Gets the instruction set the engine's bulk kernels currently run on
+
+ @return The instruction set in use
+ */
+AE_SimdLevel AE_GetSimdLevel()
+{
+    if (AE_simdLevel == AE_SIMD_AUTO)
+    {
+        //Find the best instruction set the CPU supports
+        AE_SimdLevel supported = AE_SIMD_SCALAR;
+#ifdef AE_X86_SIMD
+        if (SDL_HasAVX2())
+        {
+            supported = AE_SIMD_AVX2;
+        }
+        else if (SDL_HasSSE2())
+        {
+            supported = AE_SIMD_SSE2;
+        }
+#endif
+        //Use the requested one unless the CPU can't run it
+        if (AE_simdLevelRequested == AE_SIMD_AUTO || AE_simdLevelRequested > supported)
+        {
+            AE_simdLevel = supported;
+        }
+        else
+        {
+            AE_simdLevel = AE_simdLevelRequested;
+        }
+    }
+    return AE_simdLevel;
+}
+
+/**
+ Advances the animation loops of a range of sprites one at a time. This is the reference every SIMD version has to match bit for bit
+
+ @param currentFrames The current loop frame of each sprite, which will be advanced
+ @param frameSpeeds The frame speed of each sprite
+ @param frameCounts The number of frames in each sprite
+ @param start The first sprite to be advanced
+ @param end One past the last sprite to be advanced
+ @param step The timestep the sprites will be animated at
+ */
+AE_NO_FP_CONTRACT static void AE_Sprites_Advance_Scalar(float* currentFrames, const float* frameSpeeds, const int* frameCounts, int start, int end, float step)
+{
+    for (int i = start; i<end; i++)
+    {
+        float frame = currentFrames[i] + ((frameSpeeds[i]/2)*step);
+        
+        //Wrap the loop the same way AE_SpriteRender does (a single frame sprite has nothing to loop through)
+        if (frame >= (float)frameCounts[i])
+        {
+            frame = (frameCounts[i] > 1) ? fmodf(frame, (float)(frameCounts[i] - 1)) : 0;
+        }
+        currentFrames[i] = frame;
+    }
+}
+
+#ifdef AE_X86_SIMD
+/**
+ Advances the animation loops of an array of sprites 4 at a time with SSE2
+
+ @param currentFrames The current loop frame of each sprite, which will be advanced
+ @param frameSpeeds The frame speed of each sprite
+ @param frameCounts The number of frames in each sprite
+ @param count The number of sprites
+ @param step The timestep the sprites will be animated at
+ */
+AE_NO_FP_CONTRACT AE_TARGET_SSE2 static void AE_Sprites_Advance_SSE2(float* currentFrames, const float* frameSpeeds, const int* frameCounts, int count, float step)
+{
+    //Halving by multiplying by 0.5 gives the exact same result as dividing by 2
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 steps = _mm_set1_ps(step);
+    const __m128i one = _mm_set1_epi32(1);
+    int i = 0;
+    
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 frame = _mm_add_ps(_mm_loadu_ps(&currentFrames[i]), _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&frameSpeeds[i]), half), steps));
+        __m128i counts = _mm_loadu_si128((const __m128i*)&frameCounts[i]);
+        __m128 wrap = _mm_cmpge_ps(frame, _mm_cvtepi32_ps(counts));
+        
+        if (_mm_movemask_ps(wrap))
+        {
+            __m128 loopEnd = _mm_cvtepi32_ps(_mm_sub_epi32(counts, one));
+            __m128 looping = _mm_castsi128_ps(_mm_cmpgt_epi32(counts, one));
+            
+            //Between loopEnd and twice loopEnd, fmodf is a single exact subtraction. Anything past that is left to the scalar version
+            __m128 farPast = _mm_cmpge_ps(frame, _mm_add_ps(loopEnd, loopEnd));
+            if (_mm_movemask_ps(_mm_and_ps(_mm_and_ps(wrap, looping), farPast)))
+            {
+                AE_Sprites_Advance_Scalar(currentFrames, frameSpeeds, frameCounts, i, i + 4, step);
+                continue;
+            }
+            
+            //Single frame sprites wrap to 0
+            __m128 wrapped = _mm_and_ps(looping, _mm_sub_ps(frame, loopEnd));
+            frame = _mm_or_ps(_mm_and_ps(wrap, wrapped), _mm_andnot_ps(wrap, frame));
+        }
+        _mm_storeu_ps(&currentFrames[i], frame);
+    }
+    
+    //Finish off the sprites that don't fill a whole register
+    AE_Sprites_Advance_Scalar(currentFrames, frameSpeeds, frameCounts, i, count, step);
+}
+
+/**
+ Advances the animation loops of an array of sprites 8 at a time with AVX2
+
+ @param currentFrames The current loop frame of each sprite, which will be advanced
+ @param frameSpeeds The frame speed of each sprite
+ @param frameCounts The number of frames in each sprite
+ @param count The number of sprites
+ @param step The timestep the sprites will be animated at
+ */
+AE_NO_FP_CONTRACT AE_TARGET_AVX2 static void AE_Sprites_Advance_AVX2(float* currentFrames, const float* frameSpeeds, const int* frameCounts, int count, float step)
+{
+    //Halving by multiplying by 0.5 gives the exact same result as dividing by 2
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 steps = _mm256_set1_ps(step);
+    const __m256i one = _mm256_set1_epi32(1);
+    int i = 0;
+    
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 frame = _mm256_add_ps(_mm256_loadu_ps(&currentFrames[i]), _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&frameSpeeds[i]), half), steps));
+        __m256i counts = _mm256_loadu_si256((const __m256i*)&frameCounts[i]);
+        __m256 wrap = _mm256_cmp_ps(frame, _mm256_cvtepi32_ps(counts), _CMP_GE_OQ);
+        
+        if (_mm256_movemask_ps(wrap))
+        {
+            __m256 loopEnd = _mm256_cvtepi32_ps(_mm256_sub_epi32(counts, one));
+            __m256 looping = _mm256_castsi256_ps(_mm256_cmpgt_epi32(counts, one));
+            
+            //Between loopEnd and twice loopEnd, fmodf is a single exact subtraction. Anything past that is left to the scalar version
+            __m256 farPast = _mm256_cmp_ps(frame, _mm256_add_ps(loopEnd, loopEnd), _CMP_GE_OQ);
+            if (_mm256_movemask_ps(_mm256_and_ps(_mm256_and_ps(wrap, looping), farPast)))
+            {
+                AE_Sprites_Advance_Scalar(currentFrames, frameSpeeds, frameCounts, i, i + 8, step);
+                continue;
+            }
+            
+            //Single frame sprites wrap to 0
+            __m256 wrapped = _mm256_and_ps(looping, _mm256_sub_ps(frame, loopEnd));
+            frame = _mm256_blendv_ps(frame, wrapped, wrap);
+        }
+        _mm256_storeu_ps(&currentFrames[i], frame);
+    }
+    
+    //Finish off the sprites that don't fill a whole register
+    AE_Sprites_Advance_Scalar(currentFrames, frameSpeeds, frameCounts, i, count, step);
+}
+#endif
+
+/**
+ Advances the animation loops of an array of sprites, wrapping each one exactly as AE_SpriteRender does. Every instruction set gives bit-identical results
+
+ @param currentFrames The current loop frame of each sprite, which will be advanced
+ @param frameSpeeds The frame speed of each sprite
+ @param frameCounts The number of frames in each sprite
+ @param count The number of sprites
+ @param step The timestep the sprites will be animated at
+ */
+AE_NO_FP_CONTRACT void AE_Sprites_Advance(float* currentFrames, const float* frameSpeeds, const int* frameCounts, int count, float step)
+{
+    switch (AE_GetSimdLevel())
+    {
+#ifdef AE_X86_SIMD
+        case AE_SIMD_AVX2:
+            AE_Sprites_Advance_AVX2(currentFrames, frameSpeeds, frameCounts, count, step);
+            break;
+        case AE_SIMD_SSE2:
+            AE_Sprites_Advance_SSE2(currentFrames, frameSpeeds, frameCounts, count, step);
+            break;
+#endif
+        default:
+            AE_Sprites_Advance_Scalar(currentFrames, frameSpeeds, frameCounts, 0, count, step);
+            break;
+    }
+}
+
+//
+//
+//End: Bulk Sprite Animation Functions
+//
+//
+
+//
+//
+//Start: Culling Functions
+//
+//
+
+/**
+ Gets a conservative bounding box of a rectangle drawn the way SDL_RenderCopyEx draws it
+
+ @param drawRect The rectangle before rotation
+ @param angle The angle in degrees the rectangle is rotated clockwise by
+ @param pivot The point the rectangle is rotated around, relative to drawRect (NULL for the center)
+ @param bounds Gets the smallest whole-pixel rectangle containing the rotated rectangle
+ */
+void AE_GetRotatedBounds(const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_Rect* bounds)
+{
+    double minx;
+    double maxx;
+    double miny;
+    double maxy;
+    
+    //Unrotated rectangles (the common case) skip the trigonometry
+    if (angle == 0.0)
+    {
+        minx = (double)SDL_min(drawRect->x, drawRect->x + drawRect->w);
+        maxx = (double)SDL_max(drawRect->x, drawRect->x + drawRect->w);
+        miny = (double)SDL_min(drawRect->y, drawRect->y + drawRect->h);
+        maxy = (double)SDL_max(drawRect->y, drawRect->y + drawRect->h);
+    }
+    else
+    {
+        //SDL rotates around the center when there is no pivot
+        const double centerx = (pivot != NULL) ? (double)pivot->x : (double)drawRect->w / 2.0;
+        const double centery = (pivot != NULL) ? (double)pivot->y : (double)drawRect->h / 2.0;
+        const double radian_angle = (M_PI * angle) / 180.0;
+        const double s = SDL_sin(radian_angle);
+        const double c = SDL_cos(radian_angle);
+        const double cornersx[4] = {-centerx, drawRect->w - centerx, drawRect->w - centerx, -centerx};
+        const double cornersy[4] = {-centery, -centery, drawRect->h - centery, drawRect->h - centery};
+        
+        minx = maxx = miny = maxy = 0;
+        for (int i = 0; i<4; i++)
+        {
+            double rotatedx = (cornersx[i] * c) - (cornersy[i] * s);
+            double rotatedy = (cornersx[i] * s) + (cornersy[i] * c);
+            
+            minx = (i == 0) ? rotatedx : SDL_min(minx, rotatedx);
+            maxx = (i == 0) ? rotatedx : SDL_max(maxx, rotatedx);
+            miny = (i == 0) ? rotatedy : SDL_min(miny, rotatedy);
+            maxy = (i == 0) ? rotatedy : SDL_max(maxy, rotatedy);
+        }
+        
+        //Move the rotated corners back around the pivot, with a pixel of slack for the renderer's own rounding
+        minx += drawRect->x + centerx - 1.0;
+        maxx += drawRect->x + centerx + 1.0;
+        miny += drawRect->y + centery - 1.0;
+        maxy += drawRect->y + centery + 1.0;
+    }
+    
+    bounds->x = (int)SDL_floor(minx);
+    bounds->y = (int)SDL_floor(miny);
+    bounds->w = (int)SDL_ceil(maxx) - bounds->x;
+    bounds->h = (int)SDL_ceil(maxy) - bounds->y;
+}
+
+/**
+ Gets the bounds a sprite would cover if it were drawn at the given coordinates, including its scale, angle and pivot
+
+ @param sprite The sprite whose bounds will be found
+ @param x The x coordinate the sprite would be drawn at
+ @param y The y coordinate the sprite would be drawn at
+ @param bounds Gets the bounds of the sprite
+ */
+void AE_SpriteGetBounds(AE_Sprite* sprite, int x, int y, SDL_Rect* bounds)
+{
+    //The drawRect already has the sprite's scale applied
+    SDL_Rect drawRect = sprite->drawRect;
+    drawRect.x = x;
+    drawRect.y = y;
+    
+    AE_GetRotatedBounds(&drawRect, sprite->angle, &sprite->pivot, bounds);
+}
+
+/**
+ Sets up a culler with a view and zeroed counts
+
+ @param culler The AE_Culler to set up
+ @param view The view to cull against, in the same coordinates sprites are drawn at (a camera rect)
+ */
+void AE_Culler_SetView(AE_Culler* culler, const SDL_Rect* view)
+{
+    culler->view = *view;
+    AE_Culler_ResetCounts(culler);
+}
+
+/**
+ Sets up a culler with a renderer's current viewport and zeroed counts
+
+ @param culler The AE_Culler to set up
+ @param renderer The renderer whose viewport will be culled against
+ */
+void AE_Culler_SetViewFromRenderer(AE_Culler* culler, SDL_Renderer* renderer)
+{
+    SDL_Rect viewport;
+    
+    //Drawing coordinates are relative to the viewport, so only its size matters
+    SDL_RenderGetViewport(renderer, &viewport);
+    viewport.x = 0;
+    viewport.y = 0;
+    
+    AE_Culler_SetView(culler, &viewport);
+}
+
+/**
+ Zeroes a culler's drawn and culled counts, for the start of a new frame
+
+ @param culler The AE_Culler whose counts will be reset
+ */
+void AE_Culler_ResetCounts(AE_Culler* culler)
+{
+    culler->drawn = 0;
+    culler->culled = 0;
+}
+
+/**
+ Tests whether a sprite drawn at the given coordinates would be seen, and counts it as drawn or culled
+
+ @param culler The AE_Culler the sprite will be tested against
+ @param sprite The sprite to be tested
+ @param x The x coordinate the sprite would be drawn at
+ @param y The y coordinate the sprite would be drawn at
+ @return Whether the sprite would be seen or not
+ */
+SDL_bool AE_Culler_TestSprite(AE_Culler* culler, AE_Sprite* sprite, int x, int y)
+{
+    SDL_Rect bounds;
+    
+    AE_SpriteGetBounds(sprite, x, y, &bounds);
+    if (SDL_HasIntersection(&bounds, &culler->view))
+    {
+        culler->drawn++;
+        return SDL_TRUE;
+    }
+    culler->culled++;
+    return SDL_FALSE;
+}
+
+/**
+ Tests a list of sprites against a culler in one pass, counting each one as drawn or culled
+
+ @param culler The AE_Culler the sprites will be tested against
+ @param sprites The sprites to be tested
+ @param positions The coordinates each sprite would be drawn at
+ @param count The number of sprites
+ @param visible Gets whether each sprite would be seen (1) or not (0)
+ @return The number of sprites that would be seen
+ */
+int AE_Culler_CullSprites(AE_Culler* culler, AE_Sprite** sprites, const SDL_Point* positions, int count, Uint8* visible)
+{
+    int drawn = 0;
+    
+    for (int i = 0; i<count; i++)
+    {
+        visible[i] = (Uint8)AE_Culler_TestSprite(culler, sprites[i], positions[i].x, positions[i].y);
+        drawn += visible[i];
+    }
+    
+    return drawn;
+}
+
+/**
+ Tests every sprite in a pool against a culler in one pass. Sprites that would not be seen are skipped by AE_SpritePool_Render until the pool is culled again
+
+ @param pool The AE_SpritePool whose sprites will be tested
+ @param culler The AE_Culler the sprites will be tested against (NULL to mark every sprite as seen)
+ @return The number of sprites in the pool that would be seen
+ */
+int AE_SpritePool_Cull(AE_SpritePool* pool, AE_Culler* culler)
+{
+    int drawn = 0;
+    
+    if (culler == NULL)
+    {
+        SDL_memset(pool->visible, 1, pool->count);
+        return pool->count;
+    }
+    
+    for (int i = 0; i<pool->count; i++)
+    {
+        SDL_Rect drawRect;
+        SDL_Rect bounds;
+        
+        //Built the same way AE_SpritePool_Render builds it
+        drawRect.x = (int)pool->x[i];
+        drawRect.y = (int)pool->y[i];
+        drawRect.w = (int)(((float)pool->frameRect[i].w) * pool->x_scale[i]);
+        drawRect.h = (int)(((float)pool->frameRect[i].h) * pool->y_scale[i]);
+        
+        AE_GetRotatedBounds(&drawRect, pool->angle[i], &pool->pivot[i], &bounds);
+        pool->visible[i] = (Uint8)SDL_HasIntersection(&bounds, &culler->view);
+        drawn += pool->visible[i];
+    }
+    
+    culler->drawn += drawn;
+    culler->culled += pool->count - drawn;
+    
+    return drawn;
+}
+
+/**
+ Gets the number of sprites counted as drawn since the culler's counts were last reset
+
+ @param culler The AE_Culler whose count will be retrieved
+ @return The number of drawn sprites
+ */
+int AE_Culler_GetDrawn(AE_Culler* culler)
+{
+    return culler->drawn;
+}
+
+/**
+ Gets the number of sprites counted as culled since the culler's counts were last reset
+
+ @param culler The AE_Culler whose count will be retrieved
+ @return The number of culled sprites
+ */
+int AE_Culler_GetCulled(AE_Culler* culler)
+{
+    return culler->culled;
+}
+
+//
+//
+//End: Culling Functions
+//
+//
+
+//
+//
+//Start: Spatial Hash Functions
+//
+//
+
+//Handles use the same layout as sprite pool handles: the slot in the low bits and the slot's generation in the high bits
+#define AE_SPATIALHASH_SLOT_BITS 20
+#define AE_SPATIALHASH_SLOT_MASK ((1u << AE_SPATIALHASH_SLOT_BITS) - 1)
+#define AE_SPATIALHASH_GENERATION_MASK (0xFFFFFFFFu >> AE_SPATIALHASH_SLOT_BITS)
+//Ends a bucket's list, and marks a slot that holds no point
+#define AE_SPATIALHASH_NONE 0xFFFFFFFFu
+//Keeps cell coordinates far from overflowing when points are far from the origin
+#define AE_SPATIALHASH_CELL_LIMIT 0x3FFFFFFF
+
+/**
+ Gets the cell coordinate a position falls in
+
+ @param hash The AE_SpatialHash whose cells will be used
+ @param position The x or y of the position
+ @return The cell coordinate
+ */
+static Sint32 AE_SpatialHash_Cell(AE_SpatialHash* hash, float position)
+{
+    float cell = SDL_floorf(position * hash->inverseCellSize);
+    
+    if (cell >= (float)AE_SPATIALHASH_CELL_LIMIT)
+    {
+        return AE_SPATIALHASH_CELL_LIMIT;
+    }
+    if (cell <= -(float)AE_SPATIALHASH_CELL_LIMIT)
+    {
+        return -AE_SPATIALHASH_CELL_LIMIT;
+    }
+    return (Sint32)cell;
+}
+
+/**
+ Gets the bucket a cell's points are listed in
+
+ @param hash The AE_SpatialHash whose buckets will be used
+ @param cellX The x of the cell
+ @param cellY The y of the cell
+ @return The index of the bucket
+ */
+static Uint32 AE_SpatialHash_Bucket(AE_SpatialHash* hash, Sint32 cellX, Sint32 cellY)
+{
+    Uint32 bucket = ((Uint32)cellX * 0x9E3779B1u) ^ ((Uint32)cellY * 0x85EBCA77u);
+    
+    //Fold the high bits down so neighbouring cells spread across the buckets
+    bucket ^= bucket >> 15;
+    return bucket & (Uint32)(hash->bucketCount - 1);
+}
+
+/**
+ Adds a slot to the front of its cell's bucket
+
+ @param hash The AE_SpatialHash the slot belongs to
+ @param slot The slot to be added
+ */
+static void AE_SpatialHash_Link(AE_SpatialHash* hash, Uint32 slot)
+{
+    Uint32 bucket = AE_SpatialHash_Bucket(hash, hash->cellX[slot], hash->cellY[slot]);
+    
+    hash->bucket[slot] = bucket;
+    hash->previous[slot] = AE_SPATIALHASH_NONE;
+    hash->next[slot] = hash->bucketHeads[bucket];
+    if (hash->next[slot] != AE_SPATIALHASH_NONE)
+    {
+        hash->previous[hash->next[slot]] = slot;
+    }
+    hash->bucketHeads[bucket] = slot;
+}
+
+/**
+ Takes a slot out of its bucket
+
+ @param hash The AE_SpatialHash the slot belongs to
+ @param slot The slot to be taken out
+ */
+static void AE_SpatialHash_Unlink(AE_SpatialHash* hash, Uint32 slot)
+{
+    if (hash->previous[slot] != AE_SPATIALHASH_NONE)
+    {
+        hash->next[hash->previous[slot]] = hash->next[slot];
+    }
+    else
+    {
+        hash->bucketHeads[hash->bucket[slot]] = hash->next[slot];
+    }
+    if (hash->next[slot] != AE_SPATIALHASH_NONE)
+    {
+        hash->previous[hash->next[slot]] = hash->previous[slot];
+    }
+}
+
+/**
+ Resizes every per-slot array in a spatial hash
+
+ @param hash The AE_SpatialHash to be resized
+ @param capacity The new number of slots the hash will have room for
+ @return Whether every array was resized or not
+ */
+static SDL_bool AE_SpatialHash_Resize(AE_SpatialHash* hash, int capacity)
+{
+    //Every per-slot array, along with the size of one element
+    void** arrays[] = {
+        (void**)&hash->x, (void**)&hash->y, (void**)&hash->data,
+        (void**)&hash->cellX, (void**)&hash->cellY, (void**)&hash->bucket, (void**)&hash->next, (void**)&hash->previous,
+        (void**)&hash->slotGeneration, (void**)&hash->freeSlots
+    };
+    size_t sizes[] = {
+        sizeof(float), sizeof(float), sizeof(void*),
+        sizeof(Sint32), sizeof(Sint32), sizeof(Uint32), sizeof(Uint32), sizeof(Uint32),
+        sizeof(Uint32), sizeof(Uint32)
+    };
+    
+    for (int i = 0; i<(int)SDL_arraysize(arrays); i++)
+    {
+        void* resized = SDL_realloc(*arrays[i], sizes[i] * capacity);
+        if (resized == NULL)
+        {
+            return SDL_FALSE;
+        }
+        *arrays[i] = resized;
+    }
+    hash->capacity = capacity;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Rebuilds the buckets of a spatial hash with a new number of buckets
+
+ @param hash The AE_SpatialHash whose buckets will be rebuilt
+ @param bucketCount The new number of buckets (a power of two)
+ @return Whether the buckets were rebuilt or not
+ */
+static SDL_bool AE_SpatialHash_Rehash(AE_SpatialHash* hash, int bucketCount)
+{
+    Uint32* bucketHeads = SDL_malloc(sizeof(Uint32) * bucketCount);
+    
+    if (bucketHeads == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Every byte set makes every head AE_SPATIALHASH_NONE
+    SDL_memset(bucketHeads, 0xFF, sizeof(Uint32) * bucketCount);
+    SDL_free(hash->bucketHeads);
+    hash->bucketHeads = bucketHeads;
+    hash->bucketCount = bucketCount;
+    
+    for (Uint32 slot = 0; slot<(Uint32)hash->slotCount; slot++)
+    {
+        if (hash->bucket[slot] != AE_SPATIALHASH_NONE)
+        {
+            AE_SpatialHash_Link(hash, slot);
+        }
+    }
+    
+    return SDL_TRUE;
+}
+
+/**
+ Finds which slot a handle refers to
+
+ @param hash The AE_SpatialHash the point would be in
+ @param handle The handle of the point
+ @return The slot of the point, or AE_SPATIALHASH_NONE if the handle is not valid
+ */
+static Uint32 AE_SpatialHash_Resolve(AE_SpatialHash* hash, AE_SpatialHandle handle)
+{
+    Uint32 slot = handle & AE_SPATIALHASH_SLOT_MASK;
+    Uint32 generation = handle >> AE_SPATIALHASH_SLOT_BITS;
+    
+    if (handle == AE_SPATIALHANDLE_INVALID || slot >= (Uint32)hash->slotCount || hash->slotGeneration[slot] != generation || hash->bucket[slot] == AE_SPATIALHASH_NONE)
+    {
+        return AE_SPATIALHASH_NONE;
+    }
+    return slot;
+}
+
+/**
+ Gets the handle of the point in a slot
+
+ @param hash The AE_SpatialHash the point is in
+ @param slot The slot of the point
+ @return The handle of the point
+ */
+static AE_SpatialHandle AE_SpatialHash_Handle(AE_SpatialHash* hash, Uint32 slot)
+{
+    return (hash->slotGeneration[slot] << AE_SPATIALHASH_SLOT_BITS) | slot;
+}
+
+/**
+ Finds every point inside an area, either a circle or a rectangle
+
+ @param hash The AE_SpatialHash to be searched
+ @param minX The left edge of the area
+ @param minY The top edge of the area
+ @param maxX The right edge of the area
+ @param maxY The bottom edge of the area
+ @param radiusSquared The squared radius of a circle in the middle of the area, or less than 0 to search the whole rectangle
+ @param results Gets the handles of the points found
+ @param maxResults The most handles that will be written to results
+ @return The number of points found
+ */
+static int AE_SpatialHash_Search(AE_SpatialHash* hash, float minX, float minY, float maxX, float maxY, float radiusSquared, AE_SpatialHandle* results, int maxResults)
+{
+    const float centerX = (minX + maxX) / 2;
+    const float centerY = (minY + maxY) / 2;
+    const Sint32 minCellX = AE_SpatialHash_Cell(hash, minX);
+    const Sint32 minCellY = AE_SpatialHash_Cell(hash, minY);
+    const Sint32 maxCellX = AE_SpatialHash_Cell(hash, maxX);
+    const Sint32 maxCellY = AE_SpatialHash_Cell(hash, maxY);
+    const Sint64 cellCount = ((Sint64)maxCellX - minCellX + 1) * ((Sint64)maxCellY - minCellY + 1);
+    int found = 0;
+    
+    //A search covering more cells than there are buckets is cheaper done bucket by bucket
+    const SDL_bool byBucket = (cellCount > hash->bucketCount) ? SDL_TRUE : SDL_FALSE;
+    const Sint64 searchCount = byBucket ? hash->bucketCount : cellCount;
+    
+    for (Sint64 i = 0; i<searchCount; i++)
+    {
+        Sint32 cellX = 0;
+        Sint32 cellY = 0;
+        Uint32 bucket = (Uint32)i;
+        
+        if (!byBucket)
+        {
+            cellX = minCellX + (Sint32)(i % (maxCellX - minCellX + 1));
+            cellY = minCellY + (Sint32)(i / (maxCellX - minCellX + 1));
+            bucket = AE_SpatialHash_Bucket(hash, cellX, cellY);
+        }
+        
+        for (Uint32 slot = hash->bucketHeads[bucket]; slot != AE_SPATIALHASH_NONE; slot = hash->next[slot])
+        {
+            //Other cells can share the bucket
+            if (!byBucket && (hash->cellX[slot] != cellX || hash->cellY[slot] != cellY))
+            {
+                continue;
+            }
+            
+            if (radiusSquared >= 0)
+            {
+                float distanceX = hash->x[slot] - centerX;
+                float distanceY = hash->y[slot] - centerY;
+                if ((distanceX * distanceX) + (distanceY * distanceY) > radiusSquared)
+                {
+                    continue;
+                }
+            }
+            else if (hash->x[slot] < minX || hash->x[slot] > maxX || hash->y[slot] < minY || hash->y[slot] > maxY)
+            {
+                continue;
+            }
+            
+            if (found < maxResults)
+            {
+                results[found] = AE_SpatialHash_Handle(hash, slot);
+            }
+            found++;
+        }
+    }
+    
+    return found;
+}
+
+/**
+ Offers a point to a nearest-first list of the closest points found so far
+
+ @param hash The AE_SpatialHash the point is in
+ @param slot The slot of the point
+ @param distanceSquared The squared distance of the point
+ @param results The handles of the closest points so far
+ @param found The number of points in the list
+ @param k The most points the list can hold
+ @return The new number of points in the list
+ */
+static int AE_SpatialHash_OfferNearest(AE_SpatialHash* hash, Uint32 slot, float distanceSquared, AE_SpatialHandle* results, int found, int k)
+{
+    float* distances = hash->nearestDistances;
+    int i;
+    
+    if (found == k && distanceSquared >= distances[k - 1])
+    {
+        return found;
+    }
+    
+    //Shift the further points down, dropping the furthest if the list is full
+    i = (found < k) ? found++ : k - 1;
+    for (; i>0 && distances[i - 1] > distanceSquared; i--)
+    {
+        distances[i] = distances[i - 1];
+        results[i] = results[i - 1];
+    }
+    distances[i] = distanceSquared;
+    results[i] = AE_SpatialHash_Handle(hash, slot);
+    
+    return found;
+}
+
+/**
+ Creates a new, empty AE_SpatialHash
+
+ @param cellSize The width and height of a grid cell (about the most common query radius works best)
+ @param capacity The number of points the hash will have room for before it needs to grow (0 or less for the default)
+ @return The new AE_SpatialHash, or NULL if it could not be created
+ */
+AE_SpatialHash* AE_CreateSpatialHash(float cellSize, int capacity)
+{
+    AE_SpatialHash* output = SDL_calloc(1, sizeof(AE_SpatialHash));
+    int bucketCount = 16;
+    
+    if (output == NULL || !(cellSize > 0))
+    {
+        SDL_free(output);
+        return NULL;
+    }
+    
+    //Default to room for 1024 points
+    if (capacity <= 0)
+    {
+        capacity = 1024;
+    }
+    
+    output->cellSize = cellSize;
+    output->inverseCellSize = 1.0f / cellSize;
+    
+    //Start with about one bucket per point
+    while (bucketCount < capacity && bucketCount < (1 << AE_SPATIALHASH_SLOT_BITS))
+    {
+        bucketCount *= 2;
+    }
+    
+    if (!AE_SpatialHash_Resize(output, capacity) || !AE_SpatialHash_Rehash(output, bucketCount))
+    {
+        AE_DestroySpatialHash(output);
+        return NULL;
+    }
+    
+    return output;
+}
+
+/**
+ Adds a point to a spatial hash
+
+ @param hash The AE_SpatialHash the point will be added to
+ @param x The x of the point
+ @param y The y of the point
+ @param data Anything the caller wants to keep with the point (such as the entity it belongs to)
+ @return The handle of the new point, or AE_SPATIALHANDLE_INVALID if it could not be added
+ */
+AE_SpatialHandle AE_SpatialHash_Insert(AE_SpatialHash* hash, float x, float y, void* data)
+{
+    Uint32 slot;
+    
+    //Reuse a removed point's slot if there is one, otherwise take a new slot
+    if (hash->freeSlotCount > 0)
+    {
+        slot = hash->freeSlots[--hash->freeSlotCount];
+    }
+    else
+    {
+        if ((Uint32)hash->slotCount > AE_SPATIALHASH_SLOT_MASK)
+        {
+            return AE_SPATIALHANDLE_INVALID;
+        }
+        //Double the slots when they run out
+        if (hash->slotCount == hash->capacity && !AE_SpatialHash_Resize(hash, hash->capacity * 2))
+        {
+            return AE_SPATIALHANDLE_INVALID;
+        }
+        slot = hash->slotCount++;
+        hash->slotGeneration[slot] = 1;
+    }
+    
+    hash->x[slot] = x;
+    hash->y[slot] = y;
+    hash->data[slot] = data;
+    hash->cellX[slot] = AE_SpatialHash_Cell(hash, x);
+    hash->cellY[slot] = AE_SpatialHash_Cell(hash, y);
+    AE_SpatialHash_Link(hash, slot);
+    hash->count++;
+    
+    //Keep the buckets short; if there's no memory to grow them, the lists just get longer
+    if (hash->count > hash->bucketCount && hash->bucketCount < (1 << AE_SPATIALHASH_SLOT_BITS))
+    {
+        AE_SpatialHash_Rehash(hash, hash->bucketCount * 2);
+    }
+    
+    return AE_SpatialHash_Handle(hash, slot);
+}
+
+/**
+ Moves a point in a spatial hash, only rehashing it if it moved into a different cell
+
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @param x The new x of the point
+ @param y The new y of the point
+ @return Whether the point was moved or not
+ */
+SDL_bool AE_SpatialHash_Move(AE_SpatialHash* hash, AE_SpatialHandle handle, float x, float y)
+{
+    Uint32 slot = AE_SpatialHash_Resolve(hash, handle);
+    
+    if (slot == AE_SPATIALHASH_NONE)
+    {
+        return SDL_FALSE;
+    }
+    
+    Sint32 cellX = AE_SpatialHash_Cell(hash, x);
+    Sint32 cellY = AE_SpatialHash_Cell(hash, y);
+    hash->x[slot] = x;
+    hash->y[slot] = y;
+    
+    //Moving within a cell doesn't change which list the point is in
+    if (cellX != hash->cellX[slot] || cellY != hash->cellY[slot])
+    {
+        AE_SpatialHash_Unlink(hash, slot);
+        hash->cellX[slot] = cellX;
+        hash->cellY[slot] = cellY;
+        AE_SpatialHash_Link(hash, slot);
+    }
+    
+    return SDL_TRUE;
+}
+
+/**
+ Removes a point from a spatial hash
+
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @return Whether the point was removed or not
+ */
+SDL_bool AE_SpatialHash_Remove(AE_SpatialHash* hash, AE_SpatialHandle handle)
+{
+    Uint32 slot = AE_SpatialHash_Resolve(hash, handle);
+    
+    if (slot == AE_SPATIALHASH_NONE)
+    {
+        return SDL_FALSE;
+    }
+    
+    AE_SpatialHash_Unlink(hash, slot);
+    hash->bucket[slot] = AE_SPATIALHASH_NONE;
+    hash->data[slot] = NULL;
+    hash->count--;
+    
+    //Bump the generation so old handles to the slot stop being valid (0 is never used so a handle is never 0)
+    hash->slotGeneration[slot] = (hash->slotGeneration[slot] + 1) & AE_SPATIALHASH_GENERATION_MASK;
+    if (hash->slotGeneration[slot] == 0)
+    {
+        hash->slotGeneration[slot] = 1;
+    }
+    hash->freeSlots[hash->freeSlotCount++] = slot;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Checks whether a handle still refers to a point in a spatial hash
+
+ @param hash The AE_SpatialHash the point would be in
+ @param handle The handle to be checked
+ @return Whether the handle is valid or not
+ */
+SDL_bool AE_SpatialHash_IsValid(AE_SpatialHash* hash, AE_SpatialHandle handle)
+{
+    return (AE_SpatialHash_Resolve(hash, handle) != AE_SPATIALHASH_NONE) ? SDL_TRUE : SDL_FALSE;
+}
+
+/**
+ Gets the position of a point in a spatial hash
+
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @param x Gets the x of the point
+ @param y Gets the y of the point
+ @return Whether the handle was valid or not
+ */
+SDL_bool AE_SpatialHash_GetPosition(AE_SpatialHash* hash, AE_SpatialHandle handle, float* x, float* y)
+{
+    Uint32 slot = AE_SpatialHash_Resolve(hash, handle);
+    
+    if (slot == AE_SPATIALHASH_NONE)
+    {
+        return SDL_FALSE;
+    }
+    *x = hash->x[slot];
+    *y = hash->y[slot];
+    return SDL_TRUE;
+}
+
+/**
+ Gets the data kept with a point in a spatial hash
+
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @return The data given when the point was inserted, or NULL if the handle is not valid
+ */
+void* AE_SpatialHash_GetData(AE_SpatialHash* hash, AE_SpatialHandle handle)
+{
+    Uint32 slot = AE_SpatialHash_Resolve(hash, handle);
+    
+    return (slot != AE_SPATIALHASH_NONE) ? hash->data[slot] : NULL;
+}
+
+/**
+ Gets the number of points in a spatial hash
+
+ @param hash The AE_SpatialHash whose points will be counted
+ @return The number of points in the hash
+ */
+int AE_SpatialHash_GetCount(AE_SpatialHash* hash)
+{
+    return hash->count;
+}
+
+/**
+ Finds every point within a distance of a position
+
+ @param hash The AE_SpatialHash to be searched
+ @param x The x of the position
+ @param y The y of the position
+ @param radius The largest distance from the position a point can be at
+ @param results Gets the handles of the points found, in no particular order (may be NULL if maxResults is 0)
+ @param maxResults The most handles that will be written to results
+ @return The number of points found, which may be more than maxResults
+ */
+int AE_SpatialHash_QueryRadius(AE_SpatialHash* hash, float x, float y, float radius, AE_SpatialHandle* results, int maxResults)
+{
+    if (radius < 0)
+    {
+        return 0;
+    }
+    return AE_SpatialHash_Search(hash, x - radius, y - radius, x + radius, y + radius, radius * radius, results, maxResults);
+}
+
+/**
+ Finds every point inside a rectangle
+
+ @param hash The AE_SpatialHash to be searched
+ @param x The x of the rectangle
+ @param y The y of the rectangle
+ @param width The width of the rectangle
+ @param height The height of the rectangle
+ @param results Gets the handles of the points found, in no particular order (may be NULL if maxResults is 0)
+ @param maxResults The most handles that will be written to results
+ @return The number of points found, which may be more than maxResults
+ */
+int AE_SpatialHash_QueryRect(AE_SpatialHash* hash, float x, float y, float width, float height, AE_SpatialHandle* results, int maxResults)
+{
+    if (width < 0 || height < 0)
+    {
+        return 0;
+    }
+    return AE_SpatialHash_Search(hash, x, y, x + width, y + height, -1.0f, results, maxResults);
+}
+
+/**
+ Finds the points nearest to a position
+
+ @param hash The AE_SpatialHash to be searched
+ @param x The x of the position
+ @param y The y of the position
+ @param k The number of points to find
+ @param results Gets the handles of the points found, nearest first
+ @param distances Gets the distance of each point found (NULL if not needed)
+ @return The number of points found, which is only less than k if the hash has fewer than k points
+ */
+int AE_SpatialHash_QueryNearest(AE_SpatialHash* hash, float x, float y, int k, AE_SpatialHandle* results, float* distances)
+{
+    const Sint32 centerX = AE_SpatialHash_Cell(hash, x);
+    const Sint32 centerY = AE_SpatialHash_Cell(hash, y);
+    int found = 0;
+    int seen = 0;
+    
+    k = SDL_min(k, hash->count);
+    if (k <= 0)
+    {
+        return 0;
+    }
+    
+    //The squared distances of the points found are kept with the hash so queries don't allocate
+    if (k > hash->nearestCapacity)
+    {
+        float* resized = SDL_realloc(hash->nearestDistances, sizeof(float) * k);
+        if (resized == NULL)
+        {
+            return 0;
+        }
+        hash->nearestDistances = resized;
+        hash->nearestCapacity = k;
+    }
+    
+    //Search outwards one ring of cells at a time
+    for (Sint32 ring = 0; seen < hash->count; ring++)
+    {
+        //Once the rings cover more cells than there are buckets, check every point instead
+        if (((Sint64)ring * 2 + 1) * ((Sint64)ring * 2 + 1) > hash->bucketCount)
+        {
+            found = 0;
+            for (Uint32 slot = 0; slot<(Uint32)hash->slotCount; slot++)
+            {
+                if (hash->bucket[slot] != AE_SPATIALHASH_NONE)
+                {
+                    float distanceX = hash->x[slot] - x;
+                    float distanceY = hash->y[slot] - y;
+                    found = AE_SpatialHash_OfferNearest(hash, slot, (distanceX * distanceX) + (distanceY * distanceY), results, found, k);
+                }
+            }
+            break;
+        }
+        
+        for (Sint32 cellY = centerY - ring; cellY <= centerY + ring; cellY++)
+        {
+            //Rows between the top and bottom of the ring only have cells at the two ends
+            const Sint32 step = (cellY == centerY - ring || cellY == centerY + ring || ring == 0) ? 1 : ring * 2;
+            
+            for (Sint32 cellX = centerX - ring; cellX <= centerX + ring; cellX += step)
+            {
+                Uint32 bucket = AE_SpatialHash_Bucket(hash, cellX, cellY);
+                
+                for (Uint32 slot = hash->bucketHeads[bucket]; slot != AE_SPATIALHASH_NONE; slot = hash->next[slot])
+                {
+                    if (hash->cellX[slot] == cellX && hash->cellY[slot] == cellY)
+                    {
+                        float distanceX = hash->x[slot] - x;
+                        float distanceY = hash->y[slot] - y;
+                        found = AE_SpatialHash_OfferNearest(hash, slot, (distanceX * distanceX) + (distanceY * distanceY), results, found, k);
+                        seen++;
+                    }
+                }
+            }
+        }
+        
+        //Every point outside the rings searched so far is at least ring cells away
+        if (found == k && hash->nearestDistances[k - 1] <= ((float)ring * hash->cellSize) * ((float)ring * hash->cellSize))
+        {
+            break;
+        }
+    }
+    
+    if (distances != NULL)
+    {
+        for (int i = 0; i<found; i++)
+        {
+            distances[i] = SDL_sqrtf(hash->nearestDistances[i]);
+        }
+    }
+    
+    return found;
+}
+
+/**
+ Frees and destroys an AE_SpatialHash
+
+ @param hash The AE_SpatialHash to be destroyed
+ */
+void AE_DestroySpatialHash(AE_SpatialHash* hash)
+{
+    if (hash != NULL)
+    {
+        SDL_free(hash->x);
+        SDL_free(hash->y);
+        SDL_free(hash->data);
+        SDL_free(hash->cellX);
+        SDL_free(hash->cellY);
+        SDL_free(hash->bucket);
+        SDL_free(hash->next);
+        SDL_free(hash->previous);
+        SDL_free(hash->slotGeneration);
+        SDL_free(hash->freeSlots);
+        SDL_free(hash->bucketHeads);
+        SDL_free(hash->nearestDistances);
+        SDL_free(hash);
+    }
+}
+
+//
+//
+//End: Spatial Hash Functions
+//
+//
+
+//
+//
+//Start: Glyph Cache Text Functions
+//
+//
+
+//The width and height of a glyph page when none is given
+#define AE_GLYPHCACHE_DEFAULT_PAGE_SIZE 512
+//Empty pixels kept between glyphs so filtering never samples a neighbour
+#define AE_GLYPHCACHE_PADDING 1
+
+/**
+ Reads one character from a UTF-8 string
+
+ @param text The string, which is moved past the character
+ @return The codepoint of the character, or U+FFFD if the string isn't valid UTF-8
+ */
+static Uint32 AE_DecodeUTF8(const char** text)
+{
+    const Uint8* bytes = (const Uint8*)*text;
+    Uint32 codepoint;
+    int length;
+    
+    if (bytes[0] < 0x80)
+    {
+        codepoint = bytes[0];
+        length = 1;
+    }
+    else if ((bytes[0] & 0xE0) == 0xC0)
+    {
+        codepoint = bytes[0] & 0x1F;
+        length = 2;
+    }
+    else if ((bytes[0] & 0xF0) == 0xE0)
+    {
+        codepoint = bytes[0] & 0x0F;
+        length = 3;
+    }
+    else if ((bytes[0] & 0xF8) == 0xF0)
+    {
+        codepoint = bytes[0] & 0x07;
+        length = 4;
+    }
+    else
+    {
+        *text += 1;
+        return 0xFFFD;
+    }
+    
+    //A missing continuation byte (including the end of the string) stops the character short
+    for (int i = 1; i<length; i++)
+    {
+        if ((bytes[i] & 0xC0) != 0x80)
+        {
+            *text += i;
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+    }
+    
+    *text += length;
+    return codepoint;
+}
+
+/**
+ Finds a glyph in a cache's table
+
+ @param cache The AE_GlyphCache to be searched
+ @param codepoint The character of the glyph
+ @return The index of the glyph, or -1 if the cache doesn't have it
+ */
+static int AE_GlyphCache_Find(AE_GlyphCache* cache, Uint32 codepoint)
+{
+    const Uint32 mask = (Uint32)cache->tableCapacity - 1;
+    
+    for (Uint32 i = (codepoint * 0x9E3779B1u) & mask; cache->table[i] >= 0; i = (i + 1) & mask)
+    {
+        if (cache->glyphs[cache->table[i]].codepoint == codepoint)
+        {
+            return cache->table[i];
+        }
+    }
+    return -1;
+}
+
+/**
+ Adds a glyph to a cache's table
+
+ @param cache The AE_GlyphCache whose table the glyph will be added to
+ @param index The index of the glyph
+ */
+static void AE_GlyphCache_AddToTable(AE_GlyphCache* cache, int index)
+{
+    const Uint32 mask = (Uint32)cache->tableCapacity - 1;
+    Uint32 i = (cache->glyphs[index].codepoint * 0x9E3779B1u) & mask;
+    
+    while (cache->table[i] >= 0)
+    {
+        i = (i + 1) & mask;
+    }
+    cache->table[i] = index;
+}
+
+/**
+ Doubles the room a cache has for glyphs, keeping its table at most half full
+
+ @param cache The AE_GlyphCache to be grown
+ @return Whether the cache was grown or not
+ */
+static SDL_bool AE_GlyphCache_Grow(AE_GlyphCache* cache)
+{
+    const int capacity = SDL_max(cache->glyphCapacity * 2, 128);
+    AE_Glyph* glyphs = SDL_realloc(cache->glyphs, sizeof(AE_Glyph) * capacity);
+    int* table = SDL_malloc(sizeof(int) * capacity * 2);
+    
+    if (glyphs == NULL || table == NULL)
+    {
+        //The old glyphs are still valid whether or not they moved
+        if (glyphs != NULL)
+        {
+            cache->glyphs = glyphs;
+        }
+        SDL_free(table);
+        return SDL_FALSE;
+    }
+    
+    SDL_free(cache->table);
+    cache->glyphs = glyphs;
+    cache->glyphCapacity = capacity;
+    cache->table = table;
+    cache->tableCapacity = capacity * 2;
+    
+    //Every byte set makes every entry -1
+    SDL_memset(cache->table, 0xFF, sizeof(int) * cache->tableCapacity);
+    for (int i = 0; i<cache->glyphCount; i++)
+    {
+        AE_GlyphCache_AddToTable(cache, i);
+    }
+    
+    return SDL_TRUE;
+}
+
+/**
+ Adds a new, empty page to a cache and moves the shelves onto it
+
+ @param cache The AE_GlyphCache the page will be added to
+ @return Whether the page was added or not
+ */
+static SDL_bool AE_GlyphCache_AddPage(AE_GlyphCache* cache)
+{
+    AE_LinkedTexture** pages = SDL_realloc(cache->pages, sizeof(AE_LinkedTexture*) * (cache->pageCount + 1));
+    SDL_Texture* texture;
+    void* blank;
+    
+    if (pages == NULL)
+    {
+        return SDL_FALSE;
+    }
+    cache->pages = pages;
+    
+    texture = SDL_CreateTexture(cache->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, cache->pageSize, cache->pageSize);
+    if (texture == NULL)
+    {
+        return SDL_FALSE;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    
+    //A new texture's pixels are undefined, so clear it to keep the padding transparent
+    if ((blank = SDL_calloc(cache->pageSize, cache->pageSize * 4)) != NULL)
+    {
+        SDL_UpdateTexture(texture, NULL, blank, cache->pageSize * 4);
+        SDL_free(blank);
+    }
+    
+    cache->pages[cache->pageCount++] = AE_CreateLinkedTexture(texture);
+    cache->shelfX = 0;
+    cache->shelfY = 0;
+    cache->shelfHeight = 0;
+    
+    return SDL_TRUE;
+}
+
+/**
+ Copies a rasterized glyph onto the shelves of the cache's last page, adding shelves and pages as needed
+
+ @param cache The AE_GlyphCache the glyph will be added to
+ @param glyph The AE_Glyph whose page and rect will be set
+ @param surface The rasterized glyph
+ */
+static void AE_GlyphCache_Place(AE_GlyphCache* cache, AE_Glyph* glyph, SDL_Surface* surface)
+{
+    const int width = surface->w + AE_GLYPHCACHE_PADDING;
+    const int height = surface->h + AE_GLYPHCACHE_PADDING;
+    SDL_Surface* converted = surface;
+    
+    if (width + AE_GLYPHCACHE_PADDING > cache->pageSize || height + AE_GLYPHCACHE_PADDING > cache->pageSize)
+    {
+        return;
+    }
+    
+    //Start a new shelf when the glyph doesn't fit on the end of this one
+    if (cache->shelfX + width + AE_GLYPHCACHE_PADDING > cache->pageSize)
+    {
+        cache->shelfX = 0;
+        cache->shelfY += cache->shelfHeight;
+        cache->shelfHeight = 0;
+    }
+    //Start a new page when the glyph doesn't fit under the last shelf
+    if (cache->pageCount == 0 || cache->shelfY + height + AE_GLYPHCACHE_PADDING > cache->pageSize)
+    {
+        if (!AE_GlyphCache_AddPage(cache))
+        {
+            return;
+        }
+    }
+    
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888 && (converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0)) == NULL)
+    {
+        return;
+    }
+    
+    glyph->rect.x = cache->shelfX + AE_GLYPHCACHE_PADDING;
+    glyph->rect.y = cache->shelfY + AE_GLYPHCACHE_PADDING;
+    glyph->rect.w = surface->w;
+    glyph->rect.h = surface->h;
+    if (SDL_UpdateTexture(cache->pages[cache->pageCount - 1]->texture, &glyph->rect, converted->pixels, converted->pitch) == 0)
+    {
+        glyph->page = cache->pages[cache->pageCount - 1];
+        cache->shelfX += width;
+        cache->shelfHeight = SDL_max(cache->shelfHeight, height);
+    }
+    
+    if (converted != surface)
+    {
+        SDL_FreeSurface(converted);
+    }
+}
+
+/**
+ Gets a glyph from a cache, rasterizing it first if the cache doesn't have it yet
+
+ @param cache The AE_GlyphCache the glyph will be taken from
+ @param codepoint The character of the glyph
+ @return The AE_Glyph (whose page is NULL if the font has nothing to draw for it), or NULL if there was no room to add it
+ */
+static AE_Glyph* AE_GlyphCache_GetGlyph(AE_GlyphCache* cache, Uint32 codepoint)
+{
+    const SDL_Color white = {255, 255, 255, 255};
+    int index = AE_GlyphCache_Find(cache, codepoint);
+    SDL_Surface* surface = NULL;
+    
+    if (index >= 0)
+    {
+        return &cache->glyphs[index];
+    }
+    if (cache->glyphCount == cache->glyphCapacity && !AE_GlyphCache_Grow(cache))
+    {
+        return NULL;
+    }
+    
+    AE_Glyph* glyph = &cache->glyphs[cache->glyphCount];
+    SDL_zerop(glyph);
+    glyph->codepoint = codepoint;
+    
+    //Changing a font's style throws away its own caches, so only change it when it differs
+    int previousStyle = TTF_GetFontStyle(cache->font);
+    if (previousStyle != cache->style)
+    {
+        TTF_SetFontStyle(cache->font, cache->style);
+    }
+    
+    //Glyphs are rasterized in white so they can be tinted to any color when drawn
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    if (TTF_GlyphMetrics32(cache->font, codepoint, NULL, NULL, NULL, NULL, &glyph->advance) == 0)
+    {
+        surface = TTF_RenderGlyph32_Blended(cache->font, codepoint, white);
+    }
+#else
+    if (codepoint <= 0xFFFF && TTF_GlyphMetrics(cache->font, (Uint16)codepoint, NULL, NULL, NULL, NULL, &glyph->advance) == 0)
+    {
+        surface = TTF_RenderGlyph_Blended(cache->font, (Uint16)codepoint, white);
+    }
+#endif
+    
+    if (previousStyle != cache->style)
+    {
+        TTF_SetFontStyle(cache->font, previousStyle);
+    }
+    
+    //Characters the font can't draw are kept too, so they aren't rasterized again every frame
+    if (surface != NULL)
+    {
+        if (surface->w > 0 && surface->h > 0)
+        {
+            AE_GlyphCache_Place(cache, glyph, surface);
+        }
+        SDL_FreeSurface(surface);
+    }
+    
+    AE_GlyphCache_AddToTable(cache, cache->glyphCount);
+    cache->glyphCount++;
+    
+    return glyph;
+}
+
+/**
+ Gets the kerning between two characters
+
+ @param cache The AE_GlyphCache whose font will be used
+ @param previous The character before (0 for none)
+ @param codepoint The character after
+ @return The number of pixels to move the second character by
+ */
+static int AE_GlyphCache_Kerning(AE_GlyphCache* cache, Uint32 previous, Uint32 codepoint)
+{
+    if (previous == 0 || !TTF_GetFontKerning(cache->font))
+    {
+        return 0;
+    }
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    return TTF_GetFontKerningSizeGlyphs32(cache->font, previous, codepoint);
+#else
+    if (previous > 0xFFFF || codepoint > 0xFFFF)
+    {
+        return 0;
+    }
+    return TTF_GetFontKerningSizeGlyphs(cache->font, (Uint16)previous, (Uint16)codepoint);
+#endif
+}
+
+/**
+ Creates a new, empty glyph cache for a font and style
+
+ @param renderer The renderer the text will be drawn on
+ @param font The font the glyphs will be rasterized from, which must stay open as long as the cache exists
+ @param style The TTF_STYLE flags the glyphs will be rasterized with
+ @param pageSize The width and height of each glyph page (0 or less for the default)
+ @return The new AE_GlyphCache, or NULL if it could not be created
+ */
+AE_GlyphCache* AE_CreateGlyphCache(SDL_Renderer* renderer, TTF_Font* font, int style, int pageSize)
+{
+    AE_GlyphCache* output = SDL_calloc(1, sizeof(AE_GlyphCache));
+    
+    if (output == NULL)
+    {
+        return NULL;
+    }
+    
+    output->renderer = renderer;
+    output->font = font;
+    output->style = style;
+    output->pageSize = (pageSize > 0) ? pageSize : AE_GLYPHCACHE_DEFAULT_PAGE_SIZE;
+    output->fontHeight = TTF_FontHeight(font);
+    output->lineSkip = TTF_FontLineSkip(font);
+    
+    //Pages are only made once there's a glyph to put on them
+    if (!AE_GlyphCache_Grow(output))
+    {
+        AE_DestroyGlyphCache(output);
+        return NULL;
+    }
+    
+    return output;
+}
+
+/**
+ Rasterizes characters ahead of time so the first frame that draws them doesn't have to
+
+ @param cache The AE_GlyphCache the characters will be added to
+ @param characters A UTF-8 string of the characters to be added
+ @return Whether every character was added or not
+ */
+SDL_bool AE_GlyphCache_Preload(AE_GlyphCache* cache, const char* characters)
+{
+    SDL_bool success = SDL_TRUE;
+    
+    while (*characters != '\0')
+    {
+        if (AE_GlyphCache_GetGlyph(cache, AE_DecodeUTF8(&characters)) == NULL)
+        {
+            success = SDL_FALSE;
+        }
+    }
+    
+    return success;
+}
+
+/**
+ Draws text with kerning, rasterizing any characters the cache doesn't have yet
+
+ @param cache The AE_GlyphCache the text will be drawn from
+ @param batch The AE_SpriteBatch the glyphs will be merged through (NULL to draw each one on its own)
+ @param text The UTF-8 text to be drawn, where '\n' starts a new line
+ @param x The x of the top-left corner of the text
+ @param y The y of the top-left corner of the text
+ @param textColor The color of the text
+ @return Whether every glyph was drawn successfully or not
+ */
+SDL_bool AE_GlyphCache_RenderText(AE_GlyphCache* cache, AE_SpriteBatch* batch, const char* text, int x, int y, SDL_Color textColor)
+{
+    const AE_ColorBundle color = {textColor.r, textColor.g, textColor.b};
+    SDL_bool success = SDL_TRUE;
+    SDL_Rect drawRect = {x, y, 0, 0};
+    Uint32 previous = 0;
+    
+    AE_PROFILE_BEGIN("AE_GlyphCache_RenderText");
+    while (*text != '\0')
+    {
+        Uint32 codepoint = AE_DecodeUTF8(&text);
+        AE_Glyph* glyph;
+        
+        if (codepoint == '\n')
+        {
+            drawRect.x = x;
+            drawRect.y += cache->lineSkip;
+            previous = 0;
+            continue;
+        }
+        
+        if ((glyph = AE_GlyphCache_GetGlyph(cache, codepoint)) == NULL)
+        {
+            success = SDL_FALSE;
+            continue;
+        }
+        
+        drawRect.x += AE_GlyphCache_Kerning(cache, previous, codepoint);
+        
+        //Glyphs like spaces only move the pen
+        if (glyph->page != NULL)
+        {
+            drawRect.w = glyph->rect.w;
+            drawRect.h = glyph->rect.h;
+            
+            if (batch != NULL)
+            {
+                if (!AE_SpriteBatch_Submit(batch, glyph->page, &glyph->rect, &drawRect, 0.0, NULL, SDL_FLIP_NONE, color, textColor.a))
+                {
+                    success = SDL_FALSE;
+                }
+            }
+            else
+            {
+                AE_SetTextureModulation(cache->renderer, glyph->page->texture, color, textColor.a);
+                if (SDL_RenderCopy(cache->renderer, glyph->page->texture, &glyph->rect, &drawRect) != 0)
+                {
+                    success = SDL_FALSE;
+                }
+            }
+        }
+        
+        drawRect.x += glyph->advance;
+        previous = codepoint;
+    }
+    AE_PROFILE_END();
+    
+    return success;
+}
+
+/**
+ Measures the size text would be drawn at, with kerning
+
+ @param cache The AE_GlyphCache the text would be drawn from
+ @param text The UTF-8 text to be measured, where '\n' starts a new line
+ @param width Gets the width of the widest line (NULL if not needed)
+ @param height Gets the height of every line together (NULL if not needed)
+ @return Whether every character could be measured or not
+ */
+SDL_bool AE_GlyphCache_MeasureText(AE_GlyphCache* cache, const char* text, int* width, int* height)
+{
+    SDL_bool success = SDL_TRUE;
+    int penX = 0;
+    int widest = 0;
+    int lines = 1;
+    Uint32 previous = 0;
+    
+    while (*text != '\0')
+    {
+        Uint32 codepoint = AE_DecodeUTF8(&text);
+        AE_Glyph* glyph;
+        
+        if (codepoint == '\n')
+        {
+            penX = 0;
+            lines++;
+            previous = 0;
+            continue;
+        }
+        
+        if ((glyph = AE_GlyphCache_GetGlyph(cache, codepoint)) == NULL)
+        {
+            success = SDL_FALSE;
+            continue;
+        }
+        
+        penX += AE_GlyphCache_Kerning(cache, previous, codepoint);
+        //A glyph can be drawn wider than it moves the pen (such as italics)
+        widest = SDL_max(widest, penX + SDL_max(glyph->advance, glyph->rect.w));
+        penX += glyph->advance;
+        previous = codepoint;
+    }
+    
+    if (width != NULL)
+    {
+        *width = widest;
+    }
+    if (height != NULL)
+    {
+        *height = ((lines - 1) * cache->lineSkip) + cache->fontHeight;
+    }
+    
+    return success;
+}
+
+/**
+ Gets the number of glyph pages a cache has made
+
+ @param cache The AE_GlyphCache whose pages will be counted
+ @return The number of pages
+ */
+int AE_GlyphCache_GetPageCount(AE_GlyphCache* cache)
+{
+    return cache->pageCount;
+}
+
+/**
+ Frees and destroys an AE_GlyphCache and its pages (the font is left open)
+
+ @param cache The AE_GlyphCache to be destroyed
+ */
+void AE_DestroyGlyphCache(AE_GlyphCache* cache)
+{
+    if (cache != NULL)
+    {
+        for (int i = 0; i<cache->pageCount; i++)
+        {
+            AE_DestroyLinkedTexture(cache->pages[i]);
+        }
+        SDL_free(cache->pages);
+        SDL_free(cache->glyphs);
+        SDL_free(cache->table);
+        SDL_free(cache);
+    }
+}
+
+//
+//
+//End: Glyph Cache Text Functions
+//
+//
+
+
+//
+//
+//Start: Timer functions
+//
+//
+
+/**
+ Creates a new AE_Timer
+
+ @return A pointer to the new AE_Timer
+ */
+AE_Timer* AE_Create_Timer()
+{
+    AE_Timer* output = SDL_malloc(sizeof(AE_Timer));
+    if (output != NULL)
+    {
+        AE_FillTimer(output);
+    }
+    return output;
+}
+
+/**
+ Resets an AE_Timer held by value, so timers can live inside other objects without an allocation of their own
+
+ @param timer The AE_Timer to reset to a stopped timer
+ */
+void AE_FillTimer(AE_Timer* timer)
+{
+    timer->isStarted = SDL_FALSE;
+    timer->isPaused = SDL_FALSE;
+    timer->startTime = 0;
+    timer->pauseTime = 0;
+}
+
+/**
+ Frees and destroys an AE_Timer made with AE_Create_Timer. AE_Timer comes straight from SDL_malloc rather than the engine's allocator, so freeing it with SDL_free stays valid
+
+ @param timer The AE_Timer to be destroyed
+ */
+void AE_DestroyTimer(AE_Timer* timer)
+{
+    SDL_free(timer);
+}
+
+/**
+ Starts (and unpauses) an AE_Timer
+
+ @param timer The timer to start
+ */
+void AE_Timer_Start(AE_Timer* timer)
+{
+    timer->isStarted = SDL_TRUE;
+    timer->isPaused = SDL_FALSE;
+    timer->startTime = SDL_GetTicks();
+    timer->pauseTime = 0;
+}
+
+/**
+ Pauses an AE_Timer
+
+ @param timer The AE_Timer to pause
+ */
+void AE_Timer_Pause(AE_Timer* timer)
+{
+    if (timer->isStarted && !timer->isPaused)
+    {
+        timer->isPaused = SDL_TRUE;
+        timer->pauseTime = SDL_GetTicks() - timer->startTime;
+    }
+}
+
+/**
+ Resumes a paused AE_Timer
+
+ @param timer The AE_Timer to resume
+ */
+void AE_Timer_Resume(AE_Timer* timer)
+{
+    //If a timer is started and paused
+    if (timer->isStarted && timer->isPaused)
+    {
+        //Unpause the timer
+        timer->isPaused = SDL_FALSE;
+        //Set the start time to the saved time
+        timer->startTime = SDL_GetTicks() - timer->pauseTime;
+        timer->pauseTime = 0;
+    }
+}
+
+/**
+ Stops a paused AE_Timer
+ 
+ @param timer The AE_Timer to stop
+ */
+void AE_Timer_Stop(AE_Timer* timer)
+{
+    timer->isStarted = SDL_FALSE;
+    timer->isPaused = SDL_FALSE;
+    timer->startTime = 0;
+    timer->pauseTime = 0;
+}
+
+/**
+ Gets the amount of time in an AE_Timer
+
+ @param timer The AE_Timer to get the time from
+ @return The current time on the AE_Timer
+ */
+Uint32 AE_Timer_GetTime(AE_Timer* timer)
+{
+    Uint32 output = 0;
+    
+    //If the timer's started
+    if (timer->isStarted)
+    {
+        //If the timer is paused, return the saved time
+        if (timer->isPaused)
+        {
+            output = timer->pauseTime;
+        }
+        else
+        //return the regular time
+        {
+            output = SDL_GetTicks() - timer->startTime;
+        }
+    }
+    
+    return output;
+}
+
+/**
+ Returns whether an AE_Timer is paused or not
+
+ @param timer The AE_Timer to be determined whether it is paused or not
+ @return Whether the AE_Timer is paused or not
+ */
 SDL_bool AE_Timer_IsPaused(AE_Timer* timer)
 {
-    return timer->isStarted && timer->isPaused;
+    return timer->isStarted && timer->isPaused;
+}
+
+/**
+ Returns whether an AE_Timer is started
+
+ @param timer The AE_Timer to determine whether it is started or not
+ @return Whether the AE_Timer is started or not
+ */
+SDL_bool AE_Timer_IsStarted(AE_Timer* timer)
+{
+    return timer->isStarted;
+}
+
+/**
+ Converts performance counter ticks to nanoseconds without overflowing, however long the timer has run
+
+ @param ticks The performance counter ticks
+ @return The nanoseconds
+ */
+static Uint64 AE_PreciseTimer_Nanoseconds(Uint64 ticks)
+{
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    return (ticks / frequency) * 1000000000ULL + ((ticks % frequency) * 1000000000ULL) / frequency;
+}
+
+/**
+ Gets the ticks on an AE_PreciseTimer, not counting time spent paused
+
+ @param timer The AE_PreciseTimer to get the ticks from
+ @return The performance counter ticks
+ */
+static Uint64 AE_PreciseTimer_GetTicks(AE_PreciseTimer* timer)
+{
+    if (!timer->isStarted)
+    {
+        return 0;
+    }
+    return timer->isPaused ? timer->pauseTicks : SDL_GetPerformanceCounter() - timer->startCounter;
+}
+
+/**
+ Creates a new AE_PreciseTimer
+
+ @return A pointer to the new AE_PreciseTimer
+ */
+AE_PreciseTimer* AE_Create_PreciseTimer()
+{
+    AE_PreciseTimer* output = AE_AllocateObject(AE_OBJECT_PRECISETIMER, sizeof(AE_PreciseTimer));
+    if (output != NULL)
+    {
+        AE_FillPreciseTimer(output);
+    }
+    return output;
+}
+
+/**
+ Resets an AE_PreciseTimer held by value to a stopped timer with no laps
+
+ @param timer The AE_PreciseTimer to reset
+ */
+void AE_FillPreciseTimer(AE_PreciseTimer* timer)
+{
+    AE_PreciseTimer_Stop(timer);
+    AE_PreciseTimer_ResetStats(timer);
+}
+
+/**
+ Frees and destroys an AE_PreciseTimer made with AE_Create_PreciseTimer
+
+ @param timer The AE_PreciseTimer to be destroyed
+ */
+void AE_DestroyPreciseTimer(AE_PreciseTimer* timer)
+{
+    AE_ReleaseObject(AE_OBJECT_PRECISETIMER, timer);
+}
+
+/**
+ Starts (and unpauses) an AE_PreciseTimer
+
+ @param timer The AE_PreciseTimer to start
+ */
+void AE_PreciseTimer_Start(AE_PreciseTimer* timer)
+{
+    timer->isStarted = SDL_TRUE;
+    timer->isPaused = SDL_FALSE;
+    timer->startCounter = SDL_GetPerformanceCounter();
+    timer->pauseTicks = 0;
+    timer->lapTicks = 0;
+}
+
+/**
+ Pauses an AE_PreciseTimer
+
+ @param timer The AE_PreciseTimer to pause
+ */
+void AE_PreciseTimer_Pause(AE_PreciseTimer* timer)
+{
+    if (timer->isStarted && !timer->isPaused)
+    {
+        timer->isPaused = SDL_TRUE;
+        timer->pauseTicks = SDL_GetPerformanceCounter() - timer->startCounter;
+    }
+}
+
+/**
+ Resumes a paused AE_PreciseTimer
+
+ @param timer The AE_PreciseTimer to resume
+ */
+void AE_PreciseTimer_Resume(AE_PreciseTimer* timer)
+{
+    if (timer->isStarted && timer->isPaused)
+    {
+        //Move the start forward by the time spent paused
+        timer->isPaused = SDL_FALSE;
+        timer->startCounter = SDL_GetPerformanceCounter() - timer->pauseTicks;
+        timer->pauseTicks = 0;
+    }
+}
+
+/**
+ Stops an AE_PreciseTimer. Its lap statistics are kept until AE_PreciseTimer_ResetStats
+
+ @param timer The AE_PreciseTimer to stop
+ */
+void AE_PreciseTimer_Stop(AE_PreciseTimer* timer)
+{
+    timer->isStarted = SDL_FALSE;
+    timer->isPaused = SDL_FALSE;
+    timer->startCounter = 0;
+    timer->pauseTicks = 0;
+    timer->lapTicks = 0;
+}
+
+/**
+ Gets the time on an AE_PreciseTimer, not counting time spent paused. This is the split time: it carries on through laps
+
+ @param timer The AE_PreciseTimer to get the time from
+ @return The time in nanoseconds
+ */
+Uint64 AE_PreciseTimer_GetTime(AE_PreciseTimer* timer)
+{
+    return AE_PreciseTimer_Nanoseconds(AE_PreciseTimer_GetTicks(timer));
+}
+
+/**
+ Gets the time on an AE_PreciseTimer since its last lap (or since it started, before the first lap)
+
+ @param timer The AE_PreciseTimer to get the lap time from
+ @return The time in nanoseconds
+ */
+Uint64 AE_PreciseTimer_GetLapTime(AE_PreciseTimer* timer)
+{
+    return AE_PreciseTimer_Nanoseconds(AE_PreciseTimer_GetTicks(timer) - timer->lapTicks);
+}
+
+/**
+ Ends the current lap of an AE_PreciseTimer and starts the next, adding the lap to the timer's statistics
+
+ @param timer The AE_PreciseTimer whose lap will be ended
+ @return The length of the lap in nanoseconds (0 if the timer isn't started)
+ */
+Uint64 AE_PreciseTimer_Lap(AE_PreciseTimer* timer)
+{
+    Uint64 ticks = AE_PreciseTimer_GetTicks(timer);
+    Uint64 lap = AE_PreciseTimer_Nanoseconds(ticks - timer->lapTicks);
+    int slot = (int)(timer->lapCount % AE_PRECISETIMER_LAP_HISTORY);
+    
+    //A stopped timer has no lap to end
+    if (!timer->isStarted)
+    {
+        return 0;
+    }
+    
+    //Keep a running total of the laps in the history, swapping out the one being overwritten
+    timer->lapHistoryTotal += lap - timer->laps[slot];
+    timer->laps[slot] = lap;
+    timer->lapCount++;
+    timer->lapTicks = ticks;
+    return lap;
+}
+
+/**
+ Gets the statistics on the most recent laps of an AE_PreciseTimer
+
+ @param timer The AE_PreciseTimer whose statistics will be retrieved
+ @return The AE_PreciseTimerStats of the timer's recent laps (all zero before the first lap)
+ */
+AE_PreciseTimerStats AE_PreciseTimer_GetStats(AE_PreciseTimer* timer)
+{
+    AE_PreciseTimerStats output = {0, 0, 0, 0, 0};
+    int count = (int)SDL_min(timer->lapCount, (Uint64)AE_PRECISETIMER_LAP_HISTORY);
+    
+    output.lapCount = timer->lapCount;
+    if (count == 0)
+    {
+        return output;
+    }
+    
+    output.last = timer->laps[(timer->lapCount - 1) % AE_PRECISETIMER_LAP_HISTORY];
+    output.min = timer->laps[0];
+    output.max = timer->laps[0];
+    for (int i = 1; i<count; i++)
+    {
+        output.min = SDL_min(output.min, timer->laps[i]);
+        output.max = SDL_max(output.max, timer->laps[i]);
+    }
+    output.average = timer->lapHistoryTotal / (Uint64)count;
+    return output;
+}
+
+/**
+ Forgets the laps an AE_PreciseTimer has recorded
+
+ @param timer The AE_PreciseTimer whose statistics will be reset
+ */
+void AE_PreciseTimer_ResetStats(AE_PreciseTimer* timer)
+{
+    timer->lapCount = 0;
+    timer->lapHistoryTotal = 0;
+    SDL_memset(timer->laps, 0, sizeof(timer->laps));
+}
+
+/**
+ Returns whether an AE_PreciseTimer is paused or not
+
+ @param timer The AE_PreciseTimer to be determined whether it is paused or not
+ @return Whether the AE_PreciseTimer is paused or not
+ */
+SDL_bool AE_PreciseTimer_IsPaused(AE_PreciseTimer* timer)
+{
+    return timer->isStarted && timer->isPaused;
+}
+
+/**
+ Returns whether an AE_PreciseTimer is started
+
+ @param timer The AE_PreciseTimer to determine whether it is started or not
+ @return Whether the AE_PreciseTimer is started or not
+ */
+SDL_bool AE_PreciseTimer_IsStarted(AE_PreciseTimer* timer)
+{
+    return timer->isStarted;
+}
+
+//
+//
+//End: Timer Functions
+//
+//
+
+//
+//
+//Start: Game Loop Functions
+//
+//
+
+//The most updates a frame runs before the loop drops the time it is behind by, unless set otherwise
+#define AE_GAMELOOP_DEFAULT_MAX_UPDATES 8
+
+/**
+ Gets the seconds between two performance counter readings
+
+ @param start The earlier reading
+ @param end The later reading
+ @return The seconds between the readings
+ */
+static double AE_GameLoop_Seconds(Uint64 start, Uint64 end)
+{
+    return (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+/**
+ Creates a new AE_GameLoop, which allows up to 8 updates per frame and doesn't limit the frame rate
+
+ @param updateRate The number of updates per second
+ @param update The callback that advances the simulation
+ @param render The callback that draws a frame (can be NULL)
+ @param userdata A pointer passed to both callbacks
+ @return The new AE_GameLoop, or NULL if it could not be created
+ */
+AE_GameLoop* AE_CreateGameLoop(double updateRate, AE_UpdateCallback update, AE_RenderCallback render, void* userdata)
+{
+    if (updateRate <= 0 || update == NULL)
+    {
+        return NULL;
+    }
+    
+    AE_GameLoop* output = SDL_calloc(1, sizeof(AE_GameLoop));
+    if (output == NULL)
+    {
+        return NULL;
+    }
+    output->update = update;
+    output->render = render;
+    output->userdata = userdata;
+    output->updateStep = 1.0 / updateRate;
+    output->maxUpdates = AE_GAMELOOP_DEFAULT_MAX_UPDATES;
+    output->frameLimit = 0;
+    output->isRunning = SDL_TRUE;
+    return output;
+}
+
+/**
+ Sets the most updates an AE_GameLoop will run in one frame before dropping the simulation time it is behind by
+
+ @param loop The AE_GameLoop whose limit will be set
+ @param maxUpdates The most updates per frame (at least 1)
+ */
+void AE_GameLoop_SetMaxUpdates(AE_GameLoop* loop, int maxUpdates)
+{
+    loop->maxUpdates = SDL_max(maxUpdates, 1);
+}
+
+/**
+ Sets the highest frame rate an AE_GameLoop renders at, sleeping out the rest of each frame. Not needed if the renderer waits for vsync
+
+ @param loop The AE_GameLoop whose frame rate will be limited
+ @param framesPerSecond The most frames per second (0 or less for no limit)
+ */
+void AE_GameLoop_SetFrameLimit(AE_GameLoop* loop, double framesPerSecond)
+{
+    loop->frameLimit = SDL_max(framesPerSecond, 0);
+}
+
+/**
+ Runs one frame of an AE_GameLoop: as many updates as the time since the last frame calls for, then a render. For games that drive their own outer loop
+
+ @param loop The AE_GameLoop to run a frame of
+ @return Whether the loop should keep running or not
+ */
+SDL_bool AE_GameLoop_Frame(AE_GameLoop* loop)
+{
+    Uint64 frameStart = SDL_GetPerformanceCounter();
+    double maxBehind = loop->updateStep * loop->maxUpdates;
+    AE_GameLoopStats* stats = &loop->stats;
+    
+    //The first frame has nothing to catch up on
+    if (loop->lastCounter == 0)
+    {
+        loop->lastCounter = frameStart;
+    }
+    stats->frameTime = AE_GameLoop_Seconds(loop->lastCounter, frameStart);
+    loop->lastCounter = frameStart;
+    
+    //Clamp how far behind the simulation can fall, or every slow frame would make the next one slower
+    loop->accumulator += stats->frameTime;
+    stats->droppedTime = 0;
+    if (loop->accumulator > maxBehind)
+    {
+        stats->droppedTime = loop->accumulator - maxBehind;
+        loop->accumulator = maxBehind;
+    }
+    
+    stats->updates = 0;
+    while (loop->isRunning && loop->accumulator >= loop->updateStep)
+    {
+        AE_PROFILE_BEGIN("AE_GameLoop Update");
+        if (!loop->update(loop->userdata, loop->updateStep))
+        {
+            loop->isRunning = SDL_FALSE;
+        }
+        AE_PROFILE_END();
+        loop->accumulator -= loop->updateStep;
+        stats->updates++;
+        loop->updateCount++;
+    }
+    Uint64 renderStart = SDL_GetPerformanceCounter();
+    stats->simulationTime = AE_GameLoop_Seconds(frameStart, renderStart);
+    
+    stats->alpha = (float)(loop->accumulator / loop->updateStep);
+    if (loop->render != NULL)
+    {
+        AE_PROFILE_BEGIN("AE_GameLoop Render");
+        loop->render(loop->userdata, stats->alpha, (float)stats->frameTime);
+        AE_PROFILE_END();
+    }
+    Uint64 renderEnd = SDL_GetPerformanceCounter();
+    stats->renderTime = AE_GameLoop_Seconds(renderStart, renderEnd);
+    stats->load = (stats->frameTime > 0) ? (stats->simulationTime + stats->renderTime) / stats->frameTime : 0;
+    
+    //Sleep out whatever is left of the frame, to the nearest millisecond SDL_Delay can manage
+    if (loop->frameLimit > 0)
+    {
+        double remaining = (1.0 / loop->frameLimit) - AE_GameLoop_Seconds(frameStart, renderEnd);
+        if (remaining >= 0.0005)
+        {
+            SDL_Delay((Uint32)(remaining * 1000.0 + 0.5));
+        }
+    }
+    AE_PROFILE_FRAME();
+    
+    return loop->isRunning;
+}
+
+/**
+ Runs frames of an AE_GameLoop until an update returns SDL_FALSE or AE_GameLoop_Stop is called
+
+ @param loop The AE_GameLoop to run
+ */
+void AE_GameLoop_Run(AE_GameLoop* loop)
+{
+    //Time spent outside the loop isn't simulated
+    loop->isRunning = SDL_TRUE;
+    loop->lastCounter = 0;
+    while (AE_GameLoop_Frame(loop))
+    {
+    }
+}
+
+/**
+ Stops an AE_GameLoop after the frame it is in
+
+ @param loop The AE_GameLoop to stop
+ */
+void AE_GameLoop_Stop(AE_GameLoop* loop)
+{
+    loop->isRunning = SDL_FALSE;
+}
+
+/**
+ Gets how the last frame of an AE_GameLoop spent its time
+
+ @param loop The AE_GameLoop whose frame will be reported
+ @return The AE_GameLoopStats of the last frame
+ */
+AE_GameLoopStats AE_GameLoop_GetStats(AE_GameLoop* loop)
+{
+    return loop->stats;
+}
+
+/**
+ Frees and destroys an AE_GameLoop
+
+ @param loop The AE_GameLoop to be destroyed
+ */
+void AE_DestroyGameLoop(AE_GameLoop* loop)
+{
+    SDL_free(loop);
+}
+
+//
+//
+//End: Game Loop Functions
+//
+//
+
+//
+//
+//Start: Profiler Functions
+//
+//
+
+//Each thread keeps its last zones in a ring of this many (a power of two), and readers stay clear of the slots the thread is about to reuse
+#define AE_PROFILER_RING_SIZE 8192
+#define AE_PROFILER_RING_MARGIN 512
+#define AE_PROFILER_MAX_DEPTH 64
+#define AE_PROFILER_MAX_ZONES 256
+
+typedef struct {
+    const char* name;
+    Uint64 start;
+    Uint64 end;
+    Uint64 childTicks;
+}AE_ProfilerEvent;
+
+typedef struct AE_ProfilerThread {
+    AE_ProfilerEvent events[AE_PROFILER_RING_SIZE];
+    //The number of zones ever written, only changed by the owning thread and only after the zone is written
+    SDL_atomic_t head;
+    AE_ProfilerEvent stack[AE_PROFILER_MAX_DEPTH];
+    int depth;
+    //How far AE_Profiler_FrameMark has read, only touched by the thread marking frames
+    Uint32 scanned;
+    //Whether a living thread owns the record. Records of finished threads are handed to new ones instead of being freed, so their zones stay in traces
+    SDL_atomic_t inUse;
+    int index;
+    struct AE_ProfilerThread* next;
+}AE_ProfilerThread;
+
+//Every thread record ever made, newest first. Records are only ever added
+static void* AE_profilerThreads = NULL;
+static SDL_atomic_t AE_profilerThreadCount;
+static SDL_atomic_t AE_profilerThreadKey;
+static SDL_SpinLock AE_profilerKeyLock = 0;
+//The counter value traces are timed from
+static Uint64 AE_profilerEpoch = 0;
+
+static AE_ProfilerZoneStats AE_profilerFrameStats[AE_PROFILER_MAX_ZONES];
+static int AE_profilerFrameStatsCount = 0;
+static Uint64 AE_profilerFrameStart = 0;
+static SDL_SpinLock AE_profilerStatsLock = 0;
+
+/**
+ Hands a thread's record back when the thread finishes, so the next new thread can use it
+
+ @param data The AE_ProfilerThread of the finished thread
+ */
+static void AE_ProfilerThread_Release(void* data)
+{
+    AE_ProfilerThread* thread = data;
+    SDL_AtomicSet(&thread->inUse, 0);
+}
+
+/**
+ Gets the calling thread's profiler record, claiming one on first use
+
+ @return The calling thread's AE_ProfilerThread, or NULL if it couldn't be created
+ */
+static AE_ProfilerThread* AE_Profiler_GetThread(void)
+{
+    SDL_TLSID key = (SDL_TLSID)SDL_AtomicGet(&AE_profilerThreadKey);
+    AE_ProfilerThread* thread;
+    
+    if (key == 0)
+    {
+        SDL_AtomicLock(&AE_profilerKeyLock);
+        key = (SDL_TLSID)SDL_AtomicGet(&AE_profilerThreadKey);
+        if (key == 0)
+        {
+            AE_profilerEpoch = SDL_GetPerformanceCounter();
+            AE_profilerFrameStart = AE_profilerEpoch;
+            key = SDL_TLSCreate();
+            SDL_AtomicSet(&AE_profilerThreadKey, (int)key);
+        }
+        SDL_AtomicUnlock(&AE_profilerKeyLock);
+        if (key == 0)
+        {
+            return NULL;
+        }
+    }
+    
+    thread = SDL_TLSGet(key);
+    if (thread != NULL)
+    {
+        return thread;
+    }
+    
+    //Reuse the record of a thread that has finished, so short lived worker threads don't pile up records
+    for (thread = SDL_AtomicGetPtr(&AE_profilerThreads); thread != NULL; thread = thread->next)
+    {
+        if (SDL_AtomicCAS(&thread->inUse, 0, 1))
+        {
+            thread->depth = 0;
+            break;
+        }
+    }
+    if (thread == NULL)
+    {
+        thread = SDL_calloc(1, sizeof(AE_ProfilerThread));
+        if (thread == NULL)
+        {
+            return NULL;
+        }
+        SDL_AtomicSet(&thread->inUse, 1);
+        thread->index = SDL_AtomicAdd(&AE_profilerThreadCount, 1);
+        do
+        {
+            thread->next = SDL_AtomicGetPtr(&AE_profilerThreads);
+        } while (!SDL_AtomicCASPtr(&AE_profilerThreads, thread->next, thread));
+    }
+    if (SDL_TLSSet(key, thread, AE_ProfilerThread_Release) != 0)
+    {
+        SDL_AtomicSet(&thread->inUse, 0);
+        return NULL;
+    }
+    return thread;
+}
+
+/**
+ Gets the oldest zone of a thread that can be read safely
+
+ @param head The number of zones the thread has written
+ @return The number of the oldest readable zone
+ */
+static Uint32 AE_ProfilerThread_Oldest(Uint32 head)
+{
+    return head > AE_PROFILER_RING_SIZE - AE_PROFILER_RING_MARGIN ? head - (AE_PROFILER_RING_SIZE - AE_PROFILER_RING_MARGIN) : 0;
+}
+
+/**
+ Copies one of a thread's zones, checking afterwards that the thread didn't reuse the slot during the copy
+
+ @param thread The AE_ProfilerThread the zone was recorded on
+ @param index The number of the zone
+ @param output Gets the zone
+ @return Whether the copy can be trusted or not
+ */
+static SDL_bool AE_ProfilerThread_Read(AE_ProfilerThread* thread, Uint32 index, AE_ProfilerEvent* output)
+{
+    *output = thread->events[index & (AE_PROFILER_RING_SIZE - 1)];
+    //A thread writing zones faster than they're read can lap the reader, which only shows once the head has moved on
+    return (Uint32)SDL_AtomicGet(&thread->head) - index < AE_PROFILER_RING_SIZE;
+}
+
+/**
+ Starts a profiling zone on the calling thread. Zones nest, and every one has to be ended on the thread that started it. Use AE_PROFILE_BEGIN so the zone compiles out of builds without profiling
+
+ @param name The name of the zone, which has to stay valid until the profile is written (a string literal)
+ */
+void AE_Profiler_Begin(const char* name)
+{
+    AE_ProfilerThread* thread = AE_Profiler_GetThread();
+    AE_ProfilerEvent* event;
+    
+    if (thread == NULL)
+    {
+        return;
+    }
+    //Zones nested past the deepest level are counted but not recorded, so their ends still match up
+    if (thread->depth < AE_PROFILER_MAX_DEPTH)
+    {
+        event = &thread->stack[thread->depth];
+        event->name = name;
+        event->childTicks = 0;
+        event->start = SDL_GetPerformanceCounter();
+    }
+    thread->depth++;
+}
+
+/**
+ Ends the calling thread's innermost profiling zone, recording it. Use AE_PROFILE_END so the zone compiles out of builds without profiling
+ */
+void AE_Profiler_End(void)
+{
+    Uint64 end = SDL_GetPerformanceCounter();
+    AE_ProfilerThread* thread = AE_Profiler_GetThread();
+    AE_ProfilerEvent* event;
+    Uint32 head;
+    
+    if (thread == NULL || thread->depth == 0)
+    {
+        return;
+    }
+    thread->depth--;
+    if (thread->depth >= AE_PROFILER_MAX_DEPTH)
+    {
+        return;
+    }
+    
+    event = &thread->stack[thread->depth];
+    event->end = end;
+    if (thread->depth > 0)
+    {
+        thread->stack[thread->depth - 1].childTicks += end - event->start;
+    }
+    
+    //The zone is written before the head moves past it, so readers never see half a zone
+    head = (Uint32)SDL_AtomicGet(&thread->head);
+    thread->events[head & (AE_PROFILER_RING_SIZE - 1)] = *event;
+    SDL_AtomicSet(&thread->head, (int)(head + 1));
+}
+
+/**
+ Adds a finished zone to the totals of a frame
+
+ @param zones The totals so far
+ @param zoneCount The number of totals so far
+ @param event The zone to add
+ @return The number of totals after adding the zone
+ */
+static int AE_Profiler_AddToFrame(AE_ProfilerZoneStats* zones, int zoneCount, const AE_ProfilerEvent* event)
+{
+    Uint64 total = AE_PreciseTimer_Nanoseconds(event->end - event->start);
+    Uint64 self = AE_PreciseTimer_Nanoseconds(event->end - event->start - event->childTicks);
+    int i;
+    
+    //Names are nearly always the same string literal, so comparing pointers first skips most string compares
+    for (i = 0; i<zoneCount; i++)
+    {
+        if (zones[i].name == event->name || SDL_strcmp(zones[i].name, event->name) == 0)
+        {
+            break;
+        }
+    }
+    if (i == zoneCount)
+    {
+        if (zoneCount == AE_PROFILER_MAX_ZONES)
+        {
+            return zoneCount;
+        }
+        zones[i].name = event->name;
+        zones[i].calls = 0;
+        zones[i].totalTime = 0;
+        zones[i].selfTime = 0;
+        zones[i].maxTime = 0;
+        zoneCount++;
+    }
+    
+    zones[i].calls++;
+    zones[i].totalTime += total;
+    zones[i].selfTime += self;
+    if (total > zones[i].maxTime)
+    {
+        zones[i].maxTime = total;
+    }
+    return zoneCount;
+}
+
+static int AE_ProfilerZoneStats_Compare(const void* a, const void* b)
+{
+    const AE_ProfilerZoneStats* zoneA = a;
+    const AE_ProfilerZoneStats* zoneB = b;
+    
+    if (zoneA->totalTime != zoneB->totalTime)
+    {
+        return zoneA->totalTime < zoneB->totalTime ? 1 : -1;
+    }
+    return SDL_strcmp(zoneA->name, zoneB->name);
+}
+
+/**
+ Marks the end of a frame, recording it as a zone of its own and totalling up every zone ended on any thread since the last mark. Call once per frame from the main thread, or use AE_PROFILE_FRAME (AE_GameLoop marks its own frames)
+ */
+void AE_Profiler_FrameMark(void)
+{
+    static AE_ProfilerZoneStats zones[AE_PROFILER_MAX_ZONES];
+    AE_ProfilerThread* thread = AE_Profiler_GetThread();
+    int zoneCount = 0;
+    
+    if (thread == NULL)
+    {
+        return;
+    }
+    
+    //The frame itself is recorded as an outermost zone, so traces show where each frame starts
+    if (thread->depth == 0)
+    {
+        AE_ProfilerEvent frame = {"Frame", AE_profilerFrameStart, SDL_GetPerformanceCounter(), 0};
+        Uint32 head = (Uint32)SDL_AtomicGet(&thread->head);
+        thread->events[head & (AE_PROFILER_RING_SIZE - 1)] = frame;
+        SDL_AtomicSet(&thread->head, (int)(head + 1));
+        AE_profilerFrameStart = frame.end;
+    }
+    
+    for (thread = SDL_AtomicGetPtr(&AE_profilerThreads); thread != NULL; thread = thread->next)
+    {
+        Uint32 head = (Uint32)SDL_AtomicGet(&thread->head);
+        Uint32 oldest = AE_ProfilerThread_Oldest(head);
+        
+        //Zones overwritten since the last frame are lost, which only happens when a thread records thousands of zones a frame
+        if ((Sint32)(thread->scanned - oldest) < 0)
+        {
+            thread->scanned = oldest;
+        }
+        for (; thread->scanned != head; thread->scanned++)
+        {
+            AE_ProfilerEvent event;
+            if (AE_ProfilerThread_Read(thread, thread->scanned, &event))
+            {
+                zoneCount = AE_Profiler_AddToFrame(zones, zoneCount, &event);
+            }
+        }
+    }
+    SDL_qsort(zones, zoneCount, sizeof(AE_ProfilerZoneStats), AE_ProfilerZoneStats_Compare);
+    
+    SDL_AtomicLock(&AE_profilerStatsLock);
+    SDL_memcpy(AE_profilerFrameStats, zones, zoneCount * sizeof(AE_ProfilerZoneStats));
+    AE_profilerFrameStatsCount = zoneCount;
+    SDL_AtomicUnlock(&AE_profilerStatsLock);
+}
+
+/**
+ Gets the totals of each profiling zone over the last frame marked
+
+ @param output The array the totals will be written to, sorted by total time with the longest first
+ @param maxCount The number of totals the array has room for
+ @return The number of zones recorded in the frame, which may be more than maxCount
+ */
+int AE_Profiler_GetFrameStats(AE_ProfilerZoneStats* output, int maxCount)
+{
+    int count;
+    
+    SDL_AtomicLock(&AE_profilerStatsLock);
+    count = AE_profilerFrameStatsCount;
+    if (output != NULL && maxCount > 0)
+    {
+        SDL_memcpy(output, AE_profilerFrameStats, SDL_min(count, maxCount) * sizeof(AE_ProfilerZoneStats));
+    }
+    SDL_AtomicUnlock(&AE_profilerStatsLock);
+    return count;
+}
+
+/**
+ Writes a zone name as a JSON string, escaping the characters JSON doesn't allow
+
+ @param file The file to write to
+ @param name The zone name
+ @return Whether the name was written or not
+ */
+static SDL_bool AE_Profiler_WriteName(SDL_RWops* file, const char* name)
+{
+    char buffer[256];
+    size_t length = 0;
+    
+    buffer[length++] = '"';
+    for (const char* c = name; *c != '\0' && length < sizeof(buffer) - 8; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            buffer[length++] = '\\';
+            buffer[length++] = *c;
+        }
+        else if ((unsigned char)*c < 0x20)
+        {
+            length += SDL_snprintf(buffer + length, sizeof(buffer) - length, "\\u%04x", (unsigned char)*c);
+        }
+        else
+        {
+            buffer[length++] = *c;
+        }
+    }
+    buffer[length++] = '"';
+    return SDL_RWwrite(file, buffer, 1, length) == length;
+}
+
+/**
+ Writes every zone still held in each thread's buffer to a Chrome trace / Perfetto JSON file
+
+ @param path The pathname of the file to write
+ @return Whether the file was written or not
+ */
+SDL_bool AE_Profiler_WriteTrace(const char* path)
+{
+    SDL_RWops* file = SDL_RWFromFile(path, "wb");
+    SDL_bool success;
+    SDL_bool first = SDL_TRUE;
+    char line[160];
+    size_t length;
+    
+    if (file == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    success = SDL_RWwrite(file, "{\"traceEvents\":[", 1, 16) == 16;
+    for (AE_ProfilerThread* thread = SDL_AtomicGetPtr(&AE_profilerThreads); thread != NULL && success; thread = thread->next)
+    {
+        Uint32 head = (Uint32)SDL_AtomicGet(&thread->head);
+        
+        for (Uint32 i = AE_ProfilerThread_Oldest(head); i != head && success; i++)
+        {
+            AE_ProfilerEvent event;
+            if (!AE_ProfilerThread_Read(thread, i, &event))
+            {
+                continue;
+            }
+            //Trace times are in microseconds, kept to the nanosecond
+            Uint64 start = AE_PreciseTimer_Nanoseconds(event.start - AE_profilerEpoch);
+            Uint64 duration = AE_PreciseTimer_Nanoseconds(event.end - event.start);
+            
+            const char* separator = first ? "\n{\"name\":" : ",\n{\"name\":";
+            success = SDL_RWwrite(file, separator, 1, SDL_strlen(separator)) == SDL_strlen(separator) && AE_Profiler_WriteName(file, event.name);
+            length = SDL_snprintf(line, sizeof(line), ",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"pid\":1,\"tid\":%d}", (unsigned long long)(start / 1000), (unsigned)(start % 1000), (unsigned long long)(duration / 1000), (unsigned)(duration % 1000), thread->index);
+            success = success && SDL_RWwrite(file, line, 1, length) == length;
+            first = SDL_FALSE;
+        }
+    }
+    success = success && SDL_RWwrite(file, "\n]}\n", 1, 4) == 4;
+    
+    if (SDL_RWclose(file) != 0)
+    {
+        success = SDL_FALSE;
+    }
+    return success;
+}
+
+//
+//
+//End: Profiler Functions
+//
+//
+
+//
+//
+//Start: General Functions
+//
+//
+
+/**
+ Blends two Uint8's together, based on the strength of the second Uint8 that should be used. To be used to combine individual R, G, or B channels
+
+ @param col1 The base color
+ @param col2 The color to be blended into the base color
+ @param percentage The percentage of the blend (50 is halfway between the colors, 0 is the base color, 100 is the blended color)
+ @return The blended color
+ */
+Uint8 AE_BlendColorChannel(Uint8 col1, Uint8 col2, Uint8 percentage)
+{
+    //Return color 1 mixed with a percentage of color 2
+    return (Uint8)(col1 + ( (col2 - col1) * ((float)percentage) / 100 ) );
+}
+
+/**
+ Gets a random number between two numbers from the calling thread's AE_Rng. Safe to call from any thread
+
+ @param min The minimun number the output can be
+ @param max The number above the maximum the output can be
+ @return The random number
+ */
+int AE_Random(int min, int max)
+{
+    AE_Rng* rng = AE_GetThreadRng();
+    
+    //If the min and max are the same, return that: else, return the random number
+    return (rng != NULL) ? AE_Rng_Range(rng, min, max) : min;
+}
+
+/**
+ Gets a random seed number from the calling thread's AE_Rng. Safe to call from any thread
+
+ @return The random seed number, which is never 0
+ */
+Uint64 AE_RandomSeed()
+{
+    AE_Rng* rng = AE_GetThreadRng();
+    Uint64 seed = 0;
+    
+    //Draw again in the one in 2^64 case the seed is 0
+    while (rng != NULL && seed == 0)
+    {
+        seed = AE_Rng_Next(rng);
+    }
+    return (seed != 0) ? seed : SDL_GetPerformanceCounter() | 1;
+}
+
+/**
+ Creates a pseudorandom Uint64 from 4 Uint64. Used for creating random numbers from seeds.
+ 
+ @param seednum_1 A manipulated Uint64
+ @param seednum_2 A manipulated Uint64
+ @param seednum_3 A manipulated Uint64
+ @param seednum_4 A manipulated Uint64
+ @return A Uint64 created by shifting and manipulating the 4 given Uint64's
+ */
+Uint64 AE_CreateFinalSeed(Uint64 seednum_1, Uint64 seednum_2, Uint64 seednum_3, Uint64 seednum_4)
+{
+    //Set the first 8 bytes (8/64)
+    Uint64 finalseed = -seednum_1 % 11;
+    finalseed = finalseed << 1 | (-seednum_1 % 13);
+    finalseed = finalseed << 1 | (-seednum_2 % 11);
+    finalseed = finalseed << 1 | (-seednum_2 % 13);
+    finalseed = finalseed << 1 | (-seednum_3 % 11);
+    finalseed = finalseed << 1 | (-seednum_3 % 13);
+    finalseed = finalseed << 1 | (-seednum_4 % 11);
+    finalseed = finalseed << 1 | (-seednum_4 % 13);
+    //Set the second 8 bytes (16/64)
+    finalseed = finalseed << 1 | (seednum_1 % 7);
+    finalseed = finalseed << 1 | (seednum_1 % 17);
+    finalseed = finalseed << 1 | (seednum_2 % 7);
+    finalseed = finalseed << 1 | (seednum_2 % 17);
+    finalseed = finalseed << 1 | (seednum_3 % 7);
+    finalseed = finalseed << 1 | (seednum_3 % 17);
+    finalseed = finalseed << 1 | (seednum_4 % 7);
+    finalseed = finalseed << 1 | (seednum_4 % 17);
+    //Set the third 8 bytes (24/64)
+    finalseed = finalseed << 1 | (-seednum_1 % 19);
+    finalseed = finalseed << 1 | (-seednum_1 % 23);
+    finalseed = finalseed << 1 | (-seednum_2 % 19);
+    finalseed = finalseed << 1 | (-seednum_2 % 23);
+    finalseed = finalseed << 1 | (-seednum_3 % 19);
+    finalseed = finalseed << 1 | (-seednum_3 % 23);
+    finalseed = finalseed << 1 | (-seednum_4 % 19);
+    finalseed = finalseed << 1 | (-seednum_4 % 23);
+    //Set the fourth 8 bytes (32/64)
+    finalseed = finalseed << 1 | (-seednum_1 % 59);
+    finalseed = finalseed << 1 | (-seednum_1 % 67);
+    finalseed = finalseed << 1 | (-seednum_2 % 59);
+    finalseed = finalseed << 1 | (-seednum_2 % 67);
+    finalseed = finalseed << 1 | (-seednum_3 % 59);
+    finalseed = finalseed << 1 | (-seednum_3 % 67);
+    finalseed = finalseed << 1 | (-seednum_4 % 59);
+    finalseed = finalseed << 1 | (-seednum_4 % 67);
+    //Set the fifth 8 bytes (40/64)
+    finalseed = finalseed << 1 | (-seednum_1 % 89);
+    finalseed = finalseed << 1 | (-seednum_1 % 97);
+    finalseed = finalseed << 1 | (-seednum_2 % 89);
+    finalseed = finalseed << 1 | (-seednum_2 % 97);
+    finalseed = finalseed << 1 | (-seednum_3 % 89);
+    finalseed = finalseed << 1 | (-seednum_3 % 97);
+    finalseed = finalseed << 1 | (-seednum_4 % 89);
+    finalseed = finalseed << 1 | (-seednum_4 % 97);
+    //Set the sixth 8 bytes (48/64)
+    finalseed = finalseed << 1 | (seednum_1 % 61);
+    finalseed = finalseed << 1 | (seednum_1 % 67);
+    finalseed = finalseed << 1 | (seednum_2 % 61);
+    finalseed = finalseed << 1 | (seednum_2 % 67);
+    finalseed = finalseed << 1 | (seednum_3 % 61);
+    finalseed = finalseed << 1 | (seednum_3 % 67);
+    finalseed = finalseed << 1 | (seednum_4 % 61);
+    finalseed = finalseed << 1 | (seednum_4 % 67);
+    //Set the seventh 8 bytes (56/64)
+    finalseed = finalseed << 1 | (7 * -seednum_1 % 41);
+    finalseed = finalseed << 1 | (7 * -seednum_1 % 37);
+    finalseed = finalseed << 1 | (7 * -seednum_2 % 41);
+    finalseed = finalseed << 1 | (7 * -seednum_2 % 37);
+    finalseed = finalseed << 1 | (7 * -seednum_3 % 41);
+    finalseed = finalseed << 1 | (7 * -seednum_3 % 37);
+    finalseed = finalseed << 1 | (7 * -seednum_4 % 41);
+    finalseed = finalseed << 1 | (7 * -seednum_4 % 37);
+    //Set the eighth 8 bytes (64/64)
+    finalseed = finalseed << 1 | (7 * -seednum_1 % 31);
+    finalseed = finalseed << 1 | (7 * -seednum_1 % 101);
+    finalseed = finalseed << 1 | (7 * -seednum_2 % 31);
+    finalseed = finalseed << 1 | (7 * -seednum_2 % 101);
+    finalseed = finalseed << 1 | (7 * -seednum_3 % 31);
+    finalseed = finalseed << 1 | (7 * -seednum_3 % 101);
+    finalseed = finalseed << 1 | (7 * -seednum_4 % 31);
+    finalseed = finalseed << 1 | (7 * -seednum_4 % 101);
+    
+    return finalseed;
+}
+
+
+//The generator AE_PseudoRandomFromSeed_Int and _Uint64 use
+static AE_SeedMode AE_seedMode = AE_SEED_MODE_HASH;
+
+//SplitMix64's increment, used to keep each input's contribution apart
+#define AE_SEED_GOLDEN_GAMMA 0x9E3779B97F4A7C15ULL
+
+/**
+ Mixes the bits of a Uint64 so every input bit affects every output bit (the SplitMix64 finalizer). A bijection, so distinct inputs never collide
+
+ @param z The Uint64 to mix
+ @return The mixed Uint64
+ */
+static Uint64 AE_SeedHash_Mix(Uint64 z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ Maps a hash onto [min, max) without the bias of taking a remainder, using Lemire's multiply-shift method. The rare rejected hashes are rehashed, so the result stays a pure function of the hash
+
+ @param hash The hash to map
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The number in the range
+ */
+static int AE_SeedHash_ToRange(Uint64 hash, int min, int max)
+{
+    if (min == max)
+    {
+        return min;
+    }
+    if (max < min)
+    {
+        int swap = min;
+        min = max;
+        max = swap;
+    }
+    
+    Uint32 range = (Uint32)((Sint64)max - (Sint64)min);
+    Uint64 product = (hash >> 32) * range;
+    Uint32 low = (Uint32)product;
+    
+    //Only products landing in the short remainder of the 32 bit space are rejected, which happens less than once in range/2^32 calls
+    if (low < range)
+    {
+        Uint32 threshold = (Uint32)(-range) % range;
+        while (low < threshold)
+        {
+            hash = AE_SeedHash_Mix(hash + AE_SEED_GOLDEN_GAMMA);
+            product = (hash >> 32) * range;
+            low = (Uint32)product;
+        }
+    }
+    return (int)((Sint64)min + (Sint64)(product >> 32));
+}
+
+/**
+ Sets which generator AE_PseudoRandomFromSeed_Int and AE_PseudoRandomFromSeed_Uint64 use. Worlds saved with older versions of the engine need AE_SEED_MODE_LEGACY to be generated the same way again
+
+ @param mode The generator to use
+ */
+void AE_SetSeedMode(AE_SeedMode mode)
+{
+    AE_seedMode = mode;
+}
+
+/**
+ Gets which generator AE_PseudoRandomFromSeed_Int and AE_PseudoRandomFromSeed_Uint64 use
+
+ @return The generator in use
+ */
+AE_SeedMode AE_GetSeedMode(void)
+{
+    return AE_seedMode;
+}
+
+/**
+ Hashes a seed, a position and a set into a pseudorandom Uint64. Stateless, so any position can be generated in any order or on any thread with the same result
+
+ @param seed The seed number
+ @param x The x being generated
+ @param y The y being generated
+ @param set A value that gives a separate stream of numbers for the same x and y
+ @return The pseudorandom Uint64
+ */
+Uint64 AE_SeedHash(Uint64 seed, Uint64 x, Uint64 y, Uint64 set)
+{
+    //Each round is a bijection of the previous one, so changing any single input always changes the output
+    Uint64 hash = AE_SeedHash_Mix(seed + set * AE_SEED_GOLDEN_GAMMA);
+    hash = AE_SeedHash_Mix(hash ^ (x + AE_SEED_GOLDEN_GAMMA));
+    return AE_SeedHash_Mix(hash ^ (y * 0xD1B54A32D192ED03ULL));
+}
+
+/**
+ Hashes a seed, a position and a set into a pseudorandom double. Stateless, like AE_SeedHash
+
+ @param seed The seed number
+ @param x The x being generated
+ @param y The y being generated
+ @param set A value that gives a separate stream of numbers for the same x and y
+ @return The pseudorandom double, at least 0 and less than 1
+ */
+double AE_SeedHash_Double(Uint64 seed, Uint64 x, Uint64 y, Uint64 set)
+{
+    //The top 53 bits fill a double's mantissa exactly
+    return (double)(Sint64)(AE_SeedHash(seed, x, y, set) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ Hashes a seed, a position and a set into a pseudorandom number between two numbers. This is what AE_PseudoRandomFromSeed_Int gives with AE_SEED_MODE_HASH, whatever the current seed mode
+
+ @param seed The seed number
+ @param x The x being generated
+ @param y The y being generated
+ @param set A value that gives a separate stream of numbers for the same x and y
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The pseudorandom number
+ */
+int AE_SeedHash_Int(Uint64 seed, Uint64 x, Uint64 y, Uint64 set, int min, int max)
+{
+    return AE_SeedHash_ToRange(AE_SeedHash(seed, x, y, set), min, max);
+}
+
+/**
+ The generator older versions of the engine used for AE_PseudoRandomFromSeed_Int. Shift counts are masked to 0-63, which keeps the sequence those versions produced on x86 while no longer being undefined
+
+ @param seed The seed number to be manipulated
+ @param x The x upon which the seed number will be manipulated
+ @param y The y upon which the seed number will be manipulated
+ @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
+ @param min The min number the output can be
+ @param max The max number the output can be
+ @return The pseudorandom number based on the seed, x, and y
+ */
+static int AE_PseudoRandomFromSeed_LegacyInt(Uint64 seed, int x, int y, Uint64 set, int min, int max)
+{
+    //Create a shifted number to manipulate the seed value based on the set
+    Uint8 setshift_1 = ((set << (x & 63))) | ((Uint64)pow(set,3));
+    Uint8 setshift_2 = ((set << (y & 63))) | set;
+    Uint8 setshift_3 = set + x + y - setshift_1;
+    Uint8 setshift_4 = -set - x - y + setshift_2;
+    
+    seed = seed | AE_CreateFinalSeed(setshift_1, setshift_2, setshift_3, setshift_4);
+    
+    //Create shifted numbers to create pseudorandom numbers by
+    Uint64 seedshift_1 = ((seed << (x & 63))) + y;
+    Uint64 seedshift_2 = ((seed << (y & 63))) + x;
+    Uint64 seedshift_3 = seed + x + y - seedshift_1;
+    Uint64 seedshift_4 = -seed - x - y + seedshift_2;
+    
+    Uint64 finalseed = AE_CreateFinalSeed(seedshift_1, seedshift_2, seedshift_3, seedshift_4);
+    
+    //If the min and max are the same, return that: else, return the random number
+    return (min != max) ? ((int )(SDL_floor(finalseed % (max - min)) + min)) : min;
+}
+
+/**
+ The generator older versions of the engine used for AE_PseudoRandomFromSeed_Uint64. Shift counts are masked to 0-63, which keeps the sequence those versions produced on x86 while no longer being undefined
+ 
+ @param seed The seed number to be manipulated
+ @param x The x upon which the seed number will be manipulated
+ @param y The y upon which the seed number will be manipulated
+ @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
+ @param min The min number the output can be
+ @param max The max number the output can be
+ @return The pseudorandom number based on the seed, x, and y
+ */
+static int AE_PseudoRandomFromSeed_LegacyUint64(Uint64 seed, Uint64 x, Uint64 y, Uint64 set, int min, int max)
+{
+    //Create a shifted number to manipulate the seed value based on the set
+    Uint64 setshift_1 = ((set << (x & 63))) | ((Uint64)pow(set,3));
+    Uint64 setshift_2 = ((set << (y & 63))) | set;
+    Uint64 setshift_3 = set + x + y - setshift_1;
+    Uint64 setshift_4 = -set - x - y + setshift_2;
+    
+    seed = seed | AE_CreateFinalSeed(setshift_1, setshift_2, setshift_3, setshift_4);
+    
+    //Create shifted numbers to create pseudorandom numbers by
+    Uint64 seedshift_1 = ((seed << (x & 63))) + y;
+    Uint64 seedshift_2 = ((seed << (y & 63))) + x;
+    Uint64 seedshift_3 = seed + x + y - seedshift_1;
+    Uint64 seedshift_4 = -seed - x - y + seedshift_2;
+    
+    Uint64 finalseed = AE_CreateFinalSeed(seedshift_1, seedshift_2, seedshift_3, seedshift_4);
+    
+    //If the min and max are the same, return that: else, return the random number
+    return (min != max) ? ((int )(floor(finalseed % (max - min)) + min)) : min;
+}
+
+/**
+ Gets a pseudorandom number between two numbers based on a given seed. Used for procedural generation: if given the same input numbers, the output will always be the same. Negative coordinates give the same numbers as AE_PseudoRandomFromSeed_Uint64 does for the coordinates cast to Uint64
+
+ @param seed The seed number to be manipulated
+ @param x The x upon which the seed number will be manipulated
+ @param y The y upon which the seed number will be manipulated
+ @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The pseudorandom number based on the seed, x, and y
+ */
+int AE_PseudoRandomFromSeed_Int(Uint64 seed, int x, int y, Uint64 set, int min, int max)
+{
+    if (AE_seedMode == AE_SEED_MODE_LEGACY)
+    {
+        return AE_PseudoRandomFromSeed_LegacyInt(seed, x, y, set, min, max);
+    }
+    return AE_SeedHash_Int(seed, (Uint64)(Sint64)x, (Uint64)(Sint64)y, set, min, max);
+}
+
+/**
+ Gets a pseudorandom number between two numbers based on a given seed. Used for procedural generation: if given the same input numbers, the output will always be the same
+ 
+ @param seed The seed number to be manipulated
+ @param x The x upon which the seed number will be manipulated
+ @param y The y upon which the seed number will be manipulated
+ @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The pseudorandom number based on the seed, x, and y
+ */
+int AE_PseudoRandomFromSeed_Uint64(Uint64 seed, Uint64 x, Uint64 y, Uint64 set, int min, int max)
+{
+    if (AE_seedMode == AE_SEED_MODE_LEGACY)
+    {
+        return AE_PseudoRandomFromSeed_LegacyUint64(seed, x, y, set, min, max);
+    }
+    return AE_SeedHash_Int(seed, x, y, set, min, max);
+}
+
+/**
+ Returns the distance between two points as an int
+
+ @param x1 The x of the first point
+ @param y1 The y of the first point
+ @param x2 The x of the second point
+ @param y2 The y of the second point
+ @return The distance between two points as an int
+ */
+int AE_PointDistance(int x1, int y1, int x2, int y2)
+{
+    return (int) sqrt((double)(pow((x1-x2), 2) + pow((y1 - y2), 2)));
+}
+
+/**
+ Returns the distance between two points as a double
+ 
+ @param x1 The x of the first point
+ @param y1 The y of the first point
+ @param x2 The x of the second point
+ @param y2 The y of the second point
+ @return The distance between two points as a double
+ */
+double AE_PointDistance_D(Uint64 x1, Uint64 y1, Uint64 x2, Uint64 y2)
+{
+    return SDL_sqrt((double)(pow((x1 - x2), 2) + pow((y1 - y2), 2)));
+}
+
+
+/**
+ Returns a float rounded to floor or ceil depending on if it's less than 0
+
+ @param input The original float
+ @return The float, rounded to the nearest floor or ceiling
+ */
+float AE_FloatBase(float input)
+{
+    float output = 0;
+    
+    if (input < 0)
+    {
+        output = SDL_floor((double)input);
+    }
+    else
+    {
+        output = SDL_ceil((double)input);
+    }
+    return output;
+}
+
+/**
+ Returns the horizontal length of a line of a given length on a given angle
+
+ @param length The length of the line whose horizontal component will be found
+ @param direction The angle of the line whose horizontal component will be found
+ @return The precise length of the horizontal component of the given line
+ */
+long double AE_Lengthdir_X(int length, float direction)
+{
+    return (long double)(SDL_cos(direction)*length);
+}
+
+/**
+ Returns the vertical length of a line of a given length on a given angle
+ 
+ @param length The length of the line whose vertical component will be found
+ @param direction The angle of the line whose vertical component will be found
+ @return The precise length of the vertical component of the given line
+ */
+long double AE_Lengthdir_Y(int length, float direction)
+{
+    return (long double)(SDL_sin(direction)*length);
+}
+
+/**
+ Returns whether a vector belonging to a point (x1, y1) is clockwise to a vector belonging to another point (x2, y2)
+ 
+ @param x1 The horizontal value of the point on a vector being tested
+ @param y1 The vertical value of the point on a vector being tested
+ @param x2 The horizontal value of the point on a vector
+ @param y2 The vertical value of the point on a vector
+ @return Whether vector (x1, y1) is clockwise to (x2, y2)
+ */
+SDL_bool AE_VectorIsClockwise(double x1, double y1, double x2, double y2)
+{
+    return (((x1 * y2) + (x2 * y1)) > 0);
 }
 
 /**
- Returns whether an AE_Timer is started
+ Returns the length of a vector designated by the endpoint
 
- @param timer The AE_Timer to determine whether it is started or not
- @return Whether the AE_Timer is started or not
+ @param x The horizontal distance of the point from the center
+ @param y The vertical distance of the point from the center
+ @return The length of the vector designated by the x and y
  */
-SDL_bool AE_Timer_IsStarted(AE_Timer* timer)
+double AE_VectorLength(double x, double y)
 {
-    return timer->isStarted;
+    return SDL_sqrt((SDL_pow(x, 2) + SDL_pow(y, 2)));
 }
 
 //
 //
-//End: Timer Functions
-//
-//
+//End: General Functions
+
+
 
 //
 //
-//Start: General Functions
+//Start: Random Number Generator Functions
 //
 //
 
+//The generator each thread's own generator is split from, seeded on first use
+static AE_Rng AE_rngRoot;
+static SDL_SpinLock AE_rngRootLock = 0;
+//The thread local storage key of each thread's generator (0 until it is first needed)
+static SDL_atomic_t AE_rngThreadKey;
+
 /**
- Blends two Uint8's together, based on the strength of the second Uint8 that should be used. To be used to combine individual R, G, or B channels
+ Rotates the bits of a Uint64 left
 
- @param col1 The base color
- @param col2 The color to be blended into the base color
- @param percentage The percentage of the blend (50 is halfway between the colors, 0 is the base color, 100 is the blended color)
- @return The blended color
+ @param value The Uint64 to rotate
+ @param count The number of bits to rotate by, from 1 to 63
+ @return The rotated Uint64
  */
-Uint8 AE_BlendColorChannel(Uint8 col1, Uint8 col2, Uint8 percentage)
+static Uint64 AE_Rng_Rotate(Uint64 value, int count)
 {
-    //Return color 1 mixed with a percentage of color 2
-    return (Uint8)(col1 + ( (col2 - col1) * ((float)percentage) / 100 ) );
+    return (value << count) | (value >> (64 - count));
 }
 
 /**
- Gets a random number between two numbers
+ Gets a random number below a bound, without the bias of taking a remainder (Lemire's multiply-shift method)
 
- @param min The minimun number the output can be
- @param max The maximum number the output can be
- @return The random number
+ @param rng The AE_Rng to draw from
+ @param range The number of values the output can have (at least 1)
+ @return The random number, at least 0 and less than range
  */
-int AE_Random(int min, int max)
+static Uint32 AE_Rng_Bounded(AE_Rng* rng, Uint32 range)
 {
-    //If the min and max are the same, return that: else, return the random number
-    return (min != max) ? ((int )(SDL_floor(rand() % (max - min)) + min)) : min;
+    Uint64 product = (AE_Rng_Next(rng) >> 32) * range;
+    Uint32 low = (Uint32)product;
+    
+    //Only draws landing in the short remainder of the 32 bit space are redrawn
+    if (low < range)
+    {
+        Uint32 threshold = (Uint32)(-range) % range;
+        while (low < threshold)
+        {
+            product = (AE_Rng_Next(rng) >> 32) * range;
+            low = (Uint32)product;
+        }
+    }
+    return (Uint32)(product >> 32);
 }
 
 /**
- Gets a random seed number
+ Seeds a random number generator, so it gives the same numbers every time it's seeded with the same seed
 
- @return The random seed number
+ @param rng The AE_Rng to be seeded
+ @param seed The seed number
  */
-Uint64 AE_RandomSeed()
+void AE_SeedRng(AE_Rng* rng, Uint64 seed)
+{
+    //Spread the seed over the state with SplitMix64, which never gives 4 zeroes in a row
+    for (int i = 0; i<4; i++)
+    {
+        seed += AE_SEED_GOLDEN_GAMMA;
+        rng->state[i] = AE_SeedHash_Mix(seed);
+    }
+}
+
+/**
+ Gets the calling thread's own random number generator, creating it on first use. Each thread's generator is split from one shared generator, so no two threads ever get overlapping numbers
+
+ @return The calling thread's AE_Rng, or NULL if it couldn't be created
+ */
+AE_Rng* AE_GetThreadRng(void)
 {
-    //Create a random Uint32 seed
-    Uint64 seed = rand();
-    //Bitshift the original by 32 and repeat
-    seed = (seed<<32) | rand();
-    //If the seed is 0, recursively find a new seed that isn't 0, and return that nonzero seed
-    if (seed == 0)
+    SDL_TLSID key = (SDL_TLSID)SDL_AtomicGet(&AE_rngThreadKey);
+    AE_Rng* rng;
+    
+    if (key == 0)
     {
-        seed = AE_RandomSeed();
+        SDL_AtomicLock(&AE_rngRootLock);
+        key = (SDL_TLSID)SDL_AtomicGet(&AE_rngThreadKey);
+        if (key == 0)
+        {
+            //Every run gets different numbers, from the time and wherever the engine was loaded
+            AE_SeedRng(&AE_rngRoot, SDL_GetPerformanceCounter() ^ (Uint64)(uintptr_t)&AE_rngRoot);
+            key = SDL_TLSCreate();
+            SDL_AtomicSet(&AE_rngThreadKey, (int)key);
+        }
+        SDL_AtomicUnlock(&AE_rngRootLock);
+        if (key == 0)
+        {
+            return NULL;
+        }
     }
     
-    return seed;
+    rng = SDL_TLSGet(key);
+    if (rng == NULL)
+    {
+        rng = SDL_malloc(sizeof(AE_Rng));
+        if (rng == NULL)
+        {
+            return NULL;
+        }
+        SDL_AtomicLock(&AE_rngRootLock);
+        AE_Rng_Split(&AE_rngRoot, rng);
+        SDL_AtomicUnlock(&AE_rngRootLock);
+        
+        //The generator is freed when the thread exits
+        if (SDL_TLSSet(key, rng, SDL_free) != 0)
+        {
+            SDL_free(rng);
+            return NULL;
+        }
+    }
+    return rng;
 }
 
 /**
- Creates a pseudorandom Uint64 from 4 Uint64. Used for creating random numbers from seeds.
- 
- @param seednum_1 A manipulated Uint64
- @param seednum_2 A manipulated Uint64
- @param seednum_3 A manipulated Uint64
- @param seednum_4 A manipulated Uint64
- @return A Uint64 created by shifting and manipulating the 4 given Uint64's
+ Gets the next random Uint64 from a random number generator
+
+ @param rng The AE_Rng to draw from
+ @return The random Uint64
  */
-Uint64 AE_CreateFinalSeed(Uint64 seednum_1, Uint64 seednum_2, Uint64 seednum_3, Uint64 seednum_4)
+Uint64 AE_Rng_Next(AE_Rng* rng)
 {
-    //Set the first 8 bytes (8/64)
-    Uint64 finalseed = -seednum_1 % 11;
-    finalseed = finalseed << 1 | (-seednum_1 % 13);
-    finalseed = finalseed << 1 | (-seednum_2 % 11);
-    finalseed = finalseed << 1 | (-seednum_2 % 13);
-    finalseed = finalseed << 1 | (-seednum_3 % 11);
-    finalseed = finalseed << 1 | (-seednum_3 % 13);
-    finalseed = finalseed << 1 | (-seednum_4 % 11);
-    finalseed = finalseed << 1 | (-seednum_4 % 13);
-    //Set the second 8 bytes (16/64)
-    finalseed = finalseed << 1 | (seednum_1 % 7);
-    finalseed = finalseed << 1 | (seednum_1 % 17);
-    finalseed = finalseed << 1 | (seednum_2 % 7);
-    finalseed = finalseed << 1 | (seednum_2 % 17);
-    finalseed = finalseed << 1 | (seednum_3 % 7);
-    finalseed = finalseed << 1 | (seednum_3 % 17);
-    finalseed = finalseed << 1 | (seednum_4 % 7);
-    finalseed = finalseed << 1 | (seednum_4 % 17);
-    //Set the third 8 bytes (24/64)
-    finalseed = finalseed << 1 | (-seednum_1 % 19);
-    finalseed = finalseed << 1 | (-seednum_1 % 23);
-    finalseed = finalseed << 1 | (-seednum_2 % 19);
-    finalseed = finalseed << 1 | (-seednum_2 % 23);
-    finalseed = finalseed << 1 | (-seednum_3 % 19);
-    finalseed = finalseed << 1 | (-seednum_3 % 23);
-    finalseed = finalseed << 1 | (-seednum_4 % 19);
-    finalseed = finalseed << 1 | (-seednum_4 % 23);
-    //Set the fourth 8 bytes (32/64)
-    finalseed = finalseed << 1 | (-seednum_1 % 59);
-    finalseed = finalseed << 1 | (-seednum_1 % 67);
-    finalseed = finalseed << 1 | (-seednum_2 % 59);
-    finalseed = finalseed << 1 | (-seednum_2 % 67);
-    finalseed = finalseed << 1 | (-seednum_3 % 59);
-    finalseed = finalseed << 1 | (-seednum_3 % 67);
-    finalseed = finalseed << 1 | (-seednum_4 % 59);
-    finalseed = finalseed << 1 | (-seednum_4 % 67);
-    //Set the fifth 8 bytes (40/64)
-    finalseed = finalseed << 1 | (-seednum_1 % 89);
-    finalseed = finalseed << 1 | (-seednum_1 % 97);
-    finalseed = finalseed << 1 | (-seednum_2 % 89);
-    finalseed = finalseed << 1 | (-seednum_2 % 97);
-    finalseed = finalseed << 1 | (-seednum_3 % 89);
-    finalseed = finalseed << 1 | (-seednum_3 % 97);
-    finalseed = finalseed << 1 | (-seednum_4 % 89);
-    finalseed = finalseed << 1 | (-seednum_4 % 97);
-    //Set the sixth 8 bytes (48/64)
-    finalseed = finalseed << 1 | (seednum_1 % 61);
-    finalseed = finalseed << 1 | (seednum_1 % 67);
-    finalseed = finalseed << 1 | (seednum_2 % 61);
-    finalseed = finalseed << 1 | (seednum_2 % 67);
-    finalseed = finalseed << 1 | (seednum_3 % 61);
-    finalseed = finalseed << 1 | (seednum_3 % 67);
-    finalseed = finalseed << 1 | (seednum_4 % 61);
-    finalseed = finalseed << 1 | (seednum_4 % 67);
-    //Set the seventh 8 bytes (56/64)
-    finalseed = finalseed << 1 | (7 * -seednum_1 % 41);
-    finalseed = finalseed << 1 | (7 * -seednum_1 % 37);
-    finalseed = finalseed << 1 | (7 * -seednum_2 % 41);
-    finalseed = finalseed << 1 | (7 * -seednum_2 % 37);
-    finalseed = finalseed << 1 | (7 * -seednum_3 % 41);
-    finalseed = finalseed << 1 | (7 * -seednum_3 % 37);
-    finalseed = finalseed << 1 | (7 * -seednum_4 % 41);
-    finalseed = finalseed << 1 | (7 * -seednum_4 % 37);
-    //Set the eighth 8 bytes (64/64)
-    finalseed = finalseed << 1 | (7 * -seednum_1 % 31);
-    finalseed = finalseed << 1 | (7 * -seednum_1 % 101);
-    finalseed = finalseed << 1 | (7 * -seednum_2 % 31);
-    finalseed = finalseed << 1 | (7 * -seednum_2 % 101);
-    finalseed = finalseed << 1 | (7 * -seednum_3 % 31);
-    finalseed = finalseed << 1 | (7 * -seednum_3 % 101);
-    finalseed = finalseed << 1 | (7 * -seednum_4 % 31);
-    finalseed = finalseed << 1 | (7 * -seednum_4 % 101);
+    Uint64* state = rng->state;
+    Uint64 output = AE_Rng_Rotate(state[1] * 5, 7) * 9;
+    Uint64 shifted = state[1] << 17;
     
-    return finalseed;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = AE_Rng_Rotate(state[3], 45);
+    
+    return output;
+}
+
+/**
+ Gets a random whole number between two numbers, without the bias of taking a remainder
+
+ @param rng The AE_Rng to draw from
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The random number (min if min and max are the same)
+ */
+int AE_Rng_Range(AE_Rng* rng, int min, int max)
+{
+    if (min == max)
+    {
+        return min;
+    }
+    if (max < min)
+    {
+        int swap = min;
+        min = max;
+        max = swap;
+    }
+    return (int)((Sint64)min + AE_Rng_Bounded(rng, (Uint32)((Sint64)max - (Sint64)min)));
+}
+
+/**
+ Gets a random float
+
+ @param rng The AE_Rng to draw from
+ @return The random float, at least 0 and less than 1
+ */
+float AE_Rng_Float(AE_Rng* rng)
+{
+    //The top 24 bits fill a float's mantissa exactly
+    return (float)(int)(AE_Rng_Next(rng) >> 40) * (1.0f / 16777216.0f);
+}
+
+/**
+ Gets a random double
+
+ @param rng The AE_Rng to draw from
+ @return The random double, at least 0 and less than 1
+ */
+double AE_Rng_Double(AE_Rng* rng)
+{
+    //The top 53 bits fill a double's mantissa exactly
+    return (double)(Sint64)(AE_Rng_Next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ Fills an array with random Uint64's
+
+ @param rng The AE_Rng to draw from
+ @param output The array to be filled
+ @param count The number of Uint64's to fill
+ */
+void AE_Rng_Fill(AE_Rng* rng, Uint64* output, int count)
+{
+    //Work on a local copy so the state can stay in registers
+    AE_Rng local = *rng;
+    AE_PROFILE_BEGIN("AE_Rng_Fill");
+    for (int i = 0; i<count; i++)
+    {
+        output[i] = AE_Rng_Next(&local);
+    }
+    *rng = local;
+    AE_PROFILE_END();
+}
+
+/**
+ Fills an array with random whole numbers between two numbers, without the bias of taking a remainder
+
+ @param rng The AE_Rng to draw from
+ @param output The array to be filled
+ @param count The number of ints to fill
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ */
+void AE_Rng_FillRange(AE_Rng* rng, int* output, int count, int min, int max)
+{
+    AE_Rng local = *rng;
+    AE_PROFILE_BEGIN("AE_Rng_FillRange");
+    for (int i = 0; i<count; i++)
+    {
+        output[i] = AE_Rng_Range(&local, min, max);
+    }
+    *rng = local;
+    AE_PROFILE_END();
+}
+
+/**
+ Fills an array with random floats, each at least 0 and less than 1
+
+ @param rng The AE_Rng to draw from
+ @param output The array to be filled
+ @param count The number of floats to fill
+ */
+void AE_Rng_FillFloat(AE_Rng* rng, float* output, int count)
+{
+    AE_Rng local = *rng;
+    AE_PROFILE_BEGIN("AE_Rng_FillFloat");
+    for (int i = 0; i<count; i++)
+    {
+        output[i] = AE_Rng_Float(&local);
+    }
+    *rng = local;
+    AE_PROFILE_END();
+}
+
+/**
+ Jumps a random number generator ahead by 2^128 numbers, as if AE_Rng_Next had been called that many times
+
+ @param rng The AE_Rng to jump
+ */
+void AE_Rng_Jump(AE_Rng* rng)
+{
+    //The jump polynomial published with xoshiro256**
+    static const Uint64 jump[4] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    Uint64 jumped[4] = {0, 0, 0, 0};
+    
+    for (int i = 0; i<4; i++)
+    {
+        for (int bit = 0; bit<64; bit++)
+        {
+            if (jump[i] & ((Uint64)1 << bit))
+            {
+                jumped[0] ^= rng->state[0];
+                jumped[1] ^= rng->state[1];
+                jumped[2] ^= rng->state[2];
+                jumped[3] ^= rng->state[3];
+            }
+            AE_Rng_Next(rng);
+        }
+    }
+    SDL_memcpy(rng->state, jumped, sizeof(jumped));
+}
+
+/**
+ Splits off a new random number generator for another thread or worker. The new one carries on where the original was, and the original jumps ahead 2^128 numbers, so the two never overlap
+
+ @param rng The AE_Rng to split
+ @param output The AE_Rng to be filled with the split off generator
+ */
+void AE_Rng_Split(AE_Rng* rng, AE_Rng* output)
+{
+    *output = *rng;
+    AE_Rng_Jump(rng);
+}
+
+//
+//
+//End: Random Number Generator Functions
+//
+//
+//
+//
+//Start: Noise Functions
+//
+//
+
+//Periods are powers of two up to 2^30 tiles, so there is at most one octave per halving down to one tile
+#define AE_NOISE_MAX_PERIOD_SHIFT 30
+#define AE_NOISE_MAX_OCTAVES (AE_NOISE_MAX_PERIOD_SHIFT + 1)
+//The most threads a noise field is split between
+#define AE_NOISE_MAX_THREADS 64
+
+//Odd constants that spread lattice x and y over the whole 32 bits before hashing
+#define AE_NOISE_PRIME_X 0x9E3779B1u
+#define AE_NOISE_PRIME_Y 0x85EBCA77u
+//Turns the top 24 bits of a hash into a float from 0 to 2 exactly
+#define AE_NOISE_VALUE_SCALE (1.0f / 8388608.0f)
+
+/**
+ Everything about a noise field that is the same for every tile, worked out once per field
+ */
+typedef struct {
+    AE_NoiseType type;
+    Uint64 seed;
+    Uint64 set;
+    int octaveCount;
+    int shifts[AE_NOISE_MAX_OCTAVES];
+    Uint32 masks[AE_NOISE_MAX_OCTAVES];
+    float scales[AE_NOISE_MAX_OCTAVES];
+    Uint32 seeds[AE_NOISE_MAX_OCTAVES];
+    float amplitudes[AE_NOISE_MAX_OCTAVES];
+    float normalize;
+}AE_NoisePlan;
+
+/**
+ Everything about one octave that is the same along a row of tiles
+ */
+typedef struct {
+    Uint32 seeded[2];
+    float frac;
+    float fade;
+}AE_NoiseRowOctave;
+
+/**
+ The band of rows of a noise field one thread fills
+ */
+typedef struct {
+    const AE_NoisePlan* plan;
+    float* floatOutput;
+    int* intOutput;
+    float* scratch;
+    int width;
+    int firstRow;
+    int endRow;
+    Sint64 originX;
+    Sint64 originY;
+    int min;
+    int max;
+    AE_SimdLevel level;
+}AE_NoiseJob;
+
+/**
+ Works out the octaves of a noise field from its settings
+
+ @param plan The AE_NoisePlan to be filled
+ @param settings The AE_NoiseSettings the noise is generated from
+ */
+static void AE_Noise_Plan(AE_NoisePlan* plan, const AE_NoiseSettings* settings)
+{
+    int shift = 0;
+    float amplitude = 1.0f;
+    float total = 0.0f;
+    
+    plan->type = settings->type;
+    plan->seed = settings->seed;
+    plan->set = settings->set;
+    
+    //Round the period down to a power of two
+    while (shift < AE_NOISE_MAX_PERIOD_SHIFT && (2 << shift) <= settings->period)
+    {
+        shift++;
+    }
+    plan->octaveCount = SDL_max(1, SDL_min(settings->octaves, shift + 1));
+    
+    for (int octave = 0; octave<plan->octaveCount; octave++)
+    {
+        plan->shifts[octave] = shift - octave;
+        plan->masks[octave] = (1u << plan->shifts[octave]) - 1;
+        plan->scales[octave] = 1.0f / (float)(1u << plan->shifts[octave]);
+        plan->seeds[octave] = (Uint32)(AE_SeedHash(settings->seed, (Uint64)octave, 0, settings->set) >> 32);
+        plan->amplitudes[octave] = amplitude;
+        total += amplitude;
+        amplitude *= settings->gain;
+    }
+    plan->normalize = (total != 0.0f) ? 1.0f / total : 0.0f;
+}
+
+/**
+ Mixes the bits of a lattice point's hash (MurmurHash3's finalizer)
+
+ @param hash The seed, x and y of the lattice point combined
+ @return The mixed hash
+ */
+static Uint32 AE_Noise_Hash(Uint32 hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    return hash ^ (hash >> 16);
+}
+
+/**
+ Eases a position within a lattice cell so the noise is smooth across cell edges (Perlin's quintic fade)
+
+ @param t The position within the cell, from 0 to 1
+ @return The eased position
+ */
+AE_NO_FP_CONTRACT static float AE_Noise_Fade(float t)
+{
+    return ((t * t) * t) * ((t * ((t * 6.0f) - 15.0f)) + 10.0f);
 }
 
+/**
+ Works out the parts of each octave that only depend on the row
+
+ @param plan The AE_NoisePlan of the field
+ @param y The y of the row
+ @param octaves The AE_NoiseRowOctave of each octave, to be filled
+ */
+AE_NO_FP_CONTRACT static void AE_Noise_SetRow(const AE_NoisePlan* plan, Sint64 y, AE_NoiseRowOctave* octaves)
+{
+    for (int octave = 0; octave<plan->octaveCount; octave++)
+    {
+        Uint32 primed = (Uint32)((Uint64)y >> plan->shifts[octave]) * AE_NOISE_PRIME_Y;
+        octaves[octave].seeded[0] = plan->seeds[octave] ^ primed;
+        octaves[octave].seeded[1] = plan->seeds[octave] ^ (primed + AE_NOISE_PRIME_Y);
+        octaves[octave].frac = (float)(int)((Uint32)y & plan->masks[octave]) * plan->scales[octave];
+        octaves[octave].fade = AE_Noise_Fade(octaves[octave].frac);
+    }
+}
 
 /**
- Gets a pseudorandom number between two numbers based on a given seed. Used for procedural generation: if given the same input numbers, the output will always be the same
+ Gets one octave of lattice noise at a point. This is the reference every SIMD version has to match bit for bit
 
- @param seed The seed number to be manipulated
- @param x The x upon which the seed number will be manipulated
- @param y The y upon which the seed number will be manipulated
- @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
- @param min The min number the output can be
- @param max The max number the output can be
- @return The pseudorandom number based on the seed, x, and y
+ @param type AE_NOISE_VALUE or AE_NOISE_GRADIENT
+ @param row The octave's AE_NoiseRowOctave for the point's row
+ @param cellX The x of the lattice cell the point is in
+ @param fracX The position of the point across the cell, from 0 to 1
+ @return The noise, from -1 to 1
  */
-int AE_PseudoRandomFromSeed_Int(Uint64 seed, int x, int y, Uint64 set, int min, int max)
+AE_NO_FP_CONTRACT static float AE_Noise_Octave(AE_NoiseType type, const AE_NoiseRowOctave* row, Uint32 cellX, float fracX)
 {
-    //Create a shifted number to manipulate the seed value based on the set
-    Uint8 setshift_1 = ((set << x)) | ((Uint64)pow(set,3));
-    Uint8 setshift_2 = ((set << y)) | set;
-    Uint8 setshift_3 = set + x + y - setshift_1;
-    Uint8 setshift_4 = -set - x - y + setshift_2;
-    
-    //Create the final shifted number based on the set
-    Uint8 finalset = -setshift_1 % 7;
-    finalset = finalset << 1 | (-setshift_1 % 17);
-    finalset = finalset << 1 | (-setshift_2 % 7);
-    finalset = finalset << 1 | (-setshift_2 % 17);
-    finalset = finalset << 1 | (-setshift_3 % 7);
-    finalset = finalset << 1 | (-setshift_3 % 17);
-    finalset = finalset << 1 | (-setshift_4 % 7);
-    finalset = finalset << 1 | (-setshift_4 % 17);
-    
-    seed = seed | AE_CreateFinalSeed(setshift_1, setshift_2, setshift_3, setshift_4);
+    Uint32 primed = cellX * AE_NOISE_PRIME_X;
+    Uint32 h00 = AE_Noise_Hash(primed ^ row->seeded[0]);
+    Uint32 h10 = AE_Noise_Hash((primed + AE_NOISE_PRIME_X) ^ row->seeded[0]);
+    Uint32 h01 = AE_Noise_Hash(primed ^ row->seeded[1]);
+    Uint32 h11 = AE_Noise_Hash((primed + AE_NOISE_PRIME_X) ^ row->seeded[1]);
+    float n00, n10, n01, n11;
     
-    //Create shifted numbers to create pseudorandom numbers by
-    Uint64 seedshift_1 = ((seed << x)) + y;
-    Uint64 seedshift_2 = ((seed << y)) + x;
-    Uint64 seedshift_3 = seed + x + y - seedshift_1;
-    Uint64 seedshift_4 = -seed - x - y + seedshift_2;
-    
-    Uint64 finalseed = AE_CreateFinalSeed(seedshift_1, seedshift_2, seedshift_3, seedshift_4);
+    if (type == AE_NOISE_VALUE)
+    {
+        //Each corner has a value
+        n00 = (float)(int)(h00 >> 8) * AE_NOISE_VALUE_SCALE - 1.0f;
+        n10 = (float)(int)(h10 >> 8) * AE_NOISE_VALUE_SCALE - 1.0f;
+        n01 = (float)(int)(h01 >> 8) * AE_NOISE_VALUE_SCALE - 1.0f;
+        n11 = (float)(int)(h11 >> 8) * AE_NOISE_VALUE_SCALE - 1.0f;
+    }
+    else
+    {
+        //Each corner has one of the four diagonal gradients, dotted with the offset from the corner
+        float fracY = row->frac;
+        n00 = ((h00 & 1) ? -fracX : fracX) + ((h00 & 2) ? -fracY : fracY);
+        n10 = ((h10 & 1) ? -(fracX - 1.0f) : (fracX - 1.0f)) + ((h10 & 2) ? -fracY : fracY);
+        n01 = ((h01 & 1) ? -fracX : fracX) + ((h01 & 2) ? -(fracY - 1.0f) : (fracY - 1.0f));
+        n11 = ((h11 & 1) ? -(fracX - 1.0f) : (fracX - 1.0f)) + ((h11 & 2) ? -(fracY - 1.0f) : (fracY - 1.0f));
+    }
     
-    //If the min and max are the same, return that: else, return the random number
-    //return (min != max) ? ((int )(floor(((seed << x) | y << seed) % (max - min)) + min)) : min;
-    return (min != max) ? ((int )(SDL_floor(finalseed % (max - min)) + min)) : min;
+    float u = AE_Noise_Fade(fracX);
+    float top = n00 + u * (n10 - n00);
+    float bottom = n01 + u * (n11 - n01);
+    return top + row->fade * (bottom - top);
 }
 
 /**
- Gets a pseudorandom number between two numbers based on a given seed. Used for procedural generation: if given the same input numbers, the output will always be the same
- 
- @param seed The seed number to be manipulated
- @param x The x upon which the seed number will be manipulated
- @param y The y upon which the seed number will be manipulated
- @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
- @param min The min number the output can be
- @param max The max number the output can be
- @return The pseudorandom number based on the seed, x, and y
+ Fills part of a row with lattice noise one tile at a time
+
+ @param plan The AE_NoisePlan of the field
+ @param octaves The AE_NoiseRowOctave of each octave for the row
+ @param row The row of noise
+ @param start The first tile to be filled
+ @param end One past the last tile to be filled
+ @param originX The x of the row's first tile
  */
-int AE_PseudoRandomFromSeed_Uint64(Uint64 seed, Uint64 x, Uint64 y, Uint64 set, int min, int max)
+AE_NO_FP_CONTRACT static void AE_Noise_Row_Scalar(const AE_NoisePlan* plan, const AE_NoiseRowOctave* octaves, float* row, int start, int end, Sint64 originX)
 {
-    //Create a shifted number to manipulate the seed value based on the set
-    Uint64 setshift_1 = ((set << x)) | ((Uint64)pow(set,3));
-    Uint64 setshift_2 = ((set << y)) | set;
-    Uint64 setshift_3 = set + x + y - setshift_1;
-    Uint64 setshift_4 = -set - x - y + setshift_2;
+    for (int x = start; x<end; x++)
+    {
+        Uint64 position = (Uint64)(originX + x);
+        float sum = 0.0f;
+        
+        for (int octave = 0; octave<plan->octaveCount; octave++)
+        {
+            Uint32 cellX = (Uint32)(position >> plan->shifts[octave]);
+            float fracX = (float)(int)((Uint32)position & plan->masks[octave]) * plan->scales[octave];
+            sum = sum + plan->amplitudes[octave] * AE_Noise_Octave(plan->type, &octaves[octave], cellX, fracX);
+        }
+        row[x] = sum * plan->normalize;
+    }
+}
+
+#ifdef AE_X86_SIMD
+/**
+ Multiplies 4 Uint32's by 4 others, keeping the low 32 bits (SSE2 has no instruction for it)
+
+ @param a The first 4 Uint32's
+ @param b The second 4 Uint32's
+ @return The 4 products
+ */
+AE_TARGET_SSE2 static __m128i AE_Noise_Mul32_SSE2(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ Mixes the bits of 4 lattice point hashes with SSE2, exactly as AE_Noise_Hash does
+
+ @param hash The seed, x and y of each lattice point combined
+ @return The mixed hashes
+ */
+AE_TARGET_SSE2 static __m128i AE_Noise_Hash_SSE2(__m128i hash)
+{
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+    hash = AE_Noise_Mul32_SSE2(hash, _mm_set1_epi32((int)0x85EBCA6Bu));
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 13));
+    hash = AE_Noise_Mul32_SSE2(hash, _mm_set1_epi32((int)0xC2B2AE35u));
+    return _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+}
+
+/**
+ Eases 4 positions within their lattice cells with SSE2, exactly as AE_Noise_Fade does
+
+ @param t The positions within the cells, from 0 to 1
+ @return The eased positions
+ */
+AE_NO_FP_CONTRACT AE_TARGET_SSE2 static __m128 AE_Noise_Fade_SSE2(__m128 t)
+{
+    __m128 cubed = _mm_mul_ps(_mm_mul_ps(t, t), t);
+    __m128 poly = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+    return _mm_mul_ps(cubed, poly);
+}
+
+/**
+ Gets the noise at a corner of 4 lattice cells with SSE2, exactly as AE_Noise_Octave does
+
+ @param type AE_NOISE_VALUE or AE_NOISE_GRADIENT
+ @param hash The mixed hash of each corner
+ @param x The x offset of each point from the corner
+ @param y The y offset of each point from the corner
+ @return The noise of each corner
+ */
+AE_NO_FP_CONTRACT AE_TARGET_SSE2 static __m128 AE_Noise_Corner_SSE2(AE_NoiseType type, __m128i hash, __m128 x, __m128 y)
+{
+    if (type == AE_NOISE_VALUE)
+    {
+        return _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(hash, 8)), _mm_set1_ps(AE_NOISE_VALUE_SCALE)), _mm_set1_ps(1.0f));
+    }
     
-    //Create the final shifted number based on the set
-    Uint8 finalset = -setshift_1 % 7;
-    finalset = finalset << 1 | (-setshift_1 % 17);
-    finalset = finalset << 1 | (-setshift_2 % 7);
-    finalset = finalset << 1 | (-setshift_2 % 17);
-    finalset = finalset << 1 | (-setshift_3 % 7);
-    finalset = finalset << 1 | (-setshift_3 % 17);
-    finalset = finalset << 1 | (-setshift_4 % 7);
-    finalset = finalset << 1 | (-setshift_4 % 17);
+    //Negating is flipping the sign bit, so moving the hash's low two bits to the sign bits picks the gradient
+    __m128 flipX = _mm_castsi128_ps(_mm_slli_epi32(hash, 31));
+    __m128 flipY = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(hash, 1), 31));
+    return _mm_add_ps(_mm_xor_ps(x, flipX), _mm_xor_ps(y, flipY));
+}
+
+/**
+ Fills a row with lattice noise 4 tiles at a time with SSE2
+
+ @param plan The AE_NoisePlan of the field
+ @param octaves The AE_NoiseRowOctave of each octave for the row
+ @param row The row of noise
+ @param width The number of tiles in the row
+ @param originX The x of the row's first tile
+ */
+AE_NO_FP_CONTRACT AE_TARGET_SSE2 static void AE_Noise_Row_SSE2(const AE_NoisePlan* plan, const AE_NoiseRowOctave* octaves, float* row, int width, Sint64 originX)
+{
+    const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128 one = _mm_set1_ps(1.0f);
+    int x = 0;
     
-    seed = seed | AE_CreateFinalSeed(setshift_1, setshift_2, setshift_3, setshift_4);
+    for (; x + 4 <= width; x += 4)
+    {
+        Uint64 position = (Uint64)(originX + x);
+        __m128 sum = _mm_setzero_ps();
+        
+        for (int octave = 0; octave<plan->octaveCount; octave++)
+        {
+            const AE_NoiseRowOctave* rowOctave = &octaves[octave];
+            
+            //Later lanes can cross into the next cell, so each lane's cell is found from its offset from the first lane's
+            __m128i offset = _mm_add_epi32(_mm_set1_epi32((int)((Uint32)position & plan->masks[octave])), lanes);
+            __m128i cellX = _mm_add_epi32(_mm_set1_epi32((int)(Uint32)(position >> plan->shifts[octave])), _mm_srl_epi32(offset, _mm_cvtsi32_si128(plan->shifts[octave])));
+            __m128 fracX = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(offset, _mm_set1_epi32((int)plan->masks[octave]))), _mm_set1_ps(plan->scales[octave]));
+            __m128 fracY = _mm_set1_ps(rowOctave->frac);
+            
+            __m128i primed = AE_Noise_Mul32_SSE2(cellX, _mm_set1_epi32((int)AE_NOISE_PRIME_X));
+            __m128i primedNext = _mm_add_epi32(primed, _mm_set1_epi32((int)AE_NOISE_PRIME_X));
+            __m128i seeded0 = _mm_set1_epi32((int)rowOctave->seeded[0]);
+            __m128i seeded1 = _mm_set1_epi32((int)rowOctave->seeded[1]);
+            
+            __m128 n00 = AE_Noise_Corner_SSE2(plan->type, AE_Noise_Hash_SSE2(_mm_xor_si128(primed, seeded0)), fracX, fracY);
+            __m128 n10 = AE_Noise_Corner_SSE2(plan->type, AE_Noise_Hash_SSE2(_mm_xor_si128(primedNext, seeded0)), _mm_sub_ps(fracX, one), fracY);
+            __m128 n01 = AE_Noise_Corner_SSE2(plan->type, AE_Noise_Hash_SSE2(_mm_xor_si128(primed, seeded1)), fracX, _mm_sub_ps(fracY, one));
+            __m128 n11 = AE_Noise_Corner_SSE2(plan->type, AE_Noise_Hash_SSE2(_mm_xor_si128(primedNext, seeded1)), _mm_sub_ps(fracX, one), _mm_sub_ps(fracY, one));
+            
+            __m128 u = AE_Noise_Fade_SSE2(fracX);
+            __m128 top = _mm_add_ps(n00, _mm_mul_ps(u, _mm_sub_ps(n10, n00)));
+            __m128 bottom = _mm_add_ps(n01, _mm_mul_ps(u, _mm_sub_ps(n11, n01)));
+            __m128 noise = _mm_add_ps(top, _mm_mul_ps(_mm_set1_ps(rowOctave->fade), _mm_sub_ps(bottom, top)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(plan->amplitudes[octave]), noise));
+        }
+        _mm_storeu_ps(&row[x], _mm_mul_ps(sum, _mm_set1_ps(plan->normalize)));
+    }
     
-    //Create shifted numbers to create pseudorandom numbers by
-    Uint64 seedshift_1 = ((seed << x)) + y;
-    Uint64 seedshift_2 = ((seed << y)) + x;
-    Uint64 seedshift_3 = seed + x + y - seedshift_1;
-    Uint64 seedshift_4 = -seed - x - y + seedshift_2;
+    //Finish off the tiles that don't fill a whole register
+    AE_Noise_Row_Scalar(plan, octaves, row, x, width, originX);
+}
+
+/**
+ Mixes the bits of 8 lattice point hashes with AVX2, exactly as AE_Noise_Hash does
+
+ @param hash The seed, x and y of each lattice point combined
+ @return The mixed hashes
+ */
+AE_TARGET_AVX2 static __m256i AE_Noise_Hash_AVX2(__m256i hash)
+{
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)0x85EBCA6Bu));
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)0xC2B2AE35u));
+    return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+}
+
+/**
+ Eases 8 positions within their lattice cells with AVX2, exactly as AE_Noise_Fade does
+
+ @param t The positions within the cells, from 0 to 1
+ @return The eased positions
+ */
+AE_NO_FP_CONTRACT AE_TARGET_AVX2 static __m256 AE_Noise_Fade_AVX2(__m256 t)
+{
+    __m256 cubed = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+    __m256 poly = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(cubed, poly);
+}
+
+/**
+ Gets the noise at a corner of 8 lattice cells with AVX2, exactly as AE_Noise_Octave does
+
+ @param type AE_NOISE_VALUE or AE_NOISE_GRADIENT
+ @param hash The mixed hash of each corner
+ @param x The x offset of each point from the corner
+ @param y The y offset of each point from the corner
+ @return The noise of each corner
+ */
+AE_NO_FP_CONTRACT AE_TARGET_AVX2 static __m256 AE_Noise_Corner_AVX2(AE_NoiseType type, __m256i hash, __m256 x, __m256 y)
+{
+    if (type == AE_NOISE_VALUE)
+    {
+        return _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(hash, 8)), _mm256_set1_ps(AE_NOISE_VALUE_SCALE)), _mm256_set1_ps(1.0f));
+    }
     
-    Uint64 finalseed = AE_CreateFinalSeed(seedshift_1, seedshift_2, seedshift_3, seedshift_4);
+    //Negating is flipping the sign bit, so moving the hash's low two bits to the sign bits picks the gradient
+    __m256 flipX = _mm256_castsi256_ps(_mm256_slli_epi32(hash, 31));
+    __m256 flipY = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_srli_epi32(hash, 1), 31));
+    return _mm256_add_ps(_mm256_xor_ps(x, flipX), _mm256_xor_ps(y, flipY));
+}
+
+/**
+ Fills a row with lattice noise 8 tiles at a time with AVX2
+
+ @param plan The AE_NoisePlan of the field
+ @param octaves The AE_NoiseRowOctave of each octave for the row
+ @param row The row of noise
+ @param width The number of tiles in the row
+ @param originX The x of the row's first tile
+ */
+AE_NO_FP_CONTRACT AE_TARGET_AVX2 static void AE_Noise_Row_AVX2(const AE_NoisePlan* plan, const AE_NoiseRowOctave* octaves, float* row, int width, Sint64 originX)
+{
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    int x = 0;
     
+    for (; x + 8 <= width; x += 8)
+    {
+        Uint64 position = (Uint64)(originX + x);
+        __m256 sum = _mm256_setzero_ps();
+        
+        for (int octave = 0; octave<plan->octaveCount; octave++)
+        {
+            const AE_NoiseRowOctave* rowOctave = &octaves[octave];
+            
+            //Later lanes can cross into the next cell, so each lane's cell is found from its offset from the first lane's
+            __m256i offset = _mm256_add_epi32(_mm256_set1_epi32((int)((Uint32)position & plan->masks[octave])), lanes);
+            __m256i cellX = _mm256_add_epi32(_mm256_set1_epi32((int)(Uint32)(position >> plan->shifts[octave])), _mm256_srl_epi32(offset, _mm_cvtsi32_si128(plan->shifts[octave])));
+            __m256 fracX = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(offset, _mm256_set1_epi32((int)plan->masks[octave]))), _mm256_set1_ps(plan->scales[octave]));
+            __m256 fracY = _mm256_set1_ps(rowOctave->frac);
+            
+            __m256i primed = _mm256_mullo_epi32(cellX, _mm256_set1_epi32((int)AE_NOISE_PRIME_X));
+            __m256i primedNext = _mm256_add_epi32(primed, _mm256_set1_epi32((int)AE_NOISE_PRIME_X));
+            __m256i seeded0 = _mm256_set1_epi32((int)rowOctave->seeded[0]);
+            __m256i seeded1 = _mm256_set1_epi32((int)rowOctave->seeded[1]);
+            
+            __m256 n00 = AE_Noise_Corner_AVX2(plan->type, AE_Noise_Hash_AVX2(_mm256_xor_si256(primed, seeded0)), fracX, fracY);
+            __m256 n10 = AE_Noise_Corner_AVX2(plan->type, AE_Noise_Hash_AVX2(_mm256_xor_si256(primedNext, seeded0)), _mm256_sub_ps(fracX, one), fracY);
+            __m256 n01 = AE_Noise_Corner_AVX2(plan->type, AE_Noise_Hash_AVX2(_mm256_xor_si256(primed, seeded1)), fracX, _mm256_sub_ps(fracY, one));
+            __m256 n11 = AE_Noise_Corner_AVX2(plan->type, AE_Noise_Hash_AVX2(_mm256_xor_si256(primedNext, seeded1)), _mm256_sub_ps(fracX, one), _mm256_sub_ps(fracY, one));
+            
+            __m256 u = AE_Noise_Fade_AVX2(fracX);
+            __m256 top = _mm256_add_ps(n00, _mm256_mul_ps(u, _mm256_sub_ps(n10, n00)));
+            __m256 bottom = _mm256_add_ps(n01, _mm256_mul_ps(u, _mm256_sub_ps(n11, n01)));
+            __m256 noise = _mm256_add_ps(top, _mm256_mul_ps(_mm256_set1_ps(rowOctave->fade), _mm256_sub_ps(bottom, top)));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(plan->amplitudes[octave]), noise));
+        }
+        _mm256_storeu_ps(&row[x], _mm256_mul_ps(sum, _mm256_set1_ps(plan->normalize)));
+    }
     
-    //If the min and max are the same, return that: else, return the random number
-    //return (min != max) ? ((int )(floor(((seed << x) | y << seed) % (max - min)) + min)) : min;
-    return (min != max) ? ((int )(floor(finalseed % (max - min)) + min)) : min;
+    //Finish off the tiles that don't fill a whole register
+    AE_Noise_Row_Scalar(plan, octaves, row, x, width, originX);
 }
+#endif
 
 /**
- Returns the distance between two points as an int
+ Gets white noise from a tile's hash
 
- @param x1 The x of the first point
- @param y1 The y of the first point
- @param x2 The x of the second point
- @param y2 The y of the second point
- @return The distance between two points as an int
+ @param hash The AE_SeedHash of the tile
+ @return The noise, from -1 to just under 1
  */
-int AE_PointDistance(int x1, int y1, int x2, int y2)
+AE_NO_FP_CONTRACT static float AE_Noise_White(Uint64 hash)
 {
-    return (int) sqrt((double)(pow((x1-x2), 2) + pow((y1 - y2), 2)));
+    return (float)(int)(hash >> 40) * AE_NOISE_VALUE_SCALE - 1.0f;
 }
 
 /**
- Returns the distance between two points as a double
- 
- @param x1 The x of the first point
- @param y1 The y of the first point
- @param x2 The x of the second point
- @param y2 The y of the second point
- @return The distance between two points as a double
+ Maps noise onto whole numbers between min and max
+
+ @param value The noise, from -1 to 1
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The number in the range
  */
-double AE_PointDistance_D(Uint64 x1, Uint64 y1, Uint64 x2, Uint64 y2)
+static int AE_Noise_ToRange(float value, int min, int max)
 {
-    return SDL_sqrt((double)(pow((x1 - x2), 2) + pow((y1 - y2), 2)));
+    if (min == max)
+    {
+        return min;
+    }
+    if (max < min)
+    {
+        int swap = min;
+        min = max;
+        max = swap;
+    }
+    
+    Sint64 range = (Sint64)max - (Sint64)min;
+    Sint64 offset = (Sint64)((double)((value + 1.0f) * 0.5f) * (double)range);
+    return (int)((Sint64)min + SDL_max(0, SDL_min(offset, range - 1)));
 }
 
+/**
+ Fills a band of rows of a noise field. Every row depends only on its own position, so how the rows are split up never changes the result
+
+ @param data The AE_NoiseJob to be filled
+ @return 0
+ */
+static int AE_NoiseJob_Work(void* data)
+{
+    AE_NoiseJob* job = data;
+    const AE_NoisePlan* plan = job->plan;
+    AE_NoiseRowOctave octaves[AE_NOISE_MAX_OCTAVES];
+    
+    AE_PROFILE_BEGIN("AE_NoiseJob_Work");
+    for (int y = job->firstRow; y<job->endRow; y++)
+    {
+        Sint64 positionY = job->originY + y;
+        size_t rowStart = (size_t)y * job->width;
+        
+        if (plan->type == AE_NOISE_WHITE)
+        {
+            for (int x = 0; x<job->width; x++)
+            {
+                Uint64 hash = AE_SeedHash(plan->seed, (Uint64)(job->originX + x), (Uint64)positionY, plan->set);
+                if (job->intOutput != NULL)
+                {
+                    job->intOutput[rowStart + x] = AE_SeedHash_ToRange(hash, job->min, job->max);
+                }
+                else
+                {
+                    job->floatOutput[rowStart + x] = AE_Noise_White(hash);
+                }
+            }
+            continue;
+        }
+        
+        //Int fields are generated a row of floats at a time and then mapped onto the range
+        float* row = (job->intOutput != NULL) ? job->scratch : &job->floatOutput[rowStart];
+        AE_Noise_SetRow(plan, positionY, octaves);
+        switch (job->level)
+        {
+#ifdef AE_X86_SIMD
+            case AE_SIMD_AVX2:
+                AE_Noise_Row_AVX2(plan, octaves, row, job->width, job->originX);
+                break;
+            case AE_SIMD_SSE2:
+                AE_Noise_Row_SSE2(plan, octaves, row, job->width, job->originX);
+                break;
+#endif
+            default:
+                AE_Noise_Row_Scalar(plan, octaves, row, 0, job->width, job->originX);
+                break;
+        }
+        
+        if (job->intOutput != NULL)
+        {
+            for (int x = 0; x<job->width; x++)
+            {
+                job->intOutput[rowStart + x] = AE_Noise_ToRange(row[x], job->min, job->max);
+            }
+        }
+    }
+    AE_PROFILE_END();
+    
+    return 0;
+}
 
 /**
- Returns a float rounded to floor or ceil depending on if it's less than 0
+ Fills a noise field with floats or ints, splitting its rows between threads
 
- @param input The original float
- @return The float, rounded to the nearest floor or ceiling
+ @param floatOutput The buffer floats will be written to, or NULL for ints
+ @param intOutput The buffer ints will be written to, or NULL for floats
+ @param width The width of the chunk in tiles
+ @param height The height of the chunk in tiles
+ @param originX The x of the chunk's top left tile
+ @param originY The y of the chunk's top left tile
+ @param settings The AE_NoiseSettings the noise is generated from
+ @param min The min number an int can be
+ @param max The number above the max an int can be
+ @param threadCount The number of threads to split the rows between (0 or less for one per CPU)
+ @return SDL_TRUE if the field was filled, SDL_FALSE if the arguments were invalid or an int field's scratch rows couldn't be allocated
  */
-float AE_FloatBase(float input)
+static SDL_bool AE_NoiseField_Fill(float* floatOutput, int* intOutput, int width, int height, Sint64 originX, Sint64 originY, const AE_NoiseSettings* settings, int min, int max, int threadCount)
 {
-    float output = 0;
+    AE_NoisePlan plan;
+    AE_NoiseJob jobs[AE_NOISE_MAX_THREADS];
+    SDL_Thread* threads[AE_NOISE_MAX_THREADS];
+    float* scratch = NULL;
     
-    if (input < 0)
+    if (width <= 0 || height <= 0 || settings == NULL || (floatOutput == NULL && intOutput == NULL))
     {
-        output = SDL_floor((double)input);
+        return SDL_FALSE;
     }
-    else
+    
+    AE_Noise_Plan(&plan, settings);
+    if (threadCount <= 0)
     {
-        output = SDL_ceil((double)input);
+        threadCount = SDL_GetCPUCount();
     }
-    return output;
+    threadCount = SDL_max(1, SDL_min(SDL_min(threadCount, AE_NOISE_MAX_THREADS), height));
+    
+    //Every job's row of scratch is allocated up front, so a failure leaves the output untouched instead of half filled
+    if (intOutput != NULL && plan.type != AE_NOISE_WHITE)
+    {
+        scratch = SDL_malloc(sizeof(float) * (size_t)width * (size_t)threadCount);
+        if (scratch == NULL)
+        {
+            return SDL_FALSE;
+        }
+    }
+    
+    AE_PROFILE_BEGIN("AE_NoiseField_Fill");
+    //The instruction set is settled here so the workers don't all race to detect it
+    AE_SimdLevel level = AE_GetSimdLevel();
+    for (int i = 0; i<threadCount; i++)
+    {
+        jobs[i].plan = &plan;
+        jobs[i].floatOutput = floatOutput;
+        jobs[i].intOutput = intOutput;
+        jobs[i].scratch = (scratch != NULL) ? &scratch[(size_t)width * i] : NULL;
+        jobs[i].width = width;
+        jobs[i].firstRow = (int)((Sint64)height * i / threadCount);
+        jobs[i].endRow = (int)((Sint64)height * (i + 1) / threadCount);
+        jobs[i].originX = originX;
+        jobs[i].originY = originY;
+        jobs[i].min = min;
+        jobs[i].max = max;
+        jobs[i].level = level;
+    }
+    
+    //The calling thread fills the first band itself, along with any band a thread couldn't be made for
+    threads[0] = NULL;
+    for (int i = 1; i<threadCount; i++)
+    {
+        threads[i] = SDL_CreateThread(AE_NoiseJob_Work, "AE_Noise", &jobs[i]);
+        if (threads[i] == NULL)
+        {
+            AE_NoiseJob_Work(&jobs[i]);
+        }
+    }
+    AE_NoiseJob_Work(&jobs[0]);
+    for (int i = 1; i<threadCount; i++)
+    {
+        if (threads[i] != NULL)
+        {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    AE_PROFILE_END();
+    
+    SDL_free(scratch);
+    return SDL_TRUE;
 }
 
 /**
- Returns the horizontal length of a line of a given length on a given angle
+ Fills noise settings with a seed and set, a period of 32 tiles, one octave and a gain of 0.5
 
- @param length The length of the line whose horizontal component will be found
- @param direction The angle of the line whose horizontal component will be found
- @return The precise length of the horizontal component of the given line
+ @param settings The AE_NoiseSettings to be filled
+ @param type The kind of noise
+ @param seed The seed number the noise is generated from
+ @param set A value that gives different noise for the same seed and position
  */
-long double AE_Lengthdir_X(int length, float direction)
+void AE_FillNoiseSettings(AE_NoiseSettings* settings, AE_NoiseType type, Uint64 seed, Uint64 set)
 {
-    return (long double)(SDL_cos(direction)*length);
+    settings->type = type;
+    settings->seed = seed;
+    settings->set = set;
+    settings->period = 32;
+    settings->octaves = 1;
+    settings->gain = 0.5f;
 }
 
 /**
- Returns the vertical length of a line of a given length on a given angle
- 
- @param length The length of the line whose vertical component will be found
- @param direction The angle of the line whose vertical component will be found
- @return The precise length of the vertical component of the given line
+ Gets the noise at a single tile. This is the reference the noise fields match exactly
+
+ @param settings The AE_NoiseSettings the noise is generated from
+ @param x The x of the tile
+ @param y The y of the tile
+ @return The noise, from -1 to 1
  */
-long double AE_Lengthdir_Y(int length, float direction)
+float AE_Noise_Sample(const AE_NoiseSettings* settings, Sint64 x, Sint64 y)
 {
-    return (long double)(SDL_sin(direction)*length);
+    AE_NoisePlan plan;
+    AE_NoiseRowOctave octaves[AE_NOISE_MAX_OCTAVES];
+    float output;
+    
+    if (settings->type == AE_NOISE_WHITE)
+    {
+        return AE_Noise_White(AE_SeedHash(settings->seed, (Uint64)x, (Uint64)y, settings->set));
+    }
+    
+    AE_Noise_Plan(&plan, settings);
+    AE_Noise_SetRow(&plan, y, octaves);
+    AE_Noise_Row_Scalar(&plan, octaves, &output, 0, 1, x);
+    return output;
 }
 
 /**
- Returns whether a vector belonging to a point (x1, y1) is clockwise to a vector belonging to another point (x2, y2)
- 
- @param x1 The horizontal value of the point on a vector being tested
- @param y1 The vertical value of the point on a vector being tested
- @param x2 The horizontal value of the point on a vector
- @param y2 The vertical value of the point on a vector
- @return Whether vector (x1, y1) is clockwise to (x2, y2)
+ Fills a chunk of tiles with noise. The result is the same for any thread count and instruction set, so chunks can be regenerated exactly
+
+ @param output The row-major width by height buffer the noise will be written to
+ @param width The width of the chunk in tiles
+ @param height The height of the chunk in tiles
+ @param originX The x of the chunk's top left tile
+ @param originY The y of the chunk's top left tile
+ @param settings The AE_NoiseSettings the noise is generated from
+ @param threadCount The number of threads to split the rows between (0 or less for one per CPU, 1 for just the calling thread)
+ @return SDL_TRUE if the chunk was filled, SDL_FALSE if the arguments were invalid
  */
-SDL_bool AE_VectorIsClockwise(double x1, double y1, double x2, double y2)
+SDL_bool AE_NoiseField_Float(float* output, int width, int height, Sint64 originX, Sint64 originY, const AE_NoiseSettings* settings, int threadCount)
 {
-    return (((x1 * y2) + (x2 * y1)) > 0);
+    return AE_NoiseField_Fill(output, NULL, width, height, originX, originY, settings, 0, 0, threadCount);
 }
 
 /**
- Returns the length of a vector designated by the endpoint
+ Fills a chunk of tiles with noise mapped onto whole numbers between min and max. White noise gives the same numbers AE_PseudoRandomFromSeed_Int does for each tile with AE_SEED_MODE_HASH. The result is the same for any thread count and instruction set
 
- @param x The horizontal distance of the point from the center
- @param y The vertical distance of the point from the center
- @return The length of the vector designated by the x and y
+ @param output The row-major width by height buffer the numbers will be written to
+ @param width The width of the chunk in tiles
+ @param height The height of the chunk in tiles
+ @param originX The x of the chunk's top left tile
+ @param originY The y of the chunk's top left tile
+ @param settings The AE_NoiseSettings the noise is generated from
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @param threadCount The number of threads to split the rows between (0 or less for one per CPU, 1 for just the calling thread)
+ @return SDL_TRUE if the chunk was filled, SDL_FALSE if the arguments were invalid or memory couldn't be allocated
  */
-double AE_VectorLength(double x, double y)
+SDL_bool AE_NoiseField_Int(int* output, int width, int height, Sint64 originX, Sint64 originY, const AE_NoiseSettings* settings, int min, int max, int threadCount)
 {
-    return SDL_sqrt((SDL_pow(x, 2) + SDL_pow(y, 2)));
+    return AE_NoiseField_Fill(NULL, output, width, height, originX, originY, settings, min, max, threadCount);
 }
 
 //
 //
-//End: General Functions
+//End: Noise Functions
+//
+//
\ No newline at end of file
@@ -73,6 +73,162 @@ void AE_CloseSDL();
 //
 //
 
+//
+//
+//Start: Memory Functions
+//
+//
+
+/**
+ The kinds of small engine objects that are allocated through the engine's allocator
+ */
+typedef enum {
+    AE_OBJECT_SPRITE,
+    AE_OBJECT_SPRITEDEF,
+    AE_OBJECT_LINKEDTEXTURE,
+    AE_OBJECT_PRECISETIMER,
+    AE_OBJECT_TYPE_COUNT
+}AE_ObjectType;
+
+/**
+ An allocator the engine's small objects are made from, with a context passed back to each callback
+ */
+typedef struct {
+    void* (*allocate)(void* context, AE_ObjectType type, size_t size);
+    void (*release)(void* context, AE_ObjectType type, void* object);
+    void* context;
+}AE_Allocator;
+
+/**
+ A pool of fixed-size objects, allocated a block at a time and recycled through a free list
+ */
+typedef struct {
+    size_t objectSize;
+    int objectsPerBlock;
+    void* blocks;
+    void* freeList;
+    int liveCount;
+    int capacity;
+    SDL_SpinLock lock;
+}AE_ObjectPool;
+
+/**
+ A bump allocator for memory that only has to last until the arena is reset, such as scratch memory for a single frame
+ */
+typedef struct {
+    Uint8* memory;
+    size_t capacity;
+    size_t used;
+    size_t peak;
+}AE_FrameArena;
+
+/**
+ Replaces the allocator the engine makes its sprites, sprite definitions, linkedTextures and precise timers from. Like SDL_SetMemoryFunctions, it must be set before any of those objects are created or after all of them are destroyed
+ 
+ @param allocator The allocator to use, or NULL to go back to the engine's own object pools
+ */
+void AE_SetAllocator(const AE_Allocator* allocator);
+
+/**
+ Gets the allocator the engine makes its small objects from
+ 
+ @return The current allocator
+ */
+AE_Allocator AE_GetAllocator(void);
+
+/**
+ Gets one of the object pools the engine's default allocator uses
+ 
+ @param type The kind of object whose pool will be retrieved
+ @return The pool objects of that kind are allocated from by default
+ */
+AE_ObjectPool* AE_GetObjectPool(AE_ObjectType type);
+
+/**
+ Creates a pool of fixed-size objects
+ 
+ @param objectSize The size of each object
+ @param objectsPerBlock The number of objects allocated at once when the pool runs out (0 or less for 64)
+ @return The new AE_ObjectPool, or NULL if it could not be created
+ */
+AE_ObjectPool* AE_CreateObjectPool(size_t objectSize, int objectsPerBlock);
+
+/**
+ Takes an object from a pool, allocating a new block if the pool is empty. Safe to call from any thread
+ 
+ @param pool The AE_ObjectPool to allocate from
+ @return The uninitialized object, or NULL if a new block couldn't be allocated
+ */
+void* AE_ObjectPool_Allocate(AE_ObjectPool* pool);
+
+/**
+ Returns an object to the pool it was taken from. Safe to call from any thread
+ 
+ @param pool The AE_ObjectPool the object was taken from
+ @param object The object to return (NULL is ignored)
+ */
+void AE_ObjectPool_Free(AE_ObjectPool* pool, void* object);
+
+/**
+ Gets the number of objects taken from a pool and not yet returned
+ 
+ @param pool The AE_ObjectPool whose objects will be counted
+ @return The number of live objects
+ */
+int AE_ObjectPool_GetLiveCount(AE_ObjectPool* pool);
+
+/**
+ Frees every block of a pool and the pool itself. Any objects still taken from it become invalid
+ 
+ @param pool The AE_ObjectPool to be destroyed
+ */
+void AE_DestroyObjectPool(AE_ObjectPool* pool);
+
+/**
+ Creates a frame arena
+ 
+ @param capacity The number of bytes the arena can hand out between resets
+ @return The new AE_FrameArena, or NULL if it could not be created
+ */
+AE_FrameArena* AE_CreateFrameArena(size_t capacity);
+
+/**
+ Takes memory from a frame arena, aligned for any type. The memory stays valid until the arena is reset
+ 
+ @param arena The AE_FrameArena to allocate from
+ @param size The number of bytes needed
+ @return The memory, or NULL if the arena doesn't have enough room left
+ */
+void* AE_FrameArena_Allocate(AE_FrameArena* arena, size_t size);
+
+/**
+ Hands all of a frame arena's memory back at once, invalidating everything allocated from it
+ 
+ @param arena The AE_FrameArena to reset
+ */
+void AE_FrameArena_Reset(AE_FrameArena* arena);
+
+/**
+ Gets the most memory a frame arena has had in use at once, for sizing it
+ 
+ @param arena The AE_FrameArena whose peak will be retrieved
+ @return The peak number of bytes in use
+ */
+size_t AE_FrameArena_GetPeak(AE_FrameArena* arena);
+
+/**
+ Frees and destroys an AE_FrameArena
+ 
+ @param arena The AE_FrameArena to be destroyed
+ */
+void AE_DestroyFrameArena(AE_FrameArena* arena);
+
+//
+//
+//End: Memory Functions
+//
+//
+
 //
 //
 //Start: SDL Texture and Surface Functions
@@ -142,21 +298,168 @@ Uint32 AE_TextureGetFormat(SDL_Texture* texture);
 //
 //
 
+//
+//
+//Start: Renderer State Cache Functions
+//
+//
+
+/**
+ The last modulation and blend state set on a single texture
+ */
+typedef struct {
+    SDL_Texture* texture;
+    Uint8 r;
+    Uint8 g;
+    Uint8 b;
+    Uint8 alpha;
+    SDL_BlendMode blendMode;
+    SDL_bool colorKnown;
+    SDL_bool alphaKnown;
+    SDL_bool blendKnown;
+}AE_TextureState;
+
+/**
+ Counters for how many texture state calls went through to SDL and how many were skipped because nothing changed
+ */
+typedef struct {
+    Uint64 colorModCalls;
+    Uint64 colorModElided;
+    Uint64 alphaModCalls;
+    Uint64 alphaModElided;
+    Uint64 blendModeCalls;
+    Uint64 blendModeElided;
+}AE_RenderStateStats;
+
+/**
+ A per-renderer cache of the texture state last given to SDL, used to skip redundant state changes
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    AE_TextureState* entries;
+    int capacity;
+    int count;
+    AE_RenderStateStats stats;
+}AE_RenderState;
+
+/**
+ Creates a state cache for a renderer. While it exists, the engine's own sprite drawing on that renderer goes through the cache
+ 
+ @param renderer The renderer whose texture state will be tracked
+ @return The new AE_RenderState (or the existing one if the renderer already has a cache)
+ */
+AE_RenderState* AE_CreateRenderState(SDL_Renderer* renderer);
+
+/**
+ Gets the state cache of a renderer
+ 
+ @param renderer The renderer whose state cache will be retrieved
+ @return The renderer's AE_RenderState, or NULL if it has none
+ */
+AE_RenderState* AE_RenderState_Get(SDL_Renderer* renderer);
+
+/**
+ Sets the color modulation of a texture, skipping the call if the texture already has that modulation
+ 
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture whose color modulation will be set
+ @param r The red modulation
+ @param g The green modulation
+ @param b The blue modulation
+ @return Whether the texture has the given color modulation or not
+ */
+SDL_bool AE_RenderState_SetTextureColorMod(AE_RenderState* state, SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b);
+
+/**
+ Sets the alpha modulation of a texture, skipping the call if the texture already has that modulation
+ 
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture whose alpha modulation will be set
+ @param alpha The alpha modulation
+ @return Whether the texture has the given alpha modulation or not
+ */
+SDL_bool AE_RenderState_SetTextureAlphaMod(AE_RenderState* state, SDL_Texture* texture, Uint8 alpha);
+
+/**
+ Sets the blend mode of a texture, skipping the call if the texture already has that blend mode
+ 
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture whose blend mode will be set
+ @param blendMode The blend mode
+ @return Whether the texture has the given blend mode or not
+ */
+SDL_bool AE_RenderState_SetTextureBlendMode(AE_RenderState* state, SDL_Texture* texture, SDL_BlendMode blendMode);
+
+/**
+ Forgets the tracked state of a texture. Must be called if the texture is changed or destroyed outside of the engine
+ 
+ @param state The AE_RenderState tracking the texture
+ @param texture The texture to forget
+ */
+void AE_RenderState_ForgetTexture(AE_RenderState* state, SDL_Texture* texture);
+
+/**
+ Forgets the tracked state of every texture
+ 
+ @param state The AE_RenderState to clear
+ */
+void AE_RenderState_Invalidate(AE_RenderState* state);
+
+/**
+ Gets the call counters of a state cache
+ 
+ @param state The AE_RenderState whose counters will be retrieved
+ @return The counters of issued and elided calls
+ */
+AE_RenderStateStats AE_RenderState_GetStats(AE_RenderState* state);
+
+/**
+ Resets the call counters of a state cache to 0
+ 
+ @param state The AE_RenderState whose counters will be reset
+ */
+void AE_RenderState_ResetStats(AE_RenderState* state);
+
+/**
+ Frees and destroys an AE_RenderState, returning its renderer to uncached drawing
+ 
+ @param state The AE_RenderState to be destroyed
+ */
+void AE_DestroyRenderState(AE_RenderState* state);
+
+//
+//
+//End: Renderer State Cache Functions
+//
+//
+
 //
 //
 //Start: Linked Textures and Associated Functions
 //
 //
 
-typedef struct AE_SheetLink {
-    void* reference;
-    struct AE_SheetLink* next;
-} AE_SheetLink;
+typedef enum {
+    AE_TEXTURE_READY,
+    AE_TEXTURE_LOADING,
+    AE_TEXTURE_FAILED
+}AE_TextureLoadState;
 
 typedef struct {
     SDL_Texture* texture;
-    AE_SheetLink* linkedList;
-    Uint16 references;
+    void** stakeholders;
+    int* stakeholderTable;
+    Uint32 stakeholderCapacity;
+    SDL_SpinLock stakeholderLock;
+    SDL_atomic_t references;
+    SDL_bool destroyWhenUnused;
+    void* nextDestroyed;
+    Uint32 id;
+    AE_TextureLoadState loadState;
+    int width;
+    int height;
+    Uint32 format;
+    Uint32 version;
 } AE_LinkedTexture;
 
 /**
@@ -177,7 +480,7 @@ AE_LinkedTexture* AE_CreateLinkedTexture(SDL_Texture* texture);
 AE_LinkedTexture* AE_LinkedTexture_CreateFromFile(SDL_Renderer* renderer, const char* path);
 
 /**
- Adds an object to the list of objects referencing a linkedTexture
+ Adds an object to the list of objects referencing a linkedTexture. An object may join more than once, and must leave once for each join. Fails once AE_DestroyLinkedTexture_Deferred has been called on the linkedTexture. Safe to call from any thread
  
  @param linkedTexture The linkedTexture that the object would like to reference
  @param stakeholder_object The object that will reference the linkedTexture
@@ -185,7 +488,7 @@ AE_LinkedTexture* AE_LinkedTexture_CreateFromFile(SDL_Renderer* renderer, const
  */
 SDL_bool AE_LinkedTexture_Join(AE_LinkedTexture* linkedTexture, void* stakeholder_object);
 /**
- Removes an object from the list of objects that reference a linkedTexture
+ Removes an object from the list of objects that reference a linkedTexture, queueing the linkedTexture for destruction if it was the last reference and AE_DestroyLinkedTexture_Deferred was called on it. Safe to call from any thread
  
  @param linkedTexture The linked texture that the object is removing itself from
  @param stakeholder_object The onject that will no longer reference the linkedTexture
@@ -199,10 +502,10 @@ SDL_bool AE_LinkedTexture_Leave(AE_LinkedTexture* linkedTexture, void* stakehold
  @param linkedTexture The linkedTexture whose reference count will be found
  @return The number of ojects referencing the linked texture
  */
-Uint16 AE_LinkedTexture_GetReferenceCount(AE_LinkedTexture* linkedTexture);
+Uint32 AE_LinkedTexture_GetReferenceCount(AE_LinkedTexture* linkedTexture);
 
 /**
- Gets the width of the texture in a linkedTexture
+ Gets the width of the texture in a linkedTexture, cached when the texture was created or finished loading
  
  @param linkedTexture The texture whose width will be retrieved
  @return The width of the texture
@@ -210,7 +513,7 @@ Uint16 AE_LinkedTexture_GetReferenceCount(AE_LinkedTexture* linkedTexture);
 int AE_LinkedTexture_GetWidth(AE_LinkedTexture* linkedTexture);
 
 /**
- Gets the height of the texture in a linkedTexture
+ Gets the height of the texture in a linkedTexture, cached when the texture was created or finished loading
  
  @param linkedTexture The texture whose height will be retrieved
  @return The height of the texture
@@ -218,7 +521,7 @@ int AE_LinkedTexture_GetWidth(AE_LinkedTexture* linkedTexture);
 int AE_LinkedTexture_GetHeight(AE_LinkedTexture* linkedTexture);
 
 /**
- Gets the format of the texture in a linkedTexture
+ Gets the format of the texture in a linkedTexture, cached when the texture was created or finished loading
  
  @param linkedTexture The texture whose format will be retrieved
  @return The format of the texture
@@ -226,7 +529,30 @@ int AE_LinkedTexture_GetHeight(AE_LinkedTexture* linkedTexture);
 Uint32 AE_LinkedTexture_GetFormat(AE_LinkedTexture* linkedTexture);
 
 /**
- Destroys a linkedTexture only if nothing references it
+ Gets whether the texture of a linkedTexture is ready to draw, still loading in the background, or failed to load
+ 
+ @param linkedTexture The linkedTexture whose load state will be retrieved
+ @return The load state of the linkedTexture
+ */
+AE_TextureLoadState AE_LinkedTexture_GetLoadState(AE_LinkedTexture* linkedTexture);
+
+/**
+ Marks the pixels of a linkedTexture as changed, so anything cached from it (an AE_CachedLayer, the chunks of an AE_Tilemap, or the draws an AE_DirtyRegion compares between frames) is drawn again. Call after updating the texture yourself, such as with SDL_UpdateTexture
+ 
+ @param linkedTexture The linkedTexture whose pixels changed
+ */
+void AE_LinkedTexture_MarkChanged(AE_LinkedTexture* linkedTexture);
+
+/**
+ Gets the version of a linkedTexture, which goes up every time its texture or pixels change
+ 
+ @param linkedTexture The linkedTexture whose version will be retrieved
+ @return The version of the linkedTexture
+ */
+Uint32 AE_LinkedTexture_GetVersion(AE_LinkedTexture* linkedTexture);
+
+/**
+ Destroys a linkedTexture only if nothing references it and it isn't still loading. Must be called on the render thread
  
  @param linkedTexture The linkedTexture to destroy
  @return Whether the linkedTexture was destroyed or not
@@ -240,6 +566,20 @@ SDL_bool AE_DestroyLinkedTexture(AE_LinkedTexture* linkedTexture);
  */
 void AE_DestroyLinkedTexture_Unsafe(AE_LinkedTexture* linkedTexture);
 
+/**
+ Marks a linkedTexture to be destroyed once nothing references it. Safe to call from any thread; the texture itself is only destroyed by AE_LinkedTexture_DestroyQueued on the render thread. Nothing may join the linkedTexture afterwards
+ 
+ @param linkedTexture The linkedTexture to destroy
+ */
+void AE_DestroyLinkedTexture_Deferred(AE_LinkedTexture* linkedTexture);
+
+/**
+ Destroys every linkedTexture whose last reference was dropped after AE_DestroyLinkedTexture_Deferred. Must be called on the render thread, for example once per frame
+ 
+ @return The number of linkedTextures destroyed
+ */
+int AE_LinkedTexture_DestroyQueued(void);
+
 //
 //
 //End: Linked Textures and Associated Functions
@@ -248,295 +588,2489 @@ void AE_DestroyLinkedTexture_Unsafe(AE_LinkedTexture* linkedTexture);
 
 //
 //
-//Start: Sprites and Sprite Functions
+//Start: Texture Registry Functions
 //
 //
 
 /**
- A sprite, complete with size and frames
+ A file loaded through a texture registry
  */
 typedef struct {
-    AE_LinkedTexture* spriteSheet;
-    int width;
-    int height;
-    
-    int frameCount;
-    SDL_Rect* frames;
-    float currentFrame;
-    float frameSpeed;
+    char* path;
+    Uint64 pathHash;
+    Uint64 contentHash;
+    Sint64 contentSize;
+    AE_LinkedTexture* linkedTexture;
+}AE_TextureRegistryEntry;
+
+/**
+ Counters for how many loads a texture registry answered from its cache and how many had to load a file
+ */
+typedef struct {
+    Uint64 hits;
+    Uint64 contentHits;
+    Uint64 misses;
+    Uint64 failures;
+}AE_TextureRegistryStats;
+
+/**
+ A cache of linkedTextures keyed by normalized path (and optionally by file contents), so each image is only loaded and uploaded once
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_bool hashContents;
     
-    SDL_Point pivot;
-    double angle;
-    SDL_RendererFlip flip;
+    AE_TextureRegistryEntry* entries;
+    int count;
+    int capacity;
     
-    float x_scale;
-    float y_scale;
-    SDL_Rect drawRect;
+    int* pathTable;
+    int* contentTable;
+    int tableCapacity;
     
-    AE_ColorBundle color;
-    Uint8 alpha;
-}AE_Sprite;
+    AE_TextureRegistryStats stats;
+}AE_TextureRegistry;
 
-typedef enum {
-    AE_SPRITE_KEEP_NONE,
-    AE_SPRITE_DEFAULT,
-    AE_SPRITE_KEEP_X,
-    AE_SPRITE_KEEP_Y,
-    AE_SPRITE_KEEP_WIDTH,
-    AE_SPRITE_KEEP_HEIGHT,
-    AE_SPRITE_KEEP_R,
-    AE_SPRITE_KEEP_G,
-    AE_SPRITE_KEEP_B
-}AE_Flag;
+/**
+ Creates an empty texture registry
+ 
+ @param renderer The renderer the textures will be uploaded to
+ @param hashContents Whether files should also be matched by their contents, so copies of an image under different paths share one texture
+ @return The new AE_TextureRegistry, or NULL if it could not be created
+ */
+AE_TextureRegistry* AE_CreateTextureRegistry(SDL_Renderer* renderer, SDL_bool hashContents);
 
 /**
- Creates a new AE_Sprite from a preexisting LinkedTexture
+ Gets the linkedTexture of a file, loading it only if the registry doesn't have it yet. The registry references the linkedTexture until it is evicted
  
- @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
- @param reference_x The x of the sprite on the spritesheet
- @param reference_y The y of the sprite on the spritesheet
- @param frameCount The number of frames in the sprite
- @param width The width of a single sprite frame
- @param height The height of a single sprite frame
- @param pivot_x The x of the sprite pivot point
- @param pivot_y The y of the sprite pivot point
- @return The initialized AE_Sprite, with all other parameters set to default
+ @param registry The AE_TextureRegistry to load through
+ @param path The pathname of the file (equivalent pathnames such as "a/./b.png" and "a\\b.png" are treated as the same file)
+ @return The linkedTexture of the file, or NULL if it could not be loaded
  */
-AE_Sprite* AE_CreateSprite(AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y);
+AE_LinkedTexture* AE_TextureRegistry_Load(AE_TextureRegistry* registry, const char* path);
 
 /**
- Guts out and fills a sprite with the given data
+ Gets the linkedTexture of a file only if the registry already has it, without loading anything or counting a hit or miss
  
- @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
- @param reference_x The x of the sprite on the spritesheet
- @param reference_y The y of the sprite on the spritesheet
- @param frameCount The number of frames in the sprite
- @param width The width of a single sprite frame
- @param height The height of a single sprite frame
- @param pivot_x The x of the sprite pivot point
- @param pivot_y The y of the sprite pivot point
+ @param registry The AE_TextureRegistry to search
+ @param path The pathname of the file
+ @return The linkedTexture of the file, or NULL if the registry doesn't have it
+ */
+AE_LinkedTexture* AE_TextureRegistry_Find(AE_TextureRegistry* registry, const char* path);
+
+/**
+ Removes a file from a registry, destroying its linkedTexture if nothing else references it
+ 
+ @param registry The AE_TextureRegistry to remove the file from
+ @param path The pathname of the file
+ @return Whether the file was in the registry or not
+ */
+SDL_bool AE_TextureRegistry_Evict(AE_TextureRegistry* registry, const char* path);
+
+/**
+ Removes and destroys every linkedTexture that nothing but the registry references
+ 
+ @param registry The AE_TextureRegistry to clean out
+ @return The number of files removed from the registry
+ */
+int AE_TextureRegistry_EvictUnused(AE_TextureRegistry* registry);
+
+/**
+ Gets the number of files in a registry
+ 
+ @param registry The AE_TextureRegistry whose files will be counted
+ @return The number of files, counting each path sharing a texture separately
+ */
+int AE_TextureRegistry_GetCount(AE_TextureRegistry* registry);
+
+/**
+ Gets the hit and miss counters of a registry
+ 
+ @param registry The AE_TextureRegistry whose counters will be retrieved
+ @return The counters of cached and uncached loads
+ */
+AE_TextureRegistryStats AE_TextureRegistry_GetStats(AE_TextureRegistry* registry);
+
+/**
+ Resets the hit and miss counters of a registry to 0
+ 
+ @param registry The AE_TextureRegistry whose counters will be reset
+ */
+void AE_TextureRegistry_ResetStats(AE_TextureRegistry* registry);
+
+/**
+ Frees and destroys an AE_TextureRegistry, destroying every linkedTexture nothing else references. Textures still referenced are left to their other stakeholders
+ 
+ @param registry The AE_TextureRegistry to be destroyed
+ */
+void AE_DestroyTextureRegistry(AE_TextureRegistry* registry);
+
+//
+//
+//End: Texture Registry Functions
+//
+//
+
+//
+//
+//Start: Texture Atlas Functions
+//
+//
+
+/**
+ A packed image's place in a texture atlas
+ */
+typedef struct {
+    AE_LinkedTexture* page;
+    SDL_Rect rect;
+}AE_AtlasRegion;
+
+/**
+ A set of images packed into as few large textures as possible so they can be drawn without switching textures
+ */
+typedef struct {
+    int pageCount;
+    AE_LinkedTexture** pages;
+    
+    int regionCount;
+    AE_AtlasRegion* regions;
+}AE_TextureAtlas;
+
+/**
+ Loads images from files and packs them into one or more atlas pages, color keying each image the same way as AE_LoadTextureFromFile
+ 
+ @param renderer The renderer which will generate the atlas pages
+ @param paths The pathnames of the files to be packed
+ @param pathCount The number of pathnames
+ @param padding The number of empty pixels left between packed images
+ @return The AE_TextureAtlas, with one region per pathname in the same order, or NULL if it could not be created
+ */
+AE_TextureAtlas* AE_CreateTextureAtlas_FromFiles(SDL_Renderer* renderer, const char** paths, int pathCount, int padding);
+
+/**
+ Packs surfaces into one or more atlas pages, leaving the surfaces untouched
+ 
+ @param renderer The renderer which will generate the atlas pages
+ @param surfaces The surfaces to be packed
+ @param surfaceCount The number of surfaces
+ @param padding The number of empty pixels left between packed images
+ @return The AE_TextureAtlas, with one region per surface in the same order, or NULL if it could not be created
+ */
+AE_TextureAtlas* AE_CreateTextureAtlas_FromSurfaces(SDL_Renderer* renderer, SDL_Surface** surfaces, int surfaceCount, int padding);
+
+/**
+ Gets a packed image's region in an atlas
+ 
+ @param atlas The AE_TextureAtlas the image was packed into
+ @param index The position of the image in the list the atlas was created from
+ @return The region of the image, or NULL if the index is out of range. A region whose page is NULL could not be packed
+ */
+AE_AtlasRegion* AE_TextureAtlas_GetRegion(AE_TextureAtlas* atlas, int index);
+
+/**
+ Gets the number of pages in an atlas
+ 
+ @param atlas The AE_TextureAtlas whose pages will be counted
+ @return The number of pages in the atlas
+ */
+int AE_TextureAtlas_GetPageCount(AE_TextureAtlas* atlas);
+
+/**
+ Gets a page of an atlas
+ 
+ @param atlas The AE_TextureAtlas whose page will be retrieved
+ @param index The index of the page
+ @return The linkedTexture of the page, or NULL if the index is out of range
+ */
+AE_LinkedTexture* AE_TextureAtlas_GetPage(AE_TextureAtlas* atlas, int index);
+
+/**
+ Destroys an atlas and its pages only if nothing references any of its pages
+ 
+ @param atlas The AE_TextureAtlas to destroy
+ @return Whether the atlas was destroyed or not
+ */
+SDL_bool AE_DestroyTextureAtlas(AE_TextureAtlas* atlas);
+
+//
+//
+//End: Texture Atlas Functions
+//
+//
+
+//
+//
+//Start: Asynchronous Texture Loading Functions
+//
+//
+
+/**
+ Called on the render thread once a texture loaded in the background is ready to draw or has failed to load
+ 
+ @param linkedTexture The linkedTexture that finished loading
+ @param success Whether the texture loaded or not
+ @param userdata The userdata given when the load was requested
+ */
+typedef void (*AE_TextureLoadCallback)(AE_LinkedTexture* linkedTexture, SDL_bool success, void* userdata);
+
+/**
+ A request to load a texture, which is passed from the render thread to a worker and back again
+ */
+typedef struct AE_TextureLoadJob {
+    void* next;
+    AE_LinkedTexture* linkedTexture;
+    char* path;
+    SDL_Surface* surface;
+    AE_TextureLoadCallback callback;
+    void* userdata;
+} AE_TextureLoadJob;
+
+/**
+ Worker threads that read, decode and convert image files, leaving only the upload to the render thread
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    Uint32 surfaceFormat;
+    
+    SDL_Thread** workers;
+    int workerCount;
+    SDL_atomic_t quit;
+    
+    SDL_mutex* requestLock;
+    SDL_cond* requestSignal;
+    AE_TextureLoadJob* requestHead;
+    AE_TextureLoadJob* requestTail;
+    
+    AE_TextureLoadJob* completedHead;
+    void* completedTail;
+    AE_TextureLoadJob completedStub;
+    
+    int pendingCount;
+}AE_TextureLoader;
+
+/**
+ Creates a texture loader and starts its worker threads
+ 
+ @param renderer The renderer the textures will be uploaded to
+ @param workerCount The number of worker threads (0 or less for one fewer than the number of CPUs, at least 1)
+ @return The new AE_TextureLoader, or NULL if it could not be created
+ */
+AE_TextureLoader* AE_CreateTextureLoader(SDL_Renderer* renderer, int workerCount);
+
+/**
+ Starts loading a texture from a file in the background, color keyed the same way as AE_LoadTextureFromFile
+ 
+ @param loader The AE_TextureLoader that will load the texture
+ @param path The pathname of the file to be loaded
+ @param callback Called on the render thread once the texture is ready or has failed (NULL for none)
+ @param userdata Passed to the callback
+ @return A linkedTexture with no texture yet, that can be joined and given to sprites straight away and is drawn once it finishes loading, or NULL if the load could not be started
+ */
+AE_LinkedTexture* AE_TextureLoader_Load(AE_TextureLoader* loader, const char* path, AE_TextureLoadCallback callback, void* userdata);
+
+/**
+ Uploads textures that have finished decoding, stopping once the time budget is spent. Call it once a frame on the render thread
+ 
+ @param loader The AE_TextureLoader whose textures will be uploaded
+ @param budgetMilliseconds The time that can be spent uploading (at least one texture is always uploaded if one is waiting)
+ @return The number of textures finished, whether they loaded or failed
+ */
+int AE_TextureLoader_Update(AE_TextureLoader* loader, double budgetMilliseconds);
+
+/**
+ Blocks until every requested texture has been loaded or has failed
+ 
+ @param loader The AE_TextureLoader to wait on
+ */
+void AE_TextureLoader_Finish(AE_TextureLoader* loader);
+
+/**
+ Gets the number of textures that have been requested but not yet finished
+ 
+ @param loader The AE_TextureLoader whose textures will be counted
+ @return The number of textures still loading
+ */
+int AE_TextureLoader_GetPendingCount(AE_TextureLoader* loader);
+
+/**
+ Stops a texture loader's workers and destroys it. Textures that hadn't finished are marked as failed and their callbacks are called
+ 
+ @param loader The AE_TextureLoader to destroy
+ */
+void AE_DestroyTextureLoader(AE_TextureLoader* loader);
+
+//
+//
+//End: Asynchronous Texture Loading Functions
+//
+//
+
+//
+//
+//Start: Sprites and Sprite Functions
+//
+//
+
+/**
+ A sprite definition: the sprite sheet, frames, default pivot and default frame speed that any number of sprites can share
+ */
+typedef struct {
+    AE_LinkedTexture* spriteSheet;
+    int width;
+    int height;
+    
+    int frameCount;
+    SDL_Rect* frames;
+    
+    SDL_Point pivot;
+    float frameSpeed;
+    
+    SDL_atomic_t references;
+}AE_SpriteDef;
+
+/**
+ A sprite, holding only its own animation, transform and color on top of a (possibly shared) AE_SpriteDef
+ */
+typedef struct {
+    AE_SpriteDef* definition;
+    
+    float currentFrame;
+    float frameSpeed;
+    
+    SDL_Point pivot;
+    double angle;
+    SDL_RendererFlip flip;
+    
+    float x_scale;
+    float y_scale;
+    SDL_Rect drawRect;
+    
+    AE_ColorBundle color;
+    Uint8 alpha;
+}AE_Sprite;
+
+typedef enum {
+    AE_SPRITE_KEEP_NONE,
+    AE_SPRITE_DEFAULT,
+    AE_SPRITE_KEEP_X,
+    AE_SPRITE_KEEP_Y,
+    AE_SPRITE_KEEP_WIDTH,
+    AE_SPRITE_KEEP_HEIGHT,
+    AE_SPRITE_KEEP_R,
+    AE_SPRITE_KEEP_G,
+    AE_SPRITE_KEEP_B
+}AE_Flag;
+
+/**
+ Creates a new AE_Sprite from a preexisting LinkedTexture
+ 
+ @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
+ @param reference_x The x of the sprite on the spritesheet
+ @param reference_y The y of the sprite on the spritesheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame
+ @param height The height of a single sprite frame
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return The initialized AE_Sprite, with all other parameters set to default
+ */
+AE_Sprite* AE_CreateSprite(AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y);
+
+/**
+ Guts out and fills a sprite with the given data, giving it a definition of its own
+ 
+ @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
+ @param reference_x The x of the sprite on the spritesheet
+ @param reference_y The y of the sprite on the spritesheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame
+ @param height The height of a single sprite frame
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return Whether the sprite's definition could be created or not. On failure the sprite is zeroed and must not be rendered
+ */
+SDL_bool AE_FillSprite(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y);
+
+/**
+ Resets the frame sprite sheet (giving the sprite its own definition first if it shares one)
+ 
+ @param sprite The AE_Sprite whose spritesheet will be reset
+ @param spriteSheet The spritesheet that the AE_Sprite will now reference
+ @param frameCount The number of frames in the sprite
+ @param reference_x The x of the desired sprite on the spritesheet
+ @param reference_y The y of the desired sprite on the spritesheet
+ @param frame_width The width of the new frames
+ @param frame_height The height of the new frames
+ @param dataToKeep Whether to keep the previous width or height, or neither
+ @return Whether the sprite now references the spritesheet or not (if it couldn't be joined, the sprite is left without a spritesheet)
+ */
+SDL_bool AE_SpriteSetSpriteSheet(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep);
+
+/**
+ Sets the number of frames in a sprite, and creates an array of frames for the sprite (giving the sprite its own definition first if it shares one)
+ 
+ @param sprite The sprite whose frame count will be expanded
+ @param frameCount The number of sprite frames
+ @param reference_x The x of the sprite on its spritesheet
+ @param reference_y The y of the sprite on its spritesheet
+ */
+void AE_SpriteSetFrames(AE_Sprite* sprite, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep);
+
+/**
+ Creates a new AE_Sprite whose frames start at the origin of an atlas region
+ 
+ @param region The AE_AtlasRegion the sprite will be drawn from, whose page will be used as the sprite sheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame, or 0 to split the region's width evenly between the frames
+ @param height The height of a single sprite frame, or 0 to use the region's height
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return The initialized AE_Sprite, with all other parameters set to default, or NULL if the region was never packed
+ */
+AE_Sprite* AE_CreateSpriteFromRegion(AE_AtlasRegion* region, int frameCount, int width, int height, int pivot_x, int pivot_y);
+
+/**
+ Sets the frames of a sprite to start at the origin of an atlas region, switching to the region's page if needed
+ 
+ @param sprite The sprite whose frames will be set
+ @param region The AE_AtlasRegion the frames will be taken from
+ @param frameCount The number of sprite frames
+ @param frame_width The width of the new frames, or 0 to split the region's width evenly between the frames
+ @param frame_height The height of the new frames, or 0 to use the region's height
+ @param dataToKeep Whether you want to keep the width, height, or neither
+ @return Whether the frames were set or not
+ */
+SDL_bool AE_SpriteSetFramesFromRegion(AE_Sprite* sprite, AE_AtlasRegion* region, int frameCount, int frame_width, int frame_height, int dataToKeep);
+
+/**
+ Creates a new AE_SpriteDef that sprites can share instead of each holding their own copy of the frames
+ 
+ @param spriteSheet The preexisting LinkedTexture that will be used as the sprite sheet
+ @param reference_x The x of the first frame on the spritesheet
+ @param reference_y The y of the first frame on the spritesheet
+ @param frameCount The number of frames in the definition
+ @param width The width of a single frame
+ @param height The height of a single frame
+ @param pivot_x The x of the default pivot point
+ @param pivot_y The y of the default pivot point
+ @param frameSpeed The default frame speed
+ @return The new AE_SpriteDef with one reference held by the caller, or NULL if it couldn't be created
+ */
+AE_SpriteDef* AE_CreateSpriteDef(AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y, float frameSpeed);
+
+/**
+ Creates a new AE_SpriteDef whose frames start at the origin of an atlas region
+ 
+ @param region The AE_AtlasRegion the frames will be taken from, whose page will be used as the sprite sheet
+ @param frameCount The number of frames in the definition
+ @param width The width of a single frame, or 0 to split the region's width evenly between the frames
+ @param height The height of a single frame, or 0 to use the region's height
+ @param pivot_x The x of the default pivot point
+ @param pivot_y The y of the default pivot point
+ @param frameSpeed The default frame speed
+ @return The new AE_SpriteDef with one reference held by the caller, or NULL if the region was never packed
+ */
+AE_SpriteDef* AE_CreateSpriteDefFromRegion(AE_AtlasRegion* region, int frameCount, int width, int height, int pivot_x, int pivot_y, float frameSpeed);
+
+/**
+ Adds a reference to an AE_SpriteDef. Safe to call from any thread
+ 
+ @param definition The AE_SpriteDef that will be referenced
+ */
+void AE_SpriteDef_Retain(AE_SpriteDef* definition);
+
+/**
+ Removes a reference from an AE_SpriteDef, destroying it once nothing references it. Safe to call from any thread
+ 
+ @param definition The AE_SpriteDef that will no longer be referenced
+ @return Whether the AE_SpriteDef was destroyed or not
+ */
+SDL_bool AE_SpriteDef_Release(AE_SpriteDef* definition);
+
+/**
+ Gets the number of sprites and owners referencing an AE_SpriteDef
+ 
+ @param definition The AE_SpriteDef whose reference count will be retrieved
+ @return The number of references to the AE_SpriteDef
+ */
+int AE_SpriteDef_GetReferenceCount(AE_SpriteDef* definition);
+
+/**
+ Creates a new AE_Sprite that shares an AE_SpriteDef
+ 
+ @param definition The AE_SpriteDef the sprite will be drawn from
+ @return The initialized AE_Sprite, with its pivot and frame speed taken from the definition and all other parameters set to default
+ */
+AE_Sprite* AE_CreateSpriteFromDef(AE_SpriteDef* definition);
+
+/**
+ Guts out and fills a sprite so it shares an AE_SpriteDef, for sprites stored by value
+ 
+ @param sprite The sprite that will be filled
+ @param definition The AE_SpriteDef the sprite will be drawn from
+ @return Whether the sprite was filled or not (SDL_FALSE if definition is NULL, in which case the sprite is zeroed)
+ */
+SDL_bool AE_FillSpriteFromDef(AE_Sprite* sprite, AE_SpriteDef* definition);
+
+/**
+ Switches the AE_SpriteDef a sprite is drawn from, restarting its animation with the new definition's pivot and frame speed
+ 
+ @param sprite The sprite whose definition will be switched
+ @param definition The AE_SpriteDef the sprite will be drawn from
+ */
+void AE_SpriteSetDef(AE_Sprite* sprite, AE_SpriteDef* definition);
+
+/**
+ Gets the AE_SpriteDef a sprite is drawn from
+ 
+ @param sprite The sprite whose definition will be retrieved
+ @return The AE_SpriteDef of the sprite
+ */
+AE_SpriteDef* AE_SpriteGetDef(AE_Sprite* sprite);
+
+/**
+ Sets the current pivot
+ 
+ @param sprite The sprite whose pivot will be set
+ @param pivot_x The x of the new pivot
+ @param pivot_y The y of the new pivot
+ @param dataToKeep Which pivot point attributes will be overwritten: x, y, both, or sets the pivot to the default position (centerpoint)
+ */
+void AE_SpriteSetPivot(AE_Sprite* sprite, int pivot_x, int pivot_y, int dataToKeep);
+
+/**
+ Sets the sprite angle
+ 
+ @param sprite The sprite whose angle will be set
+ @param angle The angle of the sprite
+ */
+void AE_SpriteSetAngle(AE_Sprite* sprite, double angle);
+
+/**
+ Sets the rendererflip of the sprite
+ 
+ @param sprite The sprite whose rendererflip will be set
+ @param flip The desired rendererflip type
+ */
+void AE_SpriteSetFlip(AE_Sprite* sprite, SDL_RendererFlip flip);
+
+/**
+ Sets the sprite scale
+ 
+ @param sprite The sprite whose scale will be set
+ @param x_scale The new scale on the x axis
+ @param y_scale The new scale on the y axis
+ @param dataToKeep Which scale attributes will be overwritten: x scale, y scale, both, or sets the both scales to the default size (1)
+ */
+void AE_SpriteSetScale(AE_Sprite* sprite, float x_scale, float y_scale, int dataToKeep);
+
+/**
+ Gets the current loop frame of the sprite
+ 
+ @param sprite The sprite whose frame will be retrieved
+ @return The current loop frame
+ */
+int AE_SpriteGetSavedFrame(AE_Sprite* sprite);
+
+/**
+ Sets the current loop frame of the sprite
+ 
+ @param sprite The sprite whose current loop frame will be set
+ @param desiredFrame The frame the loop will be set to
+ */
+void AE_SpriteSetSavedFrame(AE_Sprite* sprite, int desiredFrame);
+
+/**
+ Sets the frame speed of the sprite
+ 
+ @param sprite The sprite whose frame speed will be set
+ @param frameSpeed The speed the sprite will be set to
+ */
+void AE_SpriteSetFrameSpeed(AE_Sprite* sprite, float frameSpeed);
+
+/**
+ Sets the color of the sprite
+ 
+ @param sprite The AE_Sprite whose color will be set
+ @param color The color the AE_Sprite will be set to
+ @param dataToKeep Which preexisting color values to keep (red, green, blue) or set the color values to default color white
+ */
+void AE_SpriteSetColor(AE_Sprite* sprite, AE_ColorBundle* color, int dataToKeep);
+
+/**
+ Gets the color modulation of a sprite in a newly allocated AE_ColorBundle, which the caller frees with SDL_free. AE_SpriteGetColorValue gets the same colors without allocating
+ 
+ @param sprite The AE_Sprite whose color will be retrieved
+ @return A pointer to an AE_ColorBundle containing the colors of the AE_Sprite
+ */
+AE_ColorBundle* AE_SpriteGetColor(AE_Sprite* sprite);
+
+/**
+ Gets the color modulation of a sprite by value
+ 
+ @param sprite The AE_Sprite whose color will be retrieved
+ @return An AE_ColorBundle containing the colors of the AE_Sprite
+ */
+AE_ColorBundle AE_SpriteGetColorValue(AE_Sprite* sprite);
+
+/**
+ Sets the color of the sprite
+ 
+ @param sprite The AE_Sprite whose alpha will be set
+ @param alpha The alpha the AE_Sprite will be set to
+ */
+void AE_SpriteSetAlpha(AE_Sprite* sprite, Uint8 alpha);
+
+/**
+ Gets the alpha modulation of a sprite
+ 
+ @param sprite The AE_Sprite whose alpha will be retrieved
+ @return The alpha modulation of the sprite
+ */
+Uint8 AE_SpriteGetAlpha(AE_Sprite* sprite);
+
+
+/**
+ Renders the sprite on the given renderer, skipping the copy if the sprite is entirely outside the renderer's viewport
+ 
+ @param sprite The sprite to be rendered
+ @param renderer The renderer the sprite will be rendered on
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was successfully rendered or not
+ */
+SDL_bool AE_SpriteRender(AE_Sprite* sprite, SDL_Renderer* renderer, int x, int y, int currentFrame, float step);
+
+/**
+ Frees and destroys an AE_Sprite, releasing its reference to its AE_SpriteDef
+ 
+ @param sprite The sprite to be destroyed
+ */
+void AE_DestroySprite(AE_Sprite* sprite);
+
+//
+//
+//End: Sprites and Sprite Functions
+//
+//
+
+//
+//
+//Start: Sprite Batch Functions
+//
+//
+
+/**
+ A batch of sprite quads that are merged into one geometry draw per run of sprites sharing a sprite sheet
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_bool softwareRenderer;
+    
+    AE_LinkedTexture* spriteSheet;
+    float sheetWidth;
+    float sheetHeight;
+    
+    SDL_Vertex* vertices;
+    int vertexCount;
+    int vertexCapacity;
+    int* indices;
+    int indexCount;
+    int indexCapacity;
+    
+    int spriteCount;
+    int drawCalls;
+}AE_SpriteBatch;
+
+/**
+ Creates a new AE_SpriteBatch for a renderer
+ 
+ @param renderer The renderer the batch will draw to
+ @param spriteCapacity The number of sprites the batch will have room for before it needs to grow (0 or less for the default)
+ @return The new AE_SpriteBatch
+ */
+AE_SpriteBatch* AE_CreateSpriteBatch(SDL_Renderer* renderer, int spriteCapacity);
+
+/**
+ Begins a new frame of batched sprites, discarding anything unflushed and resetting the batch statistics
+ 
+ @param batch The AE_SpriteBatch to begin
+ */
+void AE_SpriteBatch_Begin(AE_SpriteBatch* batch);
+
+/**
+ Adds a sprite quad to a batch, using the same inputs as AE_SpriteRender. If the quad uses a different sprite sheet than the current run, the current run is flushed first
+ 
+ @param batch The AE_SpriteBatch the quad will be added to
+ @param spriteSheet The LinkedTexture the quad will be drawn from
+ @param frame The rect on the sprite sheet to be drawn (NULL for the whole sheet)
+ @param drawRect The rect on the renderer the quad will be drawn to
+ @param angle The angle of the quad in degrees
+ @param pivot The point the quad will be rotated around, relative to the drawRect (NULL for the center of the drawRect)
+ @param flip The rendererflip of the quad
+ @param color The color modulation of the quad
+ @param alpha The alpha modulation of the quad
+ @return Whether the quad was added to the batch or not
+ */
+SDL_bool AE_SpriteBatch_Submit(AE_SpriteBatch* batch, AE_LinkedTexture* spriteSheet, const SDL_Rect* frame, const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_RendererFlip flip, AE_ColorBundle color, Uint8 alpha);
+
+/**
+ Adds an AE_Sprite to a batch, animating it exactly as AE_SpriteRender would
+ 
+ @param batch The AE_SpriteBatch the sprite will be added to
+ @param sprite The sprite to be added
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was added to the batch or not
+ */
+SDL_bool AE_SpriteBatch_SubmitSprite(AE_SpriteBatch* batch, AE_Sprite* sprite, int x, int y, int currentFrame, float step);
+
+/**
+ Draws the current run of quads in a batch with a single geometry draw
+ 
+ @param batch The AE_SpriteBatch to be flushed
+ @return Whether the run was drawn successfully or not
+ */
+SDL_bool AE_SpriteBatch_Flush(AE_SpriteBatch* batch);
+
+/**
+ Ends a frame of batched sprites, flushing anything left in the batch
+ 
+ @param batch The AE_SpriteBatch to end
+ @return Whether the remaining quads were drawn successfully or not
+ */
+SDL_bool AE_SpriteBatch_End(AE_SpriteBatch* batch);
+
+/**
+ Gets the number of draw calls a batch has issued since it last began
+ 
+ @param batch The AE_SpriteBatch whose draw calls will be retrieved
+ @return The number of draw calls issued
+ */
+int AE_SpriteBatch_GetDrawCalls(AE_SpriteBatch* batch);
+
+/**
+ Gets the number of sprites submitted to a batch since it last began
+ 
+ @param batch The AE_SpriteBatch whose sprite count will be retrieved
+ @return The number of sprites submitted
+ */
+int AE_SpriteBatch_GetSpriteCount(AE_SpriteBatch* batch);
+
+/**
+ Frees and destroys an AE_SpriteBatch (without flushing it)
+ 
+ @param batch The AE_SpriteBatch to be destroyed
+ */
+void AE_DestroySpriteBatch(AE_SpriteBatch* batch);
+
+//
+//
+//End: Sprite Batch Functions
+//
+//
+
+//
+//
+//Start: Render Queue Functions
+//
+//
+
+/**
+ A single queued sprite draw, along with the key it is sorted by
+ */
+typedef struct {
+    Uint64 key;
+    AE_LinkedTexture* spriteSheet;
+    SDL_Rect frame;
+    SDL_bool wholeSheet;
+    SDL_Rect drawRect;
+    double angle;
+    SDL_Point pivot;
+    SDL_bool centerPivot;
+    SDL_RendererFlip flip;
+    AE_ColorBundle color;
+    Uint8 alpha;
+    SDL_BlendMode blendMode;
+}AE_RenderCommand;
+
+/**
+ A list of sprite draws that is sorted by layer, depth, blend mode, sprite sheet and modulation before being drawn
+ */
+typedef struct {
+    AE_RenderCommand* commands;
+    int count;
+    int capacity;
+    
+    Uint64* keys;
+    Uint32* order;
+    Uint64* scratchKeys;
+    Uint32* scratchOrder;
+    int sortCapacity;
+    
+    SDL_bool stableSort;
+    int textureSwitches;
+}AE_RenderQueue;
+
+/**
+ Packs the sort key of a draw. From most to least significant: 8 bits of layer, 16 bits of depth, 4 bits of blend mode, 24 bits of sprite sheet id and 12 bits of modulation
+ 
+ @param layer The layer of the draw (lower layers are drawn first)
+ @param depth The depth of the draw within its layer (lower depths are drawn first)
+ @param spriteSheet The LinkedTexture the draw uses
+ @param blendMode The blend mode of the draw (SDL_BLENDMODE_INVALID to leave the texture's blend mode as it is)
+ @param color The color modulation of the draw
+ @param alpha The alpha modulation of the draw
+ @return The sort key
+ */
+Uint64 AE_RenderQueue_MakeKey(Uint8 layer, Uint16 depth, AE_LinkedTexture* spriteSheet, SDL_BlendMode blendMode, AE_ColorBundle color, Uint8 alpha);
+
+/**
+ Creates a new, empty AE_RenderQueue
+ 
+ @param commandCapacity The number of draws the queue will have room for before it needs to grow (0 or less for the default)
+ @param stableSort Whether draws with equal keys keep the order they were submitted in
+ @return The new AE_RenderQueue
+ */
+AE_RenderQueue* AE_CreateRenderQueue(int commandCapacity, SDL_bool stableSort);
+
+/**
+ Sets whether a queue keeps draws with equal keys in the order they were submitted in. The unstable sort needs no scratch memory
+ 
+ @param queue The AE_RenderQueue whose sort mode will be set
+ @param stableSort Whether draws with equal keys keep their submission order
+ */
+void AE_RenderQueue_SetStableSort(AE_RenderQueue* queue, SDL_bool stableSort);
+
+/**
+ Adds a draw to a queue
+ 
+ @param queue The AE_RenderQueue the draw will be added to
+ @param layer The layer of the draw (lower layers are drawn first)
+ @param depth The depth of the draw within its layer (lower depths are drawn first)
+ @param spriteSheet The LinkedTexture the draw uses
+ @param frame The rect on the sprite sheet to be drawn (NULL for the whole sheet)
+ @param drawRect The rect on the renderer the sprite sheet will be drawn to
+ @param angle The angle of the draw in degrees
+ @param pivot The point the draw will be rotated around, relative to the drawRect (NULL for the center of the drawRect)
+ @param flip The rendererflip of the draw
+ @param color The color modulation of the draw
+ @param alpha The alpha modulation of the draw
+ @param blendMode The blend mode of the draw (SDL_BLENDMODE_INVALID to leave the texture's blend mode as it is)
+ @return Whether the draw was added to the queue or not
+ */
+SDL_bool AE_RenderQueue_Submit(AE_RenderQueue* queue, Uint8 layer, Uint16 depth, AE_LinkedTexture* spriteSheet, const SDL_Rect* frame, const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_RendererFlip flip, AE_ColorBundle color, Uint8 alpha, SDL_BlendMode blendMode);
+
+/**
+ Adds an AE_Sprite to a queue, animating it exactly as AE_SpriteRender would
+ 
+ @param queue The AE_RenderQueue the sprite will be added to
+ @param sprite The sprite to be added
+ @param layer The layer of the sprite (lower layers are drawn first)
+ @param depth The depth of the sprite within its layer (lower depths are drawn first)
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was added to the queue or not
+ */
+SDL_bool AE_RenderQueue_SubmitSprite(AE_RenderQueue* queue, AE_Sprite* sprite, Uint8 layer, Uint16 depth, int x, int y, int currentFrame, float step);
+
+/**
+ Radix sorts the draws in a queue by their keys
+ 
+ @param queue The AE_RenderQueue to be sorted
+ */
+void AE_RenderQueue_Sort(AE_RenderQueue* queue);
+
+/**
+ Sorts and draws every draw in a queue, then empties the queue
+ 
+ @param queue The AE_RenderQueue to be drawn
+ @param renderer The renderer the draws will be drawn on
+ @param batch The AE_SpriteBatch the draws will be merged through (NULL to draw each one on its own)
+ @return Whether every draw was drawn successfully or not
+ */
+SDL_bool AE_RenderQueue_Flush(AE_RenderQueue* queue, SDL_Renderer* renderer, AE_SpriteBatch* batch);
+
+/**
+ Empties a queue without drawing it
+ 
+ @param queue The AE_RenderQueue to be emptied
+ */
+void AE_RenderQueue_Clear(AE_RenderQueue* queue);
+
+/**
+ Gets the number of times the sprite sheet changed between draws during the last flush of a queue
+ 
+ @param queue The AE_RenderQueue whose texture switches will be retrieved
+ @return The number of texture switches
+ */
+int AE_RenderQueue_GetTextureSwitches(AE_RenderQueue* queue);
+
+/**
+ Frees and destroys an AE_RenderQueue
+ 
+ @param queue The AE_RenderQueue to be destroyed
+ */
+void AE_DestroyRenderQueue(AE_RenderQueue* queue);
+
+//
+//
+//End: Render Queue Functions
+//
+//
+
+//
+//
+//Start: Cached Layer Functions
+//
+//
+
+/**
+ One sprite drawn into an AE_CachedLayer, along with how it looked when the layer was last drawn
+ */
+typedef struct {
+    AE_Sprite* sprite;
+    int x;
+    int y;
+    int currentFrame;
+    
+    SDL_Texture* texture;
+    Uint32 textureVersion;
+    SDL_Rect frame;
+    SDL_bool wholeSheet;
+    SDL_Rect drawRect;
+    double angle;
+    SDL_Point pivot;
+    SDL_RendererFlip flip;
+    AE_ColorBundle color;
+    Uint8 alpha;
+}AE_CachedLayerDraw;
+
+/**
+ A set of sprite draws cached in a target texture, so content that rarely changes (backgrounds, UI chrome) costs one copy a frame instead of a draw per sprite. The layer is drawn again whenever it's invalidated or one of its sprites or sprite sheets changes
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_Texture* target;
+    int width;
+    int height;
+    
+    AE_CachedLayerDraw* draws;
+    int count;
+    int capacity;
+    
+    SDL_bool isDirty;
+    SDL_bool watchChanges;
+    Uint32 redrawCount;
+}AE_CachedLayer;
+
+/**
+ Creates an empty AE_CachedLayer backed by a target texture
+ 
+ @param renderer The renderer the layer will be drawn with
+ @param width The width of the layer
+ @param height The height of the layer
+ @return The new AE_CachedLayer, or NULL if the renderer can't draw to textures or the texture couldn't be created
+ */
+AE_CachedLayer* AE_CreateCachedLayer(SDL_Renderer* renderer, int width, int height);
+
+/**
+ Adds a sprite to a layer. The layer keeps a pointer to the sprite, so remove it before destroying the sprite
+ 
+ @param layer The AE_CachedLayer the sprite will be drawn into
+ @param sprite The sprite to be added
+ @param x The x coordinate of the sprite within the layer
+ @param y The y coordinate of the sprite within the layer
+ @param currentFrame The frame the sprite will be drawn on (-1 or less for the frame the sprite is on, which the layer never advances)
+ @return Whether the sprite was added or not
+ */
+SDL_bool AE_CachedLayer_AddSprite(AE_CachedLayer* layer, AE_Sprite* sprite, int x, int y, int currentFrame);
+
+/**
+ Removes every draw of a sprite from a layer
+ 
+ @param layer The AE_CachedLayer the sprite will be removed from
+ @param sprite The sprite to be removed
+ @return The number of draws removed
+ */
+int AE_CachedLayer_RemoveSprite(AE_CachedLayer* layer, AE_Sprite* sprite);
+
+/**
+ Removes every sprite from a layer
+ 
+ @param layer The AE_CachedLayer to be cleared
+ */
+void AE_CachedLayer_Clear(AE_CachedLayer* layer);
+
+/**
+ Makes a layer draw its sprites again the next time it's rendered. Sprite and sprite sheet changes are noticed on their own, but a renderer losing its target textures (SDL_RENDER_TARGETS_RESET or SDL_RENDER_DEVICE_RESET) isn't
+ 
+ @param layer The AE_CachedLayer to be invalidated
+ */
+void AE_CachedLayer_Invalidate(AE_CachedLayer* layer);
+
+/**
+ Sets whether a layer checks its sprites and sprite sheets for changes every time it's updated. Checking costs a little per sprite each frame, so very large layers the game invalidates itself can turn it off
+ 
+ @param layer The AE_CachedLayer whose checking will be set
+ @param watchChanges Whether changes are checked for (the default) or only AE_CachedLayer_Invalidate redraws the layer
+ */
+void AE_CachedLayer_SetWatchChanges(AE_CachedLayer* layer, SDL_bool watchChanges);
+
+/**
+ Gets whether a layer has to be drawn again, because it was invalidated or one of its sprites or sprite sheets changed
+ 
+ @param layer The AE_CachedLayer to be checked
+ @return Whether the layer has to be drawn again or not
+ */
+SDL_bool AE_CachedLayer_IsDirty(AE_CachedLayer* layer);
+
+/**
+ Draws a layer's sprites into its texture again if anything changed
+ 
+ @param layer The AE_CachedLayer to be updated
+ @return Whether the layer's texture is up to date or not
+ */
+SDL_bool AE_CachedLayer_Update(AE_CachedLayer* layer);
+
+/**
+ Updates a layer if anything changed, then copies it to the renderer's current target
+ 
+ @param layer The AE_CachedLayer to be rendered
+ @param x The x coordinate the layer will be drawn at
+ @param y The y coordinate the layer will be drawn at
+ @return Whether the layer was rendered or not
+ */
+SDL_bool AE_CachedLayer_Render(AE_CachedLayer* layer, int x, int y);
+
+/**
+ Gets the texture a layer's sprites are drawn into, for drawing it some other way (scaled, or through an AE_SpriteBatch)
+ 
+ @param layer The AE_CachedLayer whose texture will be retrieved
+ @return The target texture of the layer
+ */
+SDL_Texture* AE_CachedLayer_GetTexture(AE_CachedLayer* layer);
+
+/**
+ Gets the number of times a layer's sprites have been drawn into its texture
+ 
+ @param layer The AE_CachedLayer whose redraws will be counted
+ @return The number of redraws
+ */
+Uint32 AE_CachedLayer_GetRedrawCount(AE_CachedLayer* layer);
+
+/**
+ Frees and destroys an AE_CachedLayer and its texture (its sprites are left alone)
+ 
+ @param layer The AE_CachedLayer to be destroyed
+ */
+void AE_DestroyCachedLayer(AE_CachedLayer* layer);
+
+//
+//
+//End: Cached Layer Functions
+//
+//
+
+//
+//
+//Start: Dirty Region Functions
+//
+//
+
+/**
+ One draw in an AE_DirtyRegion's frame, along with the screen area it covers
+ */
+typedef struct {
+    AE_LinkedTexture* spriteSheet;
+    Uint32 textureVersion;
+    SDL_Rect frame;
+    SDL_bool wholeSheet;
+    SDL_Rect drawRect;
+    double angle;
+    SDL_Point pivot;
+    SDL_bool centered;
+    SDL_RendererFlip flip;
+    AE_ColorBundle color;
+    Uint8 alpha;
+    SDL_Rect bounds;
+    Uint32 rectMask;
+}AE_DirtyRegionDraw;
+
+/**
+ What the last frame of an AE_DirtyRegion redrew
+ */
+typedef struct {
+    int drawCount;
+    int redrawnDraws;
+    int rectCount;
+    Sint64 redrawnPixels;
+    float redrawnPercent;
+}AE_DirtyRegionStats;
+
+/**
+ A partial redraw mode for software renderers. Every frame's draws are compared with the last frame's, and only the screen areas where something moved, changed frame or changed tint are drawn again and presented
+ */
+typedef struct {
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    int width;
+    int height;
+    SDL_Color background;
+    
+    AE_DirtyRegionDraw* draws;
+    AE_DirtyRegionDraw* previousDraws;
+    int count;
+    int previousCount;
+    int capacity;
+    
+    SDL_Rect* rects;
+    int rectCount;
+    SDL_bool redrawAll;
+    AE_DirtyRegionStats stats;
+}AE_DirtyRegion;
+
+/**
+ Creates an AE_DirtyRegion for a window drawn by the software renderer (create the renderer with SDL_HINT_RENDER_DRIVER set to "software"). Dirty rects are in window pixels, so the renderer's viewport and scale must be left alone
+ 
+ @param window The window the region presents to
+ @param renderer The software renderer of the window
+ @return The new AE_DirtyRegion, or NULL if the renderer isn't a software renderer
+ */
+AE_DirtyRegion* AE_CreateDirtyRegion(SDL_Window* window, SDL_Renderer* renderer);
+
+/**
+ Sets the color dirty areas are cleared to before their draws are drawn again
+ 
+ @param region The AE_DirtyRegion whose background will be set
+ @param background The background color
+ */
+void AE_DirtyRegion_SetBackground(AE_DirtyRegion* region, SDL_Color background);
+
+/**
+ Begins a new frame of draws. Draws have to be submitted in the same order every frame, since each one is compared with the draw submitted in its place last frame
+ 
+ @param region The AE_DirtyRegion to begin
+ */
+void AE_DirtyRegion_Begin(AE_DirtyRegion* region);
+
+/**
+ Adds a draw to the current frame
+ 
+ @param region The AE_DirtyRegion the draw will be added to
+ @param spriteSheet The LinkedTexture to draw from
+ @param frame The area of the sprite sheet to draw (NULL for the whole sprite sheet)
+ @param drawRect The area of the screen to draw to
+ @param angle The angle of the draw
+ @param pivot The point the draw is rotated around (NULL for the center)
+ @param flip The rendererflip of the draw
+ @param color The color modulation of the draw
+ @param alpha The alpha modulation of the draw
+ @return Whether the draw was added or not
+ */
+SDL_bool AE_DirtyRegion_Submit(AE_DirtyRegion* region, AE_LinkedTexture* spriteSheet, const SDL_Rect* frame, const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_RendererFlip flip, AE_ColorBundle color, Uint8 alpha);
+
+/**
+ Adds an AE_Sprite to the current frame, animating it exactly as AE_SpriteRender would
+ 
+ @param region The AE_DirtyRegion the sprite will be added to
+ @param sprite The sprite to be added
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
+ @param step The timestep the sprite will be drawn at
+ @return Whether the sprite was added or not
+ */
+SDL_bool AE_DirtyRegion_SubmitSprite(AE_DirtyRegion* region, AE_Sprite* sprite, int x, int y, int currentFrame, float step);
+
+/**
+ Makes the next frame redraw and present the whole window, such as after SDL_WINDOWEVENT_EXPOSED or after drawing to the window some other way
+ 
+ @param region The AE_DirtyRegion to be invalidated
+ */
+void AE_DirtyRegion_Invalidate(AE_DirtyRegion* region);
+
+/**
+ Ends the current frame, drawing the areas that changed since the last frame and presenting only those areas to the window. This replaces SDL_RenderPresent
+ 
+ @param region The AE_DirtyRegion to end
+ @return Whether the changed areas were drawn and presented successfully or not
+ */
+SDL_bool AE_DirtyRegion_End(AE_DirtyRegion* region);
+
+/**
+ Gets the dirty rects the last frame redrew
+ 
+ @param region The AE_DirtyRegion whose rects will be retrieved
+ @param count Gets the number of rects
+ @return The rects, which stay valid until the next AE_DirtyRegion_End
+ */
+const SDL_Rect* AE_DirtyRegion_GetRects(AE_DirtyRegion* region, int* count);
+
+/**
+ Gets what the last frame of a region redrew
+ 
+ @param region The AE_DirtyRegion whose statistics will be retrieved
+ @return The statistics of the last frame
+ */
+AE_DirtyRegionStats AE_DirtyRegion_GetStats(AE_DirtyRegion* region);
+
+/**
+ Frees and destroys an AE_DirtyRegion (its sprite sheets and renderer are left alone)
+ 
+ @param region The AE_DirtyRegion to be destroyed
+ */
+void AE_DestroyDirtyRegion(AE_DirtyRegion* region);
+
+//
+//
+//End: Dirty Region Functions
+//
+//
+
+//
+//
+//Start: Tilemap Functions
+//
+//
+
+//The width and height of a tilemap chunk in tiles
+#define AE_TILEMAP_CHUNK_SIZE 32
+#define AE_TILEMAP_CHUNK_TILES (AE_TILEMAP_CHUNK_SIZE * AE_TILEMAP_CHUNK_SIZE)
+
+//The tile id of a cell with nothing in it
+#define AE_TILE_EMPTY 0
+
+/**
+ A kind of tile on a tilemap's tileset. Its variants run along the width of the tileset from its first frame, like the frames of a sprite
+ */
+typedef struct {
+    SDL_Rect frame;
+    int variantCount;
+}AE_TileType;
+
+/**
+ A square of tiles in an AE_Tilemap, with its variants resolved and its vertices cached while it's being drawn
+ */
+typedef struct {
+    Uint16 tiles[AE_TILEMAP_CHUNK_TILES];
+    Uint8 variants[AE_TILEMAP_CHUNK_TILES];
+    int tileCount;
+    
+    SDL_bool isBuilt;
+    SDL_Vertex* vertices;
+    int* indices;
+    int indexCount;
+    SDL_bool indicesDirty;
+    int offsetX;
+    int offsetY;
+    Uint32 lastRender;
+}AE_TilemapChunk;
+
+/**
+ Counters for how much drawing and rebuilding a tilemap has done
+ */
+typedef struct {
+    Uint64 drawnChunks;
+    Uint64 drawnTiles;
+    Uint64 builtChunks;
+    Uint64 patchedTiles;
+}AE_TilemapStats;
+
+/**
+ A grid of tiles drawn from a single tileset, stored as 16-bit tile ids in chunks. Each chunk picks its tiles' variants once and caches its geometry, so a visible chunk costs one draw call, and chunks outside the camera cost nothing
+ */
+typedef struct {
+    AE_LinkedTexture* tileset;
+    Uint32 tilesetVersion;
+    int tileWidth;
+    int tileHeight;
+    int width;
+    int height;
+    
+    AE_TilemapChunk* chunks;
+    int chunksWide;
+    int chunksHigh;
+    int* builtChunks;
+    int builtCount;
+    
+    AE_TileType* types;
+    int typeCount;
+    Uint64 seed;
+    Uint64 set;
+    AE_ColorBundle color;
+    Uint8 alpha;
+    
+    Uint32 renderCount;
+    AE_TilemapStats stats;
+}AE_Tilemap;
+
+/**
+ Creates a new tilemap with every tile empty
+ 
+ @param tileset The LinkedTexture every tile will be drawn from
+ @param width The width of the map in tiles
+ @param height The height of the map in tiles
+ @param tileWidth The width of a tile
+ @param tileHeight The height of a tile
+ @param seed The seed tile variants are picked from with AE_SeedHash_Int, whatever the seed mode
+ @param set The set tile variants are picked from
+ @return The new AE_Tilemap, or NULL if it couldn't be created
+ */
+AE_Tilemap* AE_CreateTilemap(AE_LinkedTexture* tileset, int width, int height, int tileWidth, int tileHeight, Uint64 seed, Uint64 set);
+
+/**
+ Sets where a tile id is on a tilemap's tileset, and how many variants it has
+ 
+ @param map The AE_Tilemap the tile type belongs to
+ @param id The tile id (anything but AE_TILE_EMPTY)
+ @param reference_x The x of the tile's first variant on the tileset
+ @param reference_y The y of the tile's first variant on the tileset
+ @param variantCount The number of variants of the tile, from 1 to 256
+ @return Whether the tile type was set or not
+ */
+SDL_bool AE_Tilemap_SetTileType(AE_Tilemap* map, Uint16 id, int reference_x, int reference_y, int variantCount);
+
+/**
+ Sets a tile of a tilemap. A chunk that has been built only has the changed tile updated
+ 
+ @param map The AE_Tilemap the tile is on
+ @param x The x of the tile
+ @param y The y of the tile
+ @param id The tile id, or AE_TILE_EMPTY to clear the tile
+ @return Whether the tile was on the map or not
+ */
+SDL_bool AE_Tilemap_SetTile(AE_Tilemap* map, int x, int y, Uint16 id);
+
+/**
+ Gets a tile of a tilemap
+ 
+ @param map The AE_Tilemap the tile is on
+ @param x The x of the tile
+ @param y The y of the tile
+ @return The tile id, or AE_TILE_EMPTY if the tile is off the map
+ */
+Uint16 AE_Tilemap_GetTile(AE_Tilemap* map, int x, int y);
+
+/**
+ Sets the color and alpha modulation every tile of a tilemap is drawn with
+ 
+ @param map The AE_Tilemap whose modulation will be set
+ @param color The color modulation
+ @param alpha The alpha modulation
+ */
+void AE_Tilemap_SetColor(AE_Tilemap* map, AE_ColorBundle color, Uint8 alpha);
+
+/**
+ Draws the chunks of a tilemap that are inside the renderer's viewport, with one draw call per chunk
+ 
+ @param map The AE_Tilemap to be drawn
+ @param renderer The renderer the tilemap will be drawn on
+ @param camera_x The x on the map drawn at the left edge of the viewport
+ @param camera_y The y on the map drawn at the top edge of the viewport
+ @return Whether every visible chunk was drawn successfully or not
+ */
+SDL_bool AE_Tilemap_Render(AE_Tilemap* map, SDL_Renderer* renderer, int camera_x, int camera_y);
+
+/**
+ Gets how much drawing and rebuilding a tilemap has done since its statistics were last reset
+ 
+ @param map The AE_Tilemap whose statistics will be retrieved
+ @return The statistics of the tilemap
+ */
+AE_TilemapStats AE_Tilemap_GetStats(AE_Tilemap* map);
+
+/**
+ Resets the statistics of a tilemap
+ 
+ @param map The AE_Tilemap whose statistics will be reset
+ */
+void AE_Tilemap_ResetStats(AE_Tilemap* map);
+
+/**
+ Frees and destroys an AE_Tilemap and every chunk in it
+ 
+ @param map The AE_Tilemap to be destroyed
+ */
+void AE_DestroyTilemap(AE_Tilemap* map);
+
+//
+//
+//End: Tilemap Functions
+//
+//
+
+//
+//
+//Start: Sprite Pool Functions
+//
+//
+
+/**
+ A stable handle to a sprite in an AE_SpritePool. Handles of removed sprites are never valid again
+ */
+typedef Uint32 AE_SpriteHandle;
+
+#define AE_SPRITEHANDLE_INVALID 0
+
+/**
+ A container for large numbers of sprites sharing one sprite sheet, which stores each sprite attribute in its own contiguous array
+ */
+typedef struct {
+    AE_LinkedTexture* spriteSheet;
+    int count;
+    int capacity;
+    
+    float* x;
+    float* y;
+    
+    SDL_Rect* frameRect;
+    int* frameCount;
+    int* fixedFrame;
+    float* currentFrame;
+    float* frameSpeed;
+    
+    float* x_scale;
+    float* y_scale;
+    double* angle;
+    SDL_Point* pivot;
+    SDL_RendererFlip* flip;
+    
+    AE_ColorBundle* color;
+    Uint8* alpha;
+    Uint8* visible;
+    
+    Uint32* denseToSlot;
+    Uint32* slotToDense;
+    Uint32* slotGeneration;
+    Uint32* freeSlots;
+    int freeSlotCount;
+    int slotCount;
+}AE_SpritePool;
+
+/**
+ Creates a new, empty AE_SpritePool
+ 
+ @param spriteSheet The LinkedTexture every sprite in the pool will be drawn from
+ @param capacity The number of sprites the pool will have room for before it needs to grow (0 or less for the default)
+ @return The new AE_SpritePool, or NULL if it could not be allocated or could not join the sprite sheet
+ */
+AE_SpritePool* AE_CreateSpritePool(AE_LinkedTexture* spriteSheet, int capacity);
+
+/**
+ Adds a sprite to a pool, with all other attributes set to the same defaults as AE_CreateSprite
+ 
+ @param pool The AE_SpritePool the sprite will be added to
+ @param reference_x The x of the sprite on the spritesheet
+ @param reference_y The y of the sprite on the spritesheet
+ @param frameCount The number of frames in the sprite
+ @param width The width of a single sprite frame
+ @param height The height of a single sprite frame
+ @param pivot_x The x of the sprite pivot point
+ @param pivot_y The y of the sprite pivot point
+ @return The handle of the new sprite, or AE_SPRITEHANDLE_INVALID if it could not be added
+ */
+AE_SpriteHandle AE_SpritePool_Add(AE_SpritePool* pool, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y);
+
+/**
+ Removes a sprite from a pool
+ 
+ @param pool The AE_SpritePool the sprite will be removed from
+ @param handle The handle of the sprite to be removed
+ @return Whether the sprite was removed or not
+ */
+SDL_bool AE_SpritePool_Remove(AE_SpritePool* pool, AE_SpriteHandle handle);
+
+/**
+ Returns whether a handle refers to a sprite in a pool
+ 
+ @param pool The AE_SpritePool the sprite would be in
+ @param handle The handle to be checked
+ @return Whether the handle refers to a sprite in the pool or not
+ */
+SDL_bool AE_SpritePool_IsValid(AE_SpritePool* pool, AE_SpriteHandle handle);
+
+/**
+ Gets the number of sprites in a pool
+ 
+ @param pool The AE_SpritePool whose sprites will be counted
+ @return The number of sprites in the pool
+ */
+int AE_SpritePool_GetCount(AE_SpritePool* pool);
+
+/**
+ Sets the position a pooled sprite will be drawn at
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param x The x coordinate the sprite will be drawn at
+ @param y The y coordinate the sprite will be drawn at
+ */
+void AE_SpritePool_SetPosition(AE_SpritePool* pool, AE_SpriteHandle handle, float x, float y);
+
+/**
+ Gets the position a pooled sprite will be drawn at
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param x Filled with the x coordinate of the sprite
+ @param y Filled with the y coordinate of the sprite
+ */
+void AE_SpritePool_GetPosition(AE_SpritePool* pool, AE_SpriteHandle handle, float* x, float* y);
+
+/**
+ Sets which frame a pooled sprite is drawn on
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param currentFrame The frame the sprite will be drawn on (-1 or less for an animation loop)
+ */
+void AE_SpritePool_SetFrame(AE_SpritePool* pool, AE_SpriteHandle handle, int currentFrame);
+
+/**
+ Sets the frame speed of a pooled sprite
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param frameSpeed The speed the sprite will be set to
+ */
+void AE_SpritePool_SetFrameSpeed(AE_SpritePool* pool, AE_SpriteHandle handle, float frameSpeed);
+
+/**
+ Sets the scale of a pooled sprite
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param x_scale The new scale on the x axis
+ @param y_scale The new scale on the y axis
+ */
+void AE_SpritePool_SetScale(AE_SpritePool* pool, AE_SpriteHandle handle, float x_scale, float y_scale);
+
+/**
+ Sets the angle of a pooled sprite
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param angle The angle of the sprite
+ */
+void AE_SpritePool_SetAngle(AE_SpritePool* pool, AE_SpriteHandle handle, double angle);
+
+/**
+ Sets the rendererflip of a pooled sprite
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param flip The desired rendererflip type
+ */
+void AE_SpritePool_SetFlip(AE_SpritePool* pool, AE_SpriteHandle handle, SDL_RendererFlip flip);
+
+/**
+ Sets the color of a pooled sprite
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param color The color the sprite will be set to
+ */
+void AE_SpritePool_SetColor(AE_SpritePool* pool, AE_SpriteHandle handle, AE_ColorBundle color);
+
+/**
+ Sets the alpha of a pooled sprite
+ 
+ @param pool The AE_SpritePool the sprite is in
+ @param handle The handle of the sprite
+ @param alpha The alpha the sprite will be set to
+ */
+void AE_SpritePool_SetAlpha(AE_SpritePool* pool, AE_SpriteHandle handle, Uint8 alpha);
+
+/**
+ Advances the animation loop of every looping sprite in a pool
+ 
+ @param pool The AE_SpritePool whose sprites will be animated
+ @param step The timestep the sprites will be animated at
+ */
+void AE_SpritePool_Update(AE_SpritePool* pool, float step);
+
+/**
+ Draws every sprite in a pool, except those culled by the last AE_SpritePool_Cull
+ 
+ @param pool The AE_SpritePool whose sprites will be drawn
+ @param renderer The renderer the sprites will be drawn on
+ @param batch The AE_SpriteBatch the sprites will be merged through (NULL to draw each one on its own)
+ @return Whether every sprite was drawn successfully or not
+ */
+SDL_bool AE_SpritePool_Render(AE_SpritePool* pool, SDL_Renderer* renderer, AE_SpriteBatch* batch);
+
+/**
+ Frees and destroys an AE_SpritePool and every sprite in it
+ 
+ @param pool The AE_SpritePool to be destroyed
+ */
+void AE_DestroySpritePool(AE_SpritePool* pool);
+
+//
+//
+//End: Sprite Pool Functions
+//
+//
+
+//
+//
+//Start: Bulk Sprite Animation Functions
+//
+//
+
+/**
+ The instruction sets the engine's bulk kernels can run on
+ */
+typedef enum {
+    AE_SIMD_AUTO,
+    AE_SIMD_SCALAR,
+    AE_SIMD_SSE2,
+    AE_SIMD_AVX2
+}AE_SimdLevel;
+
+/**
+ Sets the instruction set the engine's bulk kernels run on. Levels the CPU does not support fall back to the best one it does
+ 
+ @param level The instruction set to use (AE_SIMD_AUTO for the best one available)
+ */
+void AE_SetSimdLevel(AE_SimdLevel level);
+
+/**
+ Gets the instruction set the engine's bulk kernels currently run on
+ 
+ @return The instruction set in use
+ */
+AE_SimdLevel AE_GetSimdLevel();
+
+/**
+ Advances the animation loops of an array of sprites, wrapping each one exactly as AE_SpriteRender does. Every instruction set gives bit-identical results
+ 
+ @param currentFrames The current loop frame of each sprite, which will be advanced
+ @param frameSpeeds The frame speed of each sprite
+ @param frameCounts The number of frames in each sprite
+ @param count The number of sprites
+ @param step The timestep the sprites will be animated at
+ */
+void AE_Sprites_Advance(float* currentFrames, const float* frameSpeeds, const int* frameCounts, int count, float step);
+
+//
+//
+//End: Bulk Sprite Animation Functions
+//
+//
+
+//
+//
+//Start: Culling Functions
+//
+//
+
+/**
+ A view that sprites are tested against before they are drawn, along with how many were drawn and culled since the counts were last reset
+ */
+typedef struct {
+    SDL_Rect view;
+    int drawn;
+    int culled;
+}AE_Culler;
+
+/**
+ Gets a conservative bounding box of a rectangle drawn the way SDL_RenderCopyEx draws it
+ 
+ @param drawRect The rectangle before rotation
+ @param angle The angle in degrees the rectangle is rotated clockwise by
+ @param pivot The point the rectangle is rotated around, relative to drawRect (NULL for the center)
+ @param bounds Gets the smallest whole-pixel rectangle containing the rotated rectangle
+ */
+void AE_GetRotatedBounds(const SDL_Rect* drawRect, double angle, const SDL_Point* pivot, SDL_Rect* bounds);
+
+/**
+ Gets the bounds a sprite would cover if it were drawn at the given coordinates, including its scale, angle and pivot
+ 
+ @param sprite The sprite whose bounds will be found
+ @param x The x coordinate the sprite would be drawn at
+ @param y The y coordinate the sprite would be drawn at
+ @param bounds Gets the bounds of the sprite
+ */
+void AE_SpriteGetBounds(AE_Sprite* sprite, int x, int y, SDL_Rect* bounds);
+
+/**
+ Sets up a culler with a view and zeroed counts
+ 
+ @param culler The AE_Culler to set up
+ @param view The view to cull against, in the same coordinates sprites are drawn at (a camera rect)
+ */
+void AE_Culler_SetView(AE_Culler* culler, const SDL_Rect* view);
+
+/**
+ Sets up a culler with a renderer's current viewport and zeroed counts
+ 
+ @param culler The AE_Culler to set up
+ @param renderer The renderer whose viewport will be culled against
+ */
+void AE_Culler_SetViewFromRenderer(AE_Culler* culler, SDL_Renderer* renderer);
+
+/**
+ Zeroes a culler's drawn and culled counts, for the start of a new frame
+ 
+ @param culler The AE_Culler whose counts will be reset
+ */
+void AE_Culler_ResetCounts(AE_Culler* culler);
+
+/**
+ Tests whether a sprite drawn at the given coordinates would be seen, and counts it as drawn or culled
+ 
+ @param culler The AE_Culler the sprite will be tested against
+ @param sprite The sprite to be tested
+ @param x The x coordinate the sprite would be drawn at
+ @param y The y coordinate the sprite would be drawn at
+ @return Whether the sprite would be seen or not
+ */
+SDL_bool AE_Culler_TestSprite(AE_Culler* culler, AE_Sprite* sprite, int x, int y);
+
+/**
+ Tests a list of sprites against a culler in one pass, counting each one as drawn or culled
+ 
+ @param culler The AE_Culler the sprites will be tested against
+ @param sprites The sprites to be tested
+ @param positions The coordinates each sprite would be drawn at
+ @param count The number of sprites
+ @param visible Gets whether each sprite would be seen (1) or not (0)
+ @return The number of sprites that would be seen
+ */
+int AE_Culler_CullSprites(AE_Culler* culler, AE_Sprite** sprites, const SDL_Point* positions, int count, Uint8* visible);
+
+/**
+ Tests every sprite in a pool against a culler in one pass. Sprites that would not be seen are skipped by AE_SpritePool_Render until the pool is culled again
+ 
+ @param pool The AE_SpritePool whose sprites will be tested
+ @param culler The AE_Culler the sprites will be tested against (NULL to mark every sprite as seen)
+ @return The number of sprites in the pool that would be seen
+ */
+int AE_SpritePool_Cull(AE_SpritePool* pool, AE_Culler* culler);
+
+/**
+ Gets the number of sprites counted as drawn since the culler's counts were last reset
+ 
+ @param culler The AE_Culler whose count will be retrieved
+ @return The number of drawn sprites
+ */
+int AE_Culler_GetDrawn(AE_Culler* culler);
+
+/**
+ Gets the number of sprites counted as culled since the culler's counts were last reset
+ 
+ @param culler The AE_Culler whose count will be retrieved
+ @return The number of culled sprites
+ */
+int AE_Culler_GetCulled(AE_Culler* culler);
+
+//
+//
+//End: Culling Functions
+//
+//
+
+//
+//
+//Start: Spatial Hash Functions
+//
+//
+
+typedef Uint32 AE_SpatialHandle;
+
+#define AE_SPATIALHANDLE_INVALID 0
+
+/**
+ A uniform grid of points, hashed by cell so only occupied cells take up memory, for finding nearby points without testing every pair
+ */
+typedef struct {
+    float cellSize;
+    float inverseCellSize;
+    int count;
+    int capacity;
+    
+    float* x;
+    float* y;
+    void** data;
+    Sint32* cellX;
+    Sint32* cellY;
+    Uint32* bucket;
+    Uint32* next;
+    Uint32* previous;
+    
+    Uint32* slotGeneration;
+    Uint32* freeSlots;
+    int freeSlotCount;
+    int slotCount;
+    
+    Uint32* bucketHeads;
+    int bucketCount;
+    
+    float* nearestDistances;
+    int nearestCapacity;
+}AE_SpatialHash;
+
+/**
+ Creates a new, empty AE_SpatialHash
+ 
+ @param cellSize The width and height of a grid cell (about the most common query radius works best)
+ @param capacity The number of points the hash will have room for before it needs to grow (0 or less for the default)
+ @return The new AE_SpatialHash, or NULL if it could not be created
+ */
+AE_SpatialHash* AE_CreateSpatialHash(float cellSize, int capacity);
+
+/**
+ Adds a point to a spatial hash
+ 
+ @param hash The AE_SpatialHash the point will be added to
+ @param x The x of the point
+ @param y The y of the point
+ @param data Anything the caller wants to keep with the point (such as the entity it belongs to)
+ @return The handle of the new point, or AE_SPATIALHANDLE_INVALID if it could not be added
+ */
+AE_SpatialHandle AE_SpatialHash_Insert(AE_SpatialHash* hash, float x, float y, void* data);
+
+/**
+ Moves a point in a spatial hash, only rehashing it if it moved into a different cell
+ 
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @param x The new x of the point
+ @param y The new y of the point
+ @return Whether the point was moved or not
+ */
+SDL_bool AE_SpatialHash_Move(AE_SpatialHash* hash, AE_SpatialHandle handle, float x, float y);
+
+/**
+ Removes a point from a spatial hash
+ 
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @return Whether the point was removed or not
+ */
+SDL_bool AE_SpatialHash_Remove(AE_SpatialHash* hash, AE_SpatialHandle handle);
+
+/**
+ Checks whether a handle still refers to a point in a spatial hash
+ 
+ @param hash The AE_SpatialHash the point would be in
+ @param handle The handle to be checked
+ @return Whether the handle is valid or not
+ */
+SDL_bool AE_SpatialHash_IsValid(AE_SpatialHash* hash, AE_SpatialHandle handle);
+
+/**
+ Gets the position of a point in a spatial hash
+ 
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @param x Gets the x of the point
+ @param y Gets the y of the point
+ @return Whether the handle was valid or not
+ */
+SDL_bool AE_SpatialHash_GetPosition(AE_SpatialHash* hash, AE_SpatialHandle handle, float* x, float* y);
+
+/**
+ Gets the data kept with a point in a spatial hash
+ 
+ @param hash The AE_SpatialHash the point is in
+ @param handle The handle of the point
+ @return The data given when the point was inserted, or NULL if the handle is not valid
+ */
+void* AE_SpatialHash_GetData(AE_SpatialHash* hash, AE_SpatialHandle handle);
+
+/**
+ Gets the number of points in a spatial hash
+ 
+ @param hash The AE_SpatialHash whose points will be counted
+ @return The number of points in the hash
+ */
+int AE_SpatialHash_GetCount(AE_SpatialHash* hash);
+
+/**
+ Finds every point within a distance of a position
+ 
+ @param hash The AE_SpatialHash to be searched
+ @param x The x of the position
+ @param y The y of the position
+ @param radius The largest distance from the position a point can be at
+ @param results Gets the handles of the points found, in no particular order (may be NULL if maxResults is 0)
+ @param maxResults The most handles that will be written to results
+ @return The number of points found, which may be more than maxResults
+ */
+int AE_SpatialHash_QueryRadius(AE_SpatialHash* hash, float x, float y, float radius, AE_SpatialHandle* results, int maxResults);
+
+/**
+ Finds every point inside a rectangle
+ 
+ @param hash The AE_SpatialHash to be searched
+ @param x The x of the rectangle
+ @param y The y of the rectangle
+ @param width The width of the rectangle
+ @param height The height of the rectangle
+ @param results Gets the handles of the points found, in no particular order (may be NULL if maxResults is 0)
+ @param maxResults The most handles that will be written to results
+ @return The number of points found, which may be more than maxResults
+ */
+int AE_SpatialHash_QueryRect(AE_SpatialHash* hash, float x, float y, float width, float height, AE_SpatialHandle* results, int maxResults);
+
+/**
+ Finds the points nearest to a position
+ 
+ @param hash The AE_SpatialHash to be searched
+ @param x The x of the position
+ @param y The y of the position
+ @param k The number of points to find
+ @param results Gets the handles of the points found, nearest first
+ @param distances Gets the distance of each point found (NULL if not needed)
+ @return The number of points found, which is only less than k if the hash has fewer than k points
+ */
+int AE_SpatialHash_QueryNearest(AE_SpatialHash* hash, float x, float y, int k, AE_SpatialHandle* results, float* distances);
+
+/**
+ Frees and destroys an AE_SpatialHash
+ 
+ @param hash The AE_SpatialHash to be destroyed
+ */
+void AE_DestroySpatialHash(AE_SpatialHash* hash);
+
+//
+//
+//End: Spatial Hash Functions
+//
+//
+
+//
+//
+//Start: Glyph Cache Text Functions
+//
+//
+
+/**
+ A character rasterized into a glyph cache page
+ */
+typedef struct {
+    Uint32 codepoint;
+    AE_LinkedTexture* page;
+    SDL_Rect rect;
+    int advance;
+}AE_Glyph;
+
+/**
+ The glyphs of one font (at the size it was opened with) in one style, rasterized once into shared pages so text can be drawn every frame without making textures
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    int style;
+    int pageSize;
+    int fontHeight;
+    int lineSkip;
+    
+    AE_LinkedTexture** pages;
+    int pageCount;
+    int shelfX;
+    int shelfY;
+    int shelfHeight;
+    
+    AE_Glyph* glyphs;
+    int glyphCount;
+    int glyphCapacity;
+    
+    int* table;
+    int tableCapacity;
+}AE_GlyphCache;
+
+/**
+ Creates a new, empty glyph cache for a font and style
+ 
+ @param renderer The renderer the text will be drawn on
+ @param font The font the glyphs will be rasterized from, which must stay open as long as the cache exists
+ @param style The TTF_STYLE flags the glyphs will be rasterized with
+ @param pageSize The width and height of each glyph page (0 or less for the default)
+ @return The new AE_GlyphCache, or NULL if it could not be created
+ */
+AE_GlyphCache* AE_CreateGlyphCache(SDL_Renderer* renderer, TTF_Font* font, int style, int pageSize);
+
+/**
+ Rasterizes characters ahead of time so the first frame that draws them doesn't have to
+ 
+ @param cache The AE_GlyphCache the characters will be added to
+ @param characters A UTF-8 string of the characters to be added
+ @return Whether every character was added or not
+ */
+SDL_bool AE_GlyphCache_Preload(AE_GlyphCache* cache, const char* characters);
+
+/**
+ Draws text with kerning, rasterizing any characters the cache doesn't have yet
+ 
+ @param cache The AE_GlyphCache the text will be drawn from
+ @param batch The AE_SpriteBatch the glyphs will be merged through (NULL to draw each one on its own)
+ @param text The UTF-8 text to be drawn, where '\n' starts a new line
+ @param x The x of the top-left corner of the text
+ @param y The y of the top-left corner of the text
+ @param textColor The color of the text
+ @return Whether every glyph was drawn successfully or not
+ */
+SDL_bool AE_GlyphCache_RenderText(AE_GlyphCache* cache, AE_SpriteBatch* batch, const char* text, int x, int y, SDL_Color textColor);
+
+/**
+ Measures the size text would be drawn at, with kerning
+ 
+ @param cache The AE_GlyphCache the text would be drawn from
+ @param text The UTF-8 text to be measured, where '\n' starts a new line
+ @param width Gets the width of the widest line (NULL if not needed)
+ @param height Gets the height of every line together (NULL if not needed)
+ @return Whether every character could be measured or not
+ */
+SDL_bool AE_GlyphCache_MeasureText(AE_GlyphCache* cache, const char* text, int* width, int* height);
+
+/**
+ Gets the number of glyph pages a cache has made
+ 
+ @param cache The AE_GlyphCache whose pages will be counted
+ @return The number of pages
+ */
+int AE_GlyphCache_GetPageCount(AE_GlyphCache* cache);
+
+/**
+ Frees and destroys an AE_GlyphCache and its pages (the font is left open)
+ 
+ @param cache The AE_GlyphCache to be destroyed
+ */
+void AE_DestroyGlyphCache(AE_GlyphCache* cache);
+
+//
+//
+//End: Glyph Cache Text Functions
+//
+//
+
+//
+//
+//Start: Timer functions
+//
+//
+
+typedef struct {
+    Uint32 startTime;
+    Uint32 pauseTime;
+    SDL_bool isPaused;
+    SDL_bool isStarted;
+}AE_Timer;
+
+/**
+ Creates a new AE_Timer
+ 
+ @return A pointer to the new AE_Timer
+ */
+AE_Timer* AE_Create_Timer();
+
+/**
+ Resets an AE_Timer held by value, so timers can live inside other objects without an allocation of their own
+ 
+ @param timer The AE_Timer to reset to a stopped timer
+ */
+void AE_FillTimer(AE_Timer* timer);
+
+/**
+ Frees and destroys an AE_Timer made with AE_Create_Timer. AE_Timer comes straight from SDL_malloc rather than the engine's allocator, so freeing it with SDL_free stays valid
+ 
+ @param timer The AE_Timer to be destroyed
+ */
+void AE_DestroyTimer(AE_Timer* timer);
+
+/**
+ Starts (and unpauses) an AE_Timer
+ 
+ @param timer The timer to start
+ */
+void AE_Timer_Start(AE_Timer* timer);
+
+/**
+ Pauses an AE_Timer
+ 
+ @param timer The AE_Timer to pause
+ */
+void AE_Timer_Pause(AE_Timer* timer);
+
+/**
+ Resumes a paused AE_Timer
+ 
+ @param timer The AE_Timer to resume
+ */
+void AE_Timer_Resume(AE_Timer* timer);
+
+/**
+ Stops a paused AE_Timer
+ 
+ @param timer The AE_Timer to stop
+ */
+void AE_Timer_Stop(AE_Timer* timer);
+
+/**
+ Gets the amount of time in an AE_Timer
+ 
+ @param timer The AE_Timer to get the time from
+ @return The current time on the AE_Timer
+ */
+Uint32 AE_Timer_GetTime(AE_Timer* timer);
+
+/**
+ Returns whether an AE_Timer is paused or not
+ 
+ @param timer The AE_Timer to be determined whether it is paused or not
+ @return Whether the AE_Timer is paused or not
+ */
+SDL_bool AE_Timer_IsPaused(AE_Timer* timer);
+
+/**
+ Returns whether an AE_Timer is started
+ 
+ @param timer The AE_Timer to determine whether it is started or not
+ @return Whether the AE_Timer is started or not
+ */
+SDL_bool AE_Timer_IsStarted(AE_Timer* timer);
+
+//The number of recent laps an AE_PreciseTimer's statistics cover
+#define AE_PRECISETIMER_LAP_HISTORY 64
+
+/**
+ A timer on the performance counter, read in nanoseconds. It pauses, resumes and stops like an AE_Timer, and can record laps, keeping statistics on the most recent ones
+ */
+typedef struct {
+    Uint64 startCounter;
+    Uint64 pauseTicks;
+    Uint64 lapTicks;
+    SDL_bool isPaused;
+    SDL_bool isStarted;
+    Uint64 lapCount;
+    Uint64 laps[AE_PRECISETIMER_LAP_HISTORY];
+    Uint64 lapHistoryTotal;
+}AE_PreciseTimer;
+
+/**
+ Statistics on the most recent laps of an AE_PreciseTimer, in nanoseconds
+ */
+typedef struct {
+    Uint64 lapCount;
+    Uint64 last;
+    Uint64 min;
+    Uint64 average;
+    Uint64 max;
+}AE_PreciseTimerStats;
+
+/**
+ Creates a new AE_PreciseTimer
+ 
+ @return A pointer to the new AE_PreciseTimer
+ */
+AE_PreciseTimer* AE_Create_PreciseTimer();
+
+/**
+ Resets an AE_PreciseTimer held by value to a stopped timer with no laps
+ 
+ @param timer The AE_PreciseTimer to reset
+ */
+void AE_FillPreciseTimer(AE_PreciseTimer* timer);
+
+/**
+ Frees and destroys an AE_PreciseTimer made with AE_Create_PreciseTimer
+ 
+ @param timer The AE_PreciseTimer to be destroyed
+ */
+void AE_DestroyPreciseTimer(AE_PreciseTimer* timer);
+
+/**
+ Starts (and unpauses) an AE_PreciseTimer
+ 
+ @param timer The AE_PreciseTimer to start
+ */
+void AE_PreciseTimer_Start(AE_PreciseTimer* timer);
+
+/**
+ Pauses an AE_PreciseTimer
+ 
+ @param timer The AE_PreciseTimer to pause
+ */
+void AE_PreciseTimer_Pause(AE_PreciseTimer* timer);
+
+/**
+ Resumes a paused AE_PreciseTimer
+ 
+ @param timer The AE_PreciseTimer to resume
+ */
+void AE_PreciseTimer_Resume(AE_PreciseTimer* timer);
+
+/**
+ Stops an AE_PreciseTimer. Its lap statistics are kept until AE_PreciseTimer_ResetStats
+ 
+ @param timer The AE_PreciseTimer to stop
+ */
+void AE_PreciseTimer_Stop(AE_PreciseTimer* timer);
+
+/**
+ Gets the time on an AE_PreciseTimer, not counting time spent paused. This is the split time: it carries on through laps
+ 
+ @param timer The AE_PreciseTimer to get the time from
+ @return The time in nanoseconds
+ */
+Uint64 AE_PreciseTimer_GetTime(AE_PreciseTimer* timer);
+
+/**
+ Gets the time on an AE_PreciseTimer since its last lap (or since it started, before the first lap)
+ 
+ @param timer The AE_PreciseTimer to get the lap time from
+ @return The time in nanoseconds
+ */
+Uint64 AE_PreciseTimer_GetLapTime(AE_PreciseTimer* timer);
+
+/**
+ Ends the current lap of an AE_PreciseTimer and starts the next, adding the lap to the timer's statistics
+ 
+ @param timer The AE_PreciseTimer whose lap will be ended
+ @return The length of the lap in nanoseconds (0 if the timer isn't started)
+ */
+Uint64 AE_PreciseTimer_Lap(AE_PreciseTimer* timer);
+
+/**
+ Gets the statistics on the most recent laps of an AE_PreciseTimer
+ 
+ @param timer The AE_PreciseTimer whose statistics will be retrieved
+ @return The AE_PreciseTimerStats of the timer's recent laps (all zero before the first lap)
  */
-void AE_FillSprite(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int reference_x, int reference_y, int frameCount, int width, int height, int pivot_x, int pivot_y);
+AE_PreciseTimerStats AE_PreciseTimer_GetStats(AE_PreciseTimer* timer);
 
 /**
- Resets the frame sprite sheet
+ Forgets the laps an AE_PreciseTimer has recorded
  
- @param sprite The AE_Sprite whose spritesheet will be reset
- @param spriteSheet The spritesheet that the AE_Sprite will now reference
- @param frameCount The number of frames in the sprite
- @param reference_x The x of the desired sprite on the spritesheet
- @param reference_y The y of the desired sprite on the spritesheet
- @param frame_width The width of the new frames
- @param frame_height The height of the new frames
- @param dataToKeep Whether to keep the previous width or height, or neither
+ @param timer The AE_PreciseTimer whose statistics will be reset
  */
-void AE_SpriteSetSpriteSheet(AE_Sprite* sprite, AE_LinkedTexture* spriteSheet, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep);
+void AE_PreciseTimer_ResetStats(AE_PreciseTimer* timer);
 
 /**
- Sets the number of frames in a sprite, and creates an array of frames for the sprite
+ Returns whether an AE_PreciseTimer is paused or not
  
- @param sprite The sprite whose frame count will be expanded
- @param frameCount The number of sprite frames
- @param reference_x The x of the sprite on its spritesheet
- @param reference_y The y of the sprite on its spritesheet
+ @param timer The AE_PreciseTimer to be determined whether it is paused or not
+ @return Whether the AE_PreciseTimer is paused or not
  */
-void AE_SpriteSetFrames(AE_Sprite* sprite, int frameCount, int reference_x, int reference_y, int frame_width, int frame_height, int dataToKeep);
+SDL_bool AE_PreciseTimer_IsPaused(AE_PreciseTimer* timer);
 
 /**
- Sets the current pivot
+ Returns whether an AE_PreciseTimer is started
  
- @param sprite The sprite whose pivot will be set
- @param pivot_x The x of the new pivot
- @param pivot_y The y of the new pivot
- @param dataToKeep Which pivot point attributes will be overwritten: x, y, both, or sets the pivot to the default position (centerpoint)
+ @param timer The AE_PreciseTimer to determine whether it is started or not
+ @return Whether the AE_PreciseTimer is started or not
  */
-void AE_SpriteSetPivot(AE_Sprite* sprite, int pivot_x, int pivot_y, int dataToKeep);
+SDL_bool AE_PreciseTimer_IsStarted(AE_PreciseTimer* timer);
+
+//
+//
+//End: Timer Functions
+//
+//
+
+//
+//
+//Start: Game Loop Functions
+//
+//
 
 /**
- Sets the sprite angle
+ Advances a game's simulation by one fixed step
  
- @param sprite The sprite whose angle will be set
- @param angle The angle of the sprite
+ @param userdata The userdata given to the AE_GameLoop
+ @param step The length of the step in seconds, the same every call
+ @return Whether the loop should keep running or not
  */
-void AE_SpriteSetAngle(AE_Sprite* sprite, double angle);
+typedef SDL_bool (*AE_UpdateCallback)(void* userdata, double step);
 
 /**
- Sets the rendererflip of the sprite
+ Draws a game between two simulation steps
  
- @param sprite The sprite whose rendererflip will be set
- @param flip The desired rendererflip type
+ @param userdata The userdata given to the AE_GameLoop
+ @param alpha How far the simulation has got toward the next step, from 0 to 1, for blending between the last two simulated states
+ @param frameTime The seconds since the last frame was drawn, which can be passed to AE_SpriteRender as its step
  */
-void AE_SpriteSetFlip(AE_Sprite* sprite, SDL_RendererFlip flip);
+typedef void (*AE_RenderCallback)(void* userdata, float alpha, float frameTime);
 
 /**
- Sets the sprite scale
- 
- @param sprite The sprite whose scale will be set
- @param x_scale The new scale on the x axis
- @param y_scale The new scale on the y axis
- @param dataToKeep Which scale attributes will be overwritten: x scale, y scale, both, or sets the both scales to the default size (1)
+ How the last frame of an AE_GameLoop spent its time. Times are in seconds, droppedTime is simulation time skipped because the updates fell too far behind, and load is the share of the frame spent updating and rendering (above 1 means the game can't keep up)
  */
-void AE_SpriteSetScale(AE_Sprite* sprite, float x_scale, float y_scale, int dataToKeep);
+typedef struct {
+    int updates;
+    float alpha;
+    double frameTime;
+    double simulationTime;
+    double renderTime;
+    double droppedTime;
+    double load;
+}AE_GameLoopStats;
 
 /**
- Gets the current loop frame of the sprite
- 
- @param sprite The sprite whose frame will be retrieved
- @return The current loop frame
+ Runs updates at a fixed rate and renders as often as it is called, so the simulation is the same at any frame rate. Time the updates can't keep up with is dropped rather than carried over, so a slow frame can't snowball into ever slower frames
  */
-int AE_SpriteGetSavedFrame(AE_Sprite* sprite);
+typedef struct {
+    AE_UpdateCallback update;
+    AE_RenderCallback render;
+    void* userdata;
+    double updateStep;
+    int maxUpdates;
+    double frameLimit;
+    double accumulator;
+    Uint64 lastCounter;
+    SDL_bool isRunning;
+    Uint64 updateCount;
+    AE_GameLoopStats stats;
+}AE_GameLoop;
 
 /**
- Sets the current loop frame of the sprite
+ Creates a new AE_GameLoop, which allows up to 8 updates per frame and doesn't limit the frame rate
  
- @param sprite The sprite whose current loop frame will be set
- @param desiredFrame The frame the loop will be set to
+ @param updateRate The number of updates per second
+ @param update The callback that advances the simulation
+ @param render The callback that draws a frame (can be NULL)
+ @param userdata A pointer passed to both callbacks
+ @return The new AE_GameLoop, or NULL if it could not be created
  */
-void AE_SpriteSetSavedFrame(AE_Sprite* sprite, int desiredFrame);
+AE_GameLoop* AE_CreateGameLoop(double updateRate, AE_UpdateCallback update, AE_RenderCallback render, void* userdata);
 
 /**
- Sets the frame speed of the sprite
+ Sets the most updates an AE_GameLoop will run in one frame before dropping the simulation time it is behind by
  
- @param sprite The sprite whose frame speed will be set
- @param frameSpeed The speed the sprite will be set to
+ @param loop The AE_GameLoop whose limit will be set
+ @param maxUpdates The most updates per frame (at least 1)
  */
-void AE_SpriteSetFrameSpeed(AE_Sprite* sprite, float frameSpeed);
+void AE_GameLoop_SetMaxUpdates(AE_GameLoop* loop, int maxUpdates);
 
 /**
- Sets the color of the sprite
+ Sets the highest frame rate an AE_GameLoop renders at, sleeping out the rest of each frame. Not needed if the renderer waits for vsync
  
- @param sprite The AE_Sprite whose color will be set
- @param color The color the AE_Sprite will be set to
- @param dataToKeep Which preexisting color values to keep (red, green, blue) or set the color values to default color white
+ @param loop The AE_GameLoop whose frame rate will be limited
+ @param framesPerSecond The most frames per second (0 or less for no limit)
  */
-void AE_SpriteSetColor(AE_Sprite* sprite, AE_ColorBundle* color, int dataToKeep);
+void AE_GameLoop_SetFrameLimit(AE_GameLoop* loop, double framesPerSecond);
 
 /**
- Gets the color modulation of a sprite
+ Runs one frame of an AE_GameLoop: as many updates as the time since the last frame calls for, then a render. For games that drive their own outer loop
  
- @param sprite The AE_Sprite whose color will be retrieved
- @return A pointer to an AE_ColorBundle containing the colors of the AE_Sprite
+ @param loop The AE_GameLoop to run a frame of
+ @return Whether the loop should keep running or not
  */
-AE_ColorBundle* AE_SpriteGetColor(AE_Sprite* sprite);
+SDL_bool AE_GameLoop_Frame(AE_GameLoop* loop);
 
 /**
- Sets the color of the sprite
+ Runs frames of an AE_GameLoop until an update returns SDL_FALSE or AE_GameLoop_Stop is called
  
- @param sprite The AE_Sprite whose alpha will be set
- @param alpha The alpha the AE_Sprite will be set to
+ @param loop The AE_GameLoop to run
  */
-void AE_SpriteSetAlpha(AE_Sprite* sprite, Uint8 alpha);
+void AE_GameLoop_Run(AE_GameLoop* loop);
 
 /**
- Gets the alpha modulation of a sprite
+ Stops an AE_GameLoop after the frame it is in
  
- @param sprite The AE_Sprite whose alpha will be retrieved
- @return The alpha modulation of the sprite
+ @param loop The AE_GameLoop to stop
  */
-Uint8 AE_SpriteGetAlpha(AE_Sprite* sprite);
-
+void AE_GameLoop_Stop(AE_GameLoop* loop);
 
 /**
- Renders the sprite on the given renderer
+ Gets how the last frame of an AE_GameLoop spent its time
  
- @param sprite The sprite to be rendered
- @param renderer The renderer the sprite will be rendered on
- @param x The x coordinate the sprite will be drawn at
- @param y The y coordinate the sprite will be drawn at
- @param currentFrame The current frame the sprite will be drawn on (-1 or less for an animation loop)
- @param step The timestep the sprite will be drawn at
- @return Whether the sprite was successfully rendered or not
+ @param loop The AE_GameLoop whose frame will be reported
+ @return The AE_GameLoopStats of the last frame
  */
-SDL_bool AE_SpriteRender(AE_Sprite* sprite, SDL_Renderer* renderer, int x, int y, int currentFrame, float step);
+AE_GameLoopStats AE_GameLoop_GetStats(AE_GameLoop* loop);
 
 /**
- Frees and destroys an AE_Sprite
+ Frees and destroys an AE_GameLoop
  
- @param sprite The sprite to be destroyed
+ @param loop The AE_GameLoop to be destroyed
  */
-void AE_DestroySprite(AE_Sprite* sprite);
+void AE_DestroyGameLoop(AE_GameLoop* loop);
 
 //
 //
-//End: Sprites and Sprite Functions
+//End: Game Loop Functions
 //
 //
 
 //
 //
-//Start: Timer functions
+//Start: Profiler Functions
 //
 //
 
-typedef struct {
-    Uint32 startTime;
-    Uint32 pauseTime;
-    SDL_bool isPaused;
-    SDL_bool isStarted;
-}AE_Timer;
-
-/**
- Creates a new AE_Timer
- 
- @return A pointer to the new AE_Timer
- */
-AE_Timer* AE_Create_Timer();
-
-/**
- Starts (and unpauses) an AE_Timer
- 
- @param timer The timer to start
- */
-void AE_Timer_Start(AE_Timer* timer);
+//Builds with AE_PROFILE_ENABLED defined as 1 record profiling zones, in the engine and in any game code using the macros below. Otherwise the macros compile to nothing
+#ifndef AE_PROFILE_ENABLED
+#define AE_PROFILE_ENABLED 0
+#endif
+
+#if AE_PROFILE_ENABLED
+#define AE_PROFILE_BEGIN(name) AE_Profiler_Begin(name)
+#define AE_PROFILE_END() AE_Profiler_End()
+#define AE_PROFILE_FRAME() AE_Profiler_FrameMark()
+#else
+#define AE_PROFILE_BEGIN(name) ((void)0)
+#define AE_PROFILE_END() ((void)0)
+#define AE_PROFILE_FRAME() ((void)0)
+#endif
 
 /**
- Pauses an AE_Timer
- 
- @param timer The AE_Timer to pause
+ The time one profiling zone took over a frame, in nanoseconds. Self time leaves out the zones nested inside it
  */
-void AE_Timer_Pause(AE_Timer* timer);
+typedef struct {
+    const char* name;
+    Uint32 calls;
+    Uint64 totalTime;
+    Uint64 selfTime;
+    Uint64 maxTime;
+}AE_ProfilerZoneStats;
 
 /**
- Resumes a paused AE_Timer
+ Starts a profiling zone on the calling thread. Zones nest, and every one has to be ended on the thread that started it. Use AE_PROFILE_BEGIN so the zone compiles out of builds without profiling
  
- @param timer The AE_Timer to resume
+ @param name The name of the zone, which has to stay valid until the profile is written (a string literal)
  */
-void AE_Timer_Resume(AE_Timer* timer);
+void AE_Profiler_Begin(const char* name);
 
 /**
- Stops a paused AE_Timer
- 
- @param timer The AE_Timer to stop
+ Ends the calling thread's innermost profiling zone, recording it. Use AE_PROFILE_END so the zone compiles out of builds without profiling
  */
-void AE_Timer_Stop(AE_Timer* timer);
+void AE_Profiler_End(void);
 
 /**
- Gets the amount of time in an AE_Timer
- 
- @param timer The AE_Timer to get the time from
- @return The current time on the AE_Timer
+ Marks the end of a frame, recording it as a zone of its own and totalling up every zone ended on any thread since the last mark. Call once per frame from the main thread, or use AE_PROFILE_FRAME (AE_GameLoop marks its own frames)
  */
-Uint32 AE_Timer_GetTime(AE_Timer* timer);
+void AE_Profiler_FrameMark(void);
 
 /**
- Returns whether an AE_Timer is paused or not
+ Gets the totals of each profiling zone over the last frame marked
  
- @param timer The AE_Timer to be determined whether it is paused or not
- @return Whether the AE_Timer is paused or not
+ @param output The array the totals will be written to, sorted by total time with the longest first
+ @param maxCount The number of totals the array has room for
+ @return The number of zones recorded in the frame, which may be more than maxCount
  */
-SDL_bool AE_Timer_IsPaused(AE_Timer* timer);
+int AE_Profiler_GetFrameStats(AE_ProfilerZoneStats* output, int maxCount);
 
 /**
- Returns whether an AE_Timer is started
+ Writes every zone still held in each thread's buffer to a Chrome trace / Perfetto JSON file
  
- @param timer The AE_Timer to determine whether it is started or not
- @return Whether the AE_Timer is started or not
+ @param path The pathname of the file to write
+ @return Whether the file was written or not
  */
-SDL_bool AE_Timer_IsStarted(AE_Timer* timer);
+SDL_bool AE_Profiler_WriteTrace(const char* path);
 
 //
 //
-//End: Timer Functions
+//End: Profiler Functions
 //
 //
 
@@ -546,6 +3080,14 @@ SDL_bool AE_Timer_IsStarted(AE_Timer* timer);
 //
 //
 
+/**
+ The generators AE_PseudoRandomFromSeed_Int and AE_PseudoRandomFromSeed_Uint64 can use
+ */
+typedef enum {
+    AE_SEED_MODE_HASH,
+    AE_SEED_MODE_LEGACY
+}AE_SeedMode;
+
 /**
  Blends two Uint8's together, based on the strength of the second Uint8 that should be used. To be used to combine individual R, G, or B channels
  
@@ -557,18 +3099,18 @@ SDL_bool AE_Timer_IsStarted(AE_Timer* timer);
 Uint8 AE_BlendColorChannel(Uint8 col1, Uint8 col2, Uint8 percentage);
 
 /**
- Gets a random number between two numbers
+ Gets a random number between two numbers from the calling thread's AE_Rng. Safe to call from any thread
  
  @param min The minimun number the output can be
- @param max The maximum number the output can be
+ @param max The number above the maximum the output can be
  @return The random number
  */
 int AE_Random(int min, int max);
 
 /**
- Gets a random seed number
+ Gets a random seed number from the calling thread's AE_Rng. Safe to call from any thread
  
- @return The random seed number
+ @return The random seed number, which is never 0
  */
 Uint64 AE_RandomSeed();
 
@@ -584,14 +3126,63 @@ Uint64 AE_RandomSeed();
 Uint64 AE_CreateFinalSeed(Uint64 seednum_1, Uint64 seednum_2, Uint64 seednum_3, Uint64 seednum_4);
 
 /**
- Gets a pseudorandom number between two numbers based on a given seed. Used for procedural generation: if given the same input numbers, the output will always be the same
+ Sets which generator AE_PseudoRandomFromSeed_Int and AE_PseudoRandomFromSeed_Uint64 use. Worlds saved with older versions of the engine need AE_SEED_MODE_LEGACY to be generated the same way again
+ 
+ @param mode The generator to use
+ */
+void AE_SetSeedMode(AE_SeedMode mode);
+
+/**
+ Gets which generator AE_PseudoRandomFromSeed_Int and AE_PseudoRandomFromSeed_Uint64 use
+ 
+ @return The generator in use
+ */
+AE_SeedMode AE_GetSeedMode(void);
+
+/**
+ Hashes a seed, a position and a set into a pseudorandom Uint64. Stateless, so any position can be generated in any order or on any thread with the same result
+ 
+ @param seed The seed number
+ @param x The x being generated
+ @param y The y being generated
+ @param set A value that gives a separate stream of numbers for the same x and y
+ @return The pseudorandom Uint64
+ */
+Uint64 AE_SeedHash(Uint64 seed, Uint64 x, Uint64 y, Uint64 set);
+
+/**
+ Hashes a seed, a position and a set into a pseudorandom double. Stateless, like AE_SeedHash
+ 
+ @param seed The seed number
+ @param x The x being generated
+ @param y The y being generated
+ @param set A value that gives a separate stream of numbers for the same x and y
+ @return The pseudorandom double, at least 0 and less than 1
+ */
+double AE_SeedHash_Double(Uint64 seed, Uint64 x, Uint64 y, Uint64 set);
+
+/**
+ Hashes a seed, a position and a set into a pseudorandom number between two numbers. This is what AE_PseudoRandomFromSeed_Int gives with AE_SEED_MODE_HASH, whatever the current seed mode
+ 
+ @param seed The seed number
+ @param x The x being generated
+ @param y The y being generated
+ @param set A value that gives a separate stream of numbers for the same x and y
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The pseudorandom number
+ */
+int AE_SeedHash_Int(Uint64 seed, Uint64 x, Uint64 y, Uint64 set, int min, int max);
+
+/**
+ Gets a pseudorandom number between two numbers based on a given seed. Used for procedural generation: if given the same input numbers, the output will always be the same. Negative coordinates give the same numbers as AE_PseudoRandomFromSeed_Uint64 does for the coordinates cast to Uint64
  
  @param seed The seed number to be manipulated
  @param x The x upon which the seed number will be manipulated
  @param y The y upon which the seed number will be manipulated
  @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
  @param min The min number the output can be
- @param max The max number the output can be
+ @param max The number above the max the output can be
  @return The pseudorandom number based on the seed, x, and y
  */
 int AE_PseudoRandomFromSeed_Int(Uint64 seed, int x, int y, Uint64 set, int min, int max);
@@ -604,7 +3195,7 @@ int AE_PseudoRandomFromSeed_Int(Uint64 seed, int x, int y, Uint64 set, int min,
  @param y The y upon which the seed number will be manipulated
  @param set A value that manipulates the outcome so that multiple different numbers can be generated for the same x and y
  @param min The min number the output can be
- @param max The max number the output can be
+ @param max The number above the max the output can be
  @return The pseudorandom number based on the seed, x, and y
  */
 int AE_PseudoRandomFromSeed_Uint64(Uint64 seed, Uint64 x, Uint64 y, Uint64 set, int min, int max);
@@ -683,4 +3274,199 @@ double AE_VectorLength(double x, double y);
 //
 //
 
+//
+//
+//Start: Random Number Generator Functions
+//
+//
+
+/**
+ The state of a xoshiro256** random number generator. Not safe to share between threads: give each thread its own, with AE_GetThreadRng or AE_Rng_Split
+ */
+typedef struct {
+    Uint64 state[4];
+}AE_Rng;
+
+/**
+ Seeds a random number generator, so it gives the same numbers every time it's seeded with the same seed
+ 
+ @param rng The AE_Rng to be seeded
+ @param seed The seed number
+ */
+void AE_SeedRng(AE_Rng* rng, Uint64 seed);
+
+/**
+ Gets the calling thread's own random number generator, creating it on first use. Each thread's generator is split from one shared generator, so no two threads ever get overlapping numbers
+ 
+ @return The calling thread's AE_Rng, or NULL if it couldn't be created
+ */
+AE_Rng* AE_GetThreadRng(void);
+
+/**
+ Gets the next random Uint64 from a random number generator
+ 
+ @param rng The AE_Rng to draw from
+ @return The random Uint64
+ */
+Uint64 AE_Rng_Next(AE_Rng* rng);
+
+/**
+ Gets a random whole number between two numbers, without the bias of taking a remainder
+ 
+ @param rng The AE_Rng to draw from
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The random number (min if min and max are the same)
+ */
+int AE_Rng_Range(AE_Rng* rng, int min, int max);
+
+/**
+ Gets a random float
+ 
+ @param rng The AE_Rng to draw from
+ @return The random float, at least 0 and less than 1
+ */
+float AE_Rng_Float(AE_Rng* rng);
+
+/**
+ Gets a random double
+ 
+ @param rng The AE_Rng to draw from
+ @return The random double, at least 0 and less than 1
+ */
+double AE_Rng_Double(AE_Rng* rng);
+
+/**
+ Fills an array with random Uint64's
+ 
+ @param rng The AE_Rng to draw from
+ @param output The array to be filled
+ @param count The number of Uint64's to fill
+ */
+void AE_Rng_Fill(AE_Rng* rng, Uint64* output, int count);
+
+/**
+ Fills an array with random whole numbers between two numbers, without the bias of taking a remainder
+ 
+ @param rng The AE_Rng to draw from
+ @param output The array to be filled
+ @param count The number of ints to fill
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ */
+void AE_Rng_FillRange(AE_Rng* rng, int* output, int count, int min, int max);
+
+/**
+ Fills an array with random floats, each at least 0 and less than 1
+ 
+ @param rng The AE_Rng to draw from
+ @param output The array to be filled
+ @param count The number of floats to fill
+ */
+void AE_Rng_FillFloat(AE_Rng* rng, float* output, int count);
+
+/**
+ Jumps a random number generator ahead by 2^128 numbers, as if AE_Rng_Next had been called that many times
+ 
+ @param rng The AE_Rng to jump
+ */
+void AE_Rng_Jump(AE_Rng* rng);
+
+/**
+ Splits off a new random number generator for another thread or worker. The new one carries on where the original was, and the original jumps ahead 2^128 numbers, so the two never overlap
+ 
+ @param rng The AE_Rng to split
+ @param output The AE_Rng to be filled with the split off generator
+ */
+void AE_Rng_Split(AE_Rng* rng, AE_Rng* output);
+
+//
+//
+//End: Random Number Generator Functions
+//
+//
+
+//
+//
+//Start: Noise Functions
+//
+//
+
+/**
+ The kinds of noise a noise field can be filled with
+ */
+typedef enum {
+    AE_NOISE_WHITE,
+    AE_NOISE_VALUE,
+    AE_NOISE_GRADIENT
+}AE_NoiseType;
+
+/**
+ What a noise field is generated from. Lattice noise (value and gradient) has a period, the width of a lattice cell in tiles, which is rounded down to a power of two no larger than 2^30. It is summed over octaves: each octave halves the period of the one before and is weighted by gain times the one before, and octaves whose period would fall below one tile are left out
+ */
+typedef struct {
+    AE_NoiseType type;
+    Uint64 seed;
+    Uint64 set;
+    int period;
+    int octaves;
+    float gain;
+}AE_NoiseSettings;
+
+/**
+ Fills noise settings with a seed and set, a period of 32 tiles, one octave and a gain of 0.5
+ 
+ @param settings The AE_NoiseSettings to be filled
+ @param type The kind of noise
+ @param seed The seed number the noise is generated from
+ @param set A value that gives different noise for the same seed and position
+ */
+void AE_FillNoiseSettings(AE_NoiseSettings* settings, AE_NoiseType type, Uint64 seed, Uint64 set);
+
+/**
+ Gets the noise at a single tile. This is the reference the noise fields match exactly
+ 
+ @param settings The AE_NoiseSettings the noise is generated from
+ @param x The x of the tile
+ @param y The y of the tile
+ @return The noise, from -1 to 1
+ */
+float AE_Noise_Sample(const AE_NoiseSettings* settings, Sint64 x, Sint64 y);
+
+/**
+ Fills a chunk of tiles with noise. The result is the same for any thread count and instruction set, so chunks can be regenerated exactly
+ 
+ @param output The row-major width by height buffer the noise will be written to
+ @param width The width of the chunk in tiles
+ @param height The height of the chunk in tiles
+ @param originX The x of the chunk's top left tile
+ @param originY The y of the chunk's top left tile
+ @param settings The AE_NoiseSettings the noise is generated from
+ @param threadCount The number of threads to split the rows between (0 or less for one per CPU, 1 for just the calling thread)
+ @return SDL_TRUE if the chunk was filled, SDL_FALSE if the arguments were invalid
+ */
+SDL_bool AE_NoiseField_Float(float* output, int width, int height, Sint64 originX, Sint64 originY, const AE_NoiseSettings* settings, int threadCount);
+
+/**
+ Fills a chunk of tiles with noise mapped onto whole numbers between min and max. White noise gives the same numbers AE_PseudoRandomFromSeed_Int does for each tile with AE_SEED_MODE_HASH. The result is the same for any thread count and instruction set
+ 
+ @param output The row-major width by height buffer the numbers will be written to
+ @param width The width of the chunk in tiles
+ @param height The height of the chunk in tiles
+ @param originX The x of the chunk's top left tile
+ @param originY The y of the chunk's top left tile
+ @param settings The AE_NoiseSettings the noise is generated from
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @param threadCount The number of threads to split the rows between (0 or less for one per CPU, 1 for just the calling thread)
+ @return SDL_TRUE if the chunk was filled, SDL_FALSE if the arguments were invalid or memory couldn't be allocated
+ */
+SDL_bool AE_NoiseField_Int(int* output, int width, int height, Sint64 originX, Sint64 originY, const AE_NoiseSettings* settings, int min, int max, int threadCount);
+
+//
+//
+//End: Noise Functions
+//
+//
+
 #endif /* arrental_engine_h */
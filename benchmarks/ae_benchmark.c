@@ -0,0 +1,1484 @@
+//
+//  ae_benchmark.c
+//  arrental_engine
+//
+//  Benchmarks for the engine's hot paths.
+//  Build alongside the engine, e.g.:
+//  cc -O2 -I.. ae_benchmark.c ../arrental_engine.c `sdl2-config --cflags --libs` -lSDL2_image -lSDL2_ttf -lm
+//
+//  Runs headless on SDL's dummy video driver and software renderer. Options:
+//  --json <path>        Where the results are written as JSON (ae_benchmark.json by default)
+//  --baseline <path>    Results from an earlier run to compare against, failing on regressions
+//  --tolerance <percent> How much worse than the baseline a result can be before it fails (10 by default)
+//  --font <path>        A TrueType font for the text benchmarks, which are skipped without one
+//
+
+#include "../arrental_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#define AE_BENCH_MAX_RESULTS 256
+
+/**
+ One measurement, kept so the whole run can be written out as JSON
+ */
+typedef struct {
+    char name[64];
+    double value;
+    const char* unit;
+    SDL_bool higherIsBetter;
+}AE_Bench_Result;
+
+static AE_Bench_Result AE_benchResults[AE_BENCH_MAX_RESULTS];
+static int AE_benchResultCount = 0;
+
+/**
+ Gets the number of nanoseconds between two performance counter readings
+ 
+ @param start The earlier reading
+ @param end The later reading
+ @return The nanoseconds between the readings
+ */
+static double AE_Bench_Nanoseconds(Uint64 start, Uint64 end)
+{
+    return (double)(end - start) * 1000000000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+/**
+ Records a measurement for the JSON results
+ 
+ @param value The measurement
+ @param unit The unit of the measurement
+ @param higherIsBetter Whether a higher value is an improvement (a rate) or a regression (a time)
+ @param nameFormat A printf style format for the name of the measurement, which has to be unique in the run
+ */
+static void AE_Bench_Record(double value, const char* unit, SDL_bool higherIsBetter, const char* nameFormat, ...)
+{
+    va_list arguments;
+    
+    if (AE_benchResultCount == AE_BENCH_MAX_RESULTS)
+    {
+        return;
+    }
+    AE_Bench_Result* result = &AE_benchResults[AE_benchResultCount++];
+    va_start(arguments, nameFormat);
+    SDL_vsnprintf(result->name, sizeof(result->name), nameFormat, arguments);
+    va_end(arguments);
+    result->value = value;
+    result->unit = unit;
+    result->higherIsBetter = higherIsBetter;
+}
+
+/**
+ Benchmarks AE_Sprites_Advance on every instruction set at a given sprite count, checking that each one matches the scalar results bit for bit
+ 
+ @param count The number of sprites to advance
+ @return Whether every instruction set matched the scalar results or not
+ */
+static SDL_bool AE_Bench_SpritesAdvance(int count)
+{
+    const AE_SimdLevel levels[] = {AE_SIMD_SCALAR, AE_SIMD_SSE2, AE_SIMD_AVX2};
+    const char* levelNames[] = {"scalar", "sse2", "avx2"};
+    const int iterations = SDL_max(1, 50000000 / count);
+    SDL_bool identical = SDL_TRUE;
+    double scalarTime = 0;
+    
+    float* start = SDL_malloc(sizeof(float) * count);
+    float* reference = SDL_malloc(sizeof(float) * count);
+    float* frames = SDL_malloc(sizeof(float) * count);
+    float* speeds = SDL_malloc(sizeof(float) * count);
+    int* frameCounts = SDL_malloc(sizeof(int) * count);
+    
+    //A mix of frame counts, speeds and starting frames, including single frame sprites
+    for (int i = 0; i<count; i++)
+    {
+        frameCounts[i] = 1 + (i % 12);
+        speeds[i] = 10.0f + (float)(i % 7) * 5.0f;
+        start[i] = (float)(i % frameCounts[i]);
+    }
+    
+    for (int level = 0; level<(int)SDL_arraysize(levels); level++)
+    {
+        AE_SetSimdLevel(levels[level]);
+        
+        //Skip instruction sets the CPU can't run
+        if (AE_GetSimdLevel() != levels[level])
+        {
+            continue;
+        }
+        
+        SDL_memcpy(frames, start, sizeof(float) * count);
+        Uint64 startTime = SDL_GetPerformanceCounter();
+        for (int iteration = 0; iteration<iterations; iteration++)
+        {
+            AE_Sprites_Advance(frames, speeds, frameCounts, count, 1.0f / 60.0f);
+        }
+        double time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / iterations;
+        
+        if (levels[level] == AE_SIMD_SCALAR)
+        {
+            scalarTime = time;
+            SDL_memcpy(reference, frames, sizeof(float) * count);
+        }
+        else if (SDL_memcmp(reference, frames, sizeof(float) * count) != 0)
+        {
+            identical = SDL_FALSE;
+        }
+        
+        printf("sprites_advance %-6s %7d sprites: %10.1f ns/frame, %6.2f ns/sprite, %5.2fx scalar\n", levelNames[level], count, time, time / count, scalarTime / time);
+        AE_Bench_Record(time / count, "ns/sprite", SDL_FALSE, "sprites_advance.%s.%d", levelNames[level], count);
+    }
+    AE_SetSimdLevel(AE_SIMD_AUTO);
+    
+    SDL_free(start);
+    SDL_free(reference);
+    SDL_free(frames);
+    SDL_free(speeds);
+    SDL_free(frameCounts);
+    
+    return identical;
+}
+
+/**
+ Benchmarks radius queries on an AE_SpatialHash against testing every point with AE_PointDistance, checking that both find the same points
+ 
+ @param count The number of points
+ @return Whether both searches found the same number of points for every query or not
+ */
+static SDL_bool AE_Bench_SpatialHash(int count)
+{
+    const int queryCount = 1000;
+    const int radius = 50;
+    //About 20 points within the radius of each query, whatever the point count
+    const int worldSize = (int)SDL_sqrt((double)count * 3.14159 * radius * radius / 20.0);
+    SDL_bool identical = SDL_TRUE;
+    Uint64 bruteFound = 0;
+    Uint64 hashFound = 0;
+    
+    int* x = SDL_malloc(sizeof(int) * count);
+    int* y = SDL_malloc(sizeof(int) * count);
+    AE_SpatialHandle* results = SDL_malloc(sizeof(AE_SpatialHandle) * count);
+    
+    srand(count);
+    for (int i = 0; i<count; i++)
+    {
+        x[i] = rand() % worldSize;
+        y[i] = rand() % worldSize;
+    }
+    
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    AE_SpatialHash* hash = AE_CreateSpatialHash((float)radius, count);
+    for (int i = 0; i<count; i++)
+    {
+        AE_SpatialHash_Insert(hash, (float)x[i], (float)y[i], NULL);
+    }
+    double buildTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter());
+    
+    //The first queryCount points are the query positions for both searches
+    startTime = SDL_GetPerformanceCounter();
+    for (int query = 0; query<queryCount; query++)
+    {
+        for (int i = 0; i<count; i++)
+        {
+            if (AE_PointDistance(x[query], y[query], x[i], y[i]) < radius)
+            {
+                bruteFound++;
+            }
+        }
+    }
+    double bruteTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / queryCount;
+    
+    startTime = SDL_GetPerformanceCounter();
+    for (int query = 0; query<queryCount; query++)
+    {
+        //AE_PointDistance truncates, so "less than radius" is the same as "at most just under radius"
+        hashFound += AE_SpatialHash_QueryRadius(hash, (float)x[query], (float)y[query], (float)radius - 0.001f, results, count);
+    }
+    double hashTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / queryCount;
+    
+    if (bruteFound != hashFound)
+    {
+        identical = SDL_FALSE;
+    }
+    
+    printf("spatial_hash %7d points: build %10.1f us, brute force %10.1f ns/query, hash %8.1f ns/query, %7.1fx brute force\n", count, buildTime / 1000.0, bruteTime, hashTime, bruteTime / hashTime);
+    AE_Bench_Record(buildTime / 1000.0, "us", SDL_FALSE, "spatial_hash.%d.build", count);
+    AE_Bench_Record(hashTime, "ns/query", SDL_FALSE, "spatial_hash.%d.query", count);
+    
+    AE_DestroySpatialHash(hash);
+    SDL_free(x);
+    SDL_free(y);
+    SDL_free(results);
+    
+    return identical;
+}
+
+/**
+ The shared state of the threads in a linkedTexture contention run
+ */
+typedef struct {
+    AE_LinkedTexture* sheet;
+    AE_SpriteDef* definition;
+    int iterations;
+}AE_Bench_ContentionState;
+
+/**
+ Creates and destroys sprites sharing one definition and sheet as fast as it can, keeping a window of them alive so joins and leaves interleave
+
+ @param data The AE_Bench_ContentionState shared by the threads
+ @return 0
+ */
+static int AE_Bench_ContentionWorker(void* data)
+{
+    AE_Bench_ContentionState* state = data;
+    AE_Sprite* window[64] = {NULL};
+    
+    for (int i = 0; i<state->iterations; i++)
+    {
+        int slot = i % (int)SDL_arraysize(window);
+        if (window[slot] != NULL)
+        {
+            AE_LinkedTexture_Leave(state->sheet, window[slot]);
+            AE_DestroySprite(window[slot]);
+        }
+        window[slot] = AE_CreateSpriteFromDef(state->definition);
+        
+        //Also reference the sheet directly, the way a pool or atlas would
+        AE_LinkedTexture_Join(state->sheet, window[slot]);
+    }
+    for (int slot = 0; slot<(int)SDL_arraysize(window); slot++)
+    {
+        if (window[slot] != NULL)
+        {
+            AE_LinkedTexture_Leave(state->sheet, window[slot]);
+            AE_DestroySprite(window[slot]);
+        }
+    }
+    return 0;
+}
+
+/**
+ Stresses linkedTexture and sprite definition reference counting from several threads at once, then checks the counts came back to where they started and that a deferred destroy goes through once the threads are done
+
+ @param threadCount The number of threads creating and destroying sprites
+ @param iterations The number of sprites each thread creates
+ @return Whether every reference was accounted for and the sheet was destroyed or not
+ */
+static SDL_bool AE_Bench_LinkedTextureContention(int threadCount, int iterations)
+{
+    AE_Bench_ContentionState state;
+    SDL_Thread* threads[64];
+    SDL_bool success = SDL_TRUE;
+    int destroyed = 0;
+    
+    threadCount = SDL_min(threadCount, (int)SDL_arraysize(threads));
+    state.sheet = AE_CreateLinkedTexture(NULL);
+    state.definition = AE_CreateSpriteDef(state.sheet, 0, 0, 8, 16, 16, 8, 8, 30);
+    state.iterations = iterations;
+    
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    for (int i = 0; i<threadCount; i++)
+    {
+        threads[i] = SDL_CreateThread(AE_Bench_ContentionWorker, "ae_contention", &state);
+    }
+    for (int i = 0; i<threadCount; i++)
+    {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    double time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter());
+    
+    //Only the definition should still reference the sheet, and only its creator the definition
+    if (AE_LinkedTexture_GetReferenceCount(state.sheet) != 1 || AE_SpriteDef_GetReferenceCount(state.definition) != 1)
+    {
+        success = SDL_FALSE;
+    }
+    
+    //Nothing may join after a deferred destroy, so it's only asked for once the threads have stopped joining
+    AE_DestroyLinkedTexture_Deferred(state.sheet);
+    if (AE_LinkedTexture_Join(state.sheet, &state))
+    {
+        AE_LinkedTexture_Leave(state.sheet, &state);
+        success = SDL_FALSE;
+    }
+    destroyed += AE_LinkedTexture_DestroyQueued();
+    
+    //Releasing the definition drops the last reference, handing the sheet to the render thread
+    AE_SpriteDef_Release(state.definition);
+    if (AE_LinkedTexture_GetReferenceCount(state.sheet) != 0)
+    {
+        success = SDL_FALSE;
+    }
+    destroyed += AE_LinkedTexture_DestroyQueued();
+    destroyed += AE_LinkedTexture_DestroyQueued();
+    if (destroyed != 1)
+    {
+        success = SDL_FALSE;
+    }
+    
+    printf("linked_texture_contention %2d threads: %10.1f ns/sprite (create, join, leave, destroy)\n", threadCount, time / ((double)threadCount * iterations));
+    AE_Bench_Record(time / ((double)threadCount * iterations), "ns/sprite", SDL_FALSE, "linked_texture_contention.%d", threadCount);
+    
+    return success;
+}
+
+/**
+ Benchmarks AE_PseudoRandomFromSeed_Int over a square of world positions with both seed modes, checking the hash mode stays in range and gives the same numbers when run again
+ 
+ @param size The width and height of the square of positions
+ @return Whether the hash mode was in range and repeatable or not
+ */
+static SDL_bool AE_Bench_PseudoRandom(int size)
+{
+    const AE_SeedMode modes[] = {AE_SEED_MODE_LEGACY, AE_SEED_MODE_HASH};
+    const char* modeNames[] = {"legacy", "hash"};
+    SDL_bool valid = SDL_TRUE;
+    Uint64 checksums[2] = {0, 0};
+    double legacyTime = 0;
+    
+    for (int mode = 0; mode<(int)SDL_arraysize(modes); mode++)
+    {
+        AE_SetSeedMode(modes[mode]);
+        
+        //The legacy generator is slow enough that it only covers a corner of the square
+        int width = (modes[mode] == AE_SEED_MODE_LEGACY) ? SDL_min(size, 512) : size;
+        Uint64 checksum = 0;
+        
+        Uint64 startTime = SDL_GetPerformanceCounter();
+        for (int y = 0; y<width; y++)
+        {
+            for (int x = 0; x<width; x++)
+            {
+                int value = AE_PseudoRandomFromSeed_Int(0x5EED, x, y, 1, 0, 256);
+                if (value < 0 || value >= 256)
+                {
+                    valid = SDL_FALSE;
+                }
+                checksum = checksum * 31 + (Uint64)value;
+            }
+        }
+        double time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / ((double)width * width);
+        
+        if (modes[mode] == AE_SEED_MODE_LEGACY)
+        {
+            legacyTime = time;
+        }
+        else
+        {
+            checksums[0] = checksum;
+        }
+        
+        printf("pseudo_random %-6s %4dx%-4d: %8.2f ns/call, %7.1fx legacy\n", modeNames[mode], width, width, time, legacyTime / time);
+        AE_Bench_Record(time, "ns/call", SDL_FALSE, "pseudo_random.%s", modeNames[mode]);
+    }
+    
+    //Generating the square again through the Uint64 version has to give the same numbers
+    for (int y = 0; y<size; y++)
+    {
+        for (int x = 0; x<size; x++)
+        {
+            checksums[1] = checksums[1] * 31 + (Uint64)AE_PseudoRandomFromSeed_Uint64(0x5EED, (Uint64)x, (Uint64)y, 1, 0, 256);
+        }
+    }
+    if (checksums[0] != checksums[1])
+    {
+        valid = SDL_FALSE;
+    }
+    AE_SetSeedMode(AE_SEED_MODE_HASH);
+    
+    return valid;
+}
+
+/**
+ Benchmarks filling a noise field on every instruction set and with several thread counts, checking that each one matches the scalar single thread results bit for bit
+ 
+ @param size The width and height of the field
+ @param octaves The number of octaves of gradient noise
+ @return Whether every instruction set and thread count matched the scalar results or not
+ */
+static SDL_bool AE_Bench_NoiseField(int size, int octaves)
+{
+    const AE_SimdLevel levels[] = {AE_SIMD_SCALAR, AE_SIMD_SSE2, AE_SIMD_AVX2};
+    const char* levelNames[] = {"scalar", "sse2", "avx2"};
+    const int threadCounts[] = {1, 4, 0};
+    SDL_bool identical = SDL_TRUE;
+    double scalarTime = 0;
+    AE_NoiseSettings settings;
+    
+    float* reference = SDL_malloc(sizeof(float) * size * size);
+    float* field = SDL_malloc(sizeof(float) * size * size);
+    
+    AE_FillNoiseSettings(&settings, AE_NOISE_GRADIENT, 0x5EED, 0);
+    settings.period = 256;
+    settings.octaves = octaves;
+    
+    for (int level = 0; level<(int)SDL_arraysize(levels); level++)
+    {
+        AE_SetSimdLevel(levels[level]);
+        
+        //Skip instruction sets the CPU can't run
+        if (AE_GetSimdLevel() != levels[level])
+        {
+            continue;
+        }
+        
+        for (int thread = 0; thread<(int)SDL_arraysize(threadCounts); thread++)
+        {
+            //Chunks far from the origin have to come out the same as any other
+            Uint64 startTime = SDL_GetPerformanceCounter();
+            if (!AE_NoiseField_Float(field, size, size, -123456789, 987654321, &settings, threadCounts[thread]))
+            {
+                identical = SDL_FALSE;
+                continue;
+            }
+            double time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / ((double)size * size);
+            
+            if (levels[level] == AE_SIMD_SCALAR && threadCounts[thread] == 1)
+            {
+                scalarTime = time;
+                SDL_memcpy(reference, field, sizeof(float) * size * size);
+            }
+            else if (SDL_memcmp(reference, field, sizeof(float) * size * size) != 0)
+            {
+                identical = SDL_FALSE;
+            }
+            
+            printf("noise_field %-6s %d octaves %2d threads: %8.2f ns/tile, %6.2fx scalar\n", levelNames[level], octaves, (threadCounts[thread] > 0) ? threadCounts[thread] : SDL_GetCPUCount(), time, scalarTime / time);
+            AE_Bench_Record(time, "ns/tile", SDL_FALSE, (threadCounts[thread] > 0) ? "noise_field.%s.%d_threads" : "noise_field.%s.all_threads", levelNames[level], threadCounts[thread]);
+        }
+    }
+    AE_SetSimdLevel(AE_SIMD_AUTO);
+    
+    SDL_free(reference);
+    SDL_free(field);
+    
+    return identical;
+}
+
+/**
+ The way AE_Random used to get a random number, with libc's rand() and a remainder
+ 
+ @param min The min number the output can be
+ @param max The number above the max the output can be
+ @return The random number
+ */
+static int AE_Bench_LegacyRandom(int min, int max)
+{
+    return (min != max) ? ((int )(SDL_floor(rand() % (max - min)) + min)) : min;
+}
+
+/**
+ Benchmarks AE_Random and the AE_Rng functions against the rand() based version AE_Random used to be, checking every number is in range
+ 
+ @param count The number of random numbers each function draws
+ @return Whether every number was in range or not
+ */
+static SDL_bool AE_Bench_Rng(int count)
+{
+    SDL_bool valid = SDL_TRUE;
+    AE_Rng rng;
+    Uint64 checksum = 0;
+    int* ints = SDL_malloc(sizeof(int) * count);
+    float* floats = SDL_malloc(sizeof(float) * count);
+    
+    //Touch the arrays first so page faults aren't timed
+    SDL_memset(ints, 0, sizeof(int) * count);
+    SDL_memset(floats, 0, sizeof(float) * count);
+    AE_SeedRng(&rng, 0x5EED);
+    
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    for (int i = 0; i<count; i++)
+    {
+        ints[i] = AE_Bench_LegacyRandom(0, 1000);
+    }
+    double legacyTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / count;
+    printf("rng rand() random      : %6.2f ns/number\n", legacyTime);
+    
+    startTime = SDL_GetPerformanceCounter();
+    for (int i = 0; i<count; i++)
+    {
+        ints[i] = AE_Random(0, 1000);
+    }
+    double time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / count;
+    printf("rng AE_Random          : %6.2f ns/number, %5.2fx rand()\n", time, legacyTime / time);
+    AE_Bench_Record(time, "ns/number", SDL_FALSE, "rng.random");
+    
+    startTime = SDL_GetPerformanceCounter();
+    for (int i = 0; i<count; i++)
+    {
+        ints[i] = AE_Rng_Range(&rng, 0, 1000);
+    }
+    time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / count;
+    printf("rng AE_Rng_Range       : %6.2f ns/number, %5.2fx rand()\n", time, legacyTime / time);
+    AE_Bench_Record(time, "ns/number", SDL_FALSE, "rng.range");
+    
+    startTime = SDL_GetPerformanceCounter();
+    AE_Rng_FillRange(&rng, ints, count, 0, 1000);
+    time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / count;
+    printf("rng AE_Rng_FillRange   : %6.2f ns/number, %5.2fx rand()\n", time, legacyTime / time);
+    AE_Bench_Record(time, "ns/number", SDL_FALSE, "rng.fill_range");
+    
+    startTime = SDL_GetPerformanceCounter();
+    AE_Rng_FillFloat(&rng, floats, count);
+    time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / count;
+    printf("rng AE_Rng_FillFloat   : %6.2f ns/number\n", time);
+    AE_Bench_Record(time, "ns/number", SDL_FALSE, "rng.fill_float");
+    
+    for (int i = 0; i<count; i++)
+    {
+        if (ints[i] < 0 || ints[i] >= 1000 || floats[i] < 0.0f || floats[i] >= 1.0f)
+        {
+            valid = SDL_FALSE;
+        }
+        checksum += (Uint64)ints[i];
+    }
+    
+    //Half of 999 on average, so a sum far from it means the numbers are skewed
+    double mean = (double)checksum / count;
+    if (mean < 490.0 || mean > 509.0)
+    {
+        valid = SDL_FALSE;
+    }
+    
+    SDL_free(ints);
+    SDL_free(floats);
+    
+    return valid;
+}
+
+/**
+ The sprite settings a render run draws with
+ */
+typedef struct {
+    const char* name;
+    SDL_bool tint;
+    SDL_bool rotate;
+    SDL_bool flip;
+    //Whether each setting only goes on some of the sprites, so the renderer keeps switching between them
+    SDL_bool alternate;
+}AE_Bench_RenderMix;
+
+/**
+ Creates a sprite sheet of 8 32x32 frames, each a different color with a transparent border
+ 
+ @param renderer The renderer the sheet will be drawn with
+ @return The AE_LinkedTexture of the sheet, or NULL if it couldn't be created
+ */
+static AE_LinkedTexture* AE_Bench_CreateSheet(SDL_Renderer* renderer)
+{
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 256, 32, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Texture* texture = NULL;
+    
+    if (surface == NULL)
+    {
+        return NULL;
+    }
+    SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, 0, 0, 0, 0));
+    for (int frame = 0; frame<8; frame++)
+    {
+        SDL_Rect rect = {frame * 32 + 2, 2, 28, 28};
+        SDL_FillRect(surface, &rect, SDL_MapRGBA(surface->format, (Uint8)(frame * 32), (Uint8)(255 - frame * 32), 128, 255));
+    }
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    
+    return (texture != NULL) ? AE_CreateLinkedTexture(texture) : NULL;
+}
+
+/**
+ Benchmarks AE_SpriteRender on a headless software renderer with several mixes of tint, rotation and flip, checking every sprite was drawn
+ 
+ @param renderer The renderer to draw with
+ @param sheet The sprite sheet the sprites are drawn from
+ @param count The number of sprites drawn each frame
+ @param frames The number of frames drawn for each mix
+ @return Whether every sprite was drawn or not
+ */
+static SDL_bool AE_Bench_SpriteRender(SDL_Renderer* renderer, AE_LinkedTexture* sheet, int count, int frames)
+{
+    const AE_Bench_RenderMix mixes[] = {
+        {"plain", SDL_FALSE, SDL_FALSE, SDL_FALSE, SDL_FALSE},
+        {"tint", SDL_TRUE, SDL_FALSE, SDL_FALSE, SDL_FALSE},
+        {"rotate", SDL_FALSE, SDL_TRUE, SDL_FALSE, SDL_FALSE},
+        {"flip", SDL_FALSE, SDL_FALSE, SDL_TRUE, SDL_FALSE},
+        {"mixed", SDL_TRUE, SDL_TRUE, SDL_TRUE, SDL_TRUE}
+    };
+    SDL_bool success = SDL_TRUE;
+    int width = 0;
+    int height = 0;
+    
+    AE_SpriteDef* definition = AE_CreateSpriteDef(sheet, 0, 0, 8, 32, 32, 16, 16, 30);
+    AE_Sprite** sprites = SDL_malloc(sizeof(AE_Sprite*) * count);
+    SDL_Point* positions = SDL_malloc(sizeof(SDL_Point) * count);
+    AE_Rng rng;
+    
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    AE_SeedRng(&rng, (Uint64)count);
+    for (int i = 0; i<count; i++)
+    {
+        sprites[i] = AE_CreateSpriteFromDef(definition);
+        positions[i].x = AE_Rng_Range(&rng, 0, width - 32);
+        positions[i].y = AE_Rng_Range(&rng, 0, height - 32);
+    }
+    
+    for (int mix = 0; mix<(int)SDL_arraysize(mixes); mix++)
+    {
+        for (int i = 0; i<count; i++)
+        {
+            AE_ColorBundle color = {(Uint8)(64 + i % 192), (Uint8)(255 - i % 128), (Uint8)(128 + i % 64)};
+            
+            AE_SpriteSetColor(sprites[i], NULL, AE_SPRITE_DEFAULT);
+            AE_SpriteSetAlpha(sprites[i], 255);
+            AE_SpriteSetAngle(sprites[i], 0.0);
+            AE_SpriteSetFlip(sprites[i], SDL_FLIP_NONE);
+            
+            if (mixes[mix].tint && (!mixes[mix].alternate || i % 2 == 0))
+            {
+                AE_SpriteSetColor(sprites[i], &color, AE_SPRITE_KEEP_NONE);
+                AE_SpriteSetAlpha(sprites[i], (Uint8)(128 + i % 128));
+            }
+            if (mixes[mix].rotate && (!mixes[mix].alternate || i % 3 == 0))
+            {
+                AE_SpriteSetAngle(sprites[i], (double)((i * 37) % 360));
+            }
+            if (mixes[mix].flip && (!mixes[mix].alternate || i % 5 == 0))
+            {
+                AE_SpriteSetFlip(sprites[i], (i % 2 == 0) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_VERTICAL);
+            }
+        }
+        
+        //The first frame isn't timed, so the renderer has settled
+        Uint64 startTime = 0;
+        for (int frame = -1; frame<frames; frame++)
+        {
+            if (frame == 0)
+            {
+                startTime = SDL_GetPerformanceCounter();
+            }
+            SDL_RenderClear(renderer);
+            for (int i = 0; i<count; i++)
+            {
+                if (!AE_SpriteRender(sprites[i], renderer, positions[i].x, positions[i].y, -1, 1.0f / 60.0f))
+                {
+                    success = SDL_FALSE;
+                }
+            }
+            //The renderer queues its draws until it presents, so presenting is part of the cost
+            SDL_RenderPresent(renderer);
+        }
+        double time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter());
+        double spritesPerSecond = (double)count * frames * 1000000000.0 / time;
+        
+        printf("sprite_render %-6s %6d sprites: %12.0f sprites/s, %8.1f ns/sprite\n", mixes[mix].name, count, spritesPerSecond, time / ((double)count * frames));
+        AE_Bench_Record(spritesPerSecond, "sprites/s", SDL_TRUE, "sprite_render.%s.%d", mixes[mix].name, count);
+    }
+    
+    for (int i = 0; i<count; i++)
+    {
+        AE_DestroySprite(sprites[i]);
+    }
+    AE_SpriteDef_Release(definition);
+    SDL_free(sprites);
+    SDL_free(positions);
+    
+    return success;
+}
+
+/**
+ Benchmarks drawing a static scene from an AE_CachedLayer against drawing its sprites one by one every frame, checking the layer was only drawn once
+ 
+ @param renderer The renderer to draw with
+ @param sheet The sprite sheet the sprites are drawn from
+ @param count The number of sprites in the scene
+ @param frames The number of frames drawn each way
+ @return Whether every frame was drawn and the layer was never drawn again or not
+ */
+static SDL_bool AE_Bench_CachedLayer(SDL_Renderer* renderer, AE_LinkedTexture* sheet, int count, int frames)
+{
+    SDL_bool success = SDL_TRUE;
+    int width = 0;
+    int height = 0;
+    
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    AE_CachedLayer* layer = AE_CreateCachedLayer(renderer, width, height);
+    if (layer == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    AE_SpriteDef* definition = AE_CreateSpriteDef(sheet, 0, 0, 8, 32, 32, 16, 16, 30);
+    AE_Sprite** sprites = SDL_malloc(sizeof(AE_Sprite*) * count);
+    SDL_Point* positions = SDL_malloc(sizeof(SDL_Point) * count);
+    AE_Rng rng;
+    
+    AE_SeedRng(&rng, (Uint64)count);
+    for (int i = 0; i<count; i++)
+    {
+        sprites[i] = AE_CreateSpriteFromDef(definition);
+        positions[i].x = AE_Rng_Range(&rng, 0, width - 32);
+        positions[i].y = AE_Rng_Range(&rng, 0, height - 32);
+        AE_CachedLayer_AddSprite(layer, sprites[i], positions[i].x, positions[i].y, i % 8);
+    }
+    
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame<frames; frame++)
+    {
+        SDL_RenderClear(renderer);
+        for (int i = 0; i<count; i++)
+        {
+            if (!AE_SpriteRender(sprites[i], renderer, positions[i].x, positions[i].y, i % 8, 1.0f / 60.0f))
+            {
+                success = SDL_FALSE;
+            }
+        }
+        SDL_RenderPresent(renderer);
+    }
+    double directTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / frames;
+    
+    //The first frame draws the layer, every later one only copies it
+    AE_CachedLayer_Update(layer);
+    startTime = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame<frames; frame++)
+    {
+        SDL_RenderClear(renderer);
+        if (!AE_CachedLayer_Render(layer, 0, 0))
+        {
+            success = SDL_FALSE;
+        }
+        SDL_RenderPresent(renderer);
+    }
+    double cachedTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / frames;
+    
+    if (AE_CachedLayer_GetRedrawCount(layer) != 1)
+    {
+        success = SDL_FALSE;
+    }
+    
+    printf("cached_layer %6d sprites: direct %10.1f us/frame, cached %10.1f us/frame, %6.1fx direct\n", count, directTime / 1000.0, cachedTime / 1000.0, directTime / cachedTime);
+    AE_Bench_Record(directTime / 1000.0, "us/frame", SDL_FALSE, "cached_layer.%d.direct", count);
+    AE_Bench_Record(cachedTime / 1000.0, "us/frame", SDL_FALSE, "cached_layer.%d.cached", count);
+    
+    AE_DestroyCachedLayer(layer);
+    for (int i = 0; i<count; i++)
+    {
+        AE_DestroySprite(sprites[i]);
+    }
+    AE_SpriteDef_Release(definition);
+    SDL_free(sprites);
+    SDL_free(positions);
+    
+    return success;
+}
+
+/**
+ Benchmarks drawing a scrolling tile world through an AE_Tilemap against drawing it with a sprite per tile and a variant picked per tile, and how fast tiles of built chunks can be changed
+ 
+ @param renderer The renderer to draw with
+ @param sheet The sprite sheet the tiles are drawn from
+ @param size The width and height of the world in tiles
+ @param frames The number of frames drawn each way
+ @return Whether every frame was drawn and every tile changed or not
+ */
+static SDL_bool AE_Bench_Tilemap(SDL_Renderer* renderer, AE_LinkedTexture* sheet, int size, int frames)
+{
+    SDL_bool success = SDL_TRUE;
+    const Uint64 seed = 0x5EED;
+    int width = 0;
+    int height = 0;
+    
+    AE_Tilemap* map = AE_CreateTilemap(sheet, size, size, 32, 32, seed, 1);
+    if (map == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Two kinds of tile with four variants each, laid out in bands
+    Uint16* world = SDL_malloc(sizeof(Uint16) * size * size);
+    AE_Tilemap_SetTileType(map, 1, 0, 0, 4);
+    AE_Tilemap_SetTileType(map, 2, 128, 0, 4);
+    for (int y = 0; y<size; y++)
+    {
+        for (int x = 0; x<size; x++)
+        {
+            world[y * size + x] = (Uint16)(((x / 8 + y / 8) % 2) + 1);
+            AE_Tilemap_SetTile(map, x, y, world[y * size + x]);
+        }
+    }
+    
+    AE_SpriteDef* definition = AE_CreateSpriteDef(sheet, 0, 0, 8, 32, 32, 16, 16, 30);
+    AE_Sprite* tile = AE_CreateSpriteFromDef(definition);
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    
+    //The camera scrolls diagonally, the way a world is usually drawn
+    Uint64 startTime = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame<frames; frame++)
+    {
+        const int cameraX = frame * 3;
+        const int cameraY = frame * 2;
+        
+        SDL_RenderClear(renderer);
+        for (int y = cameraY / 32; y<=(cameraY + height - 1) / 32 && y<size; y++)
+        {
+            for (int x = cameraX / 32; x<=(cameraX + width - 1) / 32 && x<size; x++)
+            {
+                int variant = AE_PseudoRandomFromSeed_Int(seed, x, y, 1, 0, 4);
+                int frameIndex = (world[y * size + x] - 1) * 4 + variant;
+                if (!AE_SpriteRender(tile, renderer, x * 32 - cameraX, y * 32 - cameraY, frameIndex, 0.0f))
+                {
+                    success = SDL_FALSE;
+                }
+            }
+        }
+        SDL_RenderPresent(renderer);
+    }
+    double spriteTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / frames;
+    
+    startTime = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame<frames; frame++)
+    {
+        SDL_RenderClear(renderer);
+        if (!AE_Tilemap_Render(map, renderer, frame * 3, frame * 2))
+        {
+            success = SDL_FALSE;
+        }
+        SDL_RenderPresent(renderer);
+    }
+    double chunkTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / frames;
+    
+    //Changing tiles of chunks that are already built only rewrites their quads
+    const int changes = 100000;
+    startTime = SDL_GetPerformanceCounter();
+    for (int i = 0; i<changes; i++)
+    {
+        int x = (i * 7) % 32;
+        int y = (i / 32) % 20;
+        if (!AE_Tilemap_SetTile(map, x, y, (Uint16)((AE_Tilemap_GetTile(map, x, y) % 2) + 1)))
+        {
+            success = SDL_FALSE;
+        }
+    }
+    double setTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / changes;
+    
+    AE_TilemapStats stats = AE_Tilemap_GetStats(map);
+    printf("tilemap %4dx%-4d tiles: sprites %10.1f us/frame, chunked %10.1f us/frame, %6.1fx sprites, %4llu chunks built, set_tile %6.1f ns\n", size, size, spriteTime / 1000.0, chunkTime / 1000.0, spriteTime / chunkTime, (unsigned long long)stats.builtChunks, setTime);
+    AE_Bench_Record(spriteTime / 1000.0, "us/frame", SDL_FALSE, "tilemap.%d.sprites", size);
+    AE_Bench_Record(chunkTime / 1000.0, "us/frame", SDL_FALSE, "tilemap.%d.chunked", size);
+    AE_Bench_Record(setTime, "ns/tile", SDL_FALSE, "tilemap.%d.set_tile", size);
+    
+    AE_DestroySprite(tile);
+    AE_SpriteDef_Release(definition);
+    AE_DestroyTilemap(map);
+    SDL_free(world);
+    
+    return success;
+}
+
+/**
+ Benchmarks redrawing a scene with a few moving sprites through an AE_DirtyRegion against redrawing the whole window every frame, on a hidden window drawn by the software renderer
+ 
+ @param count The number of sprites in the scene
+ @param moving The number of those sprites that move every frame
+ @param frames The number of frames drawn each way
+ @return Whether every frame was drawn or not
+ */
+static SDL_bool AE_Bench_DirtyRegion(int count, int moving, int frames)
+{
+    SDL_bool success = SDL_TRUE;
+    int width = 0;
+    int height = 0;
+    
+    SDL_Window* window = SDL_CreateWindow("ae_benchmark", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1280, 720, SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = (window != NULL) ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : NULL;
+    AE_DirtyRegion* region = (renderer != NULL) ? AE_CreateDirtyRegion(window, renderer) : NULL;
+    AE_LinkedTexture* sheet = (renderer != NULL) ? AE_Bench_CreateSheet(renderer) : NULL;
+    if (region == NULL || sheet == NULL)
+    {
+        success = SDL_FALSE;
+    }
+    else
+    {
+        AE_SpriteDef* definition = AE_CreateSpriteDef(sheet, 0, 0, 8, 32, 32, 16, 16, 30);
+        AE_Sprite** sprites = SDL_malloc(sizeof(AE_Sprite*) * count);
+        SDL_Point* positions = SDL_malloc(sizeof(SDL_Point) * count);
+        AE_Rng rng;
+        
+        SDL_GetRendererOutputSize(renderer, &width, &height);
+        AE_SeedRng(&rng, (Uint64)count);
+        for (int i = 0; i<count; i++)
+        {
+            sprites[i] = AE_CreateSpriteFromDef(definition);
+            positions[i].x = AE_Rng_Range(&rng, 0, width - 32);
+            positions[i].y = AE_Rng_Range(&rng, 0, height - 32);
+        }
+        
+        //The first sprites walk across the window, the rest stay put on a fixed frame
+        Uint64 startTime = SDL_GetPerformanceCounter();
+        for (int frame = 0; frame<frames; frame++)
+        {
+            SDL_RenderClear(renderer);
+            for (int i = 0; i<count; i++)
+            {
+                int x = (i < moving) ? (positions[i].x + frame * 2) % (width - 32) : positions[i].x;
+                if (!AE_SpriteRender(sprites[i], renderer, x, positions[i].y, i % 8, 1.0f / 60.0f))
+                {
+                    success = SDL_FALSE;
+                }
+            }
+            SDL_RenderPresent(renderer);
+        }
+        double fullTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / frames;
+        
+        //The first frame draws the whole window and isn't timed
+        double redrawnPercent = 0.0;
+        for (int frame = -1; frame<frames; frame++)
+        {
+            if (frame == 0)
+            {
+                startTime = SDL_GetPerformanceCounter();
+            }
+            AE_DirtyRegion_Begin(region);
+            for (int i = 0; i<count; i++)
+            {
+                int x = (i < moving) ? (positions[i].x + (frame + 1) * 2) % (width - 32) : positions[i].x;
+                if (!AE_DirtyRegion_SubmitSprite(region, sprites[i], x, positions[i].y, i % 8, 1.0f / 60.0f))
+                {
+                    success = SDL_FALSE;
+                }
+            }
+            if (!AE_DirtyRegion_End(region))
+            {
+                success = SDL_FALSE;
+            }
+            if (frame >= 0)
+            {
+                redrawnPercent += AE_DirtyRegion_GetStats(region).redrawnPercent;
+            }
+        }
+        double dirtyTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / frames;
+        redrawnPercent /= frames;
+        
+        printf("dirty_region %6d sprites, %4d moving: full %10.1f us/frame, dirty %10.1f us/frame (%5.1f%% redrawn), %6.1fx full\n", count, moving, fullTime / 1000.0, dirtyTime / 1000.0, redrawnPercent, fullTime / dirtyTime);
+        AE_Bench_Record(fullTime / 1000.0, "us/frame", SDL_FALSE, "dirty_region.%d.%d.full", count, moving);
+        AE_Bench_Record(dirtyTime / 1000.0, "us/frame", SDL_FALSE, "dirty_region.%d.%d.dirty", count, moving);
+        AE_Bench_Record(redrawnPercent, "%", SDL_FALSE, "dirty_region.%d.%d.redrawn", count, moving);
+        
+        for (int i = 0; i<count; i++)
+        {
+            AE_DestroySprite(sprites[i]);
+        }
+        AE_SpriteDef_Release(definition);
+        SDL_free(sprites);
+        SDL_free(positions);
+    }
+    
+    if (region != NULL)
+    {
+        AE_DestroyDirtyRegion(region);
+    }
+    if (sheet != NULL)
+    {
+        AE_DestroyLinkedTexture(sheet);
+    }
+    if (renderer != NULL)
+    {
+        SDL_DestroyRenderer(renderer);
+    }
+    if (window != NULL)
+    {
+        SDL_DestroyWindow(window);
+    }
+    
+    return success;
+}
+
+/**
+ Benchmarks AE_LoadTextureFromFile on BMP and PNG files of a given size, checking every load gave a texture of the right size
+ 
+ @param renderer The renderer the textures are loaded for
+ @param size The width and height of the images
+ @param iterations The number of times each image is loaded
+ @return Whether every load worked or not
+ */
+static SDL_bool AE_Bench_TextureLoad(SDL_Renderer* renderer, int size, int iterations)
+{
+    const char* formats[] = {"bmp", "png"};
+    SDL_bool success = SDL_TRUE;
+    char paths[2][64];
+    AE_Rng rng;
+    
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    //Noise in the low bits keeps the PNG from compressing down to nothing, like real art
+    AE_SeedRng(&rng, (Uint64)size);
+    for (int y = 0; y<size; y++)
+    {
+        Uint32* row = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+        for (int x = 0; x<size; x++)
+        {
+            row[x] = SDL_MapRGBA(surface->format, (Uint8)(x ^ y), (Uint8)(x + AE_Rng_Range(&rng, 0, 8)), (Uint8)y, 255);
+        }
+    }
+    
+    for (int format = 0; format<(int)SDL_arraysize(formats); format++)
+    {
+        SDL_snprintf(paths[format], sizeof(paths[format]), "ae_benchmark_%d.%s", size, formats[format]);
+    }
+    if (SDL_SaveBMP(surface, paths[0]) != 0 || IMG_SavePNG(surface, paths[1]) != 0)
+    {
+        success = SDL_FALSE;
+    }
+    SDL_FreeSurface(surface);
+    
+    for (int format = 0; format<(int)SDL_arraysize(formats) && success; format++)
+    {
+        //The first load isn't timed, so the file is already in the OS cache like every later load
+        Uint64 startTime = 0;
+        for (int iteration = -1; iteration<iterations; iteration++)
+        {
+            if (iteration == 0)
+            {
+                startTime = SDL_GetPerformanceCounter();
+            }
+            SDL_Texture* texture = AE_LoadTextureFromFile(renderer, paths[format]);
+            if (texture == NULL || AE_TextureGetWidth(texture) != size)
+            {
+                success = SDL_FALSE;
+            }
+            if (texture != NULL)
+            {
+                SDL_DestroyTexture(texture);
+            }
+        }
+        double time = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / iterations;
+        
+        printf("texture_load %s %4dx%-4d: %10.1f us/load\n", formats[format], size, size, time / 1000.0);
+        AE_Bench_Record(time / 1000.0, "us/load", SDL_FALSE, "texture_load.%s.%d", formats[format], size);
+    }
+    
+    remove(paths[0]);
+    remove(paths[1]);
+    
+    return success;
+}
+
+/**
+ Benchmarks creating a texture for a string with AE_LoadTextureFromText against drawing the same string from an AE_GlyphCache, checking every string was drawn
+ 
+ @param renderer The renderer to draw with
+ @param fontPath The pathname of a TrueType font
+ @param iterations The number of times each string is drawn
+ @return Whether every string was drawn or not
+ */
+static SDL_bool AE_Bench_Text(SDL_Renderer* renderer, const char* fontPath, int iterations)
+{
+    const char* names[] = {"short", "long"};
+    const char* texts[] = {"Score: 12345", "The quick brown fox jumps over the lazy dog while the engine keeps drawing"};
+    const SDL_Color color = {255, 255, 255, 255};
+    SDL_bool success = SDL_TRUE;
+    
+    TTF_Font* font = TTF_OpenFont(fontPath, 16);
+    if (font == NULL)
+    {
+        return SDL_FALSE;
+    }
+    AE_GlyphCache* cache = AE_CreateGlyphCache(renderer, font, TTF_STYLE_NORMAL, 512);
+    
+    for (int text = 0; text<(int)SDL_arraysize(texts); text++)
+    {
+        //Both ways draw the string and present, so the texture isn't let off drawing it
+        Uint64 startTime = SDL_GetPerformanceCounter();
+        for (int iteration = 0; iteration<iterations; iteration++)
+        {
+            SDL_Texture* texture = AE_LoadTextureFromText(renderer, font, texts[text], color);
+            if (texture == NULL || SDL_RenderCopy(renderer, texture, NULL, NULL) != 0)
+            {
+                success = SDL_FALSE;
+            }
+            SDL_RenderPresent(renderer);
+            if (texture != NULL)
+            {
+                SDL_DestroyTexture(texture);
+            }
+        }
+        double textureTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / iterations;
+        
+        //The glyphs are rasterized once, outside the timing, the way a game would after its first frame
+        if (cache == NULL || !AE_GlyphCache_RenderText(cache, NULL, texts[text], 0, 0, color))
+        {
+            success = SDL_FALSE;
+            continue;
+        }
+        startTime = SDL_GetPerformanceCounter();
+        for (int iteration = 0; iteration<iterations; iteration++)
+        {
+            if (!AE_GlyphCache_RenderText(cache, NULL, texts[text], 0, 0, color))
+            {
+                success = SDL_FALSE;
+            }
+            SDL_RenderPresent(renderer);
+        }
+        double cacheTime = AE_Bench_Nanoseconds(startTime, SDL_GetPerformanceCounter()) / iterations;
+        
+        printf("text %-5s %3d characters: texture %8.1f us/text, glyph cache %8.1f us/text, %5.1fx texture\n", names[text], (int)SDL_strlen(texts[text]), textureTime / 1000.0, cacheTime / 1000.0, textureTime / cacheTime);
+        AE_Bench_Record(textureTime / 1000.0, "us/text", SDL_FALSE, "text.texture.%s", names[text]);
+        AE_Bench_Record(cacheTime / 1000.0, "us/text", SDL_FALSE, "text.glyph_cache.%s", names[text]);
+    }
+    
+    if (cache != NULL)
+    {
+        AE_DestroyGlyphCache(cache);
+    }
+    TTF_CloseFont(font);
+    
+    return success;
+}
+
+/**
+ Benchmarks joining a linkedTexture from many objects and then leaving it in a shuffled order, checking every reference was accounted for
+ 
+ @param count The number of objects that join
+ @return Whether every join and leave worked and the count came back to zero or not
+ */
+static SDL_bool AE_Bench_LinkedTextureScaling(int count)
+{
+    SDL_bool success = SDL_TRUE;
+    AE_LinkedTexture* sheet = AE_CreateLinkedTexture(NULL);
+    //Every byte is a different address, which is all a stakeholder has to be
+    char* stakeholders = SDL_malloc(count);
+    int* order = SDL_malloc(sizeof(int) * count);
+    AE_Rng rng;
+    
+    if (sheet == NULL || stakeholders == NULL || order == NULL)
+    {
+        success = SDL_FALSE;
+        count = 0;
+    }
+    
+    AE_SeedRng(&rng, (Uint64)count);
+    for (int i = 0; i<count; i++)
+    {
+        order[i] = i;
+    }
+    for (int i = count - 1; i>0; i--)
+    {
+        int swap = AE_Rng_Range(&rng, 0, i + 1);
+        int temp = order[i];
+        order[i] = order[swap];
+        order[swap] = temp;
+    }
+    
+    //Small counts are repeated so growing the list the first time doesn't swamp them
+    const int rounds = SDL_max(1, 1000000 / SDL_max(count, 1));
+    Uint64 joinTicks = 0;
+    Uint64 leaveTicks = 0;
+    for (int round = 0; round<rounds; round++)
+    {
+        Uint64 startTime = SDL_GetPerformanceCounter();
+        for (int i = 0; i<count; i++)
+        {
+            if (!AE_LinkedTexture_Join(sheet, &stakeholders[i]))
+            {
+                success = SDL_FALSE;
+            }
+        }
+        Uint64 middleTime = SDL_GetPerformanceCounter();
+        for (int i = 0; i<count; i++)
+        {
+            if (!AE_LinkedTexture_Leave(sheet, &stakeholders[order[i]]))
+            {
+                success = SDL_FALSE;
+            }
+        }
+        joinTicks += middleTime - startTime;
+        leaveTicks += SDL_GetPerformanceCounter() - middleTime;
+    }
+    double joinTime = AE_Bench_Nanoseconds(0, joinTicks) / ((double)rounds * SDL_max(count, 1));
+    double leaveTime = AE_Bench_Nanoseconds(0, leaveTicks) / ((double)rounds * SDL_max(count, 1));
+    
+    if (sheet != NULL)
+    {
+        if (AE_LinkedTexture_GetReferenceCount(sheet) != 0)
+        {
+            success = SDL_FALSE;
+        }
+        AE_DestroyLinkedTexture(sheet);
+    }
+    
+    printf("linked_texture_scaling %7d stakeholders: join %6.1f ns, leave %6.1f ns\n", count, joinTime, leaveTime);
+    AE_Bench_Record(joinTime, "ns/join", SDL_FALSE, "linked_texture_scaling.%d.join", count);
+    AE_Bench_Record(leaveTime, "ns/leave", SDL_FALSE, "linked_texture_scaling.%d.leave", count);
+    
+    SDL_free(stakeholders);
+    SDL_free(order);
+    
+    return success;
+}
+
+/**
+ Writes every recorded result to a JSON file
+ 
+ @param path The pathname of the file to write
+ @return Whether the file was written or not
+ */
+static SDL_bool AE_Bench_WriteJson(const char* path)
+{
+    FILE* file = fopen(path, "w");
+    
+    if (file == NULL)
+    {
+        return SDL_FALSE;
+    }
+    
+    fprintf(file, "{\n  \"results\": [");
+    for (int i = 0; i<AE_benchResultCount; i++)
+    {
+        const AE_Bench_Result* result = &AE_benchResults[i];
+        fprintf(file, "%s\n    {\"name\": \"%s\", \"value\": %.6g, \"unit\": \"%s\", \"better\": \"%s\"}", (i > 0) ? "," : "", result->name, result->value, result->unit, result->higherIsBetter ? "higher" : "lower");
+    }
+    fprintf(file, "\n  ]\n}\n");
+    
+    return (fclose(file) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/**
+ Compares every recorded result against the results of an earlier run written by AE_Bench_WriteJson, printing how each one changed
+ 
+ @param path The pathname of the earlier results
+ @param tolerance The fraction worse than the earlier result a result can be before it counts as a regression
+ @return Whether the earlier results were read and nothing regressed or not
+ */
+static SDL_bool AE_Bench_CompareBaseline(const char* path, double tolerance)
+{
+    SDL_bool success = SDL_TRUE;
+    char* baseline = SDL_LoadFile(path, NULL);
+    //Room for the longest name with the quotes around it
+    char key[sizeof(AE_benchResults[0].name) + sizeof("\"name\": \"\"")];
+    
+    if (baseline == NULL)
+    {
+        printf("baseline: could not read %s\n", path);
+        return SDL_FALSE;
+    }
+    
+    for (int i = 0; i<AE_benchResultCount; i++)
+    {
+        const AE_Bench_Result* result = &AE_benchResults[i];
+        
+        //The file is only ever written by AE_Bench_WriteJson, so each name is followed by its value
+        int keyLength = SDL_snprintf(key, sizeof(key), "\"name\": \"%.*s\"", (int)sizeof(result->name) - 1, result->name);
+        char* entry = (keyLength > 0 && keyLength < (int)sizeof(key)) ? SDL_strstr(baseline, key) : NULL;
+        char* value = (entry != NULL) ? SDL_strstr(entry, "\"value\": ") : NULL;
+        if (value == NULL)
+        {
+            printf("baseline %-40s new\n", result->name);
+            continue;
+        }
+        
+        double previous = SDL_strtod(value + 9, NULL);
+        double change = (previous != 0.0) ? (result->value - previous) / previous : 0.0;
+        SDL_bool regressed = result->higherIsBetter ? (change < -tolerance) : (change > tolerance);
+        if (regressed)
+        {
+            success = SDL_FALSE;
+        }
+        printf("baseline %-40s %12.6g -> %12.6g %s (%+6.1f%%)%s\n", result->name, previous, result->value, result->unit, change * 100.0, regressed ? " REGRESSION" : "");
+    }
+    
+    SDL_free(baseline);
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    SDL_bool success = SDL_TRUE;
+    const char* jsonPath = "ae_benchmark.json";
+    const char* baselinePath = NULL;
+    const char* fontPath = NULL;
+    double tolerance = 0.1;
+    
+    for (int i = 1; i<argc; i++)
+    {
+        if (i + 1 < argc && SDL_strcmp(argv[i], "--json") == 0)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (i + 1 < argc && SDL_strcmp(argv[i], "--baseline") == 0)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (i + 1 < argc && SDL_strcmp(argv[i], "--tolerance") == 0)
+        {
+            tolerance = SDL_atof(argv[++i]) / 100.0;
+        }
+        else if (i + 1 < argc && SDL_strcmp(argv[i], "--font") == 0)
+        {
+            fontPath = argv[++i];
+        }
+        else
+        {
+            printf("usage: %s [--json path] [--baseline path] [--tolerance percent] [--font path]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    //Nothing is shown, so the dummy driver does unless another one was asked for
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_Surface* target = NULL;
+    SDL_Renderer* renderer = NULL;
+    if (SDL_Init(SDL_INIT_VIDEO) == 0 && TTF_Init() == 0)
+    {
+        IMG_Init(IMG_INIT_PNG);
+        target = SDL_CreateRGBSurfaceWithFormat(0, 1280, 720, 32, SDL_PIXELFORMAT_ARGB8888);
+        renderer = (target != NULL) ? SDL_CreateSoftwareRenderer(target) : NULL;
+    }
+    if (renderer == NULL)
+    {
+        printf("headless renderer could not be created: %s\n", SDL_GetError());
+        success = SDL_FALSE;
+    }
+    else
+    {
+        AE_LinkedTexture* sheet = AE_Bench_CreateSheet(renderer);
+        const int renderCounts[] = {1000, 10000};
+        for (int i = 0; i<(int)SDL_arraysize(renderCounts); i++)
+        {
+            if (sheet == NULL || !AE_Bench_SpriteRender(renderer, sheet, renderCounts[i], 30))
+            {
+                printf("sprite_render: sprites failed to draw at %d sprites\n", renderCounts[i]);
+                success = SDL_FALSE;
+            }
+        }
+        
+        const int layerCounts[] = {100, 1000};
+        for (int i = 0; i<(int)SDL_arraysize(layerCounts); i++)
+        {
+            if (sheet == NULL || !AE_Bench_CachedLayer(renderer, sheet, layerCounts[i], 30))
+            {
+                printf("cached_layer: frames failed to draw or the layer was redrawn at %d sprites\n", layerCounts[i]);
+                success = SDL_FALSE;
+            }
+        }
+        
+        if (sheet == NULL || !AE_Bench_Tilemap(renderer, sheet, 256, 60))
+        {
+            printf("tilemap: frames failed to draw or tiles failed to change\n");
+            success = SDL_FALSE;
+        }
+        if (sheet != NULL)
+        {
+            AE_DestroyLinkedTexture(sheet);
+        }
+        
+        const int movingCounts[] = {10, 100};
+        for (int i = 0; i<(int)SDL_arraysize(movingCounts); i++)
+        {
+            if (!AE_Bench_DirtyRegion(1000, movingCounts[i], 30))
+            {
+                printf("dirty_region: frames failed to draw with %d moving sprites\n", movingCounts[i]);
+                success = SDL_FALSE;
+            }
+        }
+        
+        const int imageSizes[] = {64, 512};
+        for (int i = 0; i<(int)SDL_arraysize(imageSizes); i++)
+        {
+            if (!AE_Bench_TextureLoad(renderer, imageSizes[i], 50))
+            {
+                printf("texture_load: images failed to load at %dx%d\n", imageSizes[i], imageSizes[i]);
+                success = SDL_FALSE;
+            }
+        }
+        
+        if (fontPath == NULL)
+        {
+            printf("text: skipped, pass --font with a TrueType font to run it\n");
+        }
+        else if (!AE_Bench_Text(renderer, fontPath, 500))
+        {
+            printf("text: strings failed to draw with %s\n", fontPath);
+            success = SDL_FALSE;
+        }
+    }
+    
+    const int spriteCounts[] = {1000, 10000, 100000};
+    for (int i = 0; i<(int)SDL_arraysize(spriteCounts); i++)
+    {
+        if (!AE_Bench_SpritesAdvance(spriteCounts[i]))
+        {
+            printf("sprites_advance: SIMD results differ from scalar at %d sprites\n", spriteCounts[i]);
+            success = SDL_FALSE;
+        }
+    }
+    
+    const int pointCounts[] = {10000, 50000, 100000};
+    for (int i = 0; i<(int)SDL_arraysize(pointCounts); i++)
+    {
+        if (!AE_Bench_SpatialHash(pointCounts[i]))
+        {
+            printf("spatial_hash: results differ from brute force at %d points\n", pointCounts[i]);
+            success = SDL_FALSE;
+        }
+    }
+    
+    const int threadCounts[] = {1, 4, 8};
+    for (int i = 0; i<(int)SDL_arraysize(threadCounts); i++)
+    {
+        if (!AE_Bench_LinkedTextureContention(threadCounts[i], 200000))
+        {
+            printf("linked_texture_contention: references were lost with %d threads\n", threadCounts[i]);
+            success = SDL_FALSE;
+        }
+    }
+    
+    const int stakeholderCounts[] = {100, 10000, 100000};
+    for (int i = 0; i<(int)SDL_arraysize(stakeholderCounts); i++)
+    {
+        if (!AE_Bench_LinkedTextureScaling(stakeholderCounts[i]))
+        {
+            printf("linked_texture_scaling: references were lost with %d stakeholders\n", stakeholderCounts[i]);
+            success = SDL_FALSE;
+        }
+    }
+    
+    if (!AE_Bench_PseudoRandom(4096))
+    {
+        printf("pseudo_random: hash mode was out of range or not repeatable\n");
+        success = SDL_FALSE;
+    }
+    
+    if (!AE_Bench_NoiseField(1024, 6))
+    {
+        printf("noise_field: results differ between instruction sets or thread counts\n");
+        success = SDL_FALSE;
+    }
+    
+    if (!AE_Bench_Rng(10000000))
+    {
+        printf("rng: numbers were out of range or skewed\n");
+        success = SDL_FALSE;
+    }
+    
+    if (!AE_Bench_WriteJson(jsonPath))
+    {
+        printf("results could not be written to %s\n", jsonPath);
+        success = SDL_FALSE;
+    }
+    if (baselinePath != NULL && !AE_Bench_CompareBaseline(baselinePath, tolerance))
+    {
+        printf("baseline: results regressed more than %.1f%% from %s\n", tolerance * 100.0, baselinePath);
+        success = SDL_FALSE;
+    }
+    
+    if (renderer != NULL)
+    {
+        SDL_DestroyRenderer(renderer);
+    }
+    SDL_FreeSurface(target);
+    AE_CloseSDL();
+    
+    return success ? 0 : 1;
+}